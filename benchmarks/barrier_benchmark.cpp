@@ -0,0 +1,64 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+#include "../src/renderer/barrier_tracker.h"
+
+#include <vector>
+
+void runBarrierBenchmark(BenchmarkRunner& runner) {
+	const uint32_t IMAGE_COUNT = 1000;
+	const uint32_t BUFFER_COUNT = 256;
+
+	if (!runner.shouldRun("barriers/")) {
+		return;
+	}
+
+	std::vector<VkImage> images(IMAGE_COUNT);
+	std::vector<VkBuffer> buffers(BUFFER_COUNT);
+
+	VkCommandBuffer commandBuffer = reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(1));
+
+	BarrierTracker barrierTracker;
+	barrierTracker.setSynchronization2(true);
+
+	for (uint32_t i = 0; i < IMAGE_COUNT; i++) {
+		images[i] = reinterpret_cast<VkImage>(static_cast<uintptr_t>(i + 1));
+		barrierTracker.trackImage(images[i], VK_IMAGE_ASPECT_COLOR_BIT);
+	}
+
+	for (uint32_t i = 0; i < BUFFER_COUNT; i++) {
+		buffers[i] = reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(IMAGE_COUNT + i + 1));
+		barrierTracker.trackBuffer(buffers[i]);
+	}
+
+	runner.run("barriers/frame/1k", [&]() {
+		for (VkImage image : images) {
+			barrierTracker.transitionImage(image, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+		}
+
+		for (VkBuffer buffer : buffers) {
+			barrierTracker.accessBuffer(buffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+		}
+
+		barrierTracker.flush(commandBuffer);
+
+		for (VkImage image : images) {
+			barrierTracker.transitionImage(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+		}
+
+		for (VkBuffer buffer : buffers) {
+			barrierTracker.accessBuffer(buffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+		}
+
+		barrierTracker.flush(commandBuffer);
+
+		for (VkImage image : images) {
+			barrierTracker.transitionImage(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+		}
+
+		barrierTracker.flush(commandBuffer);
+	});
+
+	BarrierTracker::statistics statistics = barrierTracker.getStatistics();
+
+	log_info("Barrier requests: " + std::to_string(statistics.requests) + ", emitted: " + std::to_string(statistics.imageBarriers + statistics.bufferBarriers) + " in " + std::to_string(statistics.batches) + " batches, elided: " + std::to_string(statistics.elidedBarriers));
+}
\ No newline at end of file
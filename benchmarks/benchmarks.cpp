@@ -0,0 +1,264 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <unordered_map>
+
+std::atomic<uint64_t> allocationCount = 0;
+std::atomic<uint64_t> allocationBytes = 0;
+volatile uint64_t benchmarkSink = 0;
+
+void* operator new(size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+	void* memory = std::malloc(size == 0 ? 1 : size);
+
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	std::free(memory);
+}
+
+void BenchmarkRunner::parseArguments(int argc, char** argv) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+
+		if (argument == "--filter" && i + 1 < argc) {
+			options.filter = argv[++i];
+		}
+		else if (argument == "--output" && i + 1 < argc) {
+			options.outputPath = argv[++i];
+		}
+		else if (argument == "--baseline" && i + 1 < argc) {
+			options.baselinePath = argv[++i];
+		}
+		else if (argument == "--threshold" && i + 1 < argc) {
+			options.regressionThreshold = std::stod(argv[++i]);
+		}
+		else if (argument == "--time" && i + 1 < argc) {
+			options.totalMilliseconds = std::stod(argv[++i]);
+		}
+		else {
+			log_warning("Unknown argument: " + argument);
+		}
+	}
+}
+
+bool BenchmarkRunner::shouldRun(const std::string& name) {
+	return options.filter.empty() || name.rfind(options.filter, 0) == 0 || options.filter.rfind(name, 0) == 0;
+}
+
+uint32_t BenchmarkRunner::getSampleCount(double sampleMilliseconds) {
+	double sampleCount = options.totalMilliseconds / std::max(sampleMilliseconds, 0.001);
+
+	return static_cast<uint32_t>(std::clamp(sampleCount, static_cast<double>(options.minimumSamples), static_cast<double>(options.maximumSamples)));
+}
+
+void BenchmarkRunner::addResult(const std::string& name, std::vector<double>& samples, uint64_t iterationsPerSample, uint64_t allocations, uint64_t bytes) {
+	std::sort(samples.begin(), samples.end());
+
+	double sum = 0.0;
+
+	for (double sample : samples) {
+		sum += sample;
+	}
+
+	auto percentile = [&samples](double fraction) {
+		size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+
+		return samples[index];
+	};
+
+	uint64_t iterations = iterationsPerSample * samples.size();
+
+	result benchmarkResult{};
+	benchmarkResult.name = name;
+	benchmarkResult.iterations = iterations;
+	benchmarkResult.samples = static_cast<uint32_t>(samples.size());
+	benchmarkResult.median = percentile(0.50);
+	benchmarkResult.p99 = percentile(0.99);
+	benchmarkResult.mean = sum / static_cast<double>(samples.size());
+	benchmarkResult.minimum = samples.front();
+	benchmarkResult.maximum = samples.back();
+	benchmarkResult.allocationsPerIteration = static_cast<double>(allocations) / static_cast<double>(iterations);
+	benchmarkResult.bytesPerIteration = static_cast<double>(bytes) / static_cast<double>(iterations);
+
+	results.push_back(benchmarkResult);
+
+	std::ostringstream line;
+	line << std::fixed << std::setprecision(1)
+		 << std::left << std::setw(40) << name << std::right
+		 << " median " << std::setw(12) << benchmarkResult.median << " ns"
+		 << "  p99 " << std::setw(12) << benchmarkResult.p99 << " ns"
+		 << std::setprecision(2)
+		 << "  allocs/iter " << std::setw(8) << benchmarkResult.allocationsPerIteration
+		 << "  bytes/iter " << std::setw(10) << benchmarkResult.bytesPerIteration;
+
+	log_info(line.str());
+}
+
+void BenchmarkRunner::report() {
+	log_info("Ran " + std::to_string(results.size()) + " benchmarks!");
+}
+
+void BenchmarkRunner::writeResults() {
+	if (options.outputPath.empty()) {
+		return;
+	}
+
+	std::ofstream file(options.outputPath);
+
+	if (!file.is_open()) {
+		log_error("Failed to open benchmark output file: " + options.outputPath);
+	}
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\n\t\"benchmarks\": [\n";
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const result& benchmarkResult = results[i];
+
+		file << "\t\t{ \"name\": \"" << benchmarkResult.name << "\""
+			 << ", \"iterations\": " << benchmarkResult.iterations
+			 << ", \"samples\": " << benchmarkResult.samples
+			 << ", \"median_ns\": " << benchmarkResult.median
+			 << ", \"p99_ns\": " << benchmarkResult.p99
+			 << ", \"mean_ns\": " << benchmarkResult.mean
+			 << ", \"min_ns\": " << benchmarkResult.minimum
+			 << ", \"max_ns\": " << benchmarkResult.maximum
+			 << ", \"allocations_per_iteration\": " << benchmarkResult.allocationsPerIteration
+			 << ", \"bytes_per_iteration\": " << benchmarkResult.bytesPerIteration
+			 << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+
+	file << "\t]\n}\n";
+
+	log_info("Successfully wrote benchmark results to " + options.outputPath);
+}
+
+bool BenchmarkRunner::compareWithBaseline() {
+	if (options.baselinePath.empty()) {
+		return true;
+	}
+
+	std::ifstream file(options.baselinePath);
+
+	if (!file.is_open()) {
+		log_error("Failed to open benchmark baseline file: " + options.baselinePath);
+	}
+
+	std::unordered_map<std::string, double> baseline;
+	std::string line;
+
+	while (std::getline(file, line)) {
+		size_t namePosition = line.find("\"name\": \"");
+		size_t medianPosition = line.find("\"median_ns\": ");
+
+		if (namePosition == std::string::npos || medianPosition == std::string::npos) {
+			continue;
+		}
+
+		namePosition += 9;
+
+		std::string name = line.substr(namePosition, line.find('"', namePosition) - namePosition);
+		baseline[name] = std::stod(line.substr(medianPosition + 13));
+	}
+
+	bool passed = true;
+
+	for (const result& benchmarkResult : results) {
+		auto iterator = baseline.find(benchmarkResult.name);
+
+		if (iterator == baseline.end() || iterator->second <= 0.0) {
+			continue;
+		}
+
+		double change = benchmarkResult.median / iterator->second - 1.0;
+
+		if (change > options.regressionThreshold) {
+			log_warning("Regression in " + benchmarkResult.name + ": " + std::to_string(iterator->second) + " ns -> " + std::to_string(benchmarkResult.median) + " ns (+" + std::to_string(change * 100.0) + "%)");
+
+			passed = false;
+		}
+	}
+
+	if (passed) {
+		log_info("No regressions against baseline " + options.baselinePath);
+	}
+
+	return passed;
+}
+
+int OutputSilencer::nullBuffer::overflow(int character) {
+	return character;
+}
+
+std::streamsize OutputSilencer::nullBuffer::xsputn(const char*, std::streamsize count) {
+	return count;
+}
+
+OutputSilencer::OutputSilencer(bool enabled) {
+	if (enabled) {
+		previous = std::cout.rdbuf(&buffer);
+	}
+}
+
+OutputSilencer::~OutputSilencer() {
+	if (previous != nullptr) {
+		std::cout.rdbuf(previous);
+	}
+}
+
+int main(int argc, char** argv) {
+	BenchmarkRunner runner;
+
+	try {
+		runner.parseArguments(argc, argv);
+
+		runUIBenchmark(runner);
+		runTextBenchmark(runner);
+		runTessellatorBenchmark(runner);
+		runLayoutBenchmark(runner);
+		runLoggerBenchmark(runner);
+		runFileSystemBenchmark(runner);
+		runMeshBenchmark(runner);
+		runTextureBenchmark(runner);
+		runSceneBenchmark(runner);
+		runCullingBenchmark(runner);
+		runPipelinesBenchmark(runner);
+		runDrawQueueBenchmark(runner);
+		runBarrierBenchmark(runner);
+		runJobSystemBenchmark(runner);
+		runInputBenchmark(runner);
+		runFrameBenchmark(runner);
+		runStartupBenchmark(runner);
+
+		runner.report();
+		runner.writeResults();
+
+		if (!runner.compareWithBaseline()) {
+			return 2;
+		}
+	}
+	catch (const std::runtime_error& e) {
+		std::cerr << e.what() << std::endl;
+
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+#define benchmarks_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+extern std::atomic<uint64_t> allocationCount;
+extern std::atomic<uint64_t> allocationBytes;
+extern volatile uint64_t benchmarkSink;
+
+template<typename T>
+inline void doNotOptimize(const T& value) {
+	benchmarkSink = benchmarkSink + static_cast<uint64_t>(value);
+}
+
+class OutputSilencer {
+	public:
+		OutputSilencer(bool enabled = true);
+		~OutputSilencer();
+	private:
+		class nullBuffer : public std::streambuf {
+			protected:
+				int overflow(int character) override;
+				std::streamsize xsputn(const char* data, std::streamsize count) override;
+		};
+
+		nullBuffer buffer;
+		std::streambuf* previous = nullptr;
+};
+
+class BenchmarkRunner {
+	public:
+		struct benchmarkOptions {
+			std::string filter;
+			std::string outputPath = "benchmark_results.json";
+			std::string baselinePath;
+			double regressionThreshold = 0.10;
+			double sampleMilliseconds = 2.0;
+			double totalMilliseconds = 1000.0;
+			uint32_t minimumSamples = 10;
+			uint32_t maximumSamples = 500;
+		};
+
+		struct result {
+			std::string name;
+			uint64_t iterations = 0;
+			uint32_t samples = 0;
+			double median = 0.0;
+			double p99 = 0.0;
+			double mean = 0.0;
+			double minimum = 0.0;
+			double maximum = 0.0;
+			double allocationsPerIteration = 0.0;
+			double bytesPerIteration = 0.0;
+		};
+
+		void parseArguments(int argc, char** argv);
+		bool shouldRun(const std::string& name);
+
+		template<typename function>
+		void run(const std::string& name, function iteration, bool silenceOutput = false) {
+			if (!shouldRun(name)) {
+				return;
+			}
+
+			std::vector<double> samples;
+			uint64_t iterationsPerSample = 0;
+			uint64_t allocations = 0;
+			uint64_t bytes = 0;
+
+			{
+				OutputSilencer silencer(silenceOutput);
+
+				auto calibrationStart = std::chrono::steady_clock::now();
+
+				do {
+					iteration();
+					iterationsPerSample++;
+				} while (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - calibrationStart).count() < options.sampleMilliseconds);
+
+				double sampleMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - calibrationStart).count();
+				uint32_t sampleCount = getSampleCount(sampleMilliseconds);
+
+				samples.reserve(sampleCount);
+
+				uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+				uint64_t bytesBefore = allocationBytes.load(std::memory_order_relaxed);
+
+				for (uint32_t sample = 0; sample < sampleCount; sample++) {
+					auto sampleStart = std::chrono::steady_clock::now();
+
+					for (uint64_t i = 0; i < iterationsPerSample; i++) {
+						iteration();
+					}
+
+					auto sampleEnd = std::chrono::steady_clock::now();
+
+					samples.push_back(std::chrono::duration<double, std::nano>(sampleEnd - sampleStart).count() / static_cast<double>(iterationsPerSample));
+				}
+
+				allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+				bytes = allocationBytes.load(std::memory_order_relaxed) - bytesBefore;
+			}
+
+			addResult(name, samples, iterationsPerSample, allocations, bytes);
+		}
+
+		void report();
+		void writeResults();
+		bool compareWithBaseline();
+
+		benchmarkOptions options;
+	private:
+		std::vector<result> results;
+
+		uint32_t getSampleCount(double sampleMilliseconds);
+		void addResult(const std::string& name, std::vector<double>& samples, uint64_t iterationsPerSample, uint64_t allocations, uint64_t bytes);
+};
+
+void runDrawQueueBenchmark(BenchmarkRunner& runner);
+void runUIBenchmark(BenchmarkRunner& runner);
+void runTextBenchmark(BenchmarkRunner& runner);
+void runTessellatorBenchmark(BenchmarkRunner& runner);
+void runLayoutBenchmark(BenchmarkRunner& runner);
+void runLoggerBenchmark(BenchmarkRunner& runner);
+void runFileSystemBenchmark(BenchmarkRunner& runner);
+void runPipelinesBenchmark(BenchmarkRunner& runner);
+void runFrameBenchmark(BenchmarkRunner& runner);
+void runJobSystemBenchmark(BenchmarkRunner& runner);
+void runInputBenchmark(BenchmarkRunner& runner);
+void runStartupBenchmark(BenchmarkRunner& runner);
+void runBarrierBenchmark(BenchmarkRunner& runner);
+void runMeshBenchmark(BenchmarkRunner& runner);
+void runTextureBenchmark(BenchmarkRunner& runner);
+void runSceneBenchmark(BenchmarkRunner& runner);
+void runCullingBenchmark(BenchmarkRunner& runner);
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "benchmarks.h"
+#include "../src/application/application.h"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void runCullingBenchmark(BenchmarkRunner& runner) {
+	if (!runner.shouldRun("culling/")) {
+		return;
+	}
+
+	const uint32_t OBJECT_COUNTS[] = { 10000, 100000, 1000000 };
+	const float DENSITY = 0.05f;
+	const uint32_t MOVING_STRIDE = 100;
+
+	Application application;
+	application.options.workerThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	{
+		OutputSilencer silencer;
+		application.jobSystem.init(application);
+	}
+
+	JobSystem& jobSystem = application.jobSystem;
+
+	for (uint32_t objectCount : OBJECT_COUNTS) {
+		float worldSize = std::cbrt(static_cast<float>(objectCount) / DENSITY);
+		glm::vec3 center(worldSize * 0.5f);
+
+		Bvh bvh;
+		std::vector<Bvh::aabb> bounds(objectCount);
+		uint32_t random = 0x2545F491u;
+
+		auto nextFloat = [&random]() {
+			random = random * 1664525u + 1013904223u;
+
+			return static_cast<float>(random >> 8) / static_cast<float>(1u << 24);
+		};
+
+		for (uint32_t i = 0; i < objectCount; i++) {
+			glm::vec3 position(nextFloat() * worldSize, nextFloat() * worldSize, nextFloat() * worldSize);
+			glm::vec3 extent(0.25f + nextFloat());
+
+			bounds[i] = { position - extent, position + extent };
+			bvh.insert(bounds[i]);
+		}
+
+		bvh.rebuild();
+
+		glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, worldSize * 0.5f);
+		glm::mat4 view = glm::lookAtRH(center, center + glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		Bvh::frustum frustum = Bvh::extractFrustum(projection * view);
+
+		std::vector<Bvh::proxyHandle> bruteForceVisible;
+		std::vector<Bvh::proxyHandle> bvhVisible;
+
+		bvh.cullBruteForce(frustum, jobSystem, bruteForceVisible);
+		bvh.cull(frustum, jobSystem, bvhVisible);
+
+		Bvh::statistics stats = bvh.getStatistics();
+		std::string count = std::to_string(objectCount);
+
+		log_info("Culling benchmark " + count + " objects: " + std::to_string(bruteForceVisible.size()) + " visible by brute force, " + std::to_string(bvhVisible.size()) + " by the BVH after testing " + std::to_string(stats.testedNodes) + " of " + std::to_string(stats.nodes) + " nodes");
+
+		runner.run("culling/brute_force/" + count, [&]() {
+			bvh.cullBruteForce(frustum, jobSystem, bruteForceVisible);
+			doNotOptimize(bruteForceVisible.size());
+		});
+
+		runner.run("culling/bvh/" + count, [&]() {
+			bvh.cull(frustum, jobSystem, bvhVisible);
+			doNotOptimize(bvhVisible.size());
+		});
+
+		float offset = 0.0f;
+
+		runner.run("culling/refit/" + count, [&]() {
+			offset = offset > 1.0f ? 0.0f : offset + 0.1f;
+
+			for (uint32_t i = 0; i < objectCount; i += MOVING_STRIDE) {
+				bvh.update(i, { bounds[i].min + offset, bounds[i].max + offset });
+			}
+
+			bvh.cull(frustum, jobSystem, bvhVisible);
+			doNotOptimize(bvhVisible.size());
+		});
+
+		runner.run("culling/rebuild/" + count, [&]() {
+			bvh.rebuild();
+			doNotOptimize(bvh.getStatistics().nodes);
+		});
+	}
+
+	{
+		OutputSilencer silencer;
+		jobSystem.cleanup();
+	}
+}
\ No newline at end of file
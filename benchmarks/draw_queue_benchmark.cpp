@@ -0,0 +1,63 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+#include "../src/renderer/draw_queue.h"
+
+#include <random>
+#include <vector>
+
+void runDrawQueueBenchmark(BenchmarkRunner& runner) {
+	const uint32_t PACKET_COUNT = 1000000;
+	const uint32_t PIPELINE_COUNT = 8;
+	const uint32_t MATERIAL_COUNT = 64;
+	const uint32_t MESH_COUNT = 256;
+
+	if (!runner.shouldRun("draw_queue/")) {
+		return;
+	}
+
+	log_info("Running draw queue benchmark with " + std::to_string(PACKET_COUNT) + " packets...");
+
+	std::mt19937 random(1337);
+	std::uniform_int_distribution<uint32_t> pipelineDistribution(0, PIPELINE_COUNT - 1);
+	std::uniform_int_distribution<uint32_t> materialDistribution(0, MATERIAL_COUNT - 1);
+	std::uniform_int_distribution<uint32_t> meshDistribution(1, MESH_COUNT);
+	std::uniform_real_distribution<float> depthDistribution(0.0f, 1000.0f);
+
+	std::vector<DrawQueue::drawPacket> sourcePackets(PACKET_COUNT);
+
+	for (uint32_t i = 0; i < PACKET_COUNT; i++) {
+		DrawQueue::drawPacket& packet = sourcePackets[i];
+
+		uint32_t pipelineId = pipelineDistribution(random);
+
+		packet.pipeline = reinterpret_cast<VkPipeline>(static_cast<uintptr_t>(pipelineId + 1));
+		packet.materialId = materialDistribution(random);
+		packet.meshId = meshDistribution(random);
+		packet.vertexCount = 36;
+		packet.instance = i;
+
+		DrawQueue::pass pass = (i % 10 == 0) ? DrawQueue::pass::transparent : DrawQueue::pass::opaque;
+		packet.sortKey = DrawQueue::makeSortKey(pass, pipelineId, packet.materialId, depthDistribution(random));
+	}
+
+	DrawQueue drawQueue;
+	drawQueue.reserve(PACKET_COUNT);
+
+	runner.run("draw_queue/submit/1M", [&]() {
+		drawQueue.clear();
+
+		for (const DrawQueue::drawPacket& packet : sourcePackets) {
+			drawQueue.submit(packet);
+		}
+	});
+
+	runner.run("draw_queue/sort/1M", [&]() {
+		drawQueue.sort();
+	});
+
+	runner.run("draw_queue/build/1M", [&]() {
+		drawQueue.buildDrawCommands();
+	});
+
+	log_info("Packets: " + std::to_string(PACKET_COUNT) + ", instanced draw commands: " + std::to_string(drawQueue.getDrawCommands().size()));
+}
\ No newline at end of file
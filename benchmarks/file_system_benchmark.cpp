@@ -0,0 +1,41 @@
+#include "benchmarks.h"
+#include "../src/file_system/file_system.h"
+#include "../src/logger/logger.h"
+
+#include <filesystem>
+#include <fstream>
+
+void runFileSystemBenchmark(BenchmarkRunner& runner) {
+	const size_t FILE_SIZES[] = { 4 * 1024, 256 * 1024, 16 * 1024 * 1024 };
+	const char* FILE_NAMES[] = { "4KB", "256KB", "16MB" };
+
+	for (size_t i = 0; i < 3; i++) {
+		std::string name = std::string("file_system/readFile/") + FILE_NAMES[i];
+
+		if (!runner.shouldRun(name)) {
+			continue;
+		}
+
+		std::filesystem::path path = std::filesystem::temp_directory_path() / ("renderer_benchmark_" + std::string(FILE_NAMES[i]) + ".bin");
+
+		{
+			std::vector<char> contents(FILE_SIZES[i], 'r');
+			std::ofstream file(path, std::ios::binary);
+
+			if (!file.is_open()) {
+				log_error("Failed to create benchmark file: " + path.string());
+			}
+
+			file.write(contents.data(), contents.size());
+		}
+
+		const std::string fileName = path.string();
+
+		runner.run(name, [&]() {
+			std::vector<char> buffer = fileSystem.readFile(fileName);
+			doNotOptimize(buffer.size());
+		}, true);
+
+		std::filesystem::remove(path);
+	}
+}
\ No newline at end of file
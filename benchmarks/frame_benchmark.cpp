@@ -0,0 +1,63 @@
+#include "benchmarks.h"
+#include "../src/application/application.h"
+
+static void runFrameBenchmark(BenchmarkRunner& runner, const std::string& name, bool renderThread) {
+	if (!runner.shouldRun(name)) {
+		return;
+	}
+
+	Application application;
+	application.options.headless = true;
+	application.options.renderThread = renderThread;
+	application.options.deviceCachePath.clear();
+
+	{
+		OutputSilencer silencer;
+
+		application.startup();
+	}
+
+	if (renderThread) {
+		runner.run(name, [&]() {
+			application.ui.drawUI();
+			application.renderer.buildFramePacket(application.renderThread.beginPacket());
+			application.renderThread.submitPacket();
+		});
+
+		application.renderThread.flush();
+	}
+	else {
+		runner.run(name, [&]() {
+			application.renderer.drawFrame();
+		});
+	}
+
+	{
+		OutputSilencer silencer;
+
+		application.renderThread.cleanup();
+		application.ui.cleanup();
+		application.renderer.cleanup();
+		application.jobSystem.cleanup();
+	}
+}
+
+void runFrameBenchmark(BenchmarkRunner& runner) {
+	runFrameBenchmark(runner, "renderer/drawFrame", false);
+	runFrameBenchmark(runner, "renderer/renderThread", true);
+}
+
+void runStartupBenchmark(BenchmarkRunner& runner) {
+	runner.run("application/startup", [&]() {
+		Application application;
+		application.options.headless = true;
+		application.options.deviceCachePath.clear();
+
+		application.startup();
+
+		application.renderThread.cleanup();
+		application.ui.cleanup();
+		application.renderer.cleanup();
+		application.jobSystem.cleanup();
+	}, true);
+}
\ No newline at end of file
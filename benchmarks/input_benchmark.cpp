@@ -0,0 +1,30 @@
+#include "benchmarks.h"
+#include "../src/application/application.h"
+
+void runInputBenchmark(BenchmarkRunner& runner) {
+	Application application;
+	application.options.headless = true;
+
+	application.input.bindKey(GLFW_KEY_ESCAPE, Input::action::quit);
+
+	std::vector<Input::eventStamp> frameEvents;
+	frameEvents.reserve(256);
+
+	runner.run("input/processEvents/256", [&]() {
+		for (int i = 0; i < 256; i++) {
+			Input::event newEvent{};
+			newEvent.type = i % 2 == 0 ? Input::eventType::key : Input::eventType::mouseMove;
+			newEvent.code = GLFW_KEY_A + i % 26;
+			newEvent.state = (i / 2) % 2 == 0 ? GLFW_PRESS : GLFW_RELEASE;
+			newEvent.x = i;
+			newEvent.y = i;
+
+			application.input.pushEvent(newEvent);
+		}
+
+		application.input.processEvents(application);
+		application.input.writeFrameEvents(frameEvents);
+
+		doNotOptimize(frameEvents.size());
+	});
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "benchmarks.h"
+#include "../src/application/application.h"
+
+#include <cmath>
+
+void runJobSystemBenchmark(BenchmarkRunner& runner) {
+	const uint32_t ELEMENT_COUNT = 1 << 22;
+	const uint32_t GRAIN_SIZE = 1 << 14;
+	const uint32_t EMPTY_JOB_COUNT = 1024;
+
+	if (!runner.shouldRun("job_system/")) {
+		return;
+	}
+
+	std::vector<float> input(ELEMENT_COUNT);
+	std::vector<float> output(ELEMENT_COUNT);
+
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		input[i] = static_cast<float>(i % 1000) * 0.5f;
+	}
+
+	uint32_t maximumThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<uint32_t> threadCounts;
+
+	for (uint32_t threadCount = 1; threadCount < maximumThreads; threadCount *= 2) {
+		threadCounts.push_back(threadCount);
+	}
+
+	threadCounts.push_back(maximumThreads);
+
+	for (uint32_t threadCount : threadCounts) {
+		Application application;
+		application.options.workerThreads = threadCount;
+
+		{
+			OutputSilencer silencer;
+			application.jobSystem.init(application);
+		}
+
+		JobSystem& jobSystem = application.jobSystem;
+
+		runner.run("job_system/parallel_for/" + std::to_string(threadCount), [&]() {
+			jobSystem.parallelFor(ELEMENT_COUNT, GRAIN_SIZE, [&](uint32_t begin, uint32_t end) {
+				for (uint32_t i = begin; i < end; i++) {
+					output[i] = std::sqrt(input[i]) * std::sin(input[i]) + std::cos(input[i]);
+				}
+			});
+		});
+
+		runner.run("job_system/empty_jobs/" + std::to_string(threadCount), [&]() {
+			JobSystem::counter completion;
+
+			for (uint32_t i = 0; i < EMPTY_JOB_COUNT; i++) {
+				jobSystem.submit([]() {}, &completion);
+			}
+
+			jobSystem.wait(completion);
+		});
+
+		runner.run("job_system/dependency_chain/" + std::to_string(threadCount), [&]() {
+			JobSystem::counter stages[4];
+			uint32_t chunkCount = ELEMENT_COUNT / GRAIN_SIZE / 16;
+
+			for (uint32_t stage = 0; stage < 4; stage++) {
+				for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+					jobSystem.submit([&output, chunk, GRAIN_SIZE]() {
+						for (uint32_t i = chunk * GRAIN_SIZE; i < (chunk + 1) * GRAIN_SIZE; i++) {
+							output[i] = output[i] * 0.5f + 1.0f;
+						}
+					}, &stages[stage], stage > 0 ? &stages[stage - 1] : nullptr);
+				}
+			}
+
+			jobSystem.wait(stages[3]);
+		});
+
+		{
+			OutputSilencer silencer;
+			application.jobSystem.cleanup();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+#include "../src/ui/layout.h"
+
+void runLayoutBenchmark(BenchmarkRunner& runner) {
+	const uint32_t rowCount = 500;
+	const uint32_t cellsPerRow = 99;
+
+	Layout layout;
+	std::vector<Layout::nodeHandle> cells;
+
+	Layout::nodeHandle root = layout.createNode();
+
+	Layout::style rootStyle;
+	rootStyle.padding = glm::vec4(8.0f);
+	rootStyle.gap = 2.0f;
+	layout.setStyle(root, rootStyle);
+
+	Layout::style rowStyle;
+	rowStyle.flexDirection = Layout::direction::row;
+	rowStyle.alignItems = Layout::align::center;
+	rowStyle.padding = glm::vec4(4.0f);
+	rowStyle.gap = 1.0f;
+	rowStyle.shrink = 0.0f;
+
+	Layout::style cellStyle;
+	cellStyle.grow = 1.0f;
+
+	for (uint32_t row = 0; row < rowCount; row++) {
+		Layout::nodeHandle rowNode = layout.createNode(root);
+		layout.setStyle(rowNode, rowStyle);
+
+		for (uint32_t cell = 0; cell < cellsPerRow; cell++) {
+			Layout::nodeHandle cellNode = layout.createNode(rowNode);
+			layout.setStyle(cellNode, cellStyle);
+			layout.setContentSize(cellNode, { 8.0f + static_cast<float>(cell % 7), 16.0f });
+
+			cells.push_back(cellNode);
+		}
+	}
+
+	layout.update({ 1920.0f, 1080.0f });
+
+	log_info("Layout tree: " + std::to_string(layout.getStatistics().nodes) + " nodes, " + std::to_string(layout.getStatistics().changedNodes) + " placed on the first update");
+
+	runner.run("layout/50k/static", [&]() {
+		layout.update({ 1920.0f, 1080.0f });
+
+		doNotOptimize(layout.getChangedNodes().size());
+	});
+
+	uint32_t frame = 0;
+
+	runner.run("layout/50k/1changed", [&]() {
+		frame++;
+
+		layout.setContentSize(cells[(frame * 7919) % cells.size()], { 8.0f + static_cast<float>(frame % 13), 16.0f });
+		layout.update({ 1920.0f, 1080.0f });
+
+		doNotOptimize(layout.getChangedNodes().size());
+	});
+
+	runner.run("layout/50k/100changed", [&]() {
+		frame++;
+
+		for (uint32_t i = 0; i < 100; i++) {
+			layout.setContentSize(cells[(frame * 100 + i * 7919) % cells.size()], { 8.0f + static_cast<float>((frame + i) % 13), 16.0f });
+		}
+
+		layout.update({ 1920.0f, 1080.0f });
+
+		doNotOptimize(layout.getChangedNodes().size());
+	});
+
+	runner.run("layout/50k/resize", [&]() {
+		frame++;
+
+		layout.update({ 1920.0f + static_cast<float>(frame % 2), 1080.0f });
+
+		doNotOptimize(layout.getChangedNodes().size());
+	});
+
+	runner.run("layout/50k/uncached", [&]() {
+		frame++;
+
+		for (Layout::nodeHandle cell : cells) {
+			layout.markDirty(cell);
+		}
+
+		layout.update({ 1920.0f + static_cast<float>(frame % 2), 1080.0f });
+
+		doNotOptimize(layout.getChangedNodes().size());
+	});
+
+	Layout::statistics statistics = layout.getStatistics();
+
+	log_info("Layout measured " + std::to_string(statistics.measuredNodes) + " nodes with " + std::to_string(statistics.measureCacheHits) + " cache hits over " + std::to_string(statistics.updates) + " updates");
+}
\ No newline at end of file
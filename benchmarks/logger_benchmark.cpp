@@ -0,0 +1,15 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+
+void runLoggerBenchmark(BenchmarkRunner& runner) {
+	const std::string shortMessage = "Frame submitted";
+	const std::string longMessage(256, 'x');
+
+	runner.run("logger/log/short", [&]() {
+		logger.log(Logger::level::info, shortMessage);
+	}, true);
+
+	runner.run("logger/log/256", [&]() {
+		logger.log(Logger::level::warning, longMessage);
+	}, true);
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "benchmarks.h"
+#include "../src/file_system/file_system.h"
+#include "../src/logger/logger.h"
+#include "../src/mesh/mesh_cooker.h"
+#include "../src/mesh/meshes.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <glm/gtc/constants.hpp>
+
+static std::string generateSphereObj(uint32_t rings, uint32_t segments) {
+	std::string text;
+
+	for (uint32_t ring = 0; ring <= rings; ring++) {
+		float theta = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+
+		for (uint32_t segment = 0; segment <= segments; segment++) {
+			float phi = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+			glm::vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+
+			text += "v " + std::to_string(normal.x) + " " + std::to_string(normal.y) + " " + std::to_string(normal.z) + "\n";
+			text += "vn " + std::to_string(normal.x) + " " + std::to_string(normal.y) + " " + std::to_string(normal.z) + "\n";
+			text += "vt " + std::to_string(static_cast<float>(segment) / static_cast<float>(segments)) + " " + std::to_string(static_cast<float>(ring) / static_cast<float>(rings)) + "\n";
+		}
+	}
+
+	for (uint32_t ring = 0; ring < rings; ring++) {
+		for (uint32_t segment = 0; segment < segments; segment++) {
+			uint32_t a = ring * (segments + 1) + segment + 1;
+			uint32_t b = a + 1;
+			uint32_t c = a + segments + 1;
+			uint32_t d = c + 1;
+
+			std::string corners[4] = { std::to_string(a), std::to_string(c), std::to_string(d), std::to_string(b) };
+
+			text += "f";
+
+			for (const std::string& corner : corners) {
+				text += " " + corner + "/" + corner + "/" + corner;
+			}
+
+			text += "\n";
+		}
+	}
+
+	return text;
+}
+
+void runMeshBenchmark(BenchmarkRunner& runner) {
+	if (!runner.shouldRun("mesh/")) {
+		return;
+	}
+
+	std::string objText = generateSphereObj(96, 192);
+	std::vector<char> objData(objText.begin(), objText.end());
+
+	MeshImporter::sourceMesh source = MeshImporter::importObj(objData);
+	MeshCooker::cookedMesh cooked = MeshCooker::cook(source);
+
+	const MeshCooker::statistics& stats = cooked.stats;
+
+	log_info("Mesh benchmark sphere: " + std::to_string(stats.sourceVertices) + " -> " + std::to_string(stats.vertices) + " vertices, ACMR " + std::to_string(stats.sourceCache.acmr) + " -> " + std::to_string(stats.cookedCache.acmr) + ", " + std::to_string(stats.sourceBytes) + " -> " + std::to_string(stats.cookedBytes) + " bytes");
+
+	std::filesystem::path objPath = std::filesystem::temp_directory_path() / "renderer_benchmark_sphere.obj";
+	std::filesystem::path meshPath = std::filesystem::temp_directory_path() / "renderer_benchmark_sphere.mesh";
+
+	{
+		std::ofstream file(objPath, std::ios::binary);
+
+		if (!file.is_open()) {
+			log_error("Failed to create benchmark file: " + objPath.string());
+		}
+
+		file.write(objData.data(), objData.size());
+	}
+
+	MeshCooker::write(cooked, meshPath.string());
+
+	const std::string objName = objPath.string();
+	const std::string meshName = meshPath.string();
+
+	runner.run("mesh/import/obj", [&]() {
+		MeshImporter::sourceMesh imported = MeshImporter::importObj(objData);
+		doNotOptimize(imported.indices.size());
+	}, true);
+
+	runner.run("mesh/cook", [&]() {
+		MeshCooker::cookedMesh mesh = MeshCooker::cook(source);
+		doNotOptimize(mesh.indices.size());
+	}, true);
+
+	std::vector<char> upload(cooked.header.fileSize);
+
+	runner.run("mesh/load/obj", [&]() {
+		MeshImporter::sourceMesh imported = MeshImporter::importObj(fileSystem.readFile(objName));
+		MeshCooker::cookedMesh mesh = MeshCooker::cook(imported);
+		doNotOptimize(mesh.indices.size());
+	}, true);
+
+	runner.run("mesh/load/cooked", [&]() {
+		FileSystem::mappedFile file = fileSystem.mapFile(meshName);
+
+		MeshFormat::header header;
+		std::memcpy(&header, file.data, sizeof(header));
+
+		if (Meshes::validateHeader(header, file.size)) {
+			std::memcpy(upload.data(), file.data + header.vertexOffset, header.fileSize - header.vertexOffset);
+		}
+
+		fileSystem.unmapFile(file);
+		doNotOptimize(header.indexCount);
+	}, true);
+
+	std::filesystem::remove(objPath);
+	std::filesystem::remove(meshPath);
+}
\ No newline at end of file
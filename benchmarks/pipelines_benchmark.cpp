@@ -0,0 +1,61 @@
+#include "benchmarks.h"
+#include "../src/renderer/pipelines.h"
+
+#include <array>
+
+void runPipelinesBenchmark(BenchmarkRunner& runner) {
+	Pipelines::pipelineStructure pipelineStructure{};
+
+	pipelineStructure.vertexShaderPath = "src/renderer/shaders/ui_vert.spv";
+	pipelineStructure.fragmentShaderPath = "src/renderer/shaders/ui_frag.spv";
+
+	VkVertexInputBindingDescription vertexInputBindingDescription{};
+	vertexInputBindingDescription.binding = 0;
+	vertexInputBindingDescription.stride = 20;
+	vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	std::array<VkVertexInputAttributeDescription, 2> vertexInputAttributeDescriptions{};
+	vertexInputAttributeDescriptions[0].location = 0;
+	vertexInputAttributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+	vertexInputAttributeDescriptions[0].offset = 0;
+	vertexInputAttributeDescriptions[1].location = 1;
+	vertexInputAttributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+	vertexInputAttributeDescriptions[1].offset = 8;
+
+	pipelineStructure.vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	pipelineStructure.vertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
+	pipelineStructure.vertexInputStateCreateInfo.pVertexBindingDescriptions = &vertexInputBindingDescription;
+	pipelineStructure.vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputAttributeDescriptions.size());
+	pipelineStructure.vertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions.data();
+
+	pipelineStructure.inputAssemblyStateCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	pipelineStructure.rasterizationStateCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
+	pipelineStructure.rasterizationStateCreateInfo.lineWidth = 1.0f;
+	pipelineStructure.rasterizationStateCreateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
+	pipelineStructure.rasterizationStateCreateInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
+
+	pipelineStructure.multisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+	pipelineStructure.multisampleStateCreateInfo.minSampleShading = 1.0f;
+
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+	pipelineStructure.colorBlendStateCreateInfo.logicOp = VK_LOGIC_OP_COPY;
+	pipelineStructure.colorBlendStateCreateInfo.attachmentCount = 1;
+	pipelineStructure.colorBlendStateCreateInfo.pAttachments = &pipelineStructure.colorBlendAttachmentStateCreateInfo;
+
+	std::vector<VkDynamicState> dynamicStates = {
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR
+	};
+
+	pipelineStructure.dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+	pipelineStructure.dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
+
+	pipelineStructure.depthStencilStateCreateInfo = nullptr;
+	pipelineStructure.subpass = 0;
+
+	runner.run("pipelines/hashPipelineStructure", [&]() {
+		doNotOptimize(Pipelines::hashPipelineStructure(pipelineStructure));
+	});
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "benchmarks.h"
+#include "../src/application/application.h"
+
+void runSceneBenchmark(BenchmarkRunner& runner) {
+	if (!runner.shouldRun("scene/")) {
+		return;
+	}
+
+	const uint32_t NODE_COUNT = 1000000;
+	const uint32_t FANOUT = 8;
+	const uint32_t PARTIAL_STRIDE = 100;
+
+	Application application;
+	application.options.workerThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	{
+		OutputSilencer silencer;
+		application.jobSystem.init(application);
+		application.scene.init(application);
+	}
+
+	Scene& scene = application.scene;
+	std::vector<Scene::nodeHandle> nodes(NODE_COUNT);
+
+	for (uint32_t i = 0; i < NODE_COUNT; i++) {
+		nodes[i] = scene.createNode(i == 0 ? Scene::NO_NODE : nodes[(i - 1) / FANOUT]);
+		scene.setTranslation(nodes[i], glm::vec3(static_cast<float>(i % FANOUT), 1.0f, 0.0f));
+		scene.setRotation(nodes[i], glm::angleAxis(0.01f * static_cast<float>(i % 360), glm::vec3(0.0f, 1.0f, 0.0f)));
+	}
+
+	scene.update();
+
+	Scene::statistics stats = scene.getStatistics();
+
+	log_info("Scene benchmark hierarchy: " + std::to_string(stats.nodes) + " nodes in " + std::to_string(stats.levels) + " levels on " + std::to_string(application.jobSystem.getThreadCount()) + " threads");
+
+	float time = 0.0f;
+
+	runner.run("scene/update/1000000", [&]() {
+		time += 0.01f;
+
+		for (uint32_t i = 0; i < NODE_COUNT; i++) {
+			scene.setTranslation(nodes[i], glm::vec3(static_cast<float>(i % FANOUT), 1.0f, time));
+		}
+
+		doNotOptimize(scene.update());
+	});
+
+	runner.run("scene/update_partial/1000000", [&]() {
+		time += 0.01f;
+
+		for (uint32_t i = NODE_COUNT / 2; i < NODE_COUNT; i += PARTIAL_STRIDE) {
+			scene.setTranslation(nodes[i], glm::vec3(static_cast<float>(i % FANOUT), 1.0f, time));
+		}
+
+		doNotOptimize(scene.update());
+	});
+
+	Scene::frameData frame;
+
+	runner.run("scene/frame_data/partial", [&]() {
+		time += 0.01f;
+
+		for (uint32_t i = NODE_COUNT / 2; i < NODE_COUNT; i += PARTIAL_STRIDE) {
+			scene.setTranslation(nodes[i], glm::vec3(static_cast<float>(i % FANOUT), 1.0f, time));
+		}
+
+		scene.update();
+		scene.writeFrameData(frame);
+		doNotOptimize(frame.instances.size());
+	});
+
+	runner.run("scene/rebuild/1000000", [&]() {
+		scene.setParent(nodes[NODE_COUNT - 1], nodes[0]);
+		doNotOptimize(scene.update());
+	});
+
+	{
+		OutputSilencer silencer;
+		application.jobSystem.cleanup();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+#include "../src/simd/simd.h"
+#include "../src/ui/tessellator.h"
+
+#include <algorithm>
+#include <cmath>
+
+void runTessellatorBenchmark(BenchmarkRunner& runner) {
+	log_info("Tessellator instruction set: " + std::string(SimdFloat::getInstructionSet()) + ", " + std::to_string(SimdFloat::WIDTH) + " lanes");
+
+	const uint32_t shapeCount = 1000;
+	const uint32_t pointCount = 64;
+
+	std::vector<glm::vec2> points(pointCount);
+
+	for (uint32_t i = 0; i < pointCount; i++) {
+		points[i] = { static_cast<float>(i) * 8.0f, 100.0f + std::sin(static_cast<float>(i) * 0.3f) * 40.0f };
+	}
+
+	uint32_t roundedRectSegments = Tessellator::getArcSegments(12.0f, 1.5707963f);
+	uint32_t arcSegments = Tessellator::getArcSegments(40.0f, 4.0f);
+
+	uint32_t vertexCount = std::max({ Tessellator::getPolylineVertexCount(pointCount), Tessellator::getRoundedRectVertexCount(roundedRectSegments), Tessellator::getArcVertexCount(arcSegments) });
+	uint32_t indexCount = std::max({ Tessellator::getPolylineIndexCount(pointCount), Tessellator::getRoundedRectIndexCount(roundedRectSegments), Tessellator::getArcIndexCount(arcSegments) });
+
+	std::vector<float> positions(static_cast<size_t>(vertexCount) * shapeCount * 2);
+	std::vector<uint32_t> colors(static_cast<size_t>(vertexCount) * shapeCount);
+	std::vector<uint32_t> indices(static_cast<size_t>(indexCount) * shapeCount);
+
+	auto getStream = [&](uint32_t shape) {
+		Tessellator::vertexStream stream;
+		stream.positions = positions.data() + static_cast<size_t>(shape) * vertexCount * 2;
+		stream.colors = colors.data() + static_cast<size_t>(shape) * vertexCount;
+		stream.indices = indices.data() + static_cast<size_t>(shape) * indexCount;
+		stream.firstVertex = shape * vertexCount;
+
+		return stream;
+	};
+
+	runner.run("tessellator/polyline/1000x64/simd", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::polyline(points.data(), pointCount, { 0.0f, static_cast<float>(shape) }, 2.0f, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+
+	runner.run("tessellator/polyline/1000x64/scalar", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::polylineScalar(points.data(), pointCount, { 0.0f, static_cast<float>(shape) }, 2.0f, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+
+	runner.run("tessellator/roundedRect/1000/simd", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::roundedRect({ 10.0f, static_cast<float>(shape), 200.0f, 40.0f }, 12.0f, roundedRectSegments, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+
+	runner.run("tessellator/roundedRect/1000/scalar", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::roundedRectScalar({ 10.0f, static_cast<float>(shape), 200.0f, 40.0f }, 12.0f, roundedRectSegments, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+
+	runner.run("tessellator/arc/1000/simd", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::arc({ 100.0f, static_cast<float>(shape) }, 40.0f, 0.0f, 4.0f, 3.0f, arcSegments, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+
+	runner.run("tessellator/arc/1000/scalar", [&]() {
+		for (uint32_t shape = 0; shape < shapeCount; shape++) {
+			Tessellator::arcScalar({ 100.0f, static_cast<float>(shape) }, 40.0f, 0.0f, 4.0f, 3.0f, arcSegments, 0xFFFFFFFF, getStream(shape));
+		}
+
+		doNotOptimize(positions[1]);
+	});
+}
\ No newline at end of file
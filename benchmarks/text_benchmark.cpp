@@ -0,0 +1,86 @@
+#include "benchmarks.h"
+#include "../src/file_system/file_system.h"
+#include "../src/logger/logger.h"
+#include "../src/text/text.h"
+#include "../src/ui/ui.h"
+
+#include <filesystem>
+
+void runTextBenchmark(BenchmarkRunner& runner) {
+	FileSystem fileSystem;
+	std::vector<char> fontData;
+
+	for (const std::string& path : Text::getDefaultFontPaths()) {
+		std::error_code error;
+
+		if (std::filesystem::is_regular_file(path, error)) {
+			fontData = fileSystem.readFile(path);
+			break;
+		}
+	}
+
+	if (fontData.empty()) {
+		log_warning("No font found, skipping text benchmarks");
+
+		return;
+	}
+
+	std::string ascii;
+
+	for (char character = ' '; character <= '~'; character++) {
+		ascii += character;
+	}
+
+	std::vector<Text::glyphQuad> glyphQuads(ascii.size());
+
+	{
+		Text text;
+		Text::fontHandle font = text.loadFont(fontData);
+		const std::string label = "Frame time: 16.6 ms";
+
+		text.shape(font, label);
+
+		runner.run("text/shape/cached", [&]() {
+			doNotOptimize(text.shape(font, label).glyphs.size());
+		});
+	}
+
+	runner.run("text/rasterize/95glyphs", [&]() {
+		Text text;
+		Text::fontHandle font = text.loadFont(fontData);
+		uint32_t pageMask = 0;
+
+		doNotOptimize(text.layout(font, ascii, 24.0f, { 0.0f, 0.0f }, glyphQuads.data(), pageMask));
+		text.update();
+	});
+
+	{
+		Text text;
+		UI ui;
+		UI::frameData frame;
+		std::vector<UI::widgetHandle> labels;
+
+		text.loadFont(fontData);
+		ui.attachText(text);
+
+		for (int i = 0; i < 1000; i++) {
+			labels.push_back(ui.createText({ static_cast<float>(i % 10) * 160.0f, static_cast<float>(i / 10) * 20.0f }, "Label " + std::to_string(i), 16.0f));
+		}
+
+		ui.update();
+		ui.writeFrameData(frame);
+
+		uint32_t frameIndex = 0;
+
+		runner.run("text/labels/1000/100changed", [&]() {
+			frameIndex++;
+
+			for (int i = 0; i < 100; i++) {
+				ui.setText(labels[(frameIndex * 100 + i * 97) % labels.size()], std::to_string(frameIndex * 100 + i) + " fps");
+			}
+
+			ui.update();
+			ui.writeFrameData(frame);
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "benchmarks.h"
+#include "../src/logger/logger.h"
+#include "../src/texture/ktx2.h"
+#include "../src/texture/texture_transcoder.h"
+#include "../src/texture/textures.h"
+
+#include <algorithm>
+#include <cstring>
+
+static std::vector<char> generateKtx2(VkFormat format, uint32_t width, uint32_t height) {
+	uint32_t levelCount = 1;
+
+	while ((std::max(width, height) >> levelCount) > 0) {
+		levelCount++;
+	}
+
+	Ktx2::header header{};
+	std::memcpy(header.identifier, Ktx2::IDENTIFIER, sizeof(Ktx2::IDENTIFIER));
+	header.vkFormat = format;
+	header.typeSize = 1;
+	header.pixelWidth = width;
+	header.pixelHeight = height;
+	header.faceCount = 1;
+	header.levelCount = levelCount;
+
+	std::vector<Ktx2::levelIndex> levels(levelCount);
+	uint64_t offset = sizeof(header) + levelCount * sizeof(Ktx2::levelIndex);
+
+	for (uint32_t level = levelCount; level > 0; level--) {
+		uint64_t size = TextureTranscoder::getLevelSize(format, std::max(width >> (level - 1), 1u), std::max(height >> (level - 1), 1u));
+
+		levels[level - 1] = { offset, size, size };
+		offset += (size + 15) & ~15ull;
+	}
+
+	std::vector<char> data(offset);
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), levels.data(), levels.size() * sizeof(Ktx2::levelIndex));
+
+	uint32_t random = 0x9E3779B9u;
+
+	for (size_t i = sizeof(header) + levels.size() * sizeof(Ktx2::levelIndex); i < data.size(); i++) {
+		random = random * 1664525u + 1013904223u;
+		data[i] = static_cast<char>(random >> 24);
+	}
+
+	return data;
+}
+
+void runTextureBenchmark(BenchmarkRunner& runner) {
+	if (!runner.shouldRun("textures/")) {
+		return;
+	}
+
+	const uint32_t SIZE = 1024;
+
+	std::vector<char> bc1File = generateKtx2(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, SIZE, SIZE);
+	std::vector<char> bc3File = generateKtx2(VK_FORMAT_BC3_UNORM_BLOCK, SIZE, SIZE);
+
+	Ktx2::container bc1 = Ktx2::parse(bc1File.data(), bc1File.size(), "bc1");
+	Ktx2::container bc3 = Ktx2::parse(bc3File.data(), bc3File.size(), "bc3");
+
+	std::vector<uint8_t> pixels(static_cast<size_t>(SIZE) * SIZE * 4);
+
+	runner.run("textures/parse/ktx2", [&]() {
+		Ktx2::container parsed = Ktx2::parse(bc1File.data(), bc1File.size(), "bc1");
+		doNotOptimize(parsed.levels.size());
+	});
+
+	runner.run("textures/transcode/bc1", [&]() {
+		TextureTranscoder::transcode(bc1.format, reinterpret_cast<const uint8_t*>(bc1File.data() + bc1.levels[0].byteOffset), SIZE, SIZE, pixels.data());
+		doNotOptimize(pixels[pixels.size() / 2]);
+	});
+
+	runner.run("textures/transcode/bc3", [&]() {
+		TextureTranscoder::transcode(bc3.format, reinterpret_cast<const uint8_t*>(bc3File.data() + bc3.levels[0].byteOffset), SIZE, SIZE, pixels.data());
+		doNotOptimize(pixels[pixels.size() / 2]);
+	});
+
+	const uint32_t CANDIDATES = 10000;
+	const uint32_t LEVELS = 12;
+
+	std::vector<VkDeviceSize> residentBytes(LEVELS + 1, 0);
+
+	for (uint32_t level = LEVELS; level > 0; level--) {
+		residentBytes[level - 1] = residentBytes[level] + (static_cast<VkDeviceSize>(1) << (2 * (LEVELS - level))) / 2;
+	}
+
+	std::vector<Textures::residencyCandidate> candidates(CANDIDATES);
+
+	for (uint32_t i = 0; i < CANDIDATES; i++) {
+		candidates[i].baseMip = LEVELS - 7;
+		candidates[i].desiredMip = i % 4;
+		candidates[i].lastRequestFrame = i % 240;
+		candidates[i].residentBytes = residentBytes.data();
+	}
+
+	VkDeviceSize budget = 256ull * 1024 * 1024;
+	VkDeviceSize planned = Textures::planResidency(candidates, budget);
+
+	log_info("Texture benchmark residency: " + std::to_string(planned) + " of " + std::to_string(budget) + " budgeted bytes for " + std::to_string(CANDIDATES) + " textures");
+
+	runner.run("textures/plan/10000", [&]() {
+		doNotOptimize(Textures::planResidency(candidates, budget));
+	});
+}
\ No newline at end of file
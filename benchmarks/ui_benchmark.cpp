@@ -0,0 +1,98 @@
+#include "benchmarks.h"
+#include "../src/ui/ui.h"
+#include "../src/logger/logger.h"
+
+void runUIBenchmark(BenchmarkRunner& runner) {
+	UI ui;
+	UI::frameData frame;
+
+	std::vector<UI::widgetHandle> panels;
+	std::vector<UI::widgetHandle> boxes;
+
+	for (int i = 0; i < 100; i++) {
+		UI::widgetHandle panel = ui.createPanel({ static_cast<float>(i % 10) * 160.0f, static_cast<float>(i / 10) * 100.0f, 150.0f, 90.0f }, UI::packColor(0.1f, 0.1f, 0.1f), UI::packColor(0.5f, 0.5f, 0.5f));
+		panels.push_back(panel);
+
+		for (int j = 0; j < 100; j++) {
+			boxes.push_back(ui.createBox({ static_cast<float>(j % 10) * 15.0f, static_cast<float>(j / 10) * 9.0f, 14.0f, 8.0f }, UI::DEFAULT_COLOR, panel));
+		}
+	}
+
+	ui.update();
+	ui.writeFrameData(frame);
+
+	runner.run("ui/update/10k/static", [&]() {
+		ui.update();
+		ui.writeFrameData(frame);
+	});
+
+	uint32_t frameIndex = 0;
+
+	runner.run("ui/update/10k/100dirty", [&]() {
+		frameIndex++;
+
+		for (int i = 0; i < 100; i++) {
+			ui.setColor(boxes[(frameIndex * 100 + i * 97) % boxes.size()], UI::packColor(static_cast<float>(frameIndex % 256) / 255.0f, 0.0f, 1.0f));
+		}
+
+		ui.update();
+		ui.writeFrameData(frame);
+	});
+
+	runner.run("ui/update/10k/all", [&]() {
+		frameIndex++;
+
+		for (size_t i = 0; i < panels.size(); i++) {
+			ui.setRect(panels[i], { static_cast<float>(i % 10) * 160.0f + static_cast<float>(frameIndex % 8), static_cast<float>(i / 10) * 100.0f, 150.0f, 90.0f });
+		}
+
+		ui.update();
+		ui.writeFrameData(frame);
+	});
+
+	runner.run("ui/churn/100", [&]() {
+		frameIndex++;
+
+		for (int i = 0; i < 100; i++) {
+			size_t index = (frameIndex * 100 + i * 97) % boxes.size();
+			UI::widgetHandle panel = panels[index / 100];
+
+			ui.destroyWidget(boxes[index]);
+			boxes[index] = ui.createBox({ static_cast<float>(index % 10) * 15.0f, static_cast<float>((index % 100) / 10) * 9.0f, 14.0f, 8.0f }, UI::DEFAULT_COLOR, panel);
+		}
+
+		ui.update();
+		ui.writeFrameData(frame);
+	});
+
+	UI scrollingUI;
+	std::vector<UI::widgetHandle> scrollPanels;
+
+	for (int i = 0; i < 100; i++) {
+		UI::widgetHandle panel = scrollingUI.createPanel({ static_cast<float>(i % 10) * 160.0f, static_cast<float>(i / 10) * 100.0f, 150.0f, 90.0f }, UI::packColor(0.1f, 0.1f, 0.1f), UI::packColor(0.5f, 0.5f, 0.5f));
+		scrollingUI.setClip(panel, true);
+		scrollPanels.push_back(panel);
+
+		for (int j = 0; j < 100; j++) {
+			scrollingUI.createBox({ 2.0f, static_cast<float>(j) * 9.0f, 146.0f, 8.0f }, UI::DEFAULT_COLOR, panel);
+		}
+	}
+
+	scrollingUI.update();
+	scrollingUI.writeFrameData(frame);
+
+	log_info("Static clipped panels: " + std::to_string(frame.drawCommands.size()) + " draw commands");
+
+	runner.run("ui/scroll/100panels", [&]() {
+		frameIndex++;
+
+		for (UI::widgetHandle panel : scrollPanels) {
+			scrollingUI.setScroll(panel, { 0.0f, static_cast<float>(frameIndex % 800) });
+		}
+
+		scrollingUI.update();
+		scrollingUI.writeFrameData(frame);
+	});
+
+	log_info("Scrolled clipped panels: " + std::to_string(frame.drawCommands.size()) + " draw commands, " + std::to_string(scrollingUI.getStatistics().uploadedQuads) + " quads uploaded");
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "../src/logger/logger.h"
+#include "../src/mesh/mesh_cooker.h"
+
+#include <cstdio>
+
+static std::string formatRatio(float value) {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+
+	return buffer;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		std::cerr << "Usage: cooker <input.obj|input.gltf|input.glb> <output.mesh>" << std::endl;
+
+		return 1;
+	}
+
+	try {
+		std::string inputPath = argv[1];
+		std::string outputPath = argv[2];
+
+		log_info("Cooking mesh " + inputPath + "...");
+
+		MeshImporter::sourceMesh source = MeshImporter::importFile(inputPath);
+		MeshCooker::cookedMesh mesh = MeshCooker::cook(source);
+		MeshCooker::write(mesh, outputPath);
+
+		const MeshCooker::statistics& stats = mesh.stats;
+
+		log_info("Vertices: " + std::to_string(stats.sourceVertices) + " -> " + std::to_string(stats.vertices));
+		log_info("Triangles: " + std::to_string(stats.sourceTriangles) + " -> " + std::to_string(stats.triangles));
+		log_info("ACMR: " + formatRatio(stats.sourceCache.acmr) + " -> " + formatRatio(stats.cookedCache.acmr));
+		log_info("ATVR: " + formatRatio(stats.sourceCache.atvr) + " -> " + formatRatio(stats.cookedCache.atvr));
+		log_info("Bytes: " + std::to_string(stats.sourceBytes) + " -> " + std::to_string(stats.cookedBytes));
+
+		log_info("Cooked mesh written to " + outputPath);
+	}
+	catch (const std::runtime_error& e) {
+		std::cerr << e.what() << std::endl;
+
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
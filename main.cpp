@@ -1,10 +1,11 @@
 #include "main.h"
 #include "src/application/application.h"
 
-int main() {
+int main(int argc, char** argv) {
 	Application application;
 
 	try {
+		application.parseArguments(argc, argv);
 		application.init();
 	}
 	catch (const std::runtime_error& e) {
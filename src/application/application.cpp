@@ -1,22 +1,164 @@
 #include "application.h"
 
-void Application::init() {
-	log_info("Initializing application...");
+void Application::parseArguments(int argc, char** argv) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
 
-	window.init(*this);
-	renderer.init(*this);
-	ui.init(*this);
+		if (argument == "--headless") {
+			options.headless = true;
+		}
+		else if (argument == "--trace") {
+			options.trace = true;
+		}
+		else if (argument == "--frames" && i + 1 < argc) {
+			options.frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--readback" && i + 1 < argc) {
+			options.readbackPath = argv[++i];
+		}
+		else if (argument == "--workers" && i + 1 < argc) {
+			options.workerThreads = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--render-thread") {
+			options.renderThread = true;
+		}
+		else if (argument == "--continuous") {
+			options.idleRendering = false;
+		}
+		else if (argument == "--max-idle-ms" && i + 1 < argc) {
+			options.maxIdleMilliseconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--pacing" && i + 1 < argc) {
+			std::string profileName = argv[++i];
 
-	log_info("Application initialized!");
+			if (!FramePacer::parseProfile(profileName, options.pacingProfile)) {
+				log_warning("Unknown pacing profile: " + profileName);
+			}
+		}
+		else if (argument == "--font" && i + 1 < argc) {
+			options.fontPath = argv[++i];
+		}
+		else if (argument == "--mesh" && i + 1 < argc) {
+			options.meshPaths.push_back(argv[++i]);
+			options.meshTexturePaths.push_back("");
+		}
+		else if (argument == "--texture" && i + 1 < argc) {
+			if (options.meshTexturePaths.empty()) {
+				log_warning("--texture must follow a --mesh argument!");
+				i++;
+			}
+			else {
+				options.meshTexturePaths.back() = argv[++i];
+			}
+		}
+		else if (argument == "--texture-budget" && i + 1 < argc) {
+			options.textureBudgetMegabytes = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--frames-in-flight" && i + 1 < argc) {
+			options.framesInFlight = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+		}
+		else if (argument == "--no-occlusion") {
+			options.occlusionCulling = false;
+		}
+		else {
+			log_warning("Unknown argument: " + argument);
+		}
+	}
+
+	if (!options.readbackPath.empty() && (!options.headless || options.frameCount == 0)) {
+		log_error("--readback requires --headless and --frames!");
+	}
+
+	if (!options.occlusionCulling && options.meshPaths.empty()) {
+		log_error("--no-occlusion requires --mesh!");
+	}
+
+	if (options.headless) {
+		log_info("Running in headless mode!");
+	}
+}
+
+void Application::init() {
+	startup();
 
 	running = true;
+	startTime = std::chrono::steady_clock::now();
 
 	while (running) {
 		loop();
 	}
 }
 
+void Application::startup() {
+	launchTime = std::chrono::steady_clock::now();
+
+	log_info("Initializing application...");
+
+	tracer.init(options.trace);
+	jobSystem.init(*this);
+	renderer.init(*this);
+
+	InitGraph graph;
+
+	graph.addStep("window", {}, [this]() {
+		window.init(*this);
+	}, true);
+
+	graph.addStep("input", { "window" }, [this]() {
+		input.init(*this);
+	}, true);
+
+	graph.addStep("shader files", {}, [this]() {
+		pipelines.loadShaderCode(startupShaders);
+	});
+
+	renderer.addInitSteps(graph);
+
+	graph.addStep("text", {}, [this]() {
+		text.init(*this);
+	});
+
+	graph.addStep("ui", { "render pass", "shader files", "text" }, [this]() {
+		ui.init(*this);
+	});
+
+	graph.addStep("textures", { "renderer", "ui" }, [this]() {
+		textures.init(*this);
+	});
+
+	graph.addStep("scene", { "renderer" }, [this]() {
+		scene.init(*this);
+	});
+
+	graph.addStep("culling", { "scene" }, [this]() {
+		culling.init(*this);
+	});
+
+	graph.addStep("meshes", { "renderer", "shader files", "ui", "textures", "scene", "culling" }, [this]() {
+		meshes.init(*this);
+	});
+
+	graph.run(jobSystem);
+	graph.report();
+
+	pipelines.clearShaderCache();
+
+	renderThread.init(*this);
+
+	log_info("Application initialized!");
+}
+
+std::chrono::steady_clock::time_point Application::getLaunchTime() {
+	return launchTime;
+}
+
 void Application::loop() {
+	trace_zone("Application::loop");
+
+	if (!renderThread.isEnabled()) {
+		renderer.framePacer.waitForFrameStart();
+	}
+
 	window.poll(*this);
 
 	if (window.shouldClose(*this)) {
@@ -25,7 +167,30 @@ void Application::loop() {
 		return;
 	}
 
-	if (running) {
+	if (!running) {
+		return;
+	}
+
+	if (scene.update()) {
+		culling.update();
+		renderer.markDamaged();
+	}
+
+	if (renderThread.isEnabled()) {
+		ui.drawUI();
+
+		if (!renderer.isFrameNeeded()) {
+			return;
+		}
+
+		renderer.buildFramePacket(renderThread.beginPacket());
+		renderThread.submitPacket();
+
+		if (options.headless && options.frameCount != 0 && renderThread.getSubmittedFrames() >= options.frameCount) {
+			renderThread.flush();
+		}
+	}
+	else {
 		renderer.drawFrame();
 	}
 }
@@ -33,6 +198,25 @@ void Application::loop() {
 void Application::cleanup() {
 	running = false;
 
+	if (options.headless) {
+		double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		uint64_t frames = renderer.getFrameNumber();
+
+		log_info("Rendered " + std::to_string(frames) + " headless frames in " + std::to_string(milliseconds) + " ms (" + std::to_string(frames * 1000.0 / milliseconds) + " fps)");
+	}
+
+	renderThread.cleanup();
+
+	input.cleanup();
 	window.cleanup(*this);
+	ui.cleanup();
+	meshes.cleanup();
+	culling.cleanup();
+	scene.cleanup();
+	textures.cleanup();
+	text.cleanup();
 	renderer.cleanup();
+	jobSystem.cleanup();
+
+	tracer.cleanup();
 }
\ No newline at end of file
@@ -3,14 +3,48 @@
 
 #include "../../src/window/window.h"
 #include "../../src/renderer/renderer.h"
+#include "../../src/renderer/render_thread.h"
 #include "../../src/logger/logger.h"
 #include "../../src/input/input.h"
 #include "../../src/file_system/file_system.h"
 #include "../../src/ui/ui.h"
+#include "../../src/text/text.h"
+#include "../../src/mesh/meshes.h"
+#include "../../src/texture/textures.h"
+#include "../../src/scene/scene.h"
+#include "../../src/culling/culling.h"
+#include "../../src/tracer/tracer.h"
+#include "../../src/job_system/job_system.h"
+#include "../../src/application/init_graph.h"
+
+#include <chrono>
+#include <string>
 
 class Application {
 	public:
+		struct launchOptions {
+			bool headless = false;
+			bool trace = false;
+			uint32_t frameCount = 0;
+			std::string readbackPath;
+			uint32_t workerThreads = 0;
+			bool renderThread = false;
+			bool idleRendering = true;
+			uint32_t maxIdleMilliseconds = 1000;
+			FramePacer::profile pacingProfile = FramePacer::profile::maxThroughput;
+			uint32_t framesInFlight = 0;
+			std::string deviceCachePath = "physical_device.cache";
+			std::string fontPath;
+			std::vector<std::string> meshPaths;
+			std::vector<std::string> meshTexturePaths;
+			uint32_t textureBudgetMegabytes = 0;
+			bool occlusionCulling = true;
+		};
+
+		void parseArguments(int argc, char** argv);
+
 		void init();
+		void startup();
 		void loop();
 		void cleanup();
 
@@ -23,7 +57,32 @@ class Application {
 		Logger logger;
 		Input input;
 		UI ui;
+		Text text;
+		Meshes meshes;
+		Textures textures;
+		Scene scene;
+		Culling culling;
+		JobSystem jobSystem;
+		RenderThread renderThread;
+
+		launchOptions options;
 
 		bool running = false;
+
+		std::chrono::steady_clock::time_point getLaunchTime();
 	private:
+		std::chrono::steady_clock::time_point startTime;
+		std::chrono::steady_clock::time_point launchTime;
+
+		const std::vector<std::string> startupShaders = {
+			"src/renderer/shaders/vert.spv",
+			"src/renderer/shaders/frag.spv",
+			"src/renderer/shaders/ui_vert.spv",
+			"src/renderer/shaders/ui_frag.spv",
+			"src/renderer/shaders/ui_image_frag.spv",
+			"src/renderer/shaders/ui_shape_vert.spv",
+			"src/renderer/shaders/ui_shape_frag.spv",
+			"src/renderer/shaders/mesh_vert.spv",
+			"src/renderer/shaders/mesh_frag.spv"
+		};
 };
\ No newline at end of file
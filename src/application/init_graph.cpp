@@ -0,0 +1,159 @@
+#include "init_graph.h"
+#include "application.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+void InitGraph::addStep(const char* name, const std::vector<const char*>& dependencies, std::function<void()> function, bool mainThread) {
+	std::unique_ptr<step> newStep = std::make_unique<step>();
+	newStep->name = name;
+	newStep->dependencyNames = dependencies;
+	newStep->function = std::move(function);
+	newStep->mainThread = mainThread;
+
+	steps.push_back(std::move(newStep));
+}
+
+void InitGraph::resolveDependencies() {
+	for (uint32_t i = 0; i < steps.size(); i++) {
+		for (const char* dependencyName : steps[i]->dependencyNames) {
+			auto dependency = std::find_if(steps.begin(), steps.end(), [&](const std::unique_ptr<step>& candidate) {
+				return std::strcmp(candidate->name, dependencyName) == 0;
+			});
+
+			if (dependency == steps.end()) {
+				log_error("Init step " + std::string(steps[i]->name) + " depends on unknown step " + dependencyName + "!");
+			}
+
+			(*dependency)->dependents.push_back(i);
+			steps[i]->remainingDependencies.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void InitGraph::run(JobSystem& jobSystem) {
+	trace_zone("InitGraph::run");
+
+	this->jobSystem = &jobSystem;
+
+	resolveDependencies();
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < steps.size(); i++) {
+		if (steps[i]->remainingDependencies.load(std::memory_order_relaxed) == 0) {
+			schedule(i);
+		}
+	}
+
+	while (completedSteps.load(std::memory_order_acquire) < steps.size()) {
+		uint32_t mainStep = UINT32_MAX;
+
+		{
+			std::lock_guard<std::mutex> lock(mainMutex);
+
+			if (!mainSteps.empty()) {
+				mainStep = mainSteps.front();
+				mainSteps.pop_front();
+			}
+		}
+
+		if (mainStep != UINT32_MAX) {
+			execute(mainStep);
+		}
+		else if (!jobSystem.runPendingJob()) {
+			std::this_thread::yield();
+		}
+	}
+
+	totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	if (failed.load(std::memory_order_acquire)) {
+		log_warning("Init step " + std::string(failedStep) + " failed!");
+
+		std::rethrow_exception(failure);
+	}
+}
+
+void InitGraph::schedule(uint32_t stepIndex) {
+	if (steps[stepIndex]->mainThread) {
+		std::lock_guard<std::mutex> lock(mainMutex);
+
+		mainSteps.push_back(stepIndex);
+
+		return;
+	}
+
+	jobSystem->submit([this, stepIndex]() {
+		execute(stepIndex);
+	});
+}
+
+void InitGraph::execute(uint32_t stepIndex) {
+	step& currentStep = *steps[stepIndex];
+
+	std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+
+	if (!failed.load(std::memory_order_acquire)) {
+		TraceZone zone(currentStep.name);
+
+		try {
+			currentStep.function();
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(failureMutex);
+
+			if (!failed.exchange(true)) {
+				failure = std::current_exception();
+				failedStep = currentStep.name;
+			}
+		}
+	}
+
+	std::chrono::steady_clock::time_point stepEnd = std::chrono::steady_clock::now();
+
+	currentStep.startMilliseconds = std::chrono::duration<double, std::milli>(stepStart - startTime).count();
+	currentStep.durationMilliseconds = std::chrono::duration<double, std::milli>(stepEnd - stepStart).count();
+
+	for (uint32_t dependent : currentStep.dependents) {
+		if (steps[dependent]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			schedule(dependent);
+		}
+	}
+
+	completedSteps.fetch_add(1, std::memory_order_release);
+}
+
+std::vector<InitGraph::stepTiming> InitGraph::getTimings() {
+	std::vector<stepTiming> timings;
+	timings.reserve(steps.size());
+
+	for (const std::unique_ptr<step>& currentStep : steps) {
+		timings.push_back({ currentStep->name, currentStep->startMilliseconds, currentStep->durationMilliseconds, currentStep->mainThread });
+	}
+
+	std::sort(timings.begin(), timings.end(), [](const stepTiming& a, const stepTiming& b) {
+		return a.startMilliseconds < b.startMilliseconds;
+	});
+
+	return timings;
+}
+
+double InitGraph::getTotalMilliseconds() {
+	return totalMilliseconds;
+}
+
+void InitGraph::report() {
+	double serialMilliseconds = 0.0;
+
+	log_info("Startup profile:");
+
+	for (const stepTiming& timing : getTimings()) {
+		serialMilliseconds += timing.durationMilliseconds;
+
+		log_info("  " + std::string(timing.name) + ": start " + std::to_string(timing.startMilliseconds) + " ms, took " + std::to_string(timing.durationMilliseconds) + " ms" + (timing.mainThread ? " (main thread)" : ""));
+	}
+
+	log_info("Startup took " + std::to_string(totalMilliseconds) + " ms (" + std::to_string(serialMilliseconds) + " ms of step time across " + std::to_string(steps.size()) + " steps)");
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#define init_graph_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+class InitGraph {
+	public:
+		struct stepTiming {
+			const char* name;
+			double startMilliseconds;
+			double durationMilliseconds;
+			bool mainThread;
+		};
+
+		void addStep(const char* name, const std::vector<const char*>& dependencies, std::function<void()> function, bool mainThread = false);
+		void run(JobSystem& jobSystem);
+		void report();
+
+		std::vector<stepTiming> getTimings();
+		double getTotalMilliseconds();
+	private:
+		struct step {
+			const char* name;
+			std::vector<const char*> dependencyNames;
+			std::vector<uint32_t> dependents;
+			std::function<void()> function;
+			bool mainThread = false;
+
+			std::atomic<uint32_t> remainingDependencies{ 0 };
+
+			double startMilliseconds = 0.0;
+			double durationMilliseconds = 0.0;
+		};
+
+		std::vector<std::unique_ptr<step>> steps;
+
+		JobSystem* jobSystem = nullptr;
+		std::chrono::steady_clock::time_point startTime;
+		double totalMilliseconds = 0.0;
+
+		std::mutex mainMutex;
+		std::deque<uint32_t> mainSteps;
+
+		std::atomic<uint32_t> completedSteps{ 0 };
+		std::atomic<bool> failed{ false };
+		std::mutex failureMutex;
+		std::exception_ptr failure;
+		const char* failedStep = nullptr;
+
+		void resolveDependencies();
+		void schedule(uint32_t stepIndex);
+		void execute(uint32_t stepIndex);
+};
\ No newline at end of file
@@ -0,0 +1,676 @@
+#include "bvh.h"
+#include "../job_system/job_system.h"
+#include "../tracer/tracer.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+static const uint32_t LANE_MASK = SimdFloat::WIDTH >= 32 ? UINT32_MAX : (1u << SimdFloat::WIDTH) - 1;
+static const uint32_t SLOT_MASK = (1u << Bvh::BRANCHING) - 1;
+
+static bool contains(const Bvh::aabb& outer, const Bvh::aabb& inner) {
+	return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+static Bvh::aabb merge(const Bvh::aabb& a, const Bvh::aabb& b) {
+	return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+}
+
+static uint32_t expandBits(uint32_t value) {
+	value = (value | (value << 16)) & 0x030000FFu;
+	value = (value | (value << 8)) & 0x0300F00Fu;
+	value = (value | (value << 4)) & 0x030C30C3u;
+	value = (value | (value << 2)) & 0x09249249u;
+
+	return value;
+}
+
+static float getSurfaceArea(const Bvh::aabb& bounds) {
+	glm::vec3 size = bounds.max - bounds.min;
+
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+Bvh::proxyHandle Bvh::insert(const aabb& bounds) {
+	proxyHandle proxy;
+
+	if (!freeProxies.empty()) {
+		proxy = freeProxies.back();
+		freeProxies.pop_back();
+	}
+	else {
+		proxy = static_cast<proxyHandle>(alive.size());
+
+		boundsMinX.push_back(0.0f);
+		boundsMinY.push_back(0.0f);
+		boundsMinZ.push_back(0.0f);
+		boundsMaxX.push_back(0.0f);
+		boundsMaxY.push_back(0.0f);
+		boundsMaxZ.push_back(0.0f);
+		alive.push_back(0);
+		proxyNodes.push_back(NO_NODE);
+		proxySlots.push_back(0);
+	}
+
+	boundsMinX[proxy] = bounds.min.x;
+	boundsMinY[proxy] = bounds.min.y;
+	boundsMinZ[proxy] = bounds.min.z;
+	boundsMaxX[proxy] = bounds.max.x;
+	boundsMaxY[proxy] = bounds.max.y;
+	boundsMaxZ[proxy] = bounds.max.z;
+	alive[proxy] = 1;
+
+	stats.proxies++;
+	stats.modificationsSinceBuild++;
+
+	if (root == NO_NODE) {
+		root = allocateNode();
+	}
+
+	uint32_t nodeIndex = root;
+	uint32_t slot = 0;
+
+	while (true) {
+		node& current = nodes[nodeIndex];
+
+		if (current.childMask != SLOT_MASK) {
+			slot = static_cast<uint32_t>(std::countr_zero(~current.childMask));
+			break;
+		}
+
+		uint32_t best = 0;
+		float bestEnlargement = getEnlargement(current, 0, bounds);
+
+		for (uint32_t i = 1; i < BRANCHING; i++) {
+			float enlargement = getEnlargement(current, i, bounds);
+
+			if (enlargement < bestEnlargement) {
+				best = i;
+				bestEnlargement = enlargement;
+			}
+		}
+
+		if (!(current.proxyMask & (1u << best))) {
+			nodeIndex = current.children[best];
+			continue;
+		}
+
+		proxyHandle sibling = current.children[best];
+		aabb siblingBounds = { { current.minX[best], current.minY[best], current.minZ[best] }, { current.maxX[best], current.maxY[best], current.maxZ[best] } };
+
+		uint32_t child = allocateNode();
+
+		nodes[child].parent = nodeIndex;
+		nodes[child].parentSlot = best;
+		nodes[child].children[0] = sibling;
+		nodes[child].childMask = 1;
+		nodes[child].proxyMask = 1;
+		setSlot(child, 0, siblingBounds);
+
+		proxyNodes[sibling] = child;
+		proxySlots[sibling] = 0;
+
+		nodes[nodeIndex].children[best] = child;
+		nodes[nodeIndex].proxyMask &= ~(1u << best);
+		setSlot(nodeIndex, best, siblingBounds);
+
+		nodeIndex = child;
+		slot = 1;
+		break;
+	}
+
+	node& target = nodes[nodeIndex];
+	target.children[slot] = proxy;
+	target.childMask |= 1u << slot;
+	target.proxyMask |= 1u << slot;
+	setSlot(nodeIndex, slot, bounds);
+
+	proxyNodes[proxy] = nodeIndex;
+	proxySlots[proxy] = slot;
+
+	growAncestors(nodeIndex, bounds);
+
+	return proxy;
+}
+
+void Bvh::remove(proxyHandle proxy) {
+	if (proxy >= alive.size() || !alive[proxy]) {
+		return;
+	}
+
+	uint32_t nodeIndex = proxyNodes[proxy];
+	uint32_t slot = proxySlots[proxy];
+
+	while (true) {
+		node& current = nodes[nodeIndex];
+		current.childMask &= ~(1u << slot);
+		current.proxyMask &= ~(1u << slot);
+
+		if (current.childMask != 0 || current.parent == NO_NODE) {
+			break;
+		}
+
+		freeNodes.push_back(nodeIndex);
+		slot = current.parentSlot;
+		nodeIndex = current.parent;
+
+		stats.nodes--;
+	}
+
+	alive[proxy] = 0;
+	proxyNodes[proxy] = NO_NODE;
+	freeProxies.push_back(proxy);
+
+	stats.proxies--;
+	stats.modificationsSinceBuild++;
+}
+
+void Bvh::update(proxyHandle proxy, const aabb& bounds) {
+	if (proxy >= alive.size() || !alive[proxy]) {
+		return;
+	}
+
+	boundsMinX[proxy] = bounds.min.x;
+	boundsMinY[proxy] = bounds.min.y;
+	boundsMinZ[proxy] = bounds.min.z;
+	boundsMaxX[proxy] = bounds.max.x;
+	boundsMaxY[proxy] = bounds.max.y;
+	boundsMaxZ[proxy] = bounds.max.z;
+
+	uint32_t nodeIndex = proxyNodes[proxy];
+	uint32_t slot = proxySlots[proxy];
+	const node& current = nodes[nodeIndex];
+
+	if (contains({ { current.minX[slot], current.minY[slot], current.minZ[slot] }, { current.maxX[slot], current.maxY[slot], current.maxZ[slot] } }, bounds)) {
+		return;
+	}
+
+	glm::vec3 margin = (bounds.max - bounds.min) * FAT_MARGIN;
+	aabb fat = { bounds.min - margin, bounds.max + margin };
+
+	setSlot(nodeIndex, slot, fat);
+	growAncestors(nodeIndex, fat);
+
+	stats.refits++;
+	stats.modificationsSinceBuild++;
+}
+
+bool Bvh::shouldRebuild() {
+	return stats.modificationsSinceBuild > std::max(REBUILD_MINIMUM, stats.proxies / 4);
+}
+
+void Bvh::rebuild() {
+	trace_zone("Bvh::rebuild");
+
+	glm::vec3 centroidMin(std::numeric_limits<float>::max());
+	glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+
+	for (proxyHandle proxy = 0; proxy < alive.size(); proxy++) {
+		if (alive[proxy]) {
+			glm::vec3 centroid(boundsMinX[proxy] + boundsMaxX[proxy], boundsMinY[proxy] + boundsMaxY[proxy], boundsMinZ[proxy] + boundsMaxZ[proxy]);
+
+			centroidMin = glm::min(centroidMin, centroid);
+			centroidMax = glm::max(centroidMax, centroid);
+		}
+	}
+
+	glm::vec3 scale = 1023.0f / glm::max(centroidMax - centroidMin, glm::vec3(1e-6f));
+
+	buildItems.clear();
+
+	for (proxyHandle proxy = 0; proxy < alive.size(); proxy++) {
+		if (alive[proxy]) {
+			glm::vec3 centroid(boundsMinX[proxy] + boundsMaxX[proxy], boundsMinY[proxy] + boundsMaxY[proxy], boundsMinZ[proxy] + boundsMaxZ[proxy]);
+			glm::uvec3 cell = glm::uvec3(glm::clamp((centroid - centroidMin) * scale, 0.0f, 1023.0f));
+
+			buildItems.push_back({ expandBits(cell.x) << 2 | expandBits(cell.y) << 1 | expandBits(cell.z), proxy });
+		}
+	}
+
+	sortBuildItems();
+
+	nodes.clear();
+	freeNodes.clear();
+	root = NO_NODE;
+
+	stats.nodes = 0;
+	stats.modificationsSinceBuild = 0;
+	stats.rebuilds++;
+
+	if (buildItems.empty()) {
+		return;
+	}
+
+	nodes.reserve(buildItems.size() * 2 / (BRANCHING - 1) + 1);
+
+	root = buildNode(0, static_cast<uint32_t>(buildItems.size()), NO_NODE, 0);
+}
+
+uint32_t Bvh::allocateNode() {
+	uint32_t nodeIndex;
+
+	if (!freeNodes.empty()) {
+		nodeIndex = freeNodes.back();
+		freeNodes.pop_back();
+		nodes[nodeIndex] = node{};
+	}
+	else {
+		nodeIndex = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+	}
+
+	node& created = nodes[nodeIndex];
+
+	for (uint32_t slot = 0; slot < BRANCHING; slot++) {
+		created.children[slot] = NO_NODE;
+		setSlot(nodeIndex, slot, { glm::vec3(0.0f), glm::vec3(0.0f) });
+	}
+
+	stats.nodes++;
+
+	return nodeIndex;
+}
+
+void Bvh::sortBuildItems() {
+	const uint32_t RADIX_BITS = 8;
+	const uint32_t BUCKETS = 1u << RADIX_BITS;
+
+	sortScratch.resize(buildItems.size());
+
+	for (uint32_t shift = 0; shift < 32; shift += RADIX_BITS) {
+		uint32_t offsets[BUCKETS] = {};
+
+		for (const buildItem& item : buildItems) {
+			offsets[(item.mortonCode >> shift) & (BUCKETS - 1)]++;
+		}
+
+		uint32_t total = 0;
+
+		for (uint32_t bucket = 0; bucket < BUCKETS; bucket++) {
+			uint32_t count = offsets[bucket];
+			offsets[bucket] = total;
+			total += count;
+		}
+
+		for (const buildItem& item : buildItems) {
+			sortScratch[offsets[(item.mortonCode >> shift) & (BUCKETS - 1)]++] = item;
+		}
+
+		buildItems.swap(sortScratch);
+	}
+}
+
+uint32_t Bvh::buildNode(uint32_t begin, uint32_t end, uint32_t parent, uint32_t parentSlot) {
+	uint32_t nodeIndex = allocateNode();
+
+	nodes[nodeIndex].parent = parent;
+	nodes[nodeIndex].parentSlot = parentSlot;
+
+	uint32_t groupBegins[BRANCHING] = { begin };
+	uint32_t groupEnds[BRANCHING] = { end };
+	uint32_t groupCount = 1;
+
+	while (groupCount < BRANCHING) {
+		uint32_t largest = 0;
+
+		for (uint32_t group = 1; group < groupCount; group++) {
+			if (groupEnds[group] - groupBegins[group] > groupEnds[largest] - groupBegins[largest]) {
+				largest = group;
+			}
+		}
+
+		uint32_t groupBegin = groupBegins[largest];
+		uint32_t groupEnd = groupEnds[largest];
+
+		if (groupEnd - groupBegin < 2) {
+			break;
+		}
+
+		uint32_t firstCode = buildItems[groupBegin].mortonCode;
+		uint32_t lastCode = buildItems[groupEnd - 1].mortonCode;
+		uint32_t middle = groupBegin + (groupEnd - groupBegin) / 2;
+
+		if (firstCode != lastCode) {
+			uint32_t splitBit = 1u << (31 - std::countl_zero(firstCode ^ lastCode));
+
+			middle = static_cast<uint32_t>(std::partition_point(buildItems.begin() + groupBegin, buildItems.begin() + groupEnd, [splitBit](const buildItem& item) {
+				return !(item.mortonCode & splitBit);
+			}) - buildItems.begin());
+		}
+
+		groupEnds[largest] = middle;
+		groupBegins[groupCount] = middle;
+		groupEnds[groupCount] = groupEnd;
+		groupCount++;
+	}
+
+	for (uint32_t slot = 0; slot < groupCount; slot++) {
+		if (groupEnds[slot] - groupBegins[slot] == 1) {
+			proxyHandle proxy = buildItems[groupBegins[slot]].proxy;
+
+			nodes[nodeIndex].children[slot] = proxy;
+			nodes[nodeIndex].proxyMask |= 1u << slot;
+			setSlot(nodeIndex, slot, getBounds(proxy));
+
+			proxyNodes[proxy] = nodeIndex;
+			proxySlots[proxy] = slot;
+		}
+		else {
+			uint32_t child = buildNode(groupBegins[slot], groupEnds[slot], nodeIndex, slot);
+
+			nodes[nodeIndex].children[slot] = child;
+			setSlot(nodeIndex, slot, getNodeBounds(child));
+		}
+
+		nodes[nodeIndex].childMask |= 1u << slot;
+	}
+
+	return nodeIndex;
+}
+
+void Bvh::setSlot(uint32_t nodeIndex, uint32_t slot, const aabb& bounds) {
+	node& current = nodes[nodeIndex];
+
+	current.minX[slot] = bounds.min.x;
+	current.minY[slot] = bounds.min.y;
+	current.minZ[slot] = bounds.min.z;
+	current.maxX[slot] = bounds.max.x;
+	current.maxY[slot] = bounds.max.y;
+	current.maxZ[slot] = bounds.max.z;
+}
+
+Bvh::aabb Bvh::getNodeBounds(uint32_t nodeIndex) {
+	const node& current = nodes[nodeIndex];
+
+	aabb bounds = { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()) };
+
+	for (uint32_t slot = 0; slot < BRANCHING; slot++) {
+		if (current.childMask & (1u << slot)) {
+			bounds = merge(bounds, { { current.minX[slot], current.minY[slot], current.minZ[slot] }, { current.maxX[slot], current.maxY[slot], current.maxZ[slot] } });
+		}
+	}
+
+	return bounds;
+}
+
+void Bvh::growAncestors(uint32_t nodeIndex, const aabb& bounds) {
+	while (nodes[nodeIndex].parent != NO_NODE) {
+		uint32_t slot = nodes[nodeIndex].parentSlot;
+		nodeIndex = nodes[nodeIndex].parent;
+
+		const node& parent = nodes[nodeIndex];
+		aabb slotBounds = { { parent.minX[slot], parent.minY[slot], parent.minZ[slot] }, { parent.maxX[slot], parent.maxY[slot], parent.maxZ[slot] } };
+
+		if (contains(slotBounds, bounds)) {
+			break;
+		}
+
+		setSlot(nodeIndex, slot, merge(slotBounds, bounds));
+	}
+}
+
+float Bvh::getEnlargement(const node& current, uint32_t slot, const aabb& bounds) {
+	aabb slotBounds = { { current.minX[slot], current.minY[slot], current.minZ[slot] }, { current.maxX[slot], current.maxY[slot], current.maxZ[slot] } };
+
+	return getSurfaceArea(merge(slotBounds, bounds)) - getSurfaceArea(slotBounds);
+}
+
+Bvh::frustum Bvh::extractFrustum(const glm::mat4& viewProjection) {
+	glm::vec4 rows[4];
+
+	for (uint32_t row = 0; row < 4; row++) {
+		rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row], viewProjection[3][row]);
+	}
+
+	frustum view;
+	view.planes[0] = rows[3] + rows[0];
+	view.planes[1] = rows[3] - rows[0];
+	view.planes[2] = rows[3] + rows[1];
+	view.planes[3] = rows[3] - rows[1];
+	view.planes[4] = rows[2];
+	view.planes[5] = rows[3] - rows[2];
+
+	for (glm::vec4& plane : view.planes) {
+		plane /= std::max(glm::length(glm::vec3(plane)), 1e-12f);
+	}
+
+	return view;
+}
+
+void Bvh::loadPlanes(const frustum& view, planeCoefficients* planes) {
+	for (uint32_t i = 0; i < 6; i++) {
+		const glm::vec4& plane = view.planes[i];
+
+		planes[i].positiveX = SimdFloat::broadcast(std::max(plane.x, 0.0f));
+		planes[i].positiveY = SimdFloat::broadcast(std::max(plane.y, 0.0f));
+		planes[i].positiveZ = SimdFloat::broadcast(std::max(plane.z, 0.0f));
+		planes[i].negativeX = SimdFloat::broadcast(std::min(plane.x, 0.0f));
+		planes[i].negativeY = SimdFloat::broadcast(std::min(plane.y, 0.0f));
+		planes[i].negativeZ = SimdFloat::broadcast(std::min(plane.z, 0.0f));
+		planes[i].distance = SimdFloat::broadcast(plane.w);
+	}
+}
+
+uint32_t Bvh::testBoxes(const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, const planeCoefficients* planes, uint32_t& insideMask) {
+	SimdFloat zero = SimdFloat::broadcast(0.0f);
+
+	SimdFloat lowX = SimdFloat::load(minX);
+	SimdFloat lowY = SimdFloat::load(minY);
+	SimdFloat lowZ = SimdFloat::load(minZ);
+	SimdFloat highX = SimdFloat::load(maxX);
+	SimdFloat highY = SimdFloat::load(maxY);
+	SimdFloat highZ = SimdFloat::load(maxZ);
+
+	uint32_t outside = 0;
+	uint32_t partial = 0;
+
+	for (uint32_t i = 0; i < 6; i++) {
+		const planeCoefficients& plane = planes[i];
+
+		SimdFloat farthest = plane.positiveX * highX + plane.negativeX * lowX + plane.positiveY * highY + plane.negativeY * lowY + plane.positiveZ * highZ + plane.negativeZ * lowZ + plane.distance;
+		SimdFloat nearest = plane.positiveX * lowX + plane.negativeX * highX + plane.positiveY * lowY + plane.negativeY * highY + plane.positiveZ * lowZ + plane.negativeZ * highZ + plane.distance;
+
+		outside |= SimdFloat::lessThanMask(farthest, zero);
+		partial |= SimdFloat::lessThanMask(nearest, zero);
+	}
+
+	insideMask = ~partial & LANE_MASK;
+
+	return ~outside & LANE_MASK;
+}
+
+void Bvh::testNode(const node& current, const planeCoefficients* planes, uint32_t& visibleMask, uint32_t& insideMask) {
+	visibleMask = 0;
+	insideMask = 0;
+
+	for (uint32_t group = 0; group < BRANCHING; group += SimdFloat::WIDTH) {
+		uint32_t groupInside;
+		uint32_t groupVisible = testBoxes(current.minX + group, current.minY + group, current.minZ + group, current.maxX + group, current.maxY + group, current.maxZ + group, planes, groupInside);
+
+		visibleMask |= groupVisible << group;
+		insideMask |= groupInside << group;
+	}
+}
+
+void Bvh::expandNode(traversalEntry entry, const planeCoefficients* planes, std::vector<proxyHandle>& visible, std::vector<traversalEntry>& children) {
+	const node& current = nodes[entry.node];
+
+	uint32_t visibleMask = current.childMask;
+	uint32_t insideMask = SLOT_MASK;
+
+	if (!entry.inside) {
+		testNode(current, planes, visibleMask, insideMask);
+		visibleMask &= current.childMask;
+	}
+
+	while (visibleMask != 0) {
+		uint32_t slot = static_cast<uint32_t>(std::countr_zero(visibleMask));
+		visibleMask &= visibleMask - 1;
+
+		if (current.proxyMask & (1u << slot)) {
+			visible.push_back(current.children[slot]);
+		}
+		else {
+			children.push_back({ current.children[slot], (insideMask & (1u << slot)) != 0 });
+		}
+	}
+}
+
+void Bvh::traverse(traversalEntry entry, const planeCoefficients* planes, std::vector<proxyHandle>& visible, std::vector<traversalEntry>& stack, uint64_t& testedNodes) {
+	stack.clear();
+	stack.push_back(entry);
+
+	while (!stack.empty()) {
+		traversalEntry current = stack.back();
+		stack.pop_back();
+
+		testedNodes += current.inside ? 0 : 1;
+
+		expandNode(current, planes, visible, stack);
+	}
+}
+
+void Bvh::cull(const frustum& view, JobSystem& jobSystem, std::vector<proxyHandle>& visible) {
+	trace_zone("Bvh::cull");
+
+	visible.clear();
+
+	if (root == NO_NODE) {
+		stats.visible = 0;
+
+		return;
+	}
+
+	planeCoefficients planes[6];
+	loadPlanes(view, planes);
+
+	uint64_t testedNodes = 0;
+	uint32_t threadCount = jobSystem.getThreadCount();
+
+	frontier.clear();
+	frontier.push_back({ root, false });
+
+	if (threadCount > 1) {
+		size_t target = static_cast<size_t>(threadCount) * FRONTIER_PER_THREAD;
+
+		while (!frontier.empty() && frontier.size() < target) {
+			bool expanded = false;
+
+			nextFrontier.clear();
+
+			for (const traversalEntry& entry : frontier) {
+				if (entry.inside) {
+					nextFrontier.push_back(entry);
+				}
+				else {
+					expandNode(entry, planes, visible, nextFrontier);
+					testedNodes++;
+					expanded = true;
+				}
+			}
+
+			frontier.swap(nextFrontier);
+
+			if (!expanded) {
+				break;
+			}
+		}
+	}
+
+	uint32_t taskCount = static_cast<uint32_t>(frontier.size());
+
+	if (taskVisible.size() < taskCount) {
+		taskVisible.resize(taskCount);
+		taskStacks.resize(taskCount);
+		taskTestedNodes.resize(taskCount);
+	}
+
+	jobSystem.parallelFor(taskCount, 1, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t task = begin; task < end; task++) {
+			taskVisible[task].clear();
+			taskTestedNodes[task] = 0;
+
+			traverse(frontier[task], planes, taskVisible[task], taskStacks[task], taskTestedNodes[task]);
+		}
+	});
+
+	for (uint32_t task = 0; task < taskCount; task++) {
+		visible.insert(visible.end(), taskVisible[task].begin(), taskVisible[task].end());
+		testedNodes += taskTestedNodes[task];
+	}
+
+	stats.visible = static_cast<uint32_t>(visible.size());
+	stats.testedNodes = testedNodes;
+}
+
+void Bvh::cullBruteForce(const frustum& view, JobSystem& jobSystem, std::vector<proxyHandle>& visible) {
+	trace_zone("Bvh::cullBruteForce");
+
+	planeCoefficients planes[6];
+	loadPlanes(view, planes);
+
+	uint32_t count = static_cast<uint32_t>(alive.size());
+	uint32_t taskCount = (count + TASK_GRAIN - 1) / TASK_GRAIN;
+
+	if (taskVisible.size() < taskCount) {
+		taskVisible.resize(taskCount);
+		taskStacks.resize(taskCount);
+		taskTestedNodes.resize(taskCount);
+	}
+
+	for (uint32_t task = 0; task < taskCount; task++) {
+		taskVisible[task].clear();
+	}
+
+	jobSystem.parallelFor(count, TASK_GRAIN, [&](uint32_t begin, uint32_t end) {
+		std::vector<proxyHandle>& output = taskVisible[begin / TASK_GRAIN];
+
+		for (uint32_t block = begin; block < end; block += SimdFloat::WIDTH) {
+			uint32_t lanes = std::min(SimdFloat::WIDTH, end - block);
+			uint32_t insideMask;
+			uint32_t visibleMask;
+
+			if (lanes == SimdFloat::WIDTH) {
+				visibleMask = testBoxes(&boundsMinX[block], &boundsMinY[block], &boundsMinZ[block], &boundsMaxX[block], &boundsMaxY[block], &boundsMaxZ[block], planes, insideMask);
+			}
+			else {
+				float padded[6][SimdFloat::WIDTH] = {};
+
+				std::copy(&boundsMinX[block], &boundsMinX[block] + lanes, padded[0]);
+				std::copy(&boundsMinY[block], &boundsMinY[block] + lanes, padded[1]);
+				std::copy(&boundsMinZ[block], &boundsMinZ[block] + lanes, padded[2]);
+				std::copy(&boundsMaxX[block], &boundsMaxX[block] + lanes, padded[3]);
+				std::copy(&boundsMaxY[block], &boundsMaxY[block] + lanes, padded[4]);
+				std::copy(&boundsMaxZ[block], &boundsMaxZ[block] + lanes, padded[5]);
+
+				visibleMask = testBoxes(padded[0], padded[1], padded[2], padded[3], padded[4], padded[5], planes, insideMask) & ((1u << lanes) - 1);
+			}
+
+			while (visibleMask != 0) {
+				uint32_t lane = static_cast<uint32_t>(std::countr_zero(visibleMask));
+				visibleMask &= visibleMask - 1;
+
+				if (alive[block + lane]) {
+					output.push_back(block + lane);
+				}
+			}
+		}
+	});
+
+	visible.clear();
+
+	for (uint32_t task = 0; task < taskCount; task++) {
+		visible.insert(visible.end(), taskVisible[task].begin(), taskVisible[task].end());
+	}
+
+	stats.visible = static_cast<uint32_t>(visible.size());
+}
+
+Bvh::aabb Bvh::getBounds(proxyHandle proxy) {
+	return { { boundsMinX[proxy], boundsMinY[proxy], boundsMinZ[proxy] }, { boundsMaxX[proxy], boundsMaxY[proxy], boundsMaxZ[proxy] } };
+}
+
+Bvh::statistics Bvh::getStatistics() {
+	return stats;
+}
\ No newline at end of file
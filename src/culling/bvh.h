@@ -0,0 +1,130 @@
+#pragma once
+#define bvh_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../simd/simd.h"
+
+class JobSystem;
+
+class Bvh {
+	public:
+		typedef uint32_t proxyHandle;
+
+		static constexpr proxyHandle NO_PROXY = UINT32_MAX;
+		static constexpr uint32_t BRANCHING = SimdFloat::WIDTH < 4 ? 4 : SimdFloat::WIDTH;
+		static constexpr uint32_t REBUILD_MINIMUM = 1024;
+		static constexpr uint32_t TASK_GRAIN = 4096;
+		static constexpr float FAT_MARGIN = 0.25f;
+
+		struct aabb {
+			glm::vec3 min;
+			glm::vec3 max;
+		};
+
+		struct frustum {
+			glm::vec4 planes[6];
+		};
+
+		struct statistics {
+			uint32_t proxies = 0;
+			uint32_t nodes = 0;
+			uint32_t visible = 0;
+			uint64_t testedNodes = 0;
+			uint64_t rebuilds = 0;
+			uint64_t refits = 0;
+			uint32_t modificationsSinceBuild = 0;
+		};
+
+		proxyHandle insert(const aabb& bounds);
+		void remove(proxyHandle proxy);
+		void update(proxyHandle proxy, const aabb& bounds);
+
+		bool shouldRebuild();
+		void rebuild();
+
+		void cull(const frustum& view, JobSystem& jobSystem, std::vector<proxyHandle>& visible);
+		void cullBruteForce(const frustum& view, JobSystem& jobSystem, std::vector<proxyHandle>& visible);
+
+		aabb getBounds(proxyHandle proxy);
+		statistics getStatistics();
+
+		static frustum extractFrustum(const glm::mat4& viewProjection);
+	private:
+		static constexpr uint32_t NO_NODE = UINT32_MAX;
+		static constexpr uint32_t FRONTIER_PER_THREAD = 8;
+
+		struct alignas(32) node {
+			float minX[BRANCHING];
+			float minY[BRANCHING];
+			float minZ[BRANCHING];
+			float maxX[BRANCHING];
+			float maxY[BRANCHING];
+			float maxZ[BRANCHING];
+			uint32_t children[BRANCHING];
+			uint32_t parent = NO_NODE;
+			uint32_t parentSlot = 0;
+			uint32_t childMask = 0;
+			uint32_t proxyMask = 0;
+		};
+
+		struct planeCoefficients {
+			SimdFloat positiveX, positiveY, positiveZ;
+			SimdFloat negativeX, negativeY, negativeZ;
+			SimdFloat distance;
+		};
+
+		struct buildItem {
+			uint32_t mortonCode;
+			proxyHandle proxy;
+		};
+
+		struct traversalEntry {
+			uint32_t node;
+			bool inside;
+		};
+
+		std::vector<node> nodes;
+		uint32_t root = NO_NODE;
+
+		std::vector<float> boundsMinX;
+		std::vector<float> boundsMinY;
+		std::vector<float> boundsMinZ;
+		std::vector<float> boundsMaxX;
+		std::vector<float> boundsMaxY;
+		std::vector<float> boundsMaxZ;
+		std::vector<uint8_t> alive;
+		std::vector<uint32_t> proxyNodes;
+		std::vector<uint32_t> proxySlots;
+		std::vector<proxyHandle> freeProxies;
+
+		std::vector<buildItem> buildItems;
+		std::vector<buildItem> sortScratch;
+		std::vector<uint32_t> freeNodes;
+
+		std::vector<traversalEntry> frontier;
+		std::vector<traversalEntry> nextFrontier;
+		std::vector<std::vector<proxyHandle>> taskVisible;
+		std::vector<std::vector<traversalEntry>> taskStacks;
+		std::vector<uint64_t> taskTestedNodes;
+
+		statistics stats;
+
+		uint32_t allocateNode();
+		void sortBuildItems();
+		uint32_t buildNode(uint32_t begin, uint32_t end, uint32_t parent, uint32_t parentSlot);
+		void setSlot(uint32_t nodeIndex, uint32_t slot, const aabb& bounds);
+		aabb getNodeBounds(uint32_t nodeIndex);
+		void growAncestors(uint32_t nodeIndex, const aabb& bounds);
+		float getEnlargement(const node& current, uint32_t slot, const aabb& bounds);
+
+		void testNode(const node& current, const planeCoefficients* planes, uint32_t& visibleMask, uint32_t& insideMask);
+		void expandNode(traversalEntry entry, const planeCoefficients* planes, std::vector<proxyHandle>& visible, std::vector<traversalEntry>& children);
+		void traverse(traversalEntry entry, const planeCoefficients* planes, std::vector<proxyHandle>& visible, std::vector<traversalEntry>& stack, uint64_t& testedNodes);
+
+		static void loadPlanes(const frustum& view, planeCoefficients* planes);
+		static uint32_t testBoxes(const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, const planeCoefficients* planes, uint32_t& insideMask);
+};
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "culling.h"
+#include "../application/application.h"
+
+void Culling::init(Application& application) {
+	log_info("Initializing culling...");
+
+	this->application = &application;
+
+	log_info("Culling initialized with " + std::to_string(Bvh::BRANCHING) + "-wide " + std::string(SimdFloat::getInstructionSet()) + " frustum tests!");
+}
+
+Culling::objectHandle Culling::createObject(Scene::nodeHandle node, glm::vec3 boundsMin, glm::vec3 boundsMax) {
+	object created;
+	created.node = node;
+	created.boundsMin = boundsMin;
+	created.boundsMax = boundsMax;
+
+	objectHandle handle = bvh.insert(getWorldBounds(created));
+
+	if (handle >= objects.size()) {
+		objects.resize(handle + 1);
+	}
+
+	if (node >= nodeObjects.size()) {
+		nodeObjects.resize(node + 1, NO_OBJECT);
+	}
+
+	created.nextObject = nodeObjects[node];
+	nodeObjects[node] = handle;
+	objects[handle] = created;
+
+	stats.objects++;
+
+	return handle;
+}
+
+void Culling::destroyObject(objectHandle handle) {
+	if (handle >= objects.size() || objects[handle].node == Scene::NO_NODE) {
+		return;
+	}
+
+	objectHandle* link = &nodeObjects[objects[handle].node];
+
+	while (*link != handle) {
+		link = &objects[*link].nextObject;
+	}
+
+	*link = objects[handle].nextObject;
+	objects[handle] = object{};
+
+	bvh.remove(handle);
+
+	stats.objects--;
+}
+
+Bvh::aabb Culling::getWorldBounds(const object& current) {
+	glm::mat4 world = application->scene.getWorldMatrix(current.node);
+
+	glm::vec3 center = glm::vec3(world * glm::vec4((current.boundsMin + current.boundsMax) * 0.5f, 1.0f));
+	glm::vec3 extent = (current.boundsMax - current.boundsMin) * 0.5f;
+	glm::vec3 worldExtent = glm::abs(glm::vec3(world[0])) * extent.x + glm::abs(glm::vec3(world[1])) * extent.y + glm::abs(glm::vec3(world[2])) * extent.z;
+
+	return { center - worldExtent, center + worldExtent };
+}
+
+void Culling::update() {
+	trace_zone("Culling::update");
+
+	application->scene.getChangedNodes(changedNodes);
+
+	for (Scene::nodeHandle node : changedNodes) {
+		if (node >= nodeObjects.size()) {
+			continue;
+		}
+
+		for (objectHandle handle = nodeObjects[node]; handle != NO_OBJECT; handle = objects[handle].nextObject) {
+			bvh.update(handle, getWorldBounds(objects[handle]));
+		}
+	}
+}
+
+void Culling::cull(const glm::mat4& viewProjection, std::vector<objectHandle>& visible) {
+	trace_zone("Culling::cull");
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (bvh.shouldRebuild()) {
+		bvh.rebuild();
+	}
+
+	bvh.cull(Bvh::extractFrustum(viewProjection), application->jobSystem, visible);
+
+	Bvh::statistics bvhStats = bvh.getStatistics();
+
+	stats.visible = bvhStats.visible;
+	stats.culls++;
+	stats.testedNodes += bvhStats.testedNodes;
+	stats.rebuilds = bvhStats.rebuilds;
+	stats.refits = bvhStats.refits;
+	stats.cullMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+Culling::statistics Culling::getStatistics() {
+	return stats;
+}
+
+void Culling::cleanup() {
+	log_info("Cleaning up culling...");
+
+	if (stats.culls > 0) {
+		log_info("Culling ran " + std::to_string(stats.culls) + " times, testing " + std::to_string(stats.testedNodes) + " nodes in " + std::to_string(stats.cullMilliseconds) + " ms with " + std::to_string(stats.rebuilds) + " rebuilds and " + std::to_string(stats.refits) + " refits");
+	}
+
+	objects.clear();
+	nodeObjects.clear();
+	bvh = Bvh();
+
+	log_info("Culling cleaned up!");
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#define culling_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bvh.h"
+#include "../scene/scene.h"
+
+class Application;
+
+class Culling {
+	public:
+		typedef Bvh::proxyHandle objectHandle;
+
+		static constexpr objectHandle NO_OBJECT = Bvh::NO_PROXY;
+
+		struct statistics {
+			uint32_t objects = 0;
+			uint32_t visible = 0;
+			uint64_t culls = 0;
+			uint64_t testedNodes = 0;
+			uint64_t rebuilds = 0;
+			uint64_t refits = 0;
+			double cullMilliseconds = 0.0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		objectHandle createObject(Scene::nodeHandle node, glm::vec3 boundsMin, glm::vec3 boundsMax);
+		void destroyObject(objectHandle object);
+
+		void update();
+		void cull(const glm::mat4& viewProjection, std::vector<objectHandle>& visible);
+
+		statistics getStatistics();
+	private:
+		struct object {
+			Scene::nodeHandle node = Scene::NO_NODE;
+			glm::vec3 boundsMin{ 0.0f };
+			glm::vec3 boundsMax{ 0.0f };
+			objectHandle nextObject = NO_OBJECT;
+		};
+
+		Application* application = nullptr;
+
+		Bvh bvh;
+		std::vector<object> objects;
+		std::vector<objectHandle> nodeObjects;
+		std::vector<Scene::nodeHandle> changedNodes;
+
+		statistics stats;
+
+		Bvh::aabb getWorldBounds(const object& current);
+};
\ No newline at end of file
@@ -1,6 +1,18 @@
 #include "file_system.h"
 #include "../application/application.h"
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 FileSystem fileSystem;
 
 std::vector<char> FileSystem::readFile(const std::string& fileName) {
@@ -22,4 +34,88 @@ std::vector<char> FileSystem::readFile(const std::string& fileName) {
 	file.close();
 
 	return buffer;
+}
+
+std::vector<std::vector<char>> FileSystem::readFiles(JobSystem& jobSystem, const std::vector<std::string>& fileNames) {
+	std::vector<std::vector<char>> buffers(fileNames.size());
+
+	jobSystem.parallelFor(static_cast<uint32_t>(fileNames.size()), 1, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) {
+			buffers[i] = readFile(fileNames[i]);
+		}
+	});
+
+	return buffers;
+}
+
+FileSystem::mappedFile FileSystem::mapFile(const std::string& fileName) {
+	mappedFile mapped;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		log_error("Failed to open file: " + fileName);
+	}
+
+	LARGE_INTEGER fileSize{};
+	GetFileSizeEx(file, &fileSize);
+
+	HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	CloseHandle(file);
+
+	void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+	if (view == nullptr) {
+		if (mapping != nullptr) {
+			CloseHandle(mapping);
+		}
+
+		log_error("Failed to map file: " + fileName);
+	}
+
+	mapped.data = static_cast<const char*>(view);
+	mapped.size = static_cast<size_t>(fileSize.QuadPart);
+	mapped.handle = mapping;
+#else
+	int file = open(fileName.c_str(), O_RDONLY);
+
+	if (file < 0) {
+		log_error("Failed to open file: " + fileName);
+	}
+
+	struct stat fileStatus{};
+	fstat(file, &fileStatus);
+
+	void* view = fileStatus.st_size > 0 ? mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+	close(file);
+
+	if (view == MAP_FAILED) {
+		log_error("Failed to map file: " + fileName);
+	}
+
+	madvise(view, static_cast<size_t>(fileStatus.st_size), MADV_SEQUENTIAL);
+
+	mapped.data = static_cast<const char*>(view);
+	mapped.size = static_cast<size_t>(fileStatus.st_size);
+#endif
+
+	log_info("Successfully mapped file: " + fileName);
+
+	return mapped;
+}
+
+void FileSystem::unmapFile(mappedFile& file) {
+	if (file.data == nullptr) {
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(file.data);
+	CloseHandle(file.handle);
+#else
+	munmap(const_cast<char*>(file.data), file.size);
+#endif
+
+	file = {};
 }
\ No newline at end of file
@@ -3,10 +3,23 @@
 
 #include <fstream>
 #include <vector>
+#include <string>
+
+class JobSystem;
 
 class FileSystem {
 	public:
+		struct mappedFile {
+			const char* data = nullptr;
+			size_t size = 0;
+			void* handle = nullptr;
+		};
+
 		std::vector<char> readFile(const std::string& fileName);
+		std::vector<std::vector<char>> readFiles(JobSystem& jobSystem, const std::vector<std::string>& fileNames);
+
+		mappedFile mapFile(const std::string& fileName);
+		void unmapFile(mappedFile& file);
 	private:
 };
 
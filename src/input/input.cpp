@@ -1,8 +1,244 @@
 #include "input.h"
 #include "../application/application.h"
 
-void Input::loop(Application& application, GLFWwindow* window) {
-	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-		application.cleanup();
+void Input::init(Application& application) {
+	log_info("Initializing input...");
+
+	this->application = &application;
+
+	bindKey(GLFW_KEY_ESCAPE, action::quit);
+
+	if (application.options.headless) {
+		log_info("Headless mode, skipping input callbacks!");
+
+		return;
+	}
+
+	glfwSetKeyCallback(application.window.glfwWindow, keyCallback);
+	glfwSetMouseButtonCallback(application.window.glfwWindow, mouseButtonCallback);
+	glfwSetCursorPosCallback(application.window.glfwWindow, cursorPositionCallback);
+	glfwSetScrollCallback(application.window.glfwWindow, scrollCallback);
+
+	log_info("Input initialized!");
+}
+
+void Input::cleanup() {
+	log_info("Cleaning up input...");
+
+	latencyStats stats = getLatencyStats();
+
+	if (stats.count > 0) {
+		log_info("Input-to-present latency over " + std::to_string(stats.count) + " events: average " + std::to_string(stats.totalMilliseconds / stats.count) + " ms, max " + std::to_string(stats.maximumMilliseconds) + " ms");
 	}
+
+	log_info("Input cleaned up!");
+}
+
+void Input::keyCallback(GLFWwindow* window, int key, int, int state, int mods) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+	event newEvent{};
+	newEvent.type = eventType::key;
+	newEvent.code = key;
+	newEvent.state = state;
+	newEvent.mods = mods;
+
+	application->input.pushEvent(newEvent);
+}
+
+void Input::mouseButtonCallback(GLFWwindow* window, int button, int state, int mods) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+	event newEvent{};
+	newEvent.type = eventType::mouseButton;
+	newEvent.code = button;
+	newEvent.state = state;
+	newEvent.mods = mods;
+
+	application->input.pushEvent(newEvent);
+}
+
+void Input::cursorPositionCallback(GLFWwindow* window, double x, double y) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+	event newEvent{};
+	newEvent.type = eventType::mouseMove;
+	newEvent.x = x;
+	newEvent.y = y;
+
+	application->input.pushEvent(newEvent);
+}
+
+void Input::scrollCallback(GLFWwindow* window, double x, double y) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+	event newEvent{};
+	newEvent.type = eventType::scroll;
+	newEvent.x = x;
+	newEvent.y = y;
+
+	application->input.pushEvent(newEvent);
+}
+
+void Input::pushEvent(event newEvent) {
+	newEvent.id = nextEventId.fetch_add(1, std::memory_order_relaxed);
+	newEvent.timestamp = std::chrono::steady_clock::now();
+
+	if (!events.push(newEvent)) {
+		droppedEvents.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Input::processEvents(Application& application) {
+	trace_zone("Input::processEvents");
+
+	for (actionState& state : actions) {
+		state.pressed = false;
+		state.released = false;
+	}
+
+	event currentEvent;
+	bool received = false;
+
+	while (events.pop(currentEvent)) {
+		received = true;
+
+		switch (currentEvent.type) {
+			case eventType::key: {
+				if (currentEvent.code < 0 || currentEvent.code > GLFW_KEY_LAST || currentEvent.state == GLFW_REPEAT) {
+					break;
+				}
+
+				bool down = currentEvent.state == GLFW_PRESS;
+				keys[currentEvent.code] = down;
+
+				auto binding = keyBindings.find(currentEvent.code);
+
+				if (binding != keyBindings.end()) {
+					applyAction(binding->second, down);
+				}
+
+				break;
+			}
+			case eventType::mouseButton: {
+				if (currentEvent.code < 0 || currentEvent.code > GLFW_MOUSE_BUTTON_LAST) {
+					break;
+				}
+
+				bool down = currentEvent.state == GLFW_PRESS;
+				mouseButtons[currentEvent.code] = down;
+
+				auto binding = mouseButtonBindings.find(currentEvent.code);
+
+				if (binding != mouseButtonBindings.end()) {
+					applyAction(binding->second, down);
+				}
+
+				break;
+			}
+			case eventType::mouseMove:
+				mouseX = currentEvent.x;
+				mouseY = currentEvent.y;
+
+				break;
+			case eventType::scroll:
+			case eventType::resize:
+				break;
+		}
+
+		if (pendingStamps.size() < EVENT_QUEUE_SIZE) {
+			pendingStamps.push_back({ currentEvent.id, currentEvent.timestamp });
+		}
+	}
+
+	if (received) {
+		application.renderer.markDamaged();
+	}
+
+	uint32_t dropped = droppedEvents.exchange(0, std::memory_order_relaxed);
+
+	if (dropped > 0) {
+		log_warning("Input event queue full, dropped " + std::to_string(dropped) + " events!");
+	}
+
+	if (wasActionPressed(action::quit) && !application.options.headless) {
+		glfwSetWindowShouldClose(application.window.glfwWindow, GLFW_TRUE);
+	}
+}
+
+void Input::applyAction(action action, bool down) {
+	actionState& state = actions[static_cast<size_t>(action)];
+
+	if (down && !state.down) {
+		state.pressed = true;
+	}
+	else if (!down && state.down) {
+		state.released = true;
+	}
+
+	state.down = down;
+}
+
+void Input::bindKey(int key, action action) {
+	keyBindings[key] = action;
+}
+
+void Input::bindMouseButton(int button, action action) {
+	mouseButtonBindings[button] = action;
+}
+
+bool Input::isActionDown(action action) {
+	return actions[static_cast<size_t>(action)].down;
+}
+
+bool Input::wasActionPressed(action action) {
+	return actions[static_cast<size_t>(action)].pressed;
+}
+
+bool Input::wasActionReleased(action action) {
+	return actions[static_cast<size_t>(action)].released;
+}
+
+bool Input::isKeyDown(int key) {
+	return key >= 0 && key <= GLFW_KEY_LAST && keys[key];
+}
+
+bool Input::isMouseButtonDown(int button) {
+	return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && mouseButtons[button];
+}
+
+double Input::getMouseX() {
+	return mouseX;
+}
+
+double Input::getMouseY() {
+	return mouseY;
+}
+
+void Input::writeFrameEvents(std::vector<eventStamp>& frameEvents) {
+	frameEvents.assign(pendingStamps.begin(), pendingStamps.end());
+	pendingStamps.clear();
+}
+
+void Input::recordPresent(const std::vector<eventStamp>& frameEvents, std::chrono::steady_clock::time_point presentTime) {
+	if (frameEvents.empty()) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(latencyMutex);
+
+	for (const eventStamp& stamp : frameEvents) {
+		double milliseconds = std::chrono::duration<double, std::milli>(presentTime - stamp.timestamp).count();
+
+		latency.count++;
+		latency.totalMilliseconds += milliseconds;
+		latency.maximumMilliseconds = std::max(latency.maximumMilliseconds, milliseconds);
+		latency.lastMilliseconds = milliseconds;
+	}
+}
+
+Input::latencyStats Input::getLatencyStats() {
+	std::lock_guard<std::mutex> lock(latencyMutex);
+
+	return latency;
 }
\ No newline at end of file
@@ -1,12 +1,111 @@
 #pragma once
 #define input_h
 
-#include "GLFW/glfw3.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../window/window.h"
+#include "../job_system/spsc_queue.h"
 
 class Application;
 
 class Input {
 	public:
-		void loop(Application& application, GLFWwindow* window);
+		enum class eventType {
+			key,
+			mouseButton,
+			mouseMove,
+			scroll,
+			resize
+		};
+
+		enum class action {
+			quit,
+			count
+		};
+
+		struct event {
+			eventType type = eventType::key;
+			int code = 0;
+			int state = 0;
+			int mods = 0;
+			double x = 0.0;
+			double y = 0.0;
+			uint64_t id = 0;
+			std::chrono::steady_clock::time_point timestamp;
+		};
+
+		struct eventStamp {
+			uint64_t id = 0;
+			std::chrono::steady_clock::time_point timestamp;
+		};
+
+		struct latencyStats {
+			uint64_t count = 0;
+			double totalMilliseconds = 0.0;
+			double maximumMilliseconds = 0.0;
+			double lastMilliseconds = 0.0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		void pushEvent(event newEvent);
+		void processEvents(Application& application);
+
+		void bindKey(int key, action action);
+		void bindMouseButton(int button, action action);
+
+		bool isActionDown(action action);
+		bool wasActionPressed(action action);
+		bool wasActionReleased(action action);
+
+		bool isKeyDown(int key);
+		bool isMouseButtonDown(int button);
+		double getMouseX();
+		double getMouseY();
+
+		void writeFrameEvents(std::vector<eventStamp>& frameEvents);
+		void recordPresent(const std::vector<eventStamp>& frameEvents, std::chrono::steady_clock::time_point presentTime);
+		latencyStats getLatencyStats();
 	private:
+		Application* application = nullptr;
+
+		static const uint32_t EVENT_QUEUE_SIZE = 1024;
+
+		SpscQueue<event, EVENT_QUEUE_SIZE> events;
+		std::atomic<uint64_t> nextEventId{ 0 };
+		std::atomic<uint32_t> droppedEvents{ 0 };
+
+		struct actionState {
+			bool down = false;
+			bool pressed = false;
+			bool released = false;
+		};
+
+		std::array<actionState, static_cast<size_t>(action::count)> actions{};
+		std::unordered_map<int, action> keyBindings;
+		std::unordered_map<int, action> mouseButtonBindings;
+
+		std::array<bool, GLFW_KEY_LAST + 1> keys{};
+		std::array<bool, GLFW_MOUSE_BUTTON_LAST + 1> mouseButtons{};
+		double mouseX = 0.0;
+		double mouseY = 0.0;
+
+		std::vector<eventStamp> pendingStamps;
+
+		std::mutex latencyMutex;
+		latencyStats latency;
+
+		void applyAction(action action, bool down);
+
+		static void keyCallback(GLFWwindow* window, int key, int scancode, int state, int mods);
+		static void mouseButtonCallback(GLFWwindow* window, int button, int state, int mods);
+		static void cursorPositionCallback(GLFWwindow* window, double x, double y);
+		static void scrollCallback(GLFWwindow* window, double x, double y);
 };
\ No newline at end of file
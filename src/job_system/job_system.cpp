@@ -0,0 +1,383 @@
+#include "job_system.h"
+#include "../application/application.h"
+
+static thread_local JobSystem* currentJobSystem = nullptr;
+static thread_local uint32_t currentThreadIndex = UINT32_MAX;
+
+JobSystem::workDeque::workDeque() : jobs(new std::atomic<job*>[DEQUE_SIZE]) {
+	for (uint32_t i = 0; i < DEQUE_SIZE; i++) {
+		jobs[i].store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+bool JobSystem::workDeque::push(job* newJob) {
+	int64_t currentBottom = bottom.load(std::memory_order_relaxed);
+	int64_t currentTop = top.load(std::memory_order_acquire);
+
+	if (currentBottom - currentTop >= static_cast<int64_t>(DEQUE_SIZE)) {
+		return false;
+	}
+
+	jobs[currentBottom & (DEQUE_SIZE - 1)].store(newJob, std::memory_order_relaxed);
+
+	bottom.store(currentBottom + 1, std::memory_order_release);
+
+	return true;
+}
+
+JobSystem::job* JobSystem::workDeque::pop() {
+	int64_t currentBottom = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(currentBottom, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	int64_t currentTop = top.load(std::memory_order_relaxed);
+
+	if (currentTop > currentBottom) {
+		bottom.store(currentBottom + 1, std::memory_order_relaxed);
+
+		return nullptr;
+	}
+
+	job* poppedJob = jobs[currentBottom & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+	if (currentTop == currentBottom) {
+		if (!top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			poppedJob = nullptr;
+		}
+
+		bottom.store(currentBottom + 1, std::memory_order_relaxed);
+	}
+
+	return poppedJob;
+}
+
+JobSystem::job* JobSystem::workDeque::steal() {
+	int64_t currentTop = top.load(std::memory_order_acquire);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	int64_t currentBottom = bottom.load(std::memory_order_acquire);
+
+	if (currentTop >= currentBottom) {
+		return nullptr;
+	}
+
+	job* stolenJob = jobs[currentTop & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+	if (!top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+
+	return stolenJob;
+}
+
+void JobSystem::init(Application& application) {
+	log_info("Initializing job system...");
+
+	this->application = &application;
+
+	uint32_t threadCount = application.options.workerThreads;
+
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	startWorkers(threadCount);
+
+	log_info("Job system initialized with " + std::to_string(threadCount) + " threads!");
+}
+
+void JobSystem::startWorkers(uint32_t threadCount) {
+	workerCount = threadCount - 1;
+
+	for (uint32_t i = 0; i < threadCount; i++) {
+		std::unique_ptr<worker> newWorker = std::make_unique<worker>();
+		newWorker->jobPool.reset(new job[JOB_POOL_SIZE]);
+		newWorker->random = 0x9E3779B9u * (i + 1);
+
+		workers.push_back(std::move(newWorker));
+	}
+
+	currentJobSystem = this;
+	currentThreadIndex = 0;
+
+	running.store(true, std::memory_order_release);
+
+	for (uint32_t i = 1; i < threadCount; i++) {
+		workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+	}
+}
+
+void JobSystem::cleanup() {
+	log_info("Cleaning up job system...");
+
+	if (!workers.empty()) {
+		while (pendingJobs.load(std::memory_order_acquire) > 0) {
+			job* nextJob = findJob();
+
+			if (nextJob != nullptr) {
+				execute(nextJob);
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running.store(false, std::memory_order_release);
+	}
+
+	sleepCondition.notify_all();
+
+	for (std::unique_ptr<worker>& currentWorker : workers) {
+		if (currentWorker->thread.joinable()) {
+			currentWorker->thread.join();
+		}
+	}
+
+	workers.clear();
+	workerCount = 0;
+
+	if (currentJobSystem == this) {
+		currentJobSystem = nullptr;
+		currentThreadIndex = UINT32_MAX;
+	}
+
+	log_info("Job system cleaned up!");
+}
+
+uint32_t JobSystem::getThreadCount() {
+	return workerCount + 1;
+}
+
+uint32_t JobSystem::getCurrentThreadIndex() {
+	return currentJobSystem == this ? currentThreadIndex : UINT32_MAX;
+}
+
+void JobSystem::workerLoop(uint32_t workerIndex) {
+	currentJobSystem = this;
+	currentThreadIndex = workerIndex;
+
+	tracer.setThreadName("worker " + std::to_string(workerIndex));
+
+	uint32_t idleSpins = 0;
+
+	while (running.load(std::memory_order_acquire)) {
+		job* nextJob = findJob();
+
+		if (nextJob != nullptr) {
+			execute(nextJob);
+			idleSpins = 0;
+
+			continue;
+		}
+
+		if (++idleSpins < 64) {
+			std::this_thread::yield();
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+
+		sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+
+		sleepCondition.wait(lock, [this]() {
+			return pendingJobs.load(std::memory_order_seq_cst) > 0 || !running.load(std::memory_order_acquire);
+		});
+
+		sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+		idleSpins = 0;
+	}
+
+	currentJobSystem = nullptr;
+	currentThreadIndex = UINT32_MAX;
+}
+
+JobSystem::job* JobSystem::allocateJob() {
+	uint32_t threadIndex = getCurrentThreadIndex();
+
+	if (threadIndex == UINT32_MAX) {
+		job* newJob = new job();
+		newJob->heapAllocated = true;
+		newJob->finished.store(false, std::memory_order_relaxed);
+
+		return newJob;
+	}
+
+	worker& currentWorker = *workers[threadIndex];
+	job* newJob = &currentWorker.jobPool[currentWorker.nextJob++ & (JOB_POOL_SIZE - 1)];
+
+	while (!newJob->finished.load(std::memory_order_acquire)) {
+		job* otherJob = findJob();
+
+		if (otherJob != nullptr) {
+			execute(otherJob);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	newJob->finished.store(false, std::memory_order_relaxed);
+
+	return newJob;
+}
+
+void JobSystem::schedule(job* newJob) {
+	pendingJobs.fetch_add(1, std::memory_order_seq_cst);
+
+	uint32_t threadIndex = getCurrentThreadIndex();
+
+	if (threadIndex != UINT32_MAX) {
+		if (!workers[threadIndex]->deque.push(newJob)) {
+			pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+
+			execute(newJob);
+
+			return;
+		}
+	}
+	else {
+		std::lock_guard<std::mutex> lock(sharedMutex);
+
+		sharedJobs.push_back(newJob);
+		sharedJobCount.fetch_add(1, std::memory_order_release);
+	}
+
+	wake();
+}
+
+void JobSystem::wake() {
+	if (sleepingWorkers.load(std::memory_order_seq_cst) == 0) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	sleepCondition.notify_one();
+}
+
+JobSystem::job* JobSystem::findJob() {
+	uint32_t threadIndex = getCurrentThreadIndex();
+	job* foundJob = nullptr;
+
+	if (threadIndex != UINT32_MAX) {
+		foundJob = workers[threadIndex]->deque.pop();
+	}
+
+	if (foundJob == nullptr && sharedJobCount.load(std::memory_order_acquire) > 0) {
+		std::lock_guard<std::mutex> lock(sharedMutex);
+
+		if (!sharedJobs.empty()) {
+			foundJob = sharedJobs.front();
+			sharedJobs.pop_front();
+			sharedJobCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	if (foundJob == nullptr) {
+		uint32_t threadCount = static_cast<uint32_t>(workers.size());
+		uint32_t offset = 0;
+
+		if (threadIndex != UINT32_MAX) {
+			uint32_t& random = workers[threadIndex]->random;
+
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+
+			offset = random;
+		}
+
+		for (uint32_t i = 0; i < threadCount && foundJob == nullptr; i++) {
+			uint32_t victim = (offset + i) % threadCount;
+
+			if (victim != threadIndex) {
+				foundJob = workers[victim]->deque.steal();
+			}
+		}
+	}
+
+	if (foundJob != nullptr) {
+		pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	return foundJob;
+}
+
+void JobSystem::execute(job* currentJob) {
+	{
+		trace_zone("JobSystem::execute");
+
+		currentJob->invoke(currentJob->data);
+	}
+
+	finish(currentJob);
+}
+
+void JobSystem::finish(job* currentJob) {
+	currentJob->destroy(currentJob->data);
+
+	counter* signal = currentJob->signal;
+
+	if (currentJob->heapAllocated) {
+		delete currentJob;
+	}
+	else {
+		currentJob->finished.store(true, std::memory_order_release);
+	}
+
+	if (signal == nullptr) {
+		return;
+	}
+
+	std::vector<job*> readyJobs;
+
+	{
+		std::lock_guard<std::mutex> lock(signal->mutex);
+
+		if (signal->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			readyJobs.swap(signal->waitingJobs);
+		}
+	}
+
+	for (job* readyJob : readyJobs) {
+		schedule(readyJob);
+	}
+}
+
+bool JobSystem::runPendingJob() {
+	job* nextJob = findJob();
+
+	if (nextJob == nullptr) {
+		return false;
+	}
+
+	execute(nextJob);
+
+	return true;
+}
+
+void JobSystem::wait(counter& counter) {
+	trace_zone("JobSystem::wait");
+
+	while (!counter.isDone()) {
+		job* nextJob = findJob();
+
+		if (nextJob != nullptr) {
+			execute(nextJob);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
\ No newline at end of file
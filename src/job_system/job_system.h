@@ -0,0 +1,171 @@
+#pragma once
+#define job_system_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <deque>
+
+class Application;
+
+class JobSystem {
+	public:
+		struct job;
+
+		struct counter {
+			std::atomic<uint32_t> value{ 0 };
+			std::mutex mutex;
+			std::vector<job*> waitingJobs;
+
+			bool isDone() {
+				return value.load(std::memory_order_acquire) == 0;
+			}
+		};
+
+		struct job {
+			static const size_t DATA_SIZE = 64;
+
+			alignas(std::max_align_t) unsigned char data[DATA_SIZE];
+			void (*invoke)(void* data) = nullptr;
+			void (*destroy)(void* data) = nullptr;
+
+			counter* signal = nullptr;
+			bool heapAllocated = false;
+			std::atomic<bool> finished{ true };
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		template<typename function>
+		void submit(function&& task, counter* signal = nullptr, counter* dependency = nullptr) {
+			using taskType = std::decay_t<function>;
+
+			static_assert(sizeof(taskType) <= job::DATA_SIZE, "Job capture is too large, capture by reference or pointer instead!");
+			static_assert(alignof(taskType) <= alignof(std::max_align_t), "Job capture alignment is too large!");
+
+			job* newJob = allocateJob();
+
+			new (newJob->data) taskType(std::forward<function>(task));
+
+			newJob->invoke = [](void* data) {
+				(*static_cast<taskType*>(data))();
+			};
+
+			newJob->destroy = [](void* data) {
+				static_cast<taskType*>(data)->~taskType();
+			};
+
+			newJob->signal = signal;
+
+			if (signal != nullptr) {
+				signal->value.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (dependency != nullptr) {
+				std::lock_guard<std::mutex> lock(dependency->mutex);
+
+				if (!dependency->isDone()) {
+					dependency->waitingJobs.push_back(newJob);
+
+					return;
+				}
+			}
+
+			schedule(newJob);
+		}
+
+		template<typename function>
+		void parallelFor(uint32_t count, uint32_t grainSize, const function& task) {
+			if (count == 0) {
+				return;
+			}
+
+			grainSize = grainSize == 0 ? 1 : grainSize;
+
+			if (count <= grainSize || workerCount == 0) {
+				task(0u, count);
+
+				return;
+			}
+
+			counter completion;
+
+			for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+				uint32_t end = begin + grainSize < count ? begin + grainSize : count;
+
+				submit([&task, begin, end]() {
+					task(begin, end);
+				}, &completion);
+			}
+
+			task(0u, grainSize);
+
+			wait(completion);
+		}
+
+		void wait(counter& counter);
+		bool runPendingJob();
+
+		uint32_t getThreadCount();
+		uint32_t getCurrentThreadIndex();
+	private:
+		Application* application = nullptr;
+
+		static const uint32_t DEQUE_SIZE = 4096;
+		static const uint32_t JOB_POOL_SIZE = 4096;
+
+		class workDeque {
+			public:
+				workDeque();
+
+				bool push(job* newJob);
+				job* pop();
+				job* steal();
+			private:
+				std::unique_ptr<std::atomic<job*>[]> jobs;
+
+				alignas(64) std::atomic<int64_t> top{ 0 };
+				alignas(64) std::atomic<int64_t> bottom{ 0 };
+		};
+
+		struct worker {
+			workDeque deque;
+			std::unique_ptr<job[]> jobPool;
+			uint32_t nextJob = 0;
+			uint32_t random = 0;
+			std::thread thread;
+		};
+
+		std::vector<std::unique_ptr<worker>> workers;
+		uint32_t workerCount = 0;
+
+		std::mutex sharedMutex;
+		std::deque<job*> sharedJobs;
+		std::atomic<uint32_t> sharedJobCount{ 0 };
+
+		std::atomic<uint32_t> pendingJobs{ 0 };
+
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+		std::atomic<uint32_t> sleepingWorkers{ 0 };
+		std::atomic<bool> running{ false };
+
+		void startWorkers(uint32_t threadCount);
+		void workerLoop(uint32_t workerIndex);
+
+		job* allocateJob();
+		void schedule(job* newJob);
+		job* findJob();
+		void execute(job* currentJob);
+		void finish(job* currentJob);
+		void wake();
+};
\ No newline at end of file
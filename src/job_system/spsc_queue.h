@@ -0,0 +1,51 @@
+#pragma once
+#define spsc_queue_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template<typename T, uint32_t CAPACITY>
+class SpscQueue {
+	public:
+		static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two!");
+
+		bool push(const T& value) {
+			uint32_t currentHead = head.load(std::memory_order_relaxed);
+
+			if (currentHead - tail.load(std::memory_order_acquire) >= CAPACITY) {
+				return false;
+			}
+
+			items[currentHead & (CAPACITY - 1)] = value;
+			head.store(currentHead + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool pop(T& value) {
+			uint32_t currentTail = tail.load(std::memory_order_relaxed);
+
+			if (currentTail == head.load(std::memory_order_acquire)) {
+				return false;
+			}
+
+			value = items[currentTail & (CAPACITY - 1)];
+			tail.store(currentTail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool isEmpty() {
+			return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+		}
+
+		uint32_t size() {
+			return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+		}
+	private:
+		std::array<T, CAPACITY> items{};
+
+		alignas(64) std::atomic<uint32_t> head{ 0 };
+		alignas(64) std::atomic<uint32_t> tail{ 0 };
+};
\ No newline at end of file
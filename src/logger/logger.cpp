@@ -16,7 +16,11 @@ std::string Logger::getDateAndTime() {
 	std::time_t nowTime = std::chrono::system_clock::to_time_t(now);
 
 	std::tm localTime;
+#ifdef _WIN32
 	localtime_s(&localTime, &nowTime);
+#else
+	localtime_r(&nowTime, &localTime);
+#endif
 
 	char buffer[20];
 	std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &localTime);
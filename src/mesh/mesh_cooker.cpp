@@ -0,0 +1,190 @@
+#include "mesh_cooker.h"
+#include "../logger/logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+void MeshCooker::generateNormals(std::vector<MeshImporter::sourceVertex>& vertices, const std::vector<uint32_t>& indices) {
+	std::vector<glm::vec3> positions(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		positions[i] = vertices[i].position;
+	}
+
+	std::vector<uint32_t> positionRemap;
+	uint32_t positionCount = MeshOptimizer::generateRemap(positions.data(), positions.size(), sizeof(glm::vec3), positionRemap);
+
+	std::vector<glm::vec3> normals(positionCount, glm::vec3(0.0f));
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const glm::vec3& a = positions[indices[i]];
+		const glm::vec3& b = positions[indices[i + 1]];
+		const glm::vec3& c = positions[indices[i + 2]];
+
+		glm::vec3 normal = glm::cross(b - a, c - a);
+
+		for (size_t corner = 0; corner < 3; corner++) {
+			normals[positionRemap[indices[i + corner]]] += normal;
+		}
+	}
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		glm::vec3 normal = normals[positionRemap[i]];
+		float length = glm::length(normal);
+
+		vertices[i].normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+}
+
+MeshFormat::vertex MeshCooker::quantize(const MeshImporter::sourceVertex& vertex, const glm::vec3& offset, const glm::vec3& inverseScale) {
+	glm::vec3 normalized = glm::clamp((vertex.position - offset) * inverseScale, glm::vec3(0.0f), glm::vec3(1.0f));
+
+	MeshFormat::vertex packed;
+	packed.position = VertexPacking::packUnorm16x4(glm::vec4(normalized, 0.0f));
+	packed.normal = VertexPacking::packSnorm1010102(glm::vec4(vertex.normal, 0.0f));
+	packed.uv = VertexPacking::packHalf2(vertex.uv);
+
+	return packed;
+}
+
+MeshCooker::cookedMesh MeshCooker::cook(const MeshImporter::sourceMesh& source) {
+	cookedMesh mesh;
+	statistics& stats = mesh.stats;
+
+	const uint32_t sourceVertexCount = static_cast<uint32_t>(source.vertices.size());
+
+	stats.sourceVertices = sourceVertexCount;
+	stats.sourceTriangles = static_cast<uint32_t>(source.indices.size() / 3);
+	stats.sourceBytes = source.vertices.size() * sizeof(MeshImporter::sourceVertex) + source.indices.size() * sizeof(uint32_t);
+	stats.sourceCache = MeshOptimizer::analyzeVertexCache(source.indices, sourceVertexCount);
+
+	std::vector<MeshImporter::sourceVertex> sourceVertices = source.vertices;
+
+	if (!source.hasNormals) {
+		generateNormals(sourceVertices, source.indices);
+	}
+
+	glm::vec3 boundsMin(std::numeric_limits<float>::max());
+	glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+
+	for (const MeshImporter::sourceVertex& vertex : sourceVertices) {
+		boundsMin = glm::min(boundsMin, vertex.position);
+		boundsMax = glm::max(boundsMax, vertex.position);
+	}
+
+	glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(1e-20f));
+
+	std::vector<MeshFormat::vertex> packedVertices(sourceVertexCount);
+
+	for (uint32_t i = 0; i < sourceVertexCount; i++) {
+		packedVertices[i] = quantize(sourceVertices[i], boundsMin, 1.0f / extent);
+	}
+
+	std::vector<uint32_t> remap;
+	uint32_t uniqueCount = MeshOptimizer::generateRemap(packedVertices.data(), packedVertices.size(), sizeof(MeshFormat::vertex), remap);
+
+	std::vector<MeshFormat::vertex> uniqueVertices(uniqueCount);
+
+	for (uint32_t i = 0; i < sourceVertexCount; i++) {
+		uniqueVertices[remap[i]] = packedVertices[i];
+	}
+
+	std::vector<uint32_t> indices;
+	indices.reserve(source.indices.size());
+
+	for (size_t i = 0; i + 2 < source.indices.size(); i += 3) {
+		uint32_t a = remap[source.indices[i]];
+		uint32_t b = remap[source.indices[i + 1]];
+		uint32_t c = remap[source.indices[i + 2]];
+
+		if (a != b && b != c && a != c) {
+			indices.insert(indices.end(), { a, b, c });
+		}
+	}
+
+	if (indices.empty()) {
+		log_error("Mesh has no triangles left after welding!");
+	}
+
+	MeshOptimizer::optimizeVertexCache(indices, uniqueCount);
+
+	std::vector<glm::vec3> positions(uniqueCount);
+
+	for (uint32_t i = 0; i < uniqueCount; i++) {
+		const VertexPacking::unorm16x4& position = uniqueVertices[i].position;
+
+		positions[i] = boundsMin + glm::vec3(position.x, position.y, position.z) / 65535.0f * extent;
+	}
+
+	MeshOptimizer::optimizeOverdraw(indices, positions);
+
+	uint32_t vertexCount = MeshOptimizer::optimizeVertexFetch(indices, uniqueCount, remap);
+
+	mesh.vertices.resize(vertexCount);
+
+	for (uint32_t i = 0; i < uniqueCount; i++) {
+		if (remap[i] != UINT32_MAX) {
+			mesh.vertices[remap[i]] = uniqueVertices[i];
+		}
+	}
+
+	mesh.indices = std::move(indices);
+
+	MeshFormat::header& header = mesh.header;
+	header.vertexCount = vertexCount;
+	header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+	header.indexSize = vertexCount <= 65536 ? sizeof(uint16_t) : sizeof(uint32_t);
+	header.vertexOffset = MeshFormat::align(sizeof(MeshFormat::header));
+	header.indexOffset = MeshFormat::align(header.vertexOffset + static_cast<uint64_t>(vertexCount) * sizeof(MeshFormat::vertex));
+	header.fileSize = MeshFormat::align(header.indexOffset + static_cast<uint64_t>(header.indexCount) * header.indexSize);
+	header.positionOffset = glm::vec4(boundsMin, 0.0f);
+	header.positionScale = glm::vec4(extent, 0.0f);
+
+	stats.vertices = vertexCount;
+	stats.triangles = header.indexCount / 3;
+	stats.cookedBytes = header.fileSize;
+	stats.cookedCache = MeshOptimizer::analyzeVertexCache(mesh.indices, vertexCount);
+
+	return mesh;
+}
+
+std::vector<char> MeshCooker::serialize(const cookedMesh& mesh) {
+	const MeshFormat::header& header = mesh.header;
+
+	std::vector<char> data(header.fileSize, 0);
+
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + header.vertexOffset, mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshFormat::vertex));
+
+	if (header.indexSize == sizeof(uint16_t)) {
+		uint16_t* indices = reinterpret_cast<uint16_t*>(data.data() + header.indexOffset);
+
+		for (size_t i = 0; i < mesh.indices.size(); i++) {
+			indices[i] = static_cast<uint16_t>(mesh.indices[i]);
+		}
+	}
+	else {
+		std::memcpy(data.data() + header.indexOffset, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+	}
+
+	return data;
+}
+
+void MeshCooker::write(const cookedMesh& mesh, const std::string& path) {
+	std::vector<char> data = serialize(mesh);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open()) {
+		log_error("Failed to open cooked mesh for writing: " + path);
+	}
+
+	file.write(data.data(), data.size());
+
+	if (!file) {
+		log_error("Failed to write cooked mesh: " + path);
+	}
+}
\ No newline at end of file
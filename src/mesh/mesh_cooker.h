@@ -0,0 +1,38 @@
+#pragma once
+#define mesh_cooker_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mesh_format.h"
+#include "mesh_importer.h"
+#include "mesh_optimizer.h"
+
+class MeshCooker {
+	public:
+		struct statistics {
+			uint32_t sourceVertices = 0;
+			uint32_t sourceTriangles = 0;
+			uint32_t vertices = 0;
+			uint32_t triangles = 0;
+			MeshOptimizer::cacheStatistics sourceCache;
+			MeshOptimizer::cacheStatistics cookedCache;
+			uint64_t sourceBytes = 0;
+			uint64_t cookedBytes = 0;
+		};
+
+		struct cookedMesh {
+			MeshFormat::header header;
+			std::vector<MeshFormat::vertex> vertices;
+			std::vector<uint32_t> indices;
+			statistics stats;
+		};
+
+		static cookedMesh cook(const MeshImporter::sourceMesh& source);
+		static std::vector<char> serialize(const cookedMesh& mesh);
+		static void write(const cookedMesh& mesh, const std::string& path);
+	private:
+		static void generateNormals(std::vector<MeshImporter::sourceVertex>& vertices, const std::vector<uint32_t>& indices);
+		static MeshFormat::vertex quantize(const MeshImporter::sourceVertex& vertex, const glm::vec3& offset, const glm::vec3& inverseScale);
+};
\ No newline at end of file
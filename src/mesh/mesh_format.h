@@ -0,0 +1,43 @@
+#pragma once
+#define mesh_format_h
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "../renderer/vertex_layout.h"
+
+class MeshFormat {
+	public:
+		static constexpr uint32_t MAGIC = 0x4853454D;
+		static constexpr uint32_t VERSION = 1;
+		static constexpr uint32_t ALIGNMENT = 16;
+
+		struct vertex {
+			VertexPacking::unorm16x4 position;
+			VertexPacking::snorm1010102 normal;
+			VertexPacking::half2 uv;
+		};
+
+		typedef VertexLayout<vertex, VERTEX_FIELD(vertex, position), VERTEX_FIELD(vertex, normal), VERTEX_FIELD(vertex, uv)> vertexLayout;
+
+		struct header {
+			uint32_t magic = MAGIC;
+			uint32_t version = VERSION;
+			uint32_t vertexCount = 0;
+			uint32_t indexCount = 0;
+			uint32_t vertexStride = sizeof(vertex);
+			uint32_t indexSize = sizeof(uint16_t);
+			uint64_t vertexOffset = 0;
+			uint64_t indexOffset = 0;
+			uint64_t fileSize = 0;
+			glm::vec4 positionOffset{};
+			glm::vec4 positionScale{};
+		};
+
+		static_assert(sizeof(header) % ALIGNMENT == 0, "Mesh header must keep the vertex data aligned");
+
+		static constexpr uint64_t align(uint64_t value) {
+			return (value + ALIGNMENT - 1) & ~static_cast<uint64_t>(ALIGNMENT - 1);
+		}
+};
\ No newline at end of file
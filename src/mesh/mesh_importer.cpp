@@ -0,0 +1,776 @@
+#include "mesh_importer.h"
+#include "../logger/logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+std::vector<char> MeshImporter::readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::ate | std::ios::binary);
+
+	if (!file.is_open()) {
+		log_error("Failed to open mesh source: " + path);
+	}
+
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	std::vector<char> buffer(fileSize);
+
+	file.seekg(0);
+	file.read(buffer.data(), fileSize);
+
+	return buffer;
+}
+
+MeshImporter::sourceMesh MeshImporter::importFile(const std::string& path) {
+	std::filesystem::path filePath(path);
+	std::string extension = filePath.extension().string();
+
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char character) {
+		return static_cast<char>(std::tolower(character));
+	});
+
+	if (extension == ".obj") {
+		return importObj(readFile(path));
+	}
+
+	if (extension == ".gltf" || extension == ".glb") {
+		return importGltf(readFile(path), filePath.parent_path().string());
+	}
+
+	log_error("Unsupported mesh source format: " + path);
+}
+
+MeshImporter::sourceMesh MeshImporter::importObj(const std::vector<char>& text) {
+	sourceMesh mesh;
+
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<sourceVertex> face;
+
+	std::string contents(text.begin(), text.end());
+	const char* cursor = contents.c_str();
+
+	auto resolve = [](long index, size_t count) {
+		long resolved = index < 0 ? static_cast<long>(count) + index : index - 1;
+
+		if (resolved < 0 || resolved >= static_cast<long>(count)) {
+			log_error("OBJ face references a missing element!");
+		}
+
+		return static_cast<size_t>(resolved);
+	};
+
+	while (*cursor != '\0') {
+		while (*cursor == ' ' || *cursor == '\t') {
+			cursor++;
+		}
+
+		if (cursor[0] == 'v' && cursor[1] == ' ') {
+			char* next = const_cast<char*>(cursor + 2);
+			glm::vec3 position;
+
+			for (uint32_t i = 0; i < 3; i++) {
+				position[i] = std::strtof(next, &next);
+			}
+
+			positions.push_back(position);
+			cursor = next;
+		}
+		else if (cursor[0] == 'v' && cursor[1] == 'n' && cursor[2] == ' ') {
+			char* next = const_cast<char*>(cursor + 3);
+			glm::vec3 normal;
+
+			for (uint32_t i = 0; i < 3; i++) {
+				normal[i] = std::strtof(next, &next);
+			}
+
+			normals.push_back(normal);
+			cursor = next;
+		}
+		else if (cursor[0] == 'v' && cursor[1] == 't' && cursor[2] == ' ') {
+			char* next = const_cast<char*>(cursor + 3);
+			float u = std::strtof(next, &next);
+			float v = std::strtof(next, &next);
+
+			uvs.push_back({ u, 1.0f - v });
+			cursor = next;
+		}
+		else if (cursor[0] == 'f' && cursor[1] == ' ') {
+			cursor += 2;
+			face.clear();
+
+			while (true) {
+				while (*cursor == ' ' || *cursor == '\t') {
+					cursor++;
+				}
+
+				if (*cursor == '\0' || *cursor == '\n' || *cursor == '\r' || *cursor == '#') {
+					break;
+				}
+
+				char* next = const_cast<char*>(cursor);
+				sourceVertex vertex;
+				bool hasNormal = false;
+
+				vertex.position = positions[resolve(std::strtol(cursor, &next, 10), positions.size())];
+
+				if (*next == '/') {
+					next++;
+
+					if (*next != '/') {
+						vertex.uv = uvs[resolve(std::strtol(next, &next, 10), uvs.size())];
+					}
+
+					if (*next == '/') {
+						vertex.normal = normals[resolve(std::strtol(next + 1, &next, 10), normals.size())];
+						hasNormal = true;
+					}
+				}
+
+				if (next == cursor) {
+					log_error("Malformed OBJ face!");
+				}
+
+				mesh.hasNormals = mesh.hasNormals && hasNormal;
+				face.push_back(vertex);
+				cursor = next;
+			}
+
+			for (size_t i = 1; i + 1 < face.size(); i++) {
+				for (size_t corner : { static_cast<size_t>(0), i, i + 1 }) {
+					mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+					mesh.vertices.push_back(face[corner]);
+				}
+			}
+		}
+
+		while (*cursor != '\0' && *cursor != '\n') {
+			cursor++;
+		}
+
+		if (*cursor == '\n') {
+			cursor++;
+		}
+	}
+
+	if (mesh.indices.empty()) {
+		log_error("OBJ file contains no faces!");
+	}
+
+	return mesh;
+}
+
+const MeshImporter::jsonValue* MeshImporter::jsonValue::find(const std::string& key) const {
+	for (const std::pair<std::string, jsonValue>& member : object) {
+		if (member.first == key) {
+			return &member.second;
+		}
+	}
+
+	return nullptr;
+}
+
+double MeshImporter::jsonValue::getNumber(const std::string& key, double fallback) const {
+	const jsonValue* value = find(key);
+
+	return value != nullptr && value->kind == type::number ? value->number : fallback;
+}
+
+void MeshImporter::skipWhitespace(const char*& cursor, const char* end) {
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) {
+		cursor++;
+	}
+}
+
+std::string MeshImporter::parseJsonString(const char*& cursor, const char* end) {
+	if (cursor >= end || *cursor != '"') {
+		log_error("Expected a string in glTF JSON!");
+	}
+
+	cursor++;
+
+	std::string result;
+
+	while (cursor < end && *cursor != '"') {
+		char character = *cursor++;
+
+		if (character != '\\') {
+			result.push_back(character);
+
+			continue;
+		}
+
+		if (cursor >= end) {
+			break;
+		}
+
+		char escape = *cursor++;
+
+		switch (escape) {
+			case 'n':
+				result.push_back('\n');
+				break;
+			case 't':
+				result.push_back('\t');
+				break;
+			case 'r':
+				result.push_back('\r');
+				break;
+			case 'b':
+				result.push_back('\b');
+				break;
+			case 'f':
+				result.push_back('\f');
+				break;
+			case 'u': {
+				if (end - cursor < 4) {
+					log_error("Truncated escape in glTF JSON!");
+				}
+
+				uint32_t codePoint = static_cast<uint32_t>(std::strtoul(std::string(cursor, 4).c_str(), nullptr, 16));
+				cursor += 4;
+
+				if (codePoint < 0x80) {
+					result.push_back(static_cast<char>(codePoint));
+				}
+				else if (codePoint < 0x800) {
+					result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+					result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				else {
+					result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+					result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+					result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+
+				break;
+			}
+			default:
+				result.push_back(escape);
+				break;
+		}
+	}
+
+	if (cursor >= end) {
+		log_error("Unterminated string in glTF JSON!");
+	}
+
+	cursor++;
+
+	return result;
+}
+
+MeshImporter::jsonValue MeshImporter::parseJson(const char*& cursor, const char* end) {
+	skipWhitespace(cursor, end);
+
+	if (cursor >= end) {
+		log_error("Unexpected end of glTF JSON!");
+	}
+
+	jsonValue value;
+
+	if (*cursor == '{' || *cursor == '[') {
+		bool isObject = *cursor == '{';
+		char closing = isObject ? '}' : ']';
+
+		value.kind = isObject ? jsonValue::type::object : jsonValue::type::array;
+		cursor++;
+
+		skipWhitespace(cursor, end);
+
+		if (cursor < end && *cursor == closing) {
+			cursor++;
+
+			return value;
+		}
+
+		while (true) {
+			if (isObject) {
+				skipWhitespace(cursor, end);
+				std::string key = parseJsonString(cursor, end);
+				skipWhitespace(cursor, end);
+
+				if (cursor >= end || *cursor != ':') {
+					log_error("Expected ':' in glTF JSON!");
+				}
+
+				cursor++;
+				value.object.emplace_back(std::move(key), parseJson(cursor, end));
+			}
+			else {
+				value.array.push_back(parseJson(cursor, end));
+			}
+
+			skipWhitespace(cursor, end);
+
+			if (cursor < end && *cursor == ',') {
+				cursor++;
+			}
+			else if (cursor < end && *cursor == closing) {
+				cursor++;
+
+				return value;
+			}
+			else {
+				log_error("Malformed glTF JSON!");
+			}
+		}
+	}
+
+	if (*cursor == '"') {
+		value.kind = jsonValue::type::string;
+		value.string = parseJsonString(cursor, end);
+	}
+	else if (end - cursor >= 4 && std::strncmp(cursor, "true", 4) == 0) {
+		value.kind = jsonValue::type::boolean;
+		value.number = 1.0;
+		cursor += 4;
+	}
+	else if (end - cursor >= 5 && std::strncmp(cursor, "false", 5) == 0) {
+		value.kind = jsonValue::type::boolean;
+		cursor += 5;
+	}
+	else if (end - cursor >= 4 && std::strncmp(cursor, "null", 4) == 0) {
+		cursor += 4;
+	}
+	else {
+		char* next = nullptr;
+		value.kind = jsonValue::type::number;
+		value.number = std::strtod(cursor, &next);
+
+		if (next == cursor) {
+			log_error("Unexpected character in glTF JSON!");
+		}
+
+		cursor = next;
+	}
+
+	return value;
+}
+
+std::vector<char> MeshImporter::decodeBase64(const std::string& text) {
+	auto decode = [](char character) -> int32_t {
+		if (character >= 'A' && character <= 'Z') {
+			return character - 'A';
+		}
+
+		if (character >= 'a' && character <= 'z') {
+			return character - 'a' + 26;
+		}
+
+		if (character >= '0' && character <= '9') {
+			return character - '0' + 52;
+		}
+
+		if (character == '+') {
+			return 62;
+		}
+
+		if (character == '/') {
+			return 63;
+		}
+
+		return -1;
+	};
+
+	std::vector<char> output;
+	output.reserve(text.size() / 4 * 3);
+
+	uint32_t accumulator = 0;
+	uint32_t bits = 0;
+
+	for (char character : text) {
+		int32_t value = decode(character);
+
+		if (value < 0) {
+			continue;
+		}
+
+		accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+		bits += 6;
+
+		if (bits >= 8) {
+			bits -= 8;
+			output.push_back(static_cast<char>((accumulator >> bits) & 0xFF));
+		}
+	}
+
+	return output;
+}
+
+MeshImporter::sourceMesh MeshImporter::importGltf(const std::vector<char>& data, const std::string& directory) {
+	gltfDocument document;
+
+	std::string json;
+	std::vector<char> binaryChunk;
+
+	if (data.size() >= 12 && std::memcmp(data.data(), "glTF", 4) == 0) {
+		uint32_t length;
+		std::memcpy(&length, data.data() + 8, sizeof(length));
+
+		size_t end = std::min<size_t>(length, data.size());
+		size_t offset = 12;
+
+		while (offset + 8 <= end) {
+			uint32_t chunkLength;
+			uint32_t chunkType;
+			std::memcpy(&chunkLength, data.data() + offset, sizeof(chunkLength));
+			std::memcpy(&chunkType, data.data() + offset + 4, sizeof(chunkType));
+
+			if (offset + 8 + chunkLength > end) {
+				log_error("Truncated GLB chunk!");
+			}
+
+			const char* chunk = data.data() + offset + 8;
+
+			if (chunkType == 0x4E4F534A) {
+				json.assign(chunk, chunkLength);
+			}
+			else if (chunkType == 0x004E4942) {
+				binaryChunk.assign(chunk, chunk + chunkLength);
+			}
+
+			offset += 8 + chunkLength;
+		}
+	}
+	else {
+		json.assign(data.begin(), data.end());
+	}
+
+	const char* cursor = json.c_str();
+	document.root = parseJson(cursor, cursor + json.size());
+
+	loadGltfBuffers(document, binaryChunk, directory);
+
+	sourceMesh mesh;
+
+	const jsonValue* scenes = document.root.find("scenes");
+
+	if (scenes != nullptr && !scenes->array.empty()) {
+		uint32_t scene = static_cast<uint32_t>(document.root.getNumber("scene", 0.0));
+		const jsonValue* nodes = getGltfElement(document, "scenes", scene).find("nodes");
+
+		if (nodes != nullptr) {
+			for (const jsonValue& node : nodes->array) {
+				importGltfNode(document, static_cast<uint32_t>(node.number), glm::mat4(1.0f), 0, mesh);
+			}
+		}
+	}
+	else if (const jsonValue* meshes = document.root.find("meshes")) {
+		for (const jsonValue& meshValue : meshes->array) {
+			if (const jsonValue* primitives = meshValue.find("primitives")) {
+				for (const jsonValue& primitive : primitives->array) {
+					importGltfPrimitive(document, primitive, glm::mat4(1.0f), mesh);
+				}
+			}
+		}
+	}
+
+	if (mesh.indices.empty()) {
+		log_error("glTF file contains no triangle meshes!");
+	}
+
+	return mesh;
+}
+
+void MeshImporter::loadGltfBuffers(gltfDocument& document, const std::vector<char>& binaryChunk, const std::string& directory) {
+	const jsonValue* buffers = document.root.find("buffers");
+
+	if (buffers == nullptr) {
+		return;
+	}
+
+	for (const jsonValue& buffer : buffers->array) {
+		const jsonValue* uri = buffer.find("uri");
+
+		if (uri == nullptr) {
+			document.buffers.push_back(binaryChunk);
+		}
+		else if (uri->string.rfind("data:", 0) == 0) {
+			size_t comma = uri->string.find(',');
+
+			if (comma == std::string::npos || uri->string.find(";base64") > comma) {
+				log_error("Unsupported glTF data URI!");
+			}
+
+			document.buffers.push_back(decodeBase64(uri->string.substr(comma + 1)));
+		}
+		else {
+			document.buffers.push_back(readFile((std::filesystem::path(directory) / uri->string).string()));
+		}
+
+		if (document.buffers.back().size() < static_cast<size_t>(buffer.getNumber("byteLength", 0.0))) {
+			log_error("glTF buffer is smaller than its declared length!");
+		}
+	}
+}
+
+const MeshImporter::jsonValue& MeshImporter::getGltfElement(const gltfDocument& document, const std::string& collection, uint32_t index) {
+	const jsonValue* elements = document.root.find(collection);
+
+	if (elements == nullptr || index >= elements->array.size()) {
+		log_error("glTF references a missing element in " + collection + "!");
+	}
+
+	return elements->array[index];
+}
+
+void MeshImporter::importGltfNode(const gltfDocument& document, uint32_t node, const glm::mat4& parentTransform, uint32_t depth, sourceMesh& mesh) {
+	if (depth > 64) {
+		log_error("glTF node hierarchy is too deep!");
+	}
+
+	const jsonValue& nodeValue = getGltfElement(document, "nodes", node);
+
+	glm::mat4 local(1.0f);
+
+	if (const jsonValue* matrix = nodeValue.find("matrix")) {
+		for (uint32_t i = 0; i < 16 && i < matrix->array.size(); i++) {
+			local[i / 4][i % 4] = static_cast<float>(matrix->array[i].number);
+		}
+	}
+	else {
+		glm::vec3 translation(0.0f);
+		glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::vec3 scale(1.0f);
+
+		if (const jsonValue* value = nodeValue.find("translation"); value != nullptr && value->array.size() == 3) {
+			translation = { value->array[0].number, value->array[1].number, value->array[2].number };
+		}
+
+		if (const jsonValue* value = nodeValue.find("rotation"); value != nullptr && value->array.size() == 4) {
+			rotation = glm::quat(static_cast<float>(value->array[3].number), static_cast<float>(value->array[0].number), static_cast<float>(value->array[1].number), static_cast<float>(value->array[2].number));
+		}
+
+		if (const jsonValue* value = nodeValue.find("scale"); value != nullptr && value->array.size() == 3) {
+			scale = { value->array[0].number, value->array[1].number, value->array[2].number };
+		}
+
+		local = glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+	}
+
+	glm::mat4 transform = parentTransform * local;
+
+	if (const jsonValue* meshIndex = nodeValue.find("mesh")) {
+		if (const jsonValue* primitives = getGltfElement(document, "meshes", static_cast<uint32_t>(meshIndex->number)).find("primitives")) {
+			for (const jsonValue& primitive : primitives->array) {
+				importGltfPrimitive(document, primitive, transform, mesh);
+			}
+		}
+	}
+
+	if (const jsonValue* children = nodeValue.find("children")) {
+		for (const jsonValue& child : children->array) {
+			importGltfNode(document, static_cast<uint32_t>(child.number), transform, depth + 1, mesh);
+		}
+	}
+}
+
+void MeshImporter::importGltfPrimitive(const gltfDocument& document, const jsonValue& primitive, const glm::mat4& transform, sourceMesh& mesh) {
+	if (primitive.getNumber("mode", 4.0) != 4.0) {
+		log_warning("Skipping non-triangle glTF primitive!");
+
+		return;
+	}
+
+	const jsonValue* attributes = primitive.find("attributes");
+	const jsonValue* position = attributes != nullptr ? attributes->find("POSITION") : nullptr;
+
+	if (position == nullptr) {
+		log_warning("Skipping glTF primitive without positions!");
+
+		return;
+	}
+
+	uint32_t componentCount = 0;
+	std::vector<float> positions = readGltfAccessor(document, static_cast<uint32_t>(position->number), componentCount);
+
+	if (componentCount != 3) {
+		log_error("glTF positions must be VEC3!");
+	}
+
+	const uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3);
+
+	std::vector<float> normals;
+	std::vector<float> uvs;
+
+	if (const jsonValue* normal = attributes->find("NORMAL")) {
+		normals = readGltfAccessor(document, static_cast<uint32_t>(normal->number), componentCount);
+
+		if (componentCount != 3 || normals.size() != positions.size()) {
+			log_error("glTF normals do not match the positions!");
+		}
+	}
+	else {
+		mesh.hasNormals = false;
+	}
+
+	if (const jsonValue* uv = attributes->find("TEXCOORD_0")) {
+		uvs = readGltfAccessor(document, static_cast<uint32_t>(uv->number), componentCount);
+
+		if (componentCount != 2 || uvs.size() / 2 != vertexCount) {
+			log_error("glTF texture coordinates do not match the positions!");
+		}
+	}
+
+	glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+	uint32_t baseVertex = static_cast<uint32_t>(mesh.vertices.size());
+
+	for (uint32_t i = 0; i < vertexCount; i++) {
+		sourceVertex vertex;
+		vertex.position = glm::vec3(transform * glm::vec4(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], 1.0f));
+
+		if (!normals.empty()) {
+			glm::vec3 normal = normalTransform * glm::vec3(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]);
+			float length = glm::length(normal);
+
+			vertex.normal = length > 0.0f ? normal / length : normal;
+		}
+
+		if (!uvs.empty()) {
+			vertex.uv = { uvs[i * 2], uvs[i * 2 + 1] };
+		}
+
+		mesh.vertices.push_back(vertex);
+	}
+
+	std::vector<uint32_t> indices;
+
+	if (const jsonValue* indexAccessor = primitive.find("indices")) {
+		indices = readGltfIndices(document, static_cast<uint32_t>(indexAccessor->number));
+	}
+	else {
+		indices.resize(vertexCount);
+
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			indices[i] = i;
+		}
+	}
+
+	indices.resize(indices.size() / 3 * 3);
+
+	bool flipWinding = glm::determinant(glm::mat3(transform)) < 0.0f;
+
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) {
+			log_error("glTF index out of range!");
+		}
+
+		mesh.indices.push_back(baseVertex + indices[i]);
+		mesh.indices.push_back(baseVertex + indices[flipWinding ? i + 2 : i + 1]);
+		mesh.indices.push_back(baseVertex + indices[flipWinding ? i + 1 : i + 2]);
+	}
+}
+
+const uint8_t* MeshImporter::getGltfAccessorData(const gltfDocument& document, const jsonValue& accessor, uint32_t elementSize, uint32_t& stride, uint32_t& count) {
+	const jsonValue* bufferViewIndex = accessor.find("bufferView");
+
+	if (bufferViewIndex == nullptr || accessor.find("sparse") != nullptr) {
+		log_error("Sparse and empty glTF accessors are not supported!");
+	}
+
+	const jsonValue& bufferView = getGltfElement(document, "bufferViews", static_cast<uint32_t>(bufferViewIndex->number));
+
+	uint32_t buffer = static_cast<uint32_t>(bufferView.getNumber("buffer", 0.0));
+	size_t offset = static_cast<size_t>(bufferView.getNumber("byteOffset", 0.0) + accessor.getNumber("byteOffset", 0.0));
+
+	stride = static_cast<uint32_t>(bufferView.getNumber("byteStride", elementSize));
+	count = static_cast<uint32_t>(accessor.getNumber("count", 0.0));
+
+	if (buffer >= document.buffers.size()) {
+		log_error("glTF buffer view references a missing buffer!");
+	}
+
+	if (count != 0 && offset + static_cast<size_t>(count - 1) * stride + elementSize > document.buffers[buffer].size()) {
+		log_error("glTF accessor reads past the end of its buffer!");
+	}
+
+	return reinterpret_cast<const uint8_t*>(document.buffers[buffer].data()) + offset;
+}
+
+std::vector<float> MeshImporter::readGltfAccessor(const gltfDocument& document, uint32_t accessor, uint32_t& componentCount) {
+	const jsonValue& accessorValue = getGltfElement(document, "accessors", accessor);
+	const jsonValue* type = accessorValue.find("type");
+
+	const std::string typeName = type != nullptr ? type->string : "";
+	componentCount = typeName == "SCALAR" ? 1 : typeName == "VEC2" ? 2 : typeName == "VEC3" ? 3 : typeName == "VEC4" ? 4 : 0;
+
+	uint32_t componentType = static_cast<uint32_t>(accessorValue.getNumber("componentType", 0.0));
+	uint32_t componentSize = componentType == 5126 ? 4 : componentType == 5123 ? 2 : componentType == 5121 ? 1 : 0;
+
+	if (componentCount == 0 || componentSize == 0) {
+		log_error("Unsupported glTF accessor format!");
+	}
+
+	const jsonValue* normalized = accessorValue.find("normalized");
+	bool isNormalized = normalized != nullptr && normalized->number != 0.0;
+
+	uint32_t stride;
+	uint32_t count;
+	const uint8_t* data = getGltfAccessorData(document, accessorValue, componentSize * componentCount, stride, count);
+
+	std::vector<float> values(static_cast<size_t>(count) * componentCount);
+
+	for (uint32_t i = 0; i < count; i++) {
+		for (uint32_t component = 0; component < componentCount; component++) {
+			const uint8_t* element = data + static_cast<size_t>(i) * stride + component * componentSize;
+			float& value = values[static_cast<size_t>(i) * componentCount + component];
+
+			if (componentType == 5126) {
+				std::memcpy(&value, element, sizeof(float));
+			}
+			else if (componentType == 5123) {
+				uint16_t integer;
+				std::memcpy(&integer, element, sizeof(integer));
+				value = isNormalized ? static_cast<float>(integer) / 65535.0f : static_cast<float>(integer);
+			}
+			else {
+				value = isNormalized ? static_cast<float>(*element) / 255.0f : static_cast<float>(*element);
+			}
+		}
+	}
+
+	return values;
+}
+
+std::vector<uint32_t> MeshImporter::readGltfIndices(const gltfDocument& document, uint32_t accessor) {
+	const jsonValue& accessorValue = getGltfElement(document, "accessors", accessor);
+
+	uint32_t componentType = static_cast<uint32_t>(accessorValue.getNumber("componentType", 0.0));
+	uint32_t componentSize = componentType == 5125 ? 4 : componentType == 5123 ? 2 : componentType == 5121 ? 1 : 0;
+
+	if (componentSize == 0) {
+		log_error("Unsupported glTF index format!");
+	}
+
+	uint32_t stride;
+	uint32_t count;
+	const uint8_t* data = getGltfAccessorData(document, accessorValue, componentSize, stride, count);
+
+	std::vector<uint32_t> indices(count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t* element = data + static_cast<size_t>(i) * stride;
+
+		if (componentSize == 4) {
+			std::memcpy(&indices[i], element, sizeof(uint32_t));
+		}
+		else if (componentSize == 2) {
+			uint16_t index;
+			std::memcpy(&index, element, sizeof(index));
+			indices[i] = index;
+		}
+		else {
+			indices[i] = *element;
+		}
+	}
+
+	return indices;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#define mesh_importer_h
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class MeshImporter {
+	public:
+		struct sourceVertex {
+			glm::vec3 position{};
+			glm::vec3 normal{};
+			glm::vec2 uv{};
+		};
+
+		struct sourceMesh {
+			std::vector<sourceVertex> vertices;
+			std::vector<uint32_t> indices;
+			bool hasNormals = true;
+		};
+
+		static sourceMesh importFile(const std::string& path);
+		static sourceMesh importObj(const std::vector<char>& text);
+		static sourceMesh importGltf(const std::vector<char>& data, const std::string& directory);
+	private:
+		struct jsonValue {
+			enum class type : uint8_t {
+				null,
+				boolean,
+				number,
+				string,
+				array,
+				object
+			};
+
+			type kind = type::null;
+			double number = 0.0;
+			std::string string;
+			std::vector<jsonValue> array;
+			std::vector<std::pair<std::string, jsonValue>> object;
+
+			const jsonValue* find(const std::string& key) const;
+			double getNumber(const std::string& key, double fallback) const;
+		};
+
+		struct gltfDocument {
+			jsonValue root;
+			std::vector<std::vector<char>> buffers;
+		};
+
+		static std::vector<char> readFile(const std::string& path);
+
+		static jsonValue parseJson(const char*& cursor, const char* end);
+		static std::string parseJsonString(const char*& cursor, const char* end);
+		static void skipWhitespace(const char*& cursor, const char* end);
+		static std::vector<char> decodeBase64(const std::string& text);
+
+		static void loadGltfBuffers(gltfDocument& document, const std::vector<char>& binaryChunk, const std::string& directory);
+		static const jsonValue& getGltfElement(const gltfDocument& document, const std::string& collection, uint32_t index);
+		static void importGltfNode(const gltfDocument& document, uint32_t node, const glm::mat4& parentTransform, uint32_t depth, sourceMesh& mesh);
+		static void importGltfPrimitive(const gltfDocument& document, const jsonValue& primitive, const glm::mat4& transform, sourceMesh& mesh);
+		static std::vector<float> readGltfAccessor(const gltfDocument& document, uint32_t accessor, uint32_t& componentCount);
+		static std::vector<uint32_t> readGltfIndices(const gltfDocument& document, uint32_t accessor);
+		static const uint8_t* getGltfAccessorData(const gltfDocument& document, const jsonValue& accessor, uint32_t elementSize, uint32_t& stride, uint32_t& count);
+};
\ No newline at end of file
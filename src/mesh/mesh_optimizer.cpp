@@ -0,0 +1,336 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+uint64_t MeshOptimizer::hashVertex(const uint8_t* vertex, size_t vertexSize) {
+	uint64_t hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < vertexSize; i++) {
+		hash ^= vertex[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+uint32_t MeshOptimizer::generateRemap(const void* vertices, size_t vertexCount, size_t vertexSize, std::vector<uint32_t>& remap) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+
+	size_t tableSize = 2;
+
+	while (tableSize < vertexCount * 2) {
+		tableSize <<= 1;
+	}
+
+	std::vector<uint32_t> table(tableSize, UINT32_MAX);
+	remap.assign(vertexCount, 0);
+
+	uint32_t uniqueCount = 0;
+
+	for (size_t i = 0; i < vertexCount; i++) {
+		const uint8_t* vertex = bytes + i * vertexSize;
+		size_t slot = hashVertex(vertex, vertexSize) & (tableSize - 1);
+
+		while (table[slot] != UINT32_MAX && std::memcmp(bytes + static_cast<size_t>(table[slot]) * vertexSize, vertex, vertexSize) != 0) {
+			slot = (slot + 1) & (tableSize - 1);
+		}
+
+		if (table[slot] == UINT32_MAX) {
+			table[slot] = static_cast<uint32_t>(i);
+			remap[i] = uniqueCount++;
+		}
+		else {
+			remap[i] = remap[table[slot]];
+		}
+	}
+
+	return uniqueCount;
+}
+
+void MeshOptimizer::remapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap) {
+	for (uint32_t& index : indices) {
+		index = remap[index];
+	}
+}
+
+float MeshOptimizer::getVertexScore(int32_t cachePosition, uint32_t remainingTriangles) {
+	if (remainingTriangles == 0) {
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+
+	if (cachePosition >= 0) {
+		score = cachePosition < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(CACHE_SIZE - 3), 1.5f);
+	}
+
+	return score + 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount) {
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	if (triangleCount == 0) {
+		return;
+	}
+
+	std::vector<uint32_t> triangleOffsets(vertexCount + 1, 0);
+
+	for (uint32_t index : indices) {
+		triangleOffsets[index + 1]++;
+	}
+
+	std::vector<uint32_t> remaining(vertexCount);
+
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		remaining[vertex] = triangleOffsets[vertex + 1];
+		triangleOffsets[vertex + 1] += triangleOffsets[vertex];
+	}
+
+	std::vector<uint32_t> vertexTriangles(indices.size());
+	std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		for (uint32_t corner = 0; corner < 3; corner++) {
+			vertexTriangles[fill[indices[triangle * 3 + corner]]++] = triangle;
+		}
+	}
+
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		vertexScores[vertex] = getVertexScore(-1, remaining[vertex]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<uint8_t> emitted(triangleCount, 0);
+
+	uint32_t bestTriangle = 0;
+
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		const uint32_t* corners = &indices[triangle * 3];
+		triangleScores[triangle] = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+
+		if (triangleScores[triangle] > triangleScores[bestTriangle]) {
+			bestTriangle = triangle;
+		}
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	std::array<uint32_t, CACHE_SIZE + 3> cache{};
+	std::array<uint32_t, CACHE_SIZE + 3> nextCache{};
+	uint32_t cacheCount = 0;
+	uint32_t cursor = 0;
+
+	for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+		if (bestTriangle == UINT32_MAX) {
+			while (emitted[cursor]) {
+				cursor++;
+			}
+
+			bestTriangle = cursor;
+		}
+
+		const uint32_t corners[3] = { indices[bestTriangle * 3], indices[bestTriangle * 3 + 1], indices[bestTriangle * 3 + 2] };
+
+		emitted[bestTriangle] = 1;
+		output.insert(output.end(), corners, corners + 3);
+
+		uint32_t nextCount = 0;
+
+		for (uint32_t vertex : corners) {
+			uint32_t* first = &vertexTriangles[triangleOffsets[vertex]];
+			uint32_t* last = first + remaining[vertex];
+			uint32_t* found = std::find(first, last, bestTriangle);
+
+			if (found != last) {
+				*found = *(last - 1);
+				remaining[vertex]--;
+			}
+
+			if (std::find(nextCache.begin(), nextCache.begin() + nextCount, vertex) == nextCache.begin() + nextCount) {
+				nextCache[nextCount++] = vertex;
+			}
+		}
+
+		for (uint32_t i = 0; i < cacheCount; i++) {
+			uint32_t vertex = cache[i];
+
+			if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+				nextCache[nextCount++] = vertex;
+			}
+		}
+
+		for (uint32_t i = 0; i < nextCount; i++) {
+			uint32_t vertex = nextCache[i];
+
+			cachePositions[vertex] = i < CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+
+			float score = getVertexScore(cachePositions[vertex], remaining[vertex]);
+			float delta = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			for (uint32_t j = 0; j < remaining[vertex]; j++) {
+				triangleScores[vertexTriangles[triangleOffsets[vertex] + j]] += delta;
+			}
+		}
+
+		cache.swap(nextCache);
+		cacheCount = std::min(nextCount, CACHE_SIZE);
+
+		bestTriangle = UINT32_MAX;
+		float bestScore = 0.0f;
+
+		for (uint32_t i = 0; i < cacheCount; i++) {
+			uint32_t vertex = cache[i];
+
+			for (uint32_t j = 0; j < remaining[vertex]; j++) {
+				uint32_t triangle = vertexTriangles[triangleOffsets[vertex] + j];
+
+				if (triangleScores[triangle] > bestScore) {
+					bestScore = triangleScores[triangle];
+					bestTriangle = triangle;
+				}
+			}
+		}
+	}
+
+	indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions) {
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	if (triangleCount < 2) {
+		return;
+	}
+
+	std::vector<uint32_t> clusterStarts;
+	std::vector<uint32_t> timestamps(positions.size(), 0);
+	uint32_t time = ANALYSIS_CACHE_SIZE + 1;
+
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		uint32_t misses = 0;
+
+		for (uint32_t corner = 0; corner < 3; corner++) {
+			uint32_t vertex = indices[triangle * 3 + corner];
+
+			if (time - timestamps[vertex] > ANALYSIS_CACHE_SIZE) {
+				timestamps[vertex] = time++;
+				misses++;
+			}
+		}
+
+		if (triangle == 0 || misses == 3) {
+			clusterStarts.push_back(triangle);
+		}
+	}
+
+	const uint32_t clusterCount = static_cast<uint32_t>(clusterStarts.size());
+
+	if (clusterCount < 2) {
+		return;
+	}
+
+	clusterStarts.push_back(triangleCount);
+
+	std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+	std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+
+	for (uint32_t cluster = 0; cluster < clusterCount; cluster++) {
+		float clusterArea = 0.0f;
+
+		for (uint32_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; triangle++) {
+			const glm::vec3& a = positions[indices[triangle * 3]];
+			const glm::vec3& b = positions[indices[triangle * 3 + 1]];
+			const glm::vec3& c = positions[indices[triangle * 3 + 2]];
+
+			glm::vec3 normal = glm::cross(b - a, c - a);
+			float area = glm::length(normal);
+
+			clusterCentroids[cluster] += (a + b + c) * (area / 3.0f);
+			clusterNormals[cluster] += normal;
+			clusterArea += area;
+		}
+
+		meshCentroid += clusterCentroids[cluster];
+		meshArea += clusterArea;
+
+		clusterCentroids[cluster] /= std::max(clusterArea, 1e-20f);
+	}
+
+	meshCentroid /= std::max(meshArea, 1e-20f);
+
+	std::vector<float> clusterKeys(clusterCount);
+
+	for (uint32_t cluster = 0; cluster < clusterCount; cluster++) {
+		float length = glm::length(clusterNormals[cluster]);
+		glm::vec3 normal = length > 0.0f ? clusterNormals[cluster] / length : glm::vec3(0.0f);
+
+		clusterKeys[cluster] = glm::dot(clusterCentroids[cluster] - meshCentroid, normal);
+	}
+
+	std::vector<uint32_t> clusterOrder(clusterCount);
+	std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterKeys](uint32_t first, uint32_t second) {
+		return clusterKeys[first] > clusterKeys[second];
+	});
+
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	for (uint32_t cluster : clusterOrder) {
+		output.insert(output.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+	}
+
+	indices.swap(output);
+}
+
+uint32_t MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& remap) {
+	remap.assign(vertexCount, UINT32_MAX);
+
+	uint32_t nextVertex = 0;
+
+	for (uint32_t& index : indices) {
+		if (remap[index] == UINT32_MAX) {
+			remap[index] = nextVertex++;
+		}
+
+		index = remap[index];
+	}
+
+	return nextVertex;
+}
+
+MeshOptimizer::cacheStatistics MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+	cacheStatistics statistics;
+
+	if (indices.empty() || vertexCount == 0) {
+		return statistics;
+	}
+
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+
+	for (uint32_t index : indices) {
+		if (time - timestamps[index] > cacheSize) {
+			timestamps[index] = time++;
+			statistics.vertexInvocations++;
+		}
+	}
+
+	statistics.acmr = static_cast<float>(statistics.vertexInvocations) / static_cast<float>(indices.size() / 3);
+	statistics.atvr = static_cast<float>(statistics.vertexInvocations) / static_cast<float>(vertexCount);
+
+	return statistics;
+}
\ No newline at end of file
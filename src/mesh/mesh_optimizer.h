@@ -0,0 +1,31 @@
+#pragma once
+#define mesh_optimizer_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class MeshOptimizer {
+	public:
+		static constexpr uint32_t CACHE_SIZE = 32;
+		static constexpr uint32_t ANALYSIS_CACHE_SIZE = 16;
+
+		struct cacheStatistics {
+			uint32_t vertexInvocations = 0;
+			float acmr = 0.0f;
+			float atvr = 0.0f;
+		};
+
+		static uint32_t generateRemap(const void* vertices, size_t vertexCount, size_t vertexSize, std::vector<uint32_t>& remap);
+		static void remapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+
+		static void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+		static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions);
+		static uint32_t optimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& remap);
+
+		static cacheStatistics analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = ANALYSIS_CACHE_SIZE);
+	private:
+		static float getVertexScore(int32_t cachePosition, uint32_t remainingTriangles);
+		static uint64_t hashVertex(const uint8_t* vertex, size_t vertexSize);
+};
\ No newline at end of file
@@ -0,0 +1,625 @@
+#include "meshes.h"
+#include "../application/application.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void Meshes::init(Application& application) {
+	log_info("Initializing meshes...");
+
+	this->application = &application;
+
+	if (application.options.meshPaths.empty()) {
+		log_info("No meshes requested!");
+
+		return;
+	}
+
+	createInstanceSets();
+	createMeshPipeline();
+
+	for (size_t i = 0; i < application.options.meshPaths.size(); i++) {
+		const std::string& texturePath = application.options.meshTexturePaths[i];
+
+		loadMesh(application.options.meshPaths[i], texturePath.empty() ? Textures::DEFAULT_TEXTURE : application.textures.loadTexture(texturePath));
+	}
+
+	log_info("Meshes initialized!");
+}
+
+bool Meshes::validateHeader(const MeshFormat::header& header, size_t fileSize) {
+	if (header.magic != MeshFormat::MAGIC || header.version != MeshFormat::VERSION || header.vertexStride != sizeof(MeshFormat::vertex)) {
+		return false;
+	}
+
+	if (header.indexSize != sizeof(uint16_t) && header.indexSize != sizeof(uint32_t)) {
+		return false;
+	}
+
+	if (header.vertexCount == 0 || header.indexCount == 0 || header.indexCount % 3 != 0 || (header.indexSize == sizeof(uint16_t) && header.vertexCount > 65536)) {
+		return false;
+	}
+
+	if (header.vertexOffset < sizeof(MeshFormat::header) || header.vertexOffset % MeshFormat::ALIGNMENT != 0 || header.indexOffset % MeshFormat::ALIGNMENT != 0) {
+		return false;
+	}
+
+	return header.vertexOffset + static_cast<uint64_t>(header.vertexCount) * header.vertexStride <= header.indexOffset
+		&& header.indexOffset + static_cast<uint64_t>(header.indexCount) * header.indexSize <= header.fileSize
+		&& header.fileSize <= fileSize;
+}
+
+Meshes::meshHandle Meshes::loadMesh(const std::string& path, Textures::textureHandle texture) {
+	trace_zone("Meshes::loadMesh");
+
+	auto loadedPath = loadedPaths.find(path);
+
+	if (loadedPath != loadedPaths.end()) {
+		mesh instance = meshes[loadedPath->second];
+		instance.texture = texture;
+
+		log_info("Instancing mesh " + path);
+
+		return addMesh(instance);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	FileSystem::mappedFile file = fileSystem.mapFile(path);
+
+	MeshFormat::header header;
+
+	if (file.size < sizeof(header)) {
+		fileSystem.unmapFile(file);
+
+		log_error("Cooked mesh is truncated: " + path);
+	}
+
+	std::memcpy(&header, file.data, sizeof(header));
+
+	if (!validateHeader(header, file.size)) {
+		fileSystem.unmapFile(file);
+
+		log_error("Invalid cooked mesh: " + path);
+	}
+
+	uint32_t maxIndex = 0;
+	const char* indexData = file.data + header.indexOffset;
+
+	for (uint32_t i = 0; i < header.indexCount; i++) {
+		uint32_t index = 0;
+		std::memcpy(&index, indexData + static_cast<size_t>(i) * header.indexSize, header.indexSize);
+		maxIndex = std::max(maxIndex, index);
+	}
+
+	if (maxIndex >= header.vertexCount) {
+		fileSystem.unmapFile(file);
+
+		log_error("Cooked mesh indexes past its vertices: " + path);
+	}
+
+	VkDevice device = application->renderer.getDevice();
+	VkDeviceSize size = header.fileSize - header.vertexOffset;
+
+	mesh loaded;
+	loaded.geometry = static_cast<uint32_t>(meshes.size());
+	loaded.indexOffset = header.indexOffset - header.vertexOffset;
+	loaded.indexType = header.indexSize == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+	loaded.indexCount = header.indexCount;
+	loaded.positionOffset = glm::vec3(header.positionOffset);
+	loaded.positionScale = glm::vec3(header.positionScale);
+	loaded.texture = texture;
+
+	application->renderer.createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, loaded.buffer, loaded.memory);
+
+	VkBuffer stagingBuffer;
+	VkDeviceMemory stagingBufferMemory;
+	application->renderer.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+
+	void* data;
+	vkMapMemory(device, stagingBufferMemory, 0, size, 0, &data);
+	std::memcpy(data, file.data + header.vertexOffset, size);
+	vkUnmapMemory(device, stagingBufferMemory);
+
+	fileSystem.unmapFile(file);
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+	barrierTracker.trackBuffer(loaded.buffer);
+
+	VkCommandBuffer commandBuffer = application->renderer.beginSingleTimeCommands();
+
+	barrierTracker.accessBuffer(loaded.buffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	VkBufferCopy region{};
+	region.size = size;
+	vkCmdCopyBuffer(commandBuffer, stagingBuffer, loaded.buffer, 1, &region);
+
+	barrierTracker.accessBuffer(loaded.buffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	application->renderer.endSingleTimeCommands(commandBuffer);
+
+	barrierTracker.forgetBuffer(loaded.buffer);
+
+	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	vkFreeMemory(device, stagingBufferMemory, nullptr);
+
+	meshHandle handle = addMesh(loaded);
+	loadedPaths.emplace(path, handle);
+
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	stats.meshes++;
+	stats.vertices += header.vertexCount;
+	stats.triangles += header.indexCount / 3;
+	stats.bytes += size;
+	stats.loadMilliseconds += milliseconds;
+
+	log_info("Loaded mesh " + path + " with " + std::to_string(header.vertexCount) + " vertices and " + std::to_string(header.indexCount / 3) + " triangles in " + std::to_string(milliseconds) + " ms");
+
+	return handle;
+}
+
+Meshes::meshHandle Meshes::addMesh(mesh& added) {
+	glm::vec3 meshMin = added.positionOffset;
+	glm::vec3 meshMax = added.positionOffset + added.positionScale;
+
+	boundsMin = meshes.empty() ? meshMin : glm::min(boundsMin, meshMin);
+	boundsMax = meshes.empty() ? meshMax : glm::max(boundsMax, meshMax);
+
+	added.node = application->scene.createNode();
+	added.object = application->culling.createObject(added.node, meshMin, meshMax);
+
+	if (added.object >= objectMeshes.size()) {
+		objectMeshes.resize(added.object + 1, NO_MESH);
+	}
+
+	objectMeshes[added.object] = static_cast<meshHandle>(meshes.size());
+
+	meshes.push_back(added);
+
+	return static_cast<meshHandle>(meshes.size() - 1);
+}
+
+Meshes::camera Meshes::getCamera(VkExtent2D extent) {
+	glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	float radius = std::max(glm::length(boundsMax - boundsMin) * 0.5f, 1e-6f);
+
+	float aspect = extent.height > 0 ? static_cast<float>(extent.width) / static_cast<float>(extent.height) : 1.0f;
+	float verticalFieldOfView = glm::radians(45.0f);
+	float horizontalFieldOfView = 2.0f * std::atan(std::tan(verticalFieldOfView * 0.5f) * aspect);
+	float distance = radius / std::sin(std::min(verticalFieldOfView, horizontalFieldOfView) * 0.5f);
+
+	glm::vec3 eye = center + glm::normalize(glm::vec3(0.6f, 0.5f, 1.0f)) * distance;
+
+	glm::mat4 viewMatrix = glm::lookAtRH(eye, center, glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 projection = glm::perspectiveRH_ZO(verticalFieldOfView, aspect, std::max(distance - radius, distance * 0.01f), distance + radius);
+	projection[1][1] *= -1.0f;
+
+	camera view{};
+	view.viewProjection = projection * viewMatrix;
+	view.position = eye;
+	view.pixelsPerUnit = static_cast<float>(extent.height) / (2.0f * std::tan(verticalFieldOfView * 0.5f));
+
+	return view;
+}
+
+void Meshes::cull(VkExtent2D extent, std::vector<meshHandle>& visibleMeshes) {
+	visibleMeshes.clear();
+
+	if (meshes.empty()) {
+		return;
+	}
+
+	application->culling.cull(getCamera(extent).viewProjection, visibleObjects);
+
+	for (Culling::objectHandle object : visibleObjects) {
+		visibleMeshes.push_back(objectMeshes[object]);
+	}
+}
+
+void Meshes::writeOcclusionCandidates(VkExtent2D extent, uint32_t frameIndex, const std::vector<meshHandle>& visibleMeshes, std::vector<OcclusionCulling::candidate>& candidates) {
+	trace_zone("Meshes::writeOcclusionCandidates");
+
+	candidates.clear();
+	drawMeshes.clear();
+	drawInstances.clear();
+
+	currentFrame = frameIndex;
+
+	if (visibleMeshes.empty() || application->scene.getInstanceBuffer() == VK_NULL_HANDLE) {
+		return;
+	}
+
+	camera view = getCamera(extent);
+	viewProjection = view.viewProjection;
+
+	Textures& textures = application->textures;
+
+	for (meshHandle visibleMesh : visibleMeshes) {
+		const mesh& current = meshes[visibleMesh];
+		uint32_t instance = application->scene.getRenderInstance(current.node);
+
+		if (instance == Scene::NO_INSTANCE) {
+			continue;
+		}
+
+		glm::mat4 world = application->scene.getRenderMatrix(current.node);
+		glm::mat3 axes = glm::mat3(world);
+		glm::vec3 center = glm::vec3(world * glm::vec4(current.positionOffset + current.positionScale * 0.5f, 1.0f));
+		glm::vec3 halfExtent = (glm::abs(axes[0]) * current.positionScale.x + glm::abs(axes[1]) * current.positionScale.y + glm::abs(axes[2]) * current.positionScale.z) * 0.5f;
+		float radius = glm::length(current.positionScale) * 0.5f;
+		float distance = std::max(glm::distance(view.position, center), radius);
+
+		textures.requestResolution(current.texture, 2.0f * radius / std::max(distance, 1e-6f) * view.pixelsPerUnit);
+
+		OcclusionCulling::candidate candidate;
+		candidate.boundsMin = center - halfExtent;
+		candidate.object = visibleMesh;
+		candidate.boundsMax = center + halfExtent;
+		candidate.indexCount = current.indexCount;
+		candidates.push_back(candidate);
+
+		drawMeshes.push_back(visibleMesh);
+		drawInstances.push_back(instance);
+	}
+
+	writeDrawInstances(drawInstances);
+}
+
+void Meshes::submitDraws(DrawQueue& drawQueue, VkExtent2D extent, uint32_t frameIndex, const std::vector<meshHandle>& visibleMeshes) {
+	trace_zone("Meshes::submitDraws");
+
+	currentFrame = frameIndex;
+
+	if (visibleMeshes.empty() || application->scene.getInstanceBuffer() == VK_NULL_HANDLE) {
+		return;
+	}
+
+	camera view = getCamera(extent);
+	Textures& textures = application->textures;
+	uint32_t pipelineId = drawQueue.getPipelineId(meshPipeline);
+
+	drawConstants.resize(meshes.size());
+
+	for (meshHandle visibleMesh : visibleMeshes) {
+		const mesh& current = meshes[visibleMesh];
+		uint32_t instance = application->scene.getRenderInstance(current.node);
+
+		if (instance == Scene::NO_INSTANCE) {
+			continue;
+		}
+
+		glm::mat4 world = application->scene.getRenderMatrix(current.node);
+		glm::vec3 center = glm::vec3(world * glm::vec4(current.positionOffset + current.positionScale * 0.5f, 1.0f));
+		float radius = glm::length(current.positionScale) * 0.5f;
+		float distance = std::max(glm::distance(view.position, center), radius);
+
+		textures.requestResolution(current.texture, 2.0f * radius / std::max(distance, 1e-6f) * view.pixelsPerUnit);
+
+		meshConstants& constants = drawConstants[current.geometry];
+		constants.viewProjection = view.viewProjection;
+		constants.positionOffset = glm::vec4(current.positionOffset, 0.0f);
+		constants.positionScale = glm::vec4(current.positionScale, 0.0f);
+
+		DrawQueue::drawPacket packet{};
+		packet.pipeline = meshPipeline;
+		packet.pipelineLayout = meshPipelineLayout;
+		packet.materialSet = textures.useTexture(current.texture);
+		packet.instanceSet = frames[currentFrame].descriptorSet;
+		packet.constants = &constants;
+		packet.constantsSize = sizeof(meshConstants);
+		packet.vertexBuffer = current.buffer;
+		packet.indexBuffer = current.buffer;
+		packet.indexBufferOffset = current.indexOffset;
+		packet.indexType = current.indexType;
+		packet.meshId = current.geometry + 1;
+		packet.materialId = current.texture;
+		packet.indexCount = current.indexCount;
+		packet.instance = instance;
+		packet.sortKey = DrawQueue::makeSortKey(DrawQueue::pass::opaque, pipelineId, current.texture, distance);
+
+		drawQueue.submit(packet);
+	}
+}
+
+void Meshes::writeDrawInstances(const std::vector<uint32_t>& instances) {
+	if (instances.empty() || frames.empty()) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+	frameInstances& frame = frames[currentFrame];
+	uint32_t count = static_cast<uint32_t>(instances.size());
+
+	if (count > frame.capacity) {
+		if (frame.buffer != VK_NULL_HANDLE) {
+			vkUnmapMemory(device, frame.memory);
+			vkDestroyBuffer(device, frame.buffer, nullptr);
+			vkFreeMemory(device, frame.memory, nullptr);
+		}
+
+		frame.capacity = std::max(count, frame.capacity * 2);
+
+		application->renderer.createBuffer(static_cast<VkDeviceSize>(frame.capacity) * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, frame.buffer, frame.memory);
+
+		if (vkMapMemory(device, frame.memory, 0, VK_WHOLE_SIZE, 0, &frame.mapped) != VK_SUCCESS) {
+			log_error("Failed to map mesh instance buffer!");
+		}
+	}
+
+	std::memcpy(frame.mapped, instances.data(), static_cast<size_t>(count) * sizeof(uint32_t));
+
+	VkDescriptorBufferInfo bufferInfos[2]{};
+	bufferInfos[0].buffer = application->scene.getInstanceBuffer();
+	bufferInfos[0].offset = 0;
+	bufferInfos[0].range = VK_WHOLE_SIZE;
+	bufferInfos[1].buffer = frame.buffer;
+	bufferInfos[1].offset = 0;
+	bufferInfos[1].range = VK_WHOLE_SIZE;
+
+	VkWriteDescriptorSet descriptorWrites[2]{};
+
+	for (uint32_t i = 0; i < 2; i++) {
+		descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[i].dstSet = frame.descriptorSet;
+		descriptorWrites[i].dstBinding = i;
+		descriptorWrites[i].descriptorCount = 1;
+		descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+	}
+
+	vkUpdateDescriptorSets(device, 2, descriptorWrites, 0, nullptr);
+}
+
+void Meshes::render(VkCommandBuffer commandBuffer, VkBuffer drawBuffer) {
+	if (drawMeshes.empty()) {
+		return;
+	}
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshPipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshPipelineLayout, 1, 1, &frames[currentFrame].descriptorSet, 0, nullptr);
+
+	Textures& textures = application->textures;
+
+	for (size_t i = 0; i < drawMeshes.size(); i++) {
+		const mesh& current = meshes[drawMeshes[i]];
+
+		VkDescriptorSet textureSet = textures.useTexture(current.texture);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshPipelineLayout, 0, 1, &textureSet, 0, nullptr);
+
+		meshConstants constants;
+		constants.viewProjection = viewProjection;
+		constants.positionOffset = glm::vec4(current.positionOffset, 0.0f);
+		constants.positionScale = glm::vec4(current.positionScale, 0.0f);
+
+		vkCmdPushConstants(commandBuffer, meshPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(meshConstants), &constants);
+
+		VkDeviceSize offset = 0;
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &current.buffer, &offset);
+		vkCmdBindIndexBuffer(commandBuffer, current.buffer, current.indexOffset, current.indexType);
+		vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+	}
+}
+
+glm::mat4 Meshes::getViewProjection(VkExtent2D extent) {
+	return getCamera(extent).viewProjection;
+}
+
+bool Meshes::hasMeshes() {
+	return !meshes.empty();
+}
+
+uint32_t Meshes::getMeshCount() {
+	return static_cast<uint32_t>(meshes.size());
+}
+
+Meshes::statistics Meshes::getStatistics() {
+	return stats;
+}
+
+void Meshes::createInstanceSets() {
+	VkDevice device = application->renderer.getDevice();
+
+	VkDescriptorSetLayoutBinding bindings[2]{};
+
+	for (uint32_t i = 0; i < 2; i++) {
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+	layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutCreateInfo.bindingCount = 2;
+	layoutCreateInfo.pBindings = bindings;
+
+	if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &instanceSetLayout) != VK_SUCCESS) {
+		log_error("Failed to create mesh instance descriptor set layout!");
+	}
+
+	frames.resize(application->renderer.getMaxFramesInFlight());
+
+	uint32_t frameCount = static_cast<uint32_t>(frames.size());
+
+	VkDescriptorPoolSize poolSize{};
+	poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSize.descriptorCount = 2 * frameCount;
+
+	VkDescriptorPoolCreateInfo poolCreateInfo{};
+	poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolCreateInfo.maxSets = frameCount;
+	poolCreateInfo.poolSizeCount = 1;
+	poolCreateInfo.pPoolSizes = &poolSize;
+
+	if (vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &instanceDescriptorPool) != VK_SUCCESS) {
+		log_error("Failed to create mesh instance descriptor pool!");
+	}
+
+	std::vector<VkDescriptorSetLayout> setLayouts(frameCount, instanceSetLayout);
+	std::vector<VkDescriptorSet> descriptorSets(frameCount);
+
+	VkDescriptorSetAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = instanceDescriptorPool;
+	allocateInfo.descriptorSetCount = frameCount;
+	allocateInfo.pSetLayouts = setLayouts.data();
+
+	if (vkAllocateDescriptorSets(device, &allocateInfo, descriptorSets.data()) != VK_SUCCESS) {
+		log_error("Failed to allocate mesh instance descriptor sets!");
+	}
+
+	for (uint32_t i = 0; i < frameCount; i++) {
+		frames[i].descriptorSet = descriptorSets[i];
+	}
+}
+
+void Meshes::createMeshPipeline() {
+	log_info("Creating mesh pipeline...");
+
+	Pipelines::pipelineStructure pipelineStructure{};
+
+	pipelineStructure.vertexShaderPath = "src/renderer/shaders/mesh_vert.spv";
+	pipelineStructure.fragmentShaderPath = "src/renderer/shaders/mesh_frag.spv";
+
+	static constexpr VertexInput<VertexBinding<MeshFormat::vertexLayout>> meshInput;
+
+	pipelineStructure.vertexInputStateCreateInfo = meshInput.getCreateInfo();
+
+	pipelineStructure.inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	pipelineStructure.inputAssemblyStateCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	pipelineStructure.inputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+
+	pipelineStructure.rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	pipelineStructure.rasterizationStateCreateInfo.depthClampEnable = VK_FALSE;
+	pipelineStructure.rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
+	pipelineStructure.rasterizationStateCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
+	pipelineStructure.rasterizationStateCreateInfo.lineWidth = 1.0f;
+	pipelineStructure.rasterizationStateCreateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
+	pipelineStructure.rasterizationStateCreateInfo.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	pipelineStructure.rasterizationStateCreateInfo.depthBiasEnable = VK_FALSE;
+	pipelineStructure.rasterizationStateCreateInfo.depthBiasConstantFactor = 0.0f;
+	pipelineStructure.rasterizationStateCreateInfo.depthBiasClamp = 0.0f;
+	pipelineStructure.rasterizationStateCreateInfo.depthBiasSlopeFactor = 0.0f;
+
+	pipelineStructure.multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	pipelineStructure.multisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+	pipelineStructure.multisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+	pipelineStructure.multisampleStateCreateInfo.minSampleShading = 1.0f;
+	pipelineStructure.multisampleStateCreateInfo.pSampleMask = nullptr;
+	pipelineStructure.multisampleStateCreateInfo.alphaToCoverageEnable = VK_FALSE;
+	pipelineStructure.multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
+
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.blendEnable = VK_FALSE;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.colorBlendOp = VK_BLEND_OP_ADD;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.alphaBlendOp = VK_BLEND_OP_ADD;
+
+	pipelineStructure.colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	pipelineStructure.colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+	pipelineStructure.colorBlendStateCreateInfo.logicOp = VK_LOGIC_OP_COPY;
+	pipelineStructure.colorBlendStateCreateInfo.attachmentCount = 1;
+	pipelineStructure.colorBlendStateCreateInfo.pAttachments = &pipelineStructure.colorBlendAttachmentStateCreateInfo;
+
+	static std::vector<VkDynamicState> dynamicStates = {
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR
+	};
+
+	pipelineStructure.dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	pipelineStructure.dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+	pipelineStructure.dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
+
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(meshConstants);
+
+	meshPipelineLayout = application->pipelines.createPipelineLayout({ pushConstantRange }, { application->textures.getDescriptorSetLayout(), instanceSetLayout });
+
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo{};
+	depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencilStateCreateInfo.depthTestEnable = VK_TRUE;
+	depthStencilStateCreateInfo.depthWriteEnable = VK_TRUE;
+	depthStencilStateCreateInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+	depthStencilStateCreateInfo.depthBoundsTestEnable = VK_FALSE;
+	depthStencilStateCreateInfo.stencilTestEnable = VK_FALSE;
+	depthStencilStateCreateInfo.minDepthBounds = 0.0f;
+	depthStencilStateCreateInfo.maxDepthBounds = 1.0f;
+
+	pipelineStructure.depthStencilStateCreateInfo = &depthStencilStateCreateInfo;
+
+	pipelineStructure.pipelineLayout = meshPipelineLayout;
+	pipelineStructure.renderPass = application->renderer.getRenderPass();
+	pipelineStructure.subpass = 0;
+
+	meshPipeline = application->pipelines.createPipeline(pipelineStructure);
+
+	log_info("Successfully created mesh pipeline!");
+}
+
+void Meshes::cleanup() {
+	log_info("Cleaning up meshes...");
+
+	if (application == nullptr) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+
+	vkDeviceWaitIdle(device);
+
+	for (size_t i = 0; i < meshes.size(); i++) {
+		mesh& current = meshes[i];
+
+		if (current.geometry == i) {
+			vkDestroyBuffer(device, current.buffer, nullptr);
+			vkFreeMemory(device, current.memory, nullptr);
+		}
+
+		application->culling.destroyObject(current.object);
+		application->scene.destroyNode(current.node);
+	}
+
+	meshes.clear();
+	objectMeshes.clear();
+	loadedPaths.clear();
+
+	if (meshPipeline != VK_NULL_HANDLE) {
+		application->pipelines.destroyPipeline(meshPipeline);
+		vkDestroyPipelineLayout(device, meshPipelineLayout, nullptr);
+
+		meshPipeline = VK_NULL_HANDLE;
+		meshPipelineLayout = VK_NULL_HANDLE;
+	}
+
+	for (frameInstances& frame : frames) {
+		if (frame.buffer != VK_NULL_HANDLE) {
+			vkUnmapMemory(device, frame.memory);
+			vkDestroyBuffer(device, frame.buffer, nullptr);
+			vkFreeMemory(device, frame.memory, nullptr);
+		}
+	}
+
+	frames.clear();
+	drawMeshes.clear();
+	drawInstances.clear();
+	drawConstants.clear();
+
+	if (instanceDescriptorPool != VK_NULL_HANDLE) {
+		vkDestroyDescriptorPool(device, instanceDescriptorPool, nullptr);
+		vkDestroyDescriptorSetLayout(device, instanceSetLayout, nullptr);
+
+		instanceDescriptorPool = VK_NULL_HANDLE;
+		instanceSetLayout = VK_NULL_HANDLE;
+	}
+
+	log_info("Meshes loaded " + std::to_string(stats.meshes) + " meshes with " + std::to_string(stats.vertices) + " vertices, " + std::to_string(stats.triangles) + " triangles and " + std::to_string(stats.bytes) + " bytes in " + std::to_string(stats.loadMilliseconds) + " ms");
+
+	log_info("Meshes cleaned up!");
+}
\ No newline at end of file
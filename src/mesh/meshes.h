@@ -0,0 +1,113 @@
+#pragma once
+#define meshes_h
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+#include "mesh_format.h"
+#include "../texture/textures.h"
+#include "../scene/scene.h"
+#include "../culling/culling.h"
+#include "../renderer/occlusion_culling.h"
+#include "../renderer/draw_queue.h"
+
+class Application;
+
+class Meshes {
+	public:
+		typedef uint32_t meshHandle;
+
+		static constexpr meshHandle NO_MESH = UINT32_MAX;
+
+		struct meshConstants {
+			glm::mat4 viewProjection;
+			glm::vec4 positionOffset;
+			glm::vec4 positionScale;
+		};
+
+		struct statistics {
+			uint32_t meshes = 0;
+			uint64_t vertices = 0;
+			uint64_t triangles = 0;
+			uint64_t bytes = 0;
+			double loadMilliseconds = 0.0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		meshHandle loadMesh(const std::string& path, Textures::textureHandle texture = Textures::DEFAULT_TEXTURE);
+		void cull(VkExtent2D extent, std::vector<meshHandle>& visibleMeshes);
+		void writeOcclusionCandidates(VkExtent2D extent, uint32_t frameIndex, const std::vector<meshHandle>& visibleMeshes, std::vector<OcclusionCulling::candidate>& candidates);
+		void render(VkCommandBuffer commandBuffer, VkBuffer drawBuffer);
+		void submitDraws(DrawQueue& drawQueue, VkExtent2D extent, uint32_t frameIndex, const std::vector<meshHandle>& visibleMeshes);
+		void writeDrawInstances(const std::vector<uint32_t>& instances);
+
+		glm::mat4 getViewProjection(VkExtent2D extent);
+		bool hasMeshes();
+		uint32_t getMeshCount();
+		statistics getStatistics();
+
+		static bool validateHeader(const MeshFormat::header& header, size_t fileSize);
+	private:
+		struct mesh {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			uint32_t geometry = 0;
+			VkDeviceSize indexOffset = 0;
+			VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+			uint32_t indexCount = 0;
+			glm::vec3 positionOffset{};
+			glm::vec3 positionScale{};
+			Textures::textureHandle texture = Textures::DEFAULT_TEXTURE;
+			Scene::nodeHandle node = Scene::NO_NODE;
+			Culling::objectHandle object = Culling::NO_OBJECT;
+		};
+
+		struct frameInstances {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			void* mapped = nullptr;
+			uint32_t capacity = 0;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		};
+
+		struct camera {
+			glm::mat4 viewProjection{ 1.0f };
+			glm::vec3 position{ 0.0f };
+			float pixelsPerUnit = 1.0f;
+		};
+
+		Application* application = nullptr;
+
+		std::vector<mesh> meshes;
+		std::vector<meshHandle> objectMeshes;
+		std::unordered_map<std::string, meshHandle> loadedPaths;
+		std::vector<Culling::objectHandle> visibleObjects;
+		std::vector<meshHandle> drawMeshes;
+		std::vector<uint32_t> drawInstances;
+		std::vector<meshConstants> drawConstants;
+		glm::mat4 viewProjection{ 1.0f };
+		glm::vec3 boundsMin{ 0.0f };
+		glm::vec3 boundsMax{ 0.0f };
+
+		VkPipeline meshPipeline = VK_NULL_HANDLE;
+		VkPipelineLayout meshPipelineLayout = VK_NULL_HANDLE;
+
+		VkDescriptorSetLayout instanceSetLayout = VK_NULL_HANDLE;
+		VkDescriptorPool instanceDescriptorPool = VK_NULL_HANDLE;
+		std::vector<frameInstances> frames;
+		uint32_t currentFrame = 0;
+
+		statistics stats;
+
+		void createInstanceSets();
+		void createMeshPipeline();
+		meshHandle addMesh(mesh& added);
+		camera getCamera(VkExtent2D extent);
+};
\ No newline at end of file
@@ -0,0 +1,514 @@
+#include "barrier_tracker.h"
+#include "../application/application.h"
+
+void BarrierTracker::init(Application& application) {
+	this->application = &application;
+}
+
+void BarrierTracker::cleanup() {
+	log_info("Cleaning up barrier tracker...");
+
+	if (stats.requests > 0) {
+		log_info("Barrier tracker: " + std::to_string(stats.requests) + " requests, " + std::to_string(stats.imageBarriers) + " image and " + std::to_string(stats.bufferBarriers) + " buffer barriers in " + std::to_string(stats.batches) + " batches, " + std::to_string(stats.mergedBarriers) + " merged, " + std::to_string(stats.elidedBarriers) + " elided");
+	}
+
+	if (VALIDATE && (stats.redundantBarriers > 0 || stats.missingBarriers > 0)) {
+		log_warning("Barrier tracker found " + std::to_string(stats.redundantBarriers) + " redundant and " + std::to_string(stats.missingBarriers) + " missing barriers!");
+	}
+
+	images.clear();
+	buffers.clear();
+	pendingImageBarriers.clear();
+	pendingBufferBarriers.clear();
+	imageBatchEnds.clear();
+	reportedProblems.clear();
+
+	log_info("Barrier tracker cleaned up!");
+}
+
+void BarrierTracker::setSynchronization2(bool enabled) {
+	synchronization2 = enabled;
+}
+
+void BarrierTracker::trackImage(VkImage image, VkImageAspectFlags aspectMask, VkImageLayout layout) {
+	imageResource& resource = images[image];
+	resource.state = {};
+	resource.state.layout = layout;
+	resource.aspectMask = aspectMask;
+	resource.pendingBarrier = -1;
+}
+
+void BarrierTracker::trackBuffer(VkBuffer buffer) {
+	bufferResource& resource = buffers[buffer];
+	resource.state = {};
+	resource.pendingBarrier = -1;
+}
+
+void BarrierTracker::forgetImage(VkImage image) {
+	auto resource = images.find(image);
+
+	if (resource == images.end()) {
+		return;
+	}
+
+	if (VALIDATE && resource->second.pendingBarrier >= 0) {
+		report("Image " + std::to_string((uint64_t) image) + " was released with an unflushed barrier", stats.missingBarriers);
+	}
+
+	images.erase(resource);
+}
+
+void BarrierTracker::forgetBuffer(VkBuffer buffer) {
+	auto resource = buffers.find(buffer);
+
+	if (resource == buffers.end()) {
+		return;
+	}
+
+	if (VALIDATE && resource->second.pendingBarrier >= 0) {
+		report("Buffer " + std::to_string((uint64_t) buffer) + " was released with an unflushed barrier", stats.missingBarriers);
+	}
+
+	buffers.erase(resource);
+}
+
+bool BarrierTracker::isWriteAccess(VkAccessFlags2 accessMask) {
+	const VkAccessFlags2 writeMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+	return (accessMask & writeMask) != 0;
+}
+
+VkAccessFlags BarrierTracker::toLegacyAccess(VkAccessFlags2 accessMask) {
+	static const std::pair<VkAccessFlags2, VkAccessFlags> mapping[] = {
+		{ VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT },
+		{ VK_ACCESS_2_INDEX_READ_BIT, VK_ACCESS_INDEX_READ_BIT },
+		{ VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT },
+		{ VK_ACCESS_2_UNIFORM_READ_BIT, VK_ACCESS_UNIFORM_READ_BIT },
+		{ VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT },
+		{ VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_ACCESS_SHADER_READ_BIT },
+		{ VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_ACCESS_SHADER_WRITE_BIT },
+		{ VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT },
+		{ VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT },
+		{ VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT },
+		{ VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT },
+		{ VK_ACCESS_2_TRANSFER_READ_BIT, VK_ACCESS_TRANSFER_READ_BIT },
+		{ VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT },
+		{ VK_ACCESS_2_HOST_READ_BIT, VK_ACCESS_HOST_READ_BIT },
+		{ VK_ACCESS_2_HOST_WRITE_BIT, VK_ACCESS_HOST_WRITE_BIT },
+		{ VK_ACCESS_2_MEMORY_READ_BIT, VK_ACCESS_MEMORY_READ_BIT },
+		{ VK_ACCESS_2_MEMORY_WRITE_BIT, VK_ACCESS_MEMORY_WRITE_BIT }
+	};
+
+	VkAccessFlags legacyMask = 0;
+	VkAccessFlags2 remaining = accessMask;
+
+	for (const auto& [sync2Bits, legacyBits] : mapping) {
+		if ((accessMask & sync2Bits) != 0) {
+			legacyMask |= legacyBits;
+			remaining &= ~sync2Bits;
+		}
+	}
+
+	if (remaining != 0) {
+		legacyMask |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	}
+
+	return legacyMask;
+}
+
+VkPipelineStageFlags BarrierTracker::toLegacyStages(VkPipelineStageFlags2 stageMask) {
+	static const std::pair<VkPipelineStageFlags2, VkPipelineStageFlags> mapping[] = {
+		{ VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT },
+		{ VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT },
+		{ VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT },
+		{ VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT },
+		{ VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT },
+		{ VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT },
+		{ VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT },
+		{ VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT },
+		{ VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT },
+		{ VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT | VK_PIPELINE_STAGE_2_RESOLVE_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT },
+		{ VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT },
+		{ VK_PIPELINE_STAGE_2_HOST_BIT, VK_PIPELINE_STAGE_HOST_BIT },
+		{ VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT },
+		{ VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT }
+	};
+
+	VkPipelineStageFlags legacyMask = 0;
+	VkPipelineStageFlags2 remaining = stageMask;
+
+	for (const auto& [sync2Bits, legacyBits] : mapping) {
+		if ((stageMask & sync2Bits) != 0) {
+			legacyMask |= legacyBits;
+			remaining &= ~sync2Bits;
+		}
+	}
+
+	if (remaining != 0) {
+		legacyMask |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+	}
+
+	return legacyMask;
+}
+
+bool BarrierTracker::applyAccess(resourceState& state, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkPipelineStageFlags2& srcStageMask, VkAccessFlags2& srcAccessMask) {
+	bool layoutChanged = layout != state.layout;
+	bool write = isWriteAccess(accessMask);
+
+	if (layoutChanged || write) {
+		srcStageMask = state.writeStages | state.readStages;
+		srcAccessMask = state.writeAccess;
+
+		state.layout = layout;
+		state.writeStages = stageMask;
+		state.writeAccess = write ? accessMask : VK_ACCESS_2_NONE;
+		state.readStages = write ? VK_PIPELINE_STAGE_2_NONE : stageMask;
+		state.readAccess = write ? VK_ACCESS_2_NONE : accessMask;
+
+		return layoutChanged || srcStageMask != VK_PIPELINE_STAGE_2_NONE;
+	}
+
+	if (state.writeStages == VK_PIPELINE_STAGE_2_NONE || ((state.readStages & stageMask) == stageMask && (state.readAccess & accessMask) == accessMask)) {
+		state.readStages |= stageMask;
+		state.readAccess |= accessMask;
+
+		return false;
+	}
+
+	srcStageMask = state.writeStages;
+	srcAccessMask = state.writeAccess;
+
+	state.readStages |= stageMask;
+	state.readAccess |= accessMask;
+
+	return true;
+}
+
+void BarrierTracker::transitionImage(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask) {
+	stats.requests++;
+
+	auto found = images.find(image);
+
+	if (found == images.end()) {
+		if (VALIDATE) {
+			report("Image " + std::to_string((uint64_t) image) + " was transitioned without being tracked", stats.missingBarriers);
+		}
+
+		found = images.emplace(image, imageResource{}).first;
+	}
+
+	imageResource& resource = found->second;
+	VkImageLayout oldLayout = resource.state.layout;
+
+	VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+	VkAccessFlags2 srcAccessMask = VK_ACCESS_2_NONE;
+
+	if (!applyAccess(resource.state, layout, stageMask, accessMask, srcStageMask, srcAccessMask)) {
+		stats.elidedBarriers++;
+
+		if (VALIDATE && resource.pendingBarrier >= 0) {
+			report("Image " + std::to_string((uint64_t) image) + " was requested twice in one barrier batch", stats.redundantBarriers);
+		}
+
+		return;
+	}
+
+	if (resource.pendingBarrier >= 0) {
+		VkImageMemoryBarrier2& barrier = pendingImageBarriers[resource.pendingBarrier];
+
+		if (barrier.newLayout == layout) {
+			barrier.dstStageMask |= stageMask;
+			barrier.dstAccessMask |= accessMask;
+
+			stats.mergedBarriers++;
+
+			return;
+		}
+
+		uint32_t batchBegin = imageBatchEnds.empty() ? 0 : imageBatchEnds.back();
+
+		if (static_cast<uint32_t>(resource.pendingBarrier) >= batchBegin) {
+			imageBatchEnds.push_back(static_cast<uint32_t>(pendingImageBarriers.size()));
+		}
+	}
+
+	VkImageMemoryBarrier2 barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+	barrier.srcStageMask = srcStageMask;
+	barrier.srcAccessMask = srcAccessMask;
+	barrier.dstStageMask = stageMask;
+	barrier.dstAccessMask = accessMask;
+	barrier.oldLayout = oldLayout;
+	barrier.newLayout = layout;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange = { resource.aspectMask, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+
+	resource.pendingBarrier = static_cast<int32_t>(pendingImageBarriers.size());
+	pendingImageBarriers.push_back(barrier);
+}
+
+void BarrierTracker::accessBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask) {
+	stats.requests++;
+
+	auto found = buffers.find(buffer);
+
+	if (found == buffers.end()) {
+		if (VALIDATE) {
+			report("Buffer " + std::to_string((uint64_t) buffer) + " was accessed without being tracked", stats.missingBarriers);
+		}
+
+		found = buffers.emplace(buffer, bufferResource{}).first;
+	}
+
+	bufferResource& resource = found->second;
+
+	VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+	VkAccessFlags2 srcAccessMask = VK_ACCESS_2_NONE;
+
+	if (!applyAccess(resource.state, resource.state.layout, stageMask, accessMask, srcStageMask, srcAccessMask)) {
+		stats.elidedBarriers++;
+
+		if (VALIDATE && resource.pendingBarrier >= 0) {
+			report("Buffer " + std::to_string((uint64_t) buffer) + " was requested twice in one barrier batch", stats.redundantBarriers);
+		}
+
+		return;
+	}
+
+	if (resource.pendingBarrier >= 0) {
+		VkBufferMemoryBarrier2& barrier = pendingBufferBarriers[resource.pendingBarrier];
+		barrier.dstStageMask |= stageMask;
+		barrier.dstAccessMask |= accessMask;
+
+		stats.mergedBarriers++;
+
+		return;
+	}
+
+	VkBufferMemoryBarrier2 barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+	barrier.srcStageMask = srcStageMask;
+	barrier.srcAccessMask = srcAccessMask;
+	barrier.dstStageMask = stageMask;
+	barrier.dstAccessMask = accessMask;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.buffer = buffer;
+	barrier.offset = 0;
+	barrier.size = VK_WHOLE_SIZE;
+
+	resource.pendingBarrier = static_cast<int32_t>(pendingBufferBarriers.size());
+	pendingBufferBarriers.push_back(barrier);
+}
+
+void BarrierTracker::flush(VkCommandBuffer commandBuffer) {
+	if (pendingImageBarriers.empty() && pendingBufferBarriers.empty()) {
+		return;
+	}
+
+	imageBatchEnds.push_back(static_cast<uint32_t>(pendingImageBarriers.size()));
+
+	uint32_t batchBegin = 0;
+
+	for (size_t batch = 0; batch < imageBatchEnds.size(); batch++) {
+		uint32_t batchEnd = imageBatchEnds[batch];
+		bool includeBuffers = batch == 0;
+
+		if (synchronization2) {
+			VkDependencyInfo dependencyInfo{};
+			dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			dependencyInfo.bufferMemoryBarrierCount = includeBuffers ? static_cast<uint32_t>(pendingBufferBarriers.size()) : 0;
+			dependencyInfo.pBufferMemoryBarriers = pendingBufferBarriers.data();
+			dependencyInfo.imageMemoryBarrierCount = batchEnd - batchBegin;
+			dependencyInfo.pImageMemoryBarriers = pendingImageBarriers.data() + batchBegin;
+
+			vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+		}
+		else {
+			flushLegacy(commandBuffer, batchBegin, batchEnd, includeBuffers);
+		}
+
+		batchBegin = batchEnd;
+	}
+
+	stats.batches += imageBatchEnds.size();
+	stats.imageBarriers += pendingImageBarriers.size();
+	stats.bufferBarriers += pendingBufferBarriers.size();
+
+	for (const VkImageMemoryBarrier2& barrier : pendingImageBarriers) {
+		auto resource = images.find(barrier.image);
+
+		if (resource != images.end()) {
+			resource->second.pendingBarrier = -1;
+		}
+	}
+
+	for (const VkBufferMemoryBarrier2& barrier : pendingBufferBarriers) {
+		auto resource = buffers.find(barrier.buffer);
+
+		if (resource != buffers.end()) {
+			resource->second.pendingBarrier = -1;
+		}
+	}
+
+	pendingImageBarriers.clear();
+	pendingBufferBarriers.clear();
+	imageBatchEnds.clear();
+}
+
+void BarrierTracker::flushLegacy(VkCommandBuffer commandBuffer, uint32_t imageBegin, uint32_t imageEnd, bool includeBuffers) {
+	VkPipelineStageFlags srcStageMask = 0;
+	VkPipelineStageFlags dstStageMask = 0;
+
+	legacyImageBarriers.clear();
+	legacyBufferBarriers.clear();
+
+	for (uint32_t i = imageBegin; i < imageEnd; i++) {
+		const VkImageMemoryBarrier2& barrier = pendingImageBarriers[i];
+
+		VkImageMemoryBarrier legacyBarrier{};
+		legacyBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		legacyBarrier.srcAccessMask = toLegacyAccess(barrier.srcAccessMask);
+		legacyBarrier.dstAccessMask = toLegacyAccess(barrier.dstAccessMask);
+		legacyBarrier.oldLayout = barrier.oldLayout;
+		legacyBarrier.newLayout = barrier.newLayout;
+		legacyBarrier.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+		legacyBarrier.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+		legacyBarrier.image = barrier.image;
+		legacyBarrier.subresourceRange = barrier.subresourceRange;
+
+		srcStageMask |= toLegacyStages(barrier.srcStageMask);
+		dstStageMask |= toLegacyStages(barrier.dstStageMask);
+
+		legacyImageBarriers.push_back(legacyBarrier);
+	}
+
+	uint32_t bufferCount = includeBuffers ? static_cast<uint32_t>(pendingBufferBarriers.size()) : 0;
+
+	for (uint32_t i = 0; i < bufferCount; i++) {
+		const VkBufferMemoryBarrier2& barrier = pendingBufferBarriers[i];
+
+		VkBufferMemoryBarrier legacyBarrier{};
+		legacyBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		legacyBarrier.srcAccessMask = toLegacyAccess(barrier.srcAccessMask);
+		legacyBarrier.dstAccessMask = toLegacyAccess(barrier.dstAccessMask);
+		legacyBarrier.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+		legacyBarrier.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+		legacyBarrier.buffer = barrier.buffer;
+		legacyBarrier.offset = barrier.offset;
+		legacyBarrier.size = barrier.size;
+
+		srcStageMask |= toLegacyStages(barrier.srcStageMask);
+		dstStageMask |= toLegacyStages(barrier.dstStageMask);
+
+		legacyBufferBarriers.push_back(legacyBarrier);
+	}
+
+	if (srcStageMask == 0) {
+		srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	}
+
+	if (dstStageMask == 0) {
+		dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	}
+
+	vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, static_cast<uint32_t>(legacyBufferBarriers.size()), legacyBufferBarriers.data(), static_cast<uint32_t>(legacyImageBarriers.size()), legacyImageBarriers.data());
+}
+
+void BarrierTracker::useImage(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask) {
+	auto found = images.find(image);
+
+	if (found == images.end()) {
+		if (VALIDATE) {
+			report("Image " + std::to_string((uint64_t) image) + " was used without being tracked", stats.missingBarriers);
+		}
+
+		found = images.emplace(image, imageResource{}).first;
+	}
+
+	imageResource& resource = found->second;
+
+	if (VALIDATE && resource.pendingBarrier >= 0) {
+		report("Image " + std::to_string((uint64_t) image) + " was used before its barrier was flushed", stats.missingBarriers);
+	}
+
+	VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+	VkAccessFlags2 srcAccessMask = VK_ACCESS_2_NONE;
+
+	if (applyAccess(resource.state, layout, stageMask, accessMask, srcStageMask, srcAccessMask) && VALIDATE) {
+		report("Image " + std::to_string((uint64_t) image) + " was used without a required barrier", stats.missingBarriers);
+	}
+}
+
+void BarrierTracker::useBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask) {
+	auto found = buffers.find(buffer);
+
+	if (found == buffers.end()) {
+		if (VALIDATE) {
+			report("Buffer " + std::to_string((uint64_t) buffer) + " was used without being tracked", stats.missingBarriers);
+		}
+
+		found = buffers.emplace(buffer, bufferResource{}).first;
+	}
+
+	bufferResource& resource = found->second;
+
+	if (VALIDATE && resource.pendingBarrier >= 0) {
+		report("Buffer " + std::to_string((uint64_t) buffer) + " was used before its barrier was flushed", stats.missingBarriers);
+	}
+
+	VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+	VkAccessFlags2 srcAccessMask = VK_ACCESS_2_NONE;
+
+	if (applyAccess(resource.state, resource.state.layout, stageMask, accessMask, srcStageMask, srcAccessMask) && VALIDATE) {
+		report("Buffer " + std::to_string((uint64_t) buffer) + " was used without a required barrier", stats.missingBarriers);
+	}
+}
+
+void BarrierTracker::setImageState(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask) {
+	auto found = images.find(image);
+
+	if (found == images.end()) {
+		log_error("Image " + std::to_string((uint64_t) image) + " had its state set without being tracked!");
+	}
+
+	imageResource& resource = found->second;
+
+	if (VALIDATE && resource.pendingBarrier >= 0) {
+		report("Image " + std::to_string((uint64_t) image) + " was overwritten before its barrier was flushed", stats.missingBarriers);
+	}
+
+	bool write = isWriteAccess(accessMask);
+
+	resource.state.layout = layout;
+	resource.state.writeStages = stageMask;
+	resource.state.writeAccess = write ? accessMask : VK_ACCESS_2_NONE;
+	resource.state.readStages = write ? VK_PIPELINE_STAGE_2_NONE : stageMask;
+	resource.state.readAccess = write ? VK_ACCESS_2_NONE : accessMask;
+}
+
+BarrierTracker::resourceState BarrierTracker::getImageState(VkImage image) {
+	auto resource = images.find(image);
+
+	return resource != images.end() ? resource->second.state : resourceState{};
+}
+
+BarrierTracker::resourceState BarrierTracker::getBufferState(VkBuffer buffer) {
+	auto resource = buffers.find(buffer);
+
+	return resource != buffers.end() ? resource->second.state : resourceState{};
+}
+
+BarrierTracker::statistics BarrierTracker::getStatistics() {
+	return stats;
+}
+
+void BarrierTracker::report(const std::string& problem, uint64_t& counter) {
+	counter++;
+
+	if (reportedProblems.insert(problem).second) {
+		log_warning(problem + "!");
+	}
+}
\ No newline at end of file
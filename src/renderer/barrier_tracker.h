@@ -0,0 +1,98 @@
+#pragma once
+#define barrier_tracker_h
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class BarrierTracker {
+	public:
+		struct resourceState {
+			VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+			VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+			VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+			VkAccessFlags2 readAccess = VK_ACCESS_2_NONE;
+		};
+
+		struct statistics {
+			uint64_t requests = 0;
+			uint64_t imageBarriers = 0;
+			uint64_t bufferBarriers = 0;
+			uint64_t mergedBarriers = 0;
+			uint64_t elidedBarriers = 0;
+			uint64_t batches = 0;
+			uint64_t redundantBarriers = 0;
+			uint64_t missingBarriers = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		void setSynchronization2(bool enabled);
+
+		void trackImage(VkImage image, VkImageAspectFlags aspectMask, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+		void trackBuffer(VkBuffer buffer);
+		void forgetImage(VkImage image);
+		void forgetBuffer(VkBuffer buffer);
+
+		void transitionImage(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask);
+		void accessBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask);
+		void flush(VkCommandBuffer commandBuffer);
+
+		void useImage(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask);
+		void useBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask);
+		void setImageState(VkImage image, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask);
+
+		resourceState getImageState(VkImage image);
+		resourceState getBufferState(VkBuffer buffer);
+		statistics getStatistics();
+	private:
+#ifdef NDEBUG
+		static constexpr bool VALIDATE = false;
+#else
+		static constexpr bool VALIDATE = true;
+#endif
+
+		struct imageResource {
+			resourceState state;
+			VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			int32_t pendingBarrier = -1;
+		};
+
+		struct bufferResource {
+			resourceState state;
+			int32_t pendingBarrier = -1;
+		};
+
+		Application* application = nullptr;
+
+		bool synchronization2 = false;
+
+		std::unordered_map<VkImage, imageResource> images;
+		std::unordered_map<VkBuffer, bufferResource> buffers;
+
+		std::vector<VkImageMemoryBarrier2> pendingImageBarriers;
+		std::vector<VkBufferMemoryBarrier2> pendingBufferBarriers;
+		std::vector<uint32_t> imageBatchEnds;
+
+		std::vector<VkImageMemoryBarrier> legacyImageBarriers;
+		std::vector<VkBufferMemoryBarrier> legacyBufferBarriers;
+
+		statistics stats;
+		std::unordered_set<std::string> reportedProblems;
+
+		static bool isWriteAccess(VkAccessFlags2 accessMask);
+		static VkAccessFlags toLegacyAccess(VkAccessFlags2 accessMask);
+		static VkPipelineStageFlags toLegacyStages(VkPipelineStageFlags2 stageMask);
+		static bool applyAccess(resourceState& state, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkPipelineStageFlags2& srcStageMask, VkAccessFlags2& srcAccessMask);
+
+		void flushLegacy(VkCommandBuffer commandBuffer, uint32_t imageBegin, uint32_t imageEnd, bool includeBuffers);
+		void report(const std::string& problem, uint64_t& counter);
+};
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "device_capabilities.h"
+#include "../application/application.h"
+
+#include <cstring>
+
+void DeviceCapabilities::init(Application& application) {
+	this->application = &application;
+}
+
+bool DeviceCapabilities::hasExtension(const std::vector<VkExtensionProperties>& availableExtensions, const char* extensionName) {
+	for (const VkExtensionProperties& extension : availableExtensions) {
+		if (std::strcmp(extension.extensionName, extensionName) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int64_t DeviceCapabilities::scoreDevice(VkPhysicalDevice physicalDevice) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	int64_t score = 0;
+
+	switch (properties.deviceType) {
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+			score += 10000;
+			break;
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+			score += 1000;
+			break;
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+			score += 500;
+			break;
+		default:
+			break;
+	}
+
+	if (properties.apiVersion >= VK_API_VERSION_1_3) {
+		score += 100;
+	}
+
+	VkPhysicalDeviceMemoryProperties memoryProperties;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+	for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+		if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+			score += static_cast<int64_t>(memoryProperties.memoryHeaps[i].size / (256ull * 1024 * 1024));
+		}
+	}
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	for (const VkQueueFamilyProperties& queueFamily : queueFamilies) {
+		if ((queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+			score += 50;
+		}
+
+		if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+			score += 25;
+		}
+	}
+
+	return score;
+}
+
+void DeviceCapabilities::query(VkPhysicalDevice physicalDevice, bool presentation, bool wantsPresentWait) {
+	this->physicalDevice = physicalDevice;
+
+	enabled = {};
+	extensions.clear();
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	enabled.deviceName = properties.deviceName;
+	enabled.deviceType = properties.deviceType;
+	enabled.apiVersion = properties.apiVersion;
+	enabled.timestampPeriod = properties.limits.timestampPeriod;
+	enabled.maxPushConstantsSize = properties.limits.maxPushConstantsSize;
+
+	VkPhysicalDeviceMemoryProperties memoryProperties;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+	for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+		if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+			enabled.deviceLocalMemory += memoryProperties.memoryHeaps[i].size;
+		}
+	}
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	for (const VkQueueFamilyProperties& queueFamily : queueFamilies) {
+		enabled.dedicatedComputeQueue |= (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT);
+		enabled.dedicatedTransferQueue |= (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+	}
+
+	uint32_t extensionCount = 0;
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+	VkPhysicalDeviceVulkan11Features vulkan11Features{};
+	vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+
+	VkPhysicalDeviceVulkan12Features vulkan12Features{};
+	vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+	VkPhysicalDeviceVulkan13Features vulkan13Features{};
+	vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+	VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+	presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+	VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+	presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+	VkPhysicalDeviceFeatures2 features{};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+	void** next = &features.pNext;
+
+	if (properties.apiVersion >= VK_API_VERSION_1_2) {
+		*next = &vulkan11Features;
+		next = &vulkan11Features.pNext;
+
+		*next = &vulkan12Features;
+		next = &vulkan12Features.pNext;
+	}
+
+	if (properties.apiVersion >= VK_API_VERSION_1_3) {
+		*next = &vulkan13Features;
+		next = &vulkan13Features.pNext;
+	}
+
+	bool presentWaitAvailable = presentation && wantsPresentWait && hasExtension(availableExtensions, VK_KHR_PRESENT_ID_EXTENSION_NAME) && hasExtension(availableExtensions, VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+	if (presentWaitAvailable) {
+		*next = &presentIdFeatures;
+		next = &presentIdFeatures.pNext;
+
+		*next = &presentWaitFeatures;
+		next = &presentWaitFeatures.pNext;
+	}
+
+	vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+	enabledFeatures = {};
+	enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+	enabledVulkan11Features = {};
+	enabledVulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+
+	enabledVulkan12Features = {};
+	enabledVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+	enabledVulkan13Features = {};
+	enabledVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+	enabledPresentIdFeatures = {};
+	enabledPresentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+	enabledPresentWaitFeatures = {};
+	enabledPresentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+	enabledFeatures.features.samplerAnisotropy = features.features.samplerAnisotropy;
+	enabledFeatures.features.multiDrawIndirect = features.features.multiDrawIndirect;
+	enabledFeatures.features.drawIndirectFirstInstance = features.features.drawIndirectFirstInstance;
+	enabledFeatures.features.fillModeNonSolid = features.features.fillModeNonSolid;
+	enabledFeatures.features.textureCompressionBC = features.features.textureCompressionBC;
+	enabledFeatures.features.textureCompressionETC2 = features.features.textureCompressionETC2;
+	enabledFeatures.features.textureCompressionASTC_LDR = features.features.textureCompressionASTC_LDR;
+
+	enabled.samplerAnisotropy = features.features.samplerAnisotropy == VK_TRUE;
+	enabled.multiDrawIndirect = features.features.multiDrawIndirect == VK_TRUE;
+	enabled.drawIndirectFirstInstance = features.features.drawIndirectFirstInstance == VK_TRUE;
+	enabled.fillModeNonSolid = features.features.fillModeNonSolid == VK_TRUE;
+	enabled.textureCompressionBC = features.features.textureCompressionBC == VK_TRUE;
+	enabled.textureCompressionETC2 = features.features.textureCompressionETC2 == VK_TRUE;
+	enabled.textureCompressionASTC = features.features.textureCompressionASTC_LDR == VK_TRUE;
+	enabled.maxSamplerAnisotropy = enabled.samplerAnisotropy ? properties.limits.maxSamplerAnisotropy : 1.0f;
+
+	next = &enabledFeatures.pNext;
+
+	if (properties.apiVersion >= VK_API_VERSION_1_2) {
+		enabledVulkan11Features.shaderDrawParameters = vulkan11Features.shaderDrawParameters;
+
+		enabledVulkan12Features.timelineSemaphore = vulkan12Features.timelineSemaphore;
+		enabledVulkan12Features.bufferDeviceAddress = vulkan12Features.bufferDeviceAddress;
+		enabledVulkan12Features.drawIndirectCount = vulkan12Features.drawIndirectCount;
+		enabledVulkan12Features.hostQueryReset = vulkan12Features.hostQueryReset;
+		enabledVulkan12Features.scalarBlockLayout = vulkan12Features.scalarBlockLayout;
+
+		bool descriptorIndexing = vulkan12Features.descriptorIndexing && vulkan12Features.runtimeDescriptorArray && vulkan12Features.descriptorBindingPartiallyBound && vulkan12Features.descriptorBindingVariableDescriptorCount && vulkan12Features.shaderSampledImageArrayNonUniformIndexing && vulkan12Features.descriptorBindingSampledImageUpdateAfterBind;
+
+		if (descriptorIndexing) {
+			enabledVulkan12Features.descriptorIndexing = VK_TRUE;
+			enabledVulkan12Features.runtimeDescriptorArray = VK_TRUE;
+			enabledVulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			enabledVulkan12Features.descriptorBindingVariableDescriptorCount = VK_TRUE;
+			enabledVulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			enabledVulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		}
+
+		enabled.shaderDrawParameters = vulkan11Features.shaderDrawParameters == VK_TRUE;
+		enabled.timelineSemaphore = vulkan12Features.timelineSemaphore == VK_TRUE;
+		enabled.bufferDeviceAddress = vulkan12Features.bufferDeviceAddress == VK_TRUE;
+		enabled.drawIndirectCount = vulkan12Features.drawIndirectCount == VK_TRUE;
+		enabled.hostQueryReset = vulkan12Features.hostQueryReset == VK_TRUE;
+		enabled.scalarBlockLayout = vulkan12Features.scalarBlockLayout == VK_TRUE;
+		enabled.descriptorIndexing = descriptorIndexing;
+
+		*next = &enabledVulkan11Features;
+		next = &enabledVulkan11Features.pNext;
+
+		*next = &enabledVulkan12Features;
+		next = &enabledVulkan12Features.pNext;
+	}
+
+	if (properties.apiVersion >= VK_API_VERSION_1_3) {
+		enabledVulkan13Features.synchronization2 = vulkan13Features.synchronization2;
+		enabledVulkan13Features.dynamicRendering = vulkan13Features.dynamicRendering;
+		enabledVulkan13Features.maintenance4 = vulkan13Features.maintenance4;
+
+		enabled.synchronization2 = vulkan13Features.synchronization2 == VK_TRUE;
+		enabled.dynamicRendering = vulkan13Features.dynamicRendering == VK_TRUE;
+		enabled.maintenance4 = vulkan13Features.maintenance4 == VK_TRUE;
+
+		*next = &enabledVulkan13Features;
+		next = &enabledVulkan13Features.pNext;
+	}
+
+	if (presentWaitAvailable && presentIdFeatures.presentId == VK_TRUE && presentWaitFeatures.presentWait == VK_TRUE) {
+		enabledPresentIdFeatures.presentId = VK_TRUE;
+		enabledPresentWaitFeatures.presentWait = VK_TRUE;
+
+		enabled.presentId = true;
+		enabled.presentWait = true;
+
+		extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+		extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+		*next = &enabledPresentIdFeatures;
+		next = &enabledPresentIdFeatures.pNext;
+
+		*next = &enabledPresentWaitFeatures;
+		next = &enabledPresentWaitFeatures.pNext;
+	}
+
+	if (hasExtension(availableExtensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+		enabled.memoryBudget = true;
+
+		extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	}
+}
+
+void* DeviceCapabilities::getFeatureChain() {
+	return &enabledFeatures;
+}
+
+const std::vector<const char*>& DeviceCapabilities::getExtensions() {
+	return extensions;
+}
+
+const DeviceCapabilities::capabilities& DeviceCapabilities::get() {
+	return enabled;
+}
+
+std::vector<DeviceCapabilities::heapBudget> DeviceCapabilities::getHeapBudgets() {
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+	budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+	VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+	memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+	memoryProperties.pNext = enabled.memoryBudget ? &budgetProperties : nullptr;
+
+	vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties);
+
+	std::vector<heapBudget> budgets(memoryProperties.memoryProperties.memoryHeapCount);
+
+	for (uint32_t i = 0; i < budgets.size(); i++) {
+		budgets[i].size = memoryProperties.memoryProperties.memoryHeaps[i].size;
+		budgets[i].budget = enabled.memoryBudget ? budgetProperties.heapBudget[i] : budgets[i].size;
+		budgets[i].usage = enabled.memoryBudget ? budgetProperties.heapUsage[i] : 0;
+		budgets[i].deviceLocal = (memoryProperties.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+	}
+
+	return budgets;
+}
+
+void DeviceCapabilities::logSummary() {
+	log_info("Device: " + enabled.deviceName + " (Vulkan " + std::to_string(VK_API_VERSION_MAJOR(enabled.apiVersion)) + "." + std::to_string(VK_API_VERSION_MINOR(enabled.apiVersion)) + ", " + std::to_string(enabled.deviceLocalMemory / (1024 * 1024)) + " MB device local)");
+
+	std::string features;
+
+	auto addFeature = [&](const char* name, bool supported) {
+		if (supported) {
+			features += features.empty() ? name : std::string(", ") + name;
+		}
+	};
+
+	addFeature("timelineSemaphore", enabled.timelineSemaphore);
+	addFeature("synchronization2", enabled.synchronization2);
+	addFeature("dynamicRendering", enabled.dynamicRendering);
+	addFeature("descriptorIndexing", enabled.descriptorIndexing);
+	addFeature("bufferDeviceAddress", enabled.bufferDeviceAddress);
+	addFeature("drawIndirectCount", enabled.drawIndirectCount);
+	addFeature("multiDrawIndirect", enabled.multiDrawIndirect);
+	addFeature("hostQueryReset", enabled.hostQueryReset);
+	addFeature("maintenance4", enabled.maintenance4);
+	addFeature("memoryBudget", enabled.memoryBudget);
+	addFeature("textureCompressionBC", enabled.textureCompressionBC);
+	addFeature("textureCompressionETC2", enabled.textureCompressionETC2);
+	addFeature("textureCompressionASTC", enabled.textureCompressionASTC);
+	addFeature("presentWait", enabled.presentWait);
+	addFeature("dedicatedCompute", enabled.dedicatedComputeQueue);
+	addFeature("dedicatedTransfer", enabled.dedicatedTransferQueue);
+
+	log_info("Enabled device features: " + (features.empty() ? std::string("none") : features));
+}
\ No newline at end of file
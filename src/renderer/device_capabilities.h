@@ -0,0 +1,88 @@
+#pragma once
+#define device_capabilities_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class DeviceCapabilities {
+	public:
+		struct capabilities {
+			std::string deviceName;
+			VkPhysicalDeviceType deviceType = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+			uint32_t apiVersion = 0;
+			VkDeviceSize deviceLocalMemory = 0;
+
+			bool dedicatedComputeQueue = false;
+			bool dedicatedTransferQueue = false;
+
+			float timestampPeriod = 0.0f;
+			uint32_t maxPushConstantsSize = 0;
+			float maxSamplerAnisotropy = 0.0f;
+
+			bool samplerAnisotropy = false;
+			bool multiDrawIndirect = false;
+			bool drawIndirectFirstInstance = false;
+			bool fillModeNonSolid = false;
+			bool textureCompressionBC = false;
+			bool textureCompressionETC2 = false;
+			bool textureCompressionASTC = false;
+
+			bool shaderDrawParameters = false;
+
+			bool timelineSemaphore = false;
+			bool descriptorIndexing = false;
+			bool bufferDeviceAddress = false;
+			bool drawIndirectCount = false;
+			bool hostQueryReset = false;
+			bool scalarBlockLayout = false;
+
+			bool synchronization2 = false;
+			bool dynamicRendering = false;
+			bool maintenance4 = false;
+
+			bool memoryBudget = false;
+			bool presentId = false;
+			bool presentWait = false;
+		};
+
+		struct heapBudget {
+			VkDeviceSize size = 0;
+			VkDeviceSize budget = 0;
+			VkDeviceSize usage = 0;
+			bool deviceLocal = false;
+		};
+
+		void init(Application& application);
+
+		static int64_t scoreDevice(VkPhysicalDevice physicalDevice);
+
+		void query(VkPhysicalDevice physicalDevice, bool presentation, bool wantsPresentWait);
+		void* getFeatureChain();
+		const std::vector<const char*>& getExtensions();
+
+		const capabilities& get();
+		std::vector<heapBudget> getHeapBudgets();
+
+		void logSummary();
+	private:
+		Application* application = nullptr;
+
+		VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+
+		capabilities enabled;
+		std::vector<const char*> extensions;
+
+		VkPhysicalDeviceFeatures2 enabledFeatures{};
+		VkPhysicalDeviceVulkan11Features enabledVulkan11Features{};
+		VkPhysicalDeviceVulkan12Features enabledVulkan12Features{};
+		VkPhysicalDeviceVulkan13Features enabledVulkan13Features{};
+		VkPhysicalDevicePresentIdFeaturesKHR enabledPresentIdFeatures{};
+		VkPhysicalDevicePresentWaitFeaturesKHR enabledPresentWaitFeatures{};
+
+		static bool hasExtension(const std::vector<VkExtensionProperties>& availableExtensions, const char* extensionName);
+};
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include "draw_queue.h"
+#include "../application/application.h"
+
+void DrawQueue::init(Application& application) {
+	log_info("Initializing draw queue...");
+
+	this->application = &application;
+
+	log_info("Draw queue initialized!");
+}
+
+void DrawQueue::cleanup() {
+	log_info("Cleaning up draw queue...");
+
+	clear();
+	pipelineIds.clear();
+
+	log_info("Draw queue cleaned up!");
+}
+
+void DrawQueue::clear() {
+	packets.clear();
+	drawCommands.clear();
+	instances.clear();
+
+	stats = {};
+}
+
+void DrawQueue::reserve(size_t packetCount) {
+	packets.reserve(packetCount);
+	keys.reserve(packetCount);
+	scratchKeys.reserve(packetCount);
+	order.reserve(packetCount);
+	scratchOrder.reserve(packetCount);
+	instances.reserve(packetCount);
+	drawCommands.reserve(packetCount);
+}
+
+void DrawQueue::submit(const drawPacket& packet) {
+	packets.push_back(packet);
+
+	stats.packets++;
+}
+
+uint32_t DrawQueue::getPipelineId(VkPipeline pipeline) {
+	auto iterator = pipelineIds.find(pipeline);
+
+	if (iterator != pipelineIds.end()) {
+		return iterator->second;
+	}
+
+	uint32_t pipelineId = static_cast<uint32_t>(pipelineIds.size());
+
+	if (pipelineId > 0xFFF) {
+		log_error("Too many pipelines registered in draw queue!");
+	}
+
+	pipelineIds.emplace(pipeline, pipelineId);
+
+	return pipelineId;
+}
+
+uint64_t DrawQueue::makeSortKey(DrawQueue::pass pass, uint32_t pipelineId, uint32_t materialId, float depth) {
+	uint32_t depthBits;
+	std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+
+	if (pass == DrawQueue::pass::transparent) {
+		depthBits = ~depthBits;
+	}
+
+	return (static_cast<uint64_t>(pass) & 0xF) << 60
+		 | (static_cast<uint64_t>(pipelineId) & 0xFFF) << 48
+		 | (static_cast<uint64_t>(materialId) & 0xFFFF) << 32
+		 | static_cast<uint64_t>(depthBits);
+}
+
+void DrawQueue::sort() {
+	const size_t count = packets.size();
+
+	keys.resize(count);
+	scratchKeys.resize(count);
+	order.resize(count);
+	scratchOrder.resize(count);
+
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = packets[i].sortKey;
+		order[i] = static_cast<uint32_t>(i);
+	}
+
+	if (count < 2) {
+		return;
+	}
+
+	histograms.assign(RADIX_PASSES * RADIX_SIZE, 0);
+
+	uint32_t* histogramData = histograms.data();
+
+	for (size_t i = 0; i < count; i++) {
+		const uint64_t key = keys[i];
+
+		for (uint32_t radixPass = 0; radixPass < RADIX_PASSES; radixPass++) {
+			histogramData[radixPass * RADIX_SIZE + ((key >> (radixPass * RADIX_BITS)) & (RADIX_SIZE - 1))]++;
+		}
+	}
+
+	for (uint32_t radixPass = 0; radixPass < RADIX_PASSES; radixPass++) {
+		uint32_t* histogram = histogramData + radixPass * RADIX_SIZE;
+		const uint32_t shift = radixPass * RADIX_BITS;
+
+		if (histogram[(keys[0] >> shift) & (RADIX_SIZE - 1)] == count) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+
+		for (uint32_t digit = 0; digit < RADIX_SIZE; digit++) {
+			const uint32_t digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+
+		const uint64_t* sourceKeys = keys.data();
+		const uint32_t* sourceOrder = order.data();
+		uint64_t* destinationKeys = scratchKeys.data();
+		uint32_t* destinationOrder = scratchOrder.data();
+
+		for (size_t i = 0; i < count; i++) {
+			const uint64_t key = sourceKeys[i];
+			const uint32_t destination = histogram[(key >> shift) & (RADIX_SIZE - 1)]++;
+
+			destinationKeys[destination] = key;
+			destinationOrder[destination] = sourceOrder[i];
+		}
+
+		keys.swap(scratchKeys);
+		order.swap(scratchOrder);
+	}
+}
+
+bool DrawQueue::canInstance(const drawPacket& first, const drawPacket& second) {
+	return first.meshId != 0
+		&& first.instanceCount == 1
+		&& second.instanceCount == 1
+		&& first.meshId == second.meshId
+		&& first.materialId == second.materialId
+		&& first.pipeline == second.pipeline
+		&& first.pipelineLayout == second.pipelineLayout
+		&& first.materialSet == second.materialSet
+		&& first.instanceSet == second.instanceSet
+		&& first.constants == second.constants
+		&& first.vertexBuffer == second.vertexBuffer
+		&& first.vertexBufferOffset == second.vertexBufferOffset
+		&& first.indexBuffer == second.indexBuffer
+		&& first.indexBufferOffset == second.indexBufferOffset
+		&& first.indexType == second.indexType
+		&& first.vertexCount == second.vertexCount
+		&& first.firstVertex == second.firstVertex
+		&& first.indexCount == second.indexCount
+		&& first.firstIndex == second.firstIndex;
+}
+
+void DrawQueue::buildDrawCommands() {
+	const size_t count = order.size();
+
+	drawCommands.clear();
+	instances.resize(count);
+
+	boundPipeline = VK_NULL_HANDLE;
+	boundPipelineLayout = VK_NULL_HANDLE;
+	boundMaterialSet = VK_NULL_HANDLE;
+	boundInstanceSet = VK_NULL_HANDLE;
+	boundConstants = nullptr;
+	boundVertexBuffer = VK_NULL_HANDLE;
+	boundVertexBufferOffset = 0;
+	boundIndexBuffer = VK_NULL_HANDLE;
+	boundIndexBufferOffset = 0;
+	boundIndexType = VK_INDEX_TYPE_UINT16;
+
+	for (size_t i = 0; i < count; i++) {
+		instances[i] = packets[order[i]].instance;
+	}
+
+	size_t i = 0;
+
+	while (i < count) {
+		const drawPacket& packet = packets[order[i]];
+
+		drawCommand command{};
+		command.pass = static_cast<DrawQueue::pass>(packet.sortKey >> 60);
+		command.pipeline = packet.pipeline;
+		command.pipelineLayout = packet.pipelineLayout;
+		command.materialSet = packet.materialSet;
+		command.instanceSet = packet.instanceSet;
+		command.constants = packet.constants;
+		command.constantsSize = packet.constantsSize;
+		command.constantStages = packet.constantStages;
+		command.vertexBuffer = packet.vertexBuffer;
+		command.vertexBufferOffset = packet.vertexBufferOffset;
+		command.indexBuffer = packet.indexBuffer;
+		command.indexBufferOffset = packet.indexBufferOffset;
+		command.indexType = packet.indexType;
+		command.vertexCount = packet.vertexCount;
+		command.firstVertex = packet.firstVertex;
+		command.indexCount = packet.indexCount;
+		command.firstIndex = packet.firstIndex;
+		command.instanceCount = packet.instanceCount;
+		command.firstInstance = packet.meshId != 0 && packet.instanceCount == 1 ? static_cast<uint32_t>(i) : packet.firstInstance;
+
+		size_t next = i + 1;
+
+		while (next < count && canInstance(packet, packets[order[next]])) {
+			command.instanceCount++;
+			next++;
+		}
+
+		drawCommands.push_back(command);
+
+		i = next;
+	}
+}
+
+void DrawQueue::record(VkCommandBuffer commandBuffer) {
+	for (const drawCommand& command : drawCommands) {
+		recordCommand(commandBuffer, command);
+	}
+}
+
+void DrawQueue::record(VkCommandBuffer commandBuffer, DrawQueue::pass pass) {
+	for (const drawCommand& command : drawCommands) {
+		if (command.pass == pass) {
+			recordCommand(commandBuffer, command);
+		}
+	}
+}
+
+void DrawQueue::recordCommand(VkCommandBuffer commandBuffer, const drawCommand& command) {
+	if (command.pipeline != boundPipeline) {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipeline);
+		boundPipeline = command.pipeline;
+
+		stats.pipelineBinds++;
+	}
+
+	if (command.pipelineLayout != boundPipelineLayout) {
+		boundPipelineLayout = command.pipelineLayout;
+		boundMaterialSet = VK_NULL_HANDLE;
+		boundInstanceSet = VK_NULL_HANDLE;
+		boundConstants = nullptr;
+	}
+
+	if (command.materialSet != VK_NULL_HANDLE && command.materialSet != boundMaterialSet) {
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipelineLayout, 0, 1, &command.materialSet, 0, nullptr);
+		boundMaterialSet = command.materialSet;
+
+		stats.descriptorSetBinds++;
+	}
+
+	if (command.instanceSet != VK_NULL_HANDLE && command.instanceSet != boundInstanceSet) {
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipelineLayout, 1, 1, &command.instanceSet, 0, nullptr);
+		boundInstanceSet = command.instanceSet;
+
+		stats.descriptorSetBinds++;
+	}
+
+	if (command.constants != nullptr && command.constants != boundConstants) {
+		vkCmdPushConstants(commandBuffer, command.pipelineLayout, command.constantStages, 0, command.constantsSize, command.constants);
+		boundConstants = command.constants;
+	}
+
+	if (command.vertexBuffer != VK_NULL_HANDLE && (command.vertexBuffer != boundVertexBuffer || command.vertexBufferOffset != boundVertexBufferOffset)) {
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &command.vertexBuffer, &command.vertexBufferOffset);
+		boundVertexBuffer = command.vertexBuffer;
+		boundVertexBufferOffset = command.vertexBufferOffset;
+
+		stats.vertexBufferBinds++;
+	}
+
+	if (command.indexBuffer != VK_NULL_HANDLE) {
+		if (command.indexBuffer != boundIndexBuffer || command.indexBufferOffset != boundIndexBufferOffset || command.indexType != boundIndexType) {
+			vkCmdBindIndexBuffer(commandBuffer, command.indexBuffer, command.indexBufferOffset, command.indexType);
+			boundIndexBuffer = command.indexBuffer;
+			boundIndexBufferOffset = command.indexBufferOffset;
+			boundIndexType = command.indexType;
+
+			stats.indexBufferBinds++;
+		}
+
+		vkCmdDrawIndexed(commandBuffer, command.indexCount, command.instanceCount, command.firstIndex, static_cast<int32_t>(command.firstVertex), command.firstInstance);
+	}
+	else {
+		vkCmdDraw(commandBuffer, command.vertexCount, command.instanceCount, command.firstVertex, command.firstInstance);
+	}
+
+	stats.drawCalls++;
+	stats.instances += command.instanceCount;
+}
+
+void DrawQueue::flush(VkCommandBuffer commandBuffer) {
+	sort();
+	buildDrawCommands();
+	record(commandBuffer);
+}
+
+const std::vector<DrawQueue::drawCommand>& DrawQueue::getDrawCommands() {
+	return drawCommands;
+}
+
+const std::vector<uint32_t>& DrawQueue::getInstances() {
+	return instances;
+}
+
+const DrawQueue::statistics DrawQueue::getStatistics() {
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+#define draw_queue_h
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class DrawQueue {
+	public:
+		enum class pass : uint8_t {
+			opaque = 0,
+			transparent = 1,
+			ui = 2
+		};
+
+		struct drawPacket {
+			uint64_t sortKey = 0;
+
+			VkPipeline pipeline = VK_NULL_HANDLE;
+			VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+			VkDescriptorSet materialSet = VK_NULL_HANDLE;
+			VkDescriptorSet instanceSet = VK_NULL_HANDLE;
+			const void* constants = nullptr;
+			uint32_t constantsSize = 0;
+			VkShaderStageFlags constantStages = VK_SHADER_STAGE_VERTEX_BIT;
+
+			VkBuffer vertexBuffer = VK_NULL_HANDLE;
+			VkDeviceSize vertexBufferOffset = 0;
+			VkBuffer indexBuffer = VK_NULL_HANDLE;
+			VkDeviceSize indexBufferOffset = 0;
+			VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+
+			uint32_t meshId = 0;
+			uint32_t materialId = 0;
+			uint32_t vertexCount = 0;
+			uint32_t firstVertex = 0;
+			uint32_t indexCount = 0;
+			uint32_t firstIndex = 0;
+			uint32_t instance = 0;
+			uint32_t instanceCount = 1;
+			uint32_t firstInstance = 0;
+		};
+
+		struct drawCommand {
+			DrawQueue::pass pass;
+
+			VkPipeline pipeline;
+			VkPipelineLayout pipelineLayout;
+			VkDescriptorSet materialSet;
+			VkDescriptorSet instanceSet;
+			const void* constants;
+			uint32_t constantsSize;
+			VkShaderStageFlags constantStages;
+
+			VkBuffer vertexBuffer;
+			VkDeviceSize vertexBufferOffset;
+			VkBuffer indexBuffer;
+			VkDeviceSize indexBufferOffset;
+			VkIndexType indexType;
+
+			uint32_t vertexCount;
+			uint32_t firstVertex;
+			uint32_t indexCount;
+			uint32_t firstIndex;
+			uint32_t instanceCount;
+			uint32_t firstInstance;
+		};
+
+		struct statistics {
+			uint32_t packets = 0;
+			uint32_t drawCalls = 0;
+			uint32_t instances = 0;
+			uint32_t pipelineBinds = 0;
+			uint32_t descriptorSetBinds = 0;
+			uint32_t vertexBufferBinds = 0;
+			uint32_t indexBufferBinds = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		void clear();
+		void reserve(size_t packetCount);
+		void submit(const drawPacket& packet);
+
+		void sort();
+		void buildDrawCommands();
+		void record(VkCommandBuffer commandBuffer);
+		void record(VkCommandBuffer commandBuffer, DrawQueue::pass pass);
+		void flush(VkCommandBuffer commandBuffer);
+
+		uint32_t getPipelineId(VkPipeline pipeline);
+
+		static uint64_t makeSortKey(DrawQueue::pass pass, uint32_t pipelineId, uint32_t materialId, float depth);
+
+		const std::vector<drawCommand>& getDrawCommands();
+		const std::vector<uint32_t>& getInstances();
+		const statistics getStatistics();
+	private:
+		Application* application = nullptr;
+
+		static const uint32_t RADIX_BITS = 11;
+		static const uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+		static const uint32_t RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+		std::vector<drawPacket> packets;
+
+		std::vector<uint64_t> keys;
+		std::vector<uint64_t> scratchKeys;
+		std::vector<uint32_t> order;
+		std::vector<uint32_t> scratchOrder;
+		std::vector<uint32_t> histograms;
+
+		std::vector<uint32_t> instances;
+		std::vector<drawCommand> drawCommands;
+
+		std::unordered_map<VkPipeline, uint32_t> pipelineIds;
+
+		VkPipeline boundPipeline = VK_NULL_HANDLE;
+		VkPipelineLayout boundPipelineLayout = VK_NULL_HANDLE;
+		VkDescriptorSet boundMaterialSet = VK_NULL_HANDLE;
+		VkDescriptorSet boundInstanceSet = VK_NULL_HANDLE;
+		const void* boundConstants = nullptr;
+		VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+		VkDeviceSize boundVertexBufferOffset = 0;
+		VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+		VkDeviceSize boundIndexBufferOffset = 0;
+		VkIndexType boundIndexType = VK_INDEX_TYPE_UINT16;
+
+		statistics stats;
+
+		bool canInstance(const drawPacket& first, const drawPacket& second);
+		void recordCommand(VkCommandBuffer commandBuffer, const drawCommand& command);
+};
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "frame_pacer.h"
+#include "../application/application.h"
+
+#include <cmath>
+#include <thread>
+
+void FramePacer::init(Application& application) {
+	log_info("Initializing frame pacer...");
+
+	this->application = &application;
+
+	currentProfile = application.options.pacingProfile;
+
+	switch (currentProfile) {
+		case profile::maxThroughput:
+			framesInFlight = 3;
+			break;
+		case profile::lowLatency:
+			framesInFlight = 2;
+			break;
+		case profile::powerSave:
+			framesInFlight = 2;
+			break;
+	}
+
+	if (application.options.framesInFlight != 0) {
+		framesInFlight = application.options.framesInFlight;
+	}
+
+	log_info("Frame pacer initialized with " + std::string(getProfileName(currentProfile)) + " profile and " + std::to_string(framesInFlight) + " frames in flight!");
+}
+
+void FramePacer::cleanup() {
+	log_info("Cleaning up frame pacer...");
+
+	jitterStatistics statistics = getJitterStatistics();
+
+	if (statistics.sampleCount > 0) {
+		log_info("Present interval over " + std::to_string(statistics.sampleCount) + " frames: mean " + std::to_string(statistics.meanMilliseconds) + " ms, jitter " + std::to_string(statistics.standardDeviationMilliseconds) + " ms, min " + std::to_string(statistics.minimumMilliseconds) + " ms, max " + std::to_string(statistics.maximumMilliseconds) + " ms");
+	}
+
+	log_info("Frame pacer cleaned up!");
+}
+
+bool FramePacer::parseProfile(const std::string& name, profile& result) {
+	if (name == "throughput") {
+		result = profile::maxThroughput;
+	}
+	else if (name == "latency") {
+		result = profile::lowLatency;
+	}
+	else if (name == "power") {
+		result = profile::powerSave;
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+const char* FramePacer::getProfileName(profile profile) {
+	switch (profile) {
+		case profile::maxThroughput:
+			return "throughput";
+		case profile::lowLatency:
+			return "latency";
+		case profile::powerSave:
+			return "power";
+	}
+
+	return "unknown";
+}
+
+FramePacer::profile FramePacer::getProfile() {
+	return currentProfile;
+}
+
+uint32_t FramePacer::getFramesInFlight() {
+	return framesInFlight;
+}
+
+VkPresentModeKHR FramePacer::choosePresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
+	std::vector<VkPresentModeKHR> preferredModes;
+
+	switch (currentProfile) {
+		case profile::maxThroughput:
+			preferredModes = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR };
+			break;
+		case profile::lowLatency:
+			preferredModes = { VK_PRESENT_MODE_MAILBOX_KHR };
+			break;
+		case profile::powerSave:
+			break;
+	}
+
+	for (VkPresentModeKHR preferredMode : preferredModes) {
+		for (VkPresentModeKHR availablePresentMode : availablePresentModes) {
+			if (availablePresentMode == preferredMode) {
+				return availablePresentMode;
+			}
+		}
+	}
+
+	return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+bool FramePacer::wantsPresentWait() {
+	return currentProfile != profile::maxThroughput;
+}
+
+void FramePacer::enablePresentWait(VkDevice device) {
+	this->device = device;
+
+	waitForPresent = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device, "vkWaitForPresentKHR"));
+	presentWaitEnabled = waitForPresent != nullptr;
+
+	if (presentWaitEnabled) {
+		log_info("Present wait enabled!");
+	}
+	else {
+		log_warning("Failed to load vkWaitForPresentKHR, pacing without present wait!");
+	}
+}
+
+bool FramePacer::isPresentWaitEnabled() {
+	return presentWaitEnabled;
+}
+
+bool FramePacer::recordsFromPresentWait() {
+	return presentWaitEnabled && wantsPresentWait();
+}
+
+void FramePacer::waitForFrameStart() {
+	if (!recordsFromPresentWait() || application->options.headless) {
+		return;
+	}
+
+	trace_zone("FramePacer::waitForFrameStart");
+
+	uint64_t submittedId = lastPresentId.load(std::memory_order_acquire);
+	uint64_t queuedFrames = currentProfile == profile::lowLatency ? 0 : 1;
+
+	if (submittedId <= queuedFrames) {
+		return;
+	}
+
+	uint64_t targetId = submittedId - queuedFrames;
+
+	if (targetId < firstPresentId.load(std::memory_order_acquire) || targetId <= lastWaitedId) {
+		return;
+	}
+
+	VkResult waitResult = waitForPresent(device, application->swapchain.getSwapchain(), targetId, PRESENT_WAIT_TIMEOUT);
+
+	if (waitResult != VK_SUCCESS) {
+		return;
+	}
+
+	std::chrono::steady_clock::time_point presentTime = std::chrono::steady_clock::now();
+
+	lastWaitedId = targetId;
+	recordPresentTime(presentTime);
+
+	if (currentProfile != profile::lowLatency) {
+		return;
+	}
+
+	double refreshNanoseconds = getRefreshNanoseconds();
+
+	if (refreshNanoseconds <= 0.0) {
+		return;
+	}
+
+	int64_t startOffset = static_cast<int64_t>(refreshNanoseconds) - cpuFrameNanoseconds.load(std::memory_order_relaxed) - START_MARGIN_NANOSECONDS;
+
+	if (startOffset > 0) {
+		trace_zone("sleep until frame start");
+		std::this_thread::sleep_until(presentTime + std::chrono::nanoseconds(startOffset));
+	}
+}
+
+uint64_t FramePacer::nextPresentId() {
+	return lastPresentId.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void FramePacer::onPresent(std::chrono::steady_clock::time_point buildTime) {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	int64_t frameNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now - buildTime).count();
+	int64_t previous = cpuFrameNanoseconds.load(std::memory_order_relaxed);
+
+	cpuFrameNanoseconds.store(previous == 0 ? frameNanoseconds : (previous * 7 + frameNanoseconds) / 8, std::memory_order_relaxed);
+
+	if (!recordsFromPresentWait()) {
+		recordPresentTime(now);
+	}
+}
+
+void FramePacer::onSwapchainRecreated() {
+	firstPresentId.store(lastPresentId.load(std::memory_order_acquire) + 1, std::memory_order_release);
+
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	hasLastPresentTime = false;
+}
+
+void FramePacer::recordPresentTime(std::chrono::steady_clock::time_point presentTime) {
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+
+	if (hasLastPresentTime) {
+		int64_t intervalNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(presentTime - lastPresentTime).count();
+
+		if (intervalNanoseconds <= MAX_PRESENT_INTERVAL_NANOSECONDS) {
+			double interval = intervalNanoseconds / 1000000.0;
+
+			sampleCount++;
+
+			double delta = interval - mean;
+			mean += delta / sampleCount;
+			sumOfSquares += delta * (interval - mean);
+
+			minimum = sampleCount == 1 ? interval : std::min(minimum, interval);
+			maximum = sampleCount == 1 ? interval : std::max(maximum, interval);
+		}
+	}
+
+	lastPresentTime = presentTime;
+	hasLastPresentTime = true;
+}
+
+double FramePacer::getRefreshNanoseconds() {
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+
+	return sampleCount < 2 ? 0.0 : mean * 1000000.0;
+}
+
+FramePacer::jitterStatistics FramePacer::getJitterStatistics() {
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+
+	jitterStatistics statistics;
+	statistics.sampleCount = sampleCount;
+	statistics.meanMilliseconds = mean;
+	statistics.standardDeviationMilliseconds = sampleCount > 1 ? std::sqrt(sumOfSquares / (sampleCount - 1)) : 0.0;
+	statistics.minimumMilliseconds = minimum;
+	statistics.maximumMilliseconds = maximum;
+
+	return statistics;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#define frame_pacer_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class FramePacer {
+	public:
+		enum class profile {
+			maxThroughput,
+			lowLatency,
+			powerSave
+		};
+
+		struct jitterStatistics {
+			uint64_t sampleCount = 0;
+			double meanMilliseconds = 0.0;
+			double standardDeviationMilliseconds = 0.0;
+			double minimumMilliseconds = 0.0;
+			double maximumMilliseconds = 0.0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		static bool parseProfile(const std::string& name, profile& result);
+		static const char* getProfileName(profile profile);
+
+		profile getProfile();
+		uint32_t getFramesInFlight();
+		VkPresentModeKHR choosePresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+
+		bool wantsPresentWait();
+		void enablePresentWait(VkDevice device);
+		bool isPresentWaitEnabled();
+
+		void waitForFrameStart();
+		uint64_t nextPresentId();
+		void onPresent(std::chrono::steady_clock::time_point buildTime);
+		void onSwapchainRecreated();
+
+		jitterStatistics getJitterStatistics();
+	private:
+		Application* application = nullptr;
+
+		static const uint64_t PRESENT_WAIT_TIMEOUT = 100000000;
+		static const int64_t START_MARGIN_NANOSECONDS = 1000000;
+		static const int64_t MAX_PRESENT_INTERVAL_NANOSECONDS = 100000000;
+
+		profile currentProfile = profile::maxThroughput;
+		uint32_t framesInFlight = 2;
+
+		VkDevice device = VK_NULL_HANDLE;
+		PFN_vkWaitForPresentKHR waitForPresent = nullptr;
+		bool presentWaitEnabled = false;
+
+		std::atomic<uint64_t> lastPresentId{ 0 };
+		std::atomic<uint64_t> firstPresentId{ 1 };
+		uint64_t lastWaitedId = 0;
+
+		std::atomic<int64_t> cpuFrameNanoseconds{ 0 };
+
+		std::mutex statisticsMutex;
+		std::chrono::steady_clock::time_point lastPresentTime;
+		bool hasLastPresentTime = false;
+		uint64_t sampleCount = 0;
+		double mean = 0.0;
+		double sumOfSquares = 0.0;
+		double minimum = 0.0;
+		double maximum = 0.0;
+
+		bool recordsFromPresentWait();
+		void recordPresentTime(std::chrono::steady_clock::time_point presentTime);
+		double getRefreshNanoseconds();
+};
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "gpu_profiler.h"
+#include "../application/application.h"
+
+void GpuProfiler::init(Application& application) {
+	log_info("Initializing GPU profiler...");
+
+	this->application = &application;
+
+	VkPhysicalDeviceProperties physicalDeviceProperties;
+	vkGetPhysicalDeviceProperties(application.renderer.getPhysicalDevice(), &physicalDeviceProperties);
+
+	Renderer::queueFamilyIndices indices = application.renderer.findQueueFamilies(application.renderer.getPhysicalDevice());
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(application.renderer.getPhysicalDevice(), &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(application.renderer.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+	uint32_t timestampValidBits = queueFamilies[indices.graphicsFamily.value()].timestampValidBits;
+
+	if (timestampValidBits == 0 || physicalDeviceProperties.limits.timestampPeriod == 0.0f) {
+		log_warning("Timestamp queries not supported on graphics queue, GPU profiler disabled!");
+
+		return;
+	}
+
+	timestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+	timestampMask = timestampValidBits >= 64 ? ~0ull : ((1ull << timestampValidBits) - 1);
+
+	if (application.renderer.getValidationLayersEnabled()) {
+		cmdBeginDebugUtilsLabel = (PFN_vkCmdBeginDebugUtilsLabelEXT) vkGetInstanceProcAddr(application.renderer.getInstance(), "vkCmdBeginDebugUtilsLabelEXT");
+		cmdEndDebugUtilsLabel = (PFN_vkCmdEndDebugUtilsLabelEXT) vkGetInstanceProcAddr(application.renderer.getInstance(), "vkCmdEndDebugUtilsLabelEXT");
+
+		labelsEnabled = cmdBeginDebugUtilsLabel != nullptr && cmdEndDebugUtilsLabel != nullptr;
+	}
+
+	createQueryPools(application.renderer.getMaxFramesInFlight());
+
+	enabled = true;
+
+	log_info("GPU profiler initialized!");
+}
+
+void GpuProfiler::createQueryPools(uint32_t frameCount) {
+	frames.resize(frameCount);
+
+	for (frameQueries& frame : frames) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = MAX_SCOPES_PER_FRAME * 2;
+
+		VkResult result = vkCreateQueryPool(application->renderer.getDevice(), &queryPoolCreateInfo, nullptr, &frame.queryPool);
+
+		if (result != VK_SUCCESS) {
+			log_error("Failed to create timestamp query pool!");
+		}
+
+		frame.scopes.reserve(MAX_SCOPES_PER_FRAME);
+	}
+
+	queryResults.resize(MAX_SCOPES_PER_FRAME * 2 * 2);
+
+	log_info("Successfully created timestamp query pools!");
+}
+
+void GpuProfiler::cleanup() {
+	log_info("Cleaning up GPU profiler...");
+
+	for (const std::string& name : getScopeNames()) {
+		timingStatistics statistics = getStatistics(name);
+
+		log_info("GPU " + name + ": " + std::to_string(statistics.average) + " ms average, " + std::to_string(statistics.p50) + " ms p50, " + std::to_string(statistics.p95) + " ms p95, " + std::to_string(statistics.p99) + " ms p99, " + std::to_string(statistics.maximum) + " ms max over " + std::to_string(statistics.sampleCount) + " samples");
+	}
+
+	for (frameQueries& frame : frames) {
+		if (frame.queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(application->renderer.getDevice(), frame.queryPool, nullptr);
+		}
+	}
+
+	frames.clear();
+	histories.clear();
+	enabled = false;
+
+	log_info("GPU profiler cleaned up!");
+}
+
+bool GpuProfiler::isEnabled() {
+	return enabled;
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (!enabled) {
+		return;
+	}
+
+	currentFrame = frameIndex;
+
+	frameQueries& frame = frames[currentFrame];
+
+	if (frame.pending) {
+		collectResults(frame);
+	}
+
+	vkCmdResetQueryPool(commandBuffer, frame.queryPool, 0, MAX_SCOPES_PER_FRAME * 2);
+
+	frame.scopes.clear();
+	frame.queryCount = 0;
+	frame.pending = true;
+}
+
+uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char* name) {
+	if (labelsEnabled) {
+		VkDebugUtilsLabelEXT label{};
+		label.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+		label.pLabelName = name;
+
+		cmdBeginDebugUtilsLabel(commandBuffer, &label);
+	}
+
+	if (!enabled) {
+		return UINT32_MAX;
+	}
+
+	frameQueries& frame = frames[currentFrame];
+
+	if (frame.scopes.size() >= MAX_SCOPES_PER_FRAME) {
+		log_warning("GPU profiler scope limit reached, dropping scope!");
+
+		return UINT32_MAX;
+	}
+
+	scope newScope{};
+	newScope.name = name;
+	newScope.beginQuery = frame.queryCount++;
+	newScope.endQuery = frame.queryCount++;
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.queryPool, newScope.beginQuery);
+
+	frame.scopes.push_back(newScope);
+
+	return static_cast<uint32_t>(frame.scopes.size() - 1);
+}
+
+void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex) {
+	if (enabled && scopeIndex != UINT32_MAX) {
+		frameQueries& frame = frames[currentFrame];
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.queryPool, frame.scopes[scopeIndex].endQuery);
+	}
+
+	if (labelsEnabled) {
+		cmdEndDebugUtilsLabel(commandBuffer);
+	}
+}
+
+void GpuProfiler::collectResults(frameQueries& frame) {
+	frame.pending = false;
+
+	if (frame.queryCount == 0) {
+		return;
+	}
+
+	VkResult result = vkGetQueryPoolResults(application->renderer.getDevice(), frame.queryPool, 0, frame.queryCount, frame.queryCount * 2 * sizeof(uint64_t), queryResults.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+	if (result != VK_SUCCESS && result != VK_NOT_READY) {
+		log_warning("Failed to read back timestamp queries!");
+
+		return;
+	}
+
+	for (const scope& frameScope : frame.scopes) {
+		uint64_t beginTimestamp = queryResults[frameScope.beginQuery * 2];
+		uint64_t beginAvailable = queryResults[frameScope.beginQuery * 2 + 1];
+		uint64_t endTimestamp = queryResults[frameScope.endQuery * 2];
+		uint64_t endAvailable = queryResults[frameScope.endQuery * 2 + 1];
+
+		if (beginAvailable == 0 || endAvailable == 0) {
+			continue;
+		}
+
+		uint64_t ticks = ((endTimestamp & timestampMask) - (beginTimestamp & timestampMask)) & timestampMask;
+
+		addSample(frameScope.name, static_cast<double>(ticks) * timestampPeriod / 1000000.0);
+	}
+}
+
+void GpuProfiler::addSample(const char* name, double milliseconds) {
+	history& scopeHistory = histories[name];
+
+	if (scopeHistory.samples.size() < HISTORY_SIZE) {
+		scopeHistory.samples.push_back(milliseconds);
+	}
+	else {
+		scopeHistory.samples[scopeHistory.next] = milliseconds;
+	}
+
+	scopeHistory.next = (scopeHistory.next + 1) % HISTORY_SIZE;
+	scopeHistory.latest = milliseconds;
+}
+
+std::vector<std::string> GpuProfiler::getScopeNames() {
+	std::vector<std::string> names;
+	names.reserve(histories.size());
+
+	for (const auto& entry : histories) {
+		names.push_back(entry.first);
+	}
+
+	std::sort(names.begin(), names.end());
+
+	return names;
+}
+
+GpuProfiler::timingStatistics GpuProfiler::getStatistics(const std::string& name) {
+	timingStatistics statistics{};
+
+	auto iterator = histories.find(name);
+
+	if (iterator == histories.end() || iterator->second.samples.empty()) {
+		return statistics;
+	}
+
+	std::vector<double> sorted = iterator->second.samples;
+	std::sort(sorted.begin(), sorted.end());
+
+	double sum = 0.0;
+
+	for (double sample : sorted) {
+		sum += sample;
+	}
+
+	auto percentile = [&sorted](double fraction) {
+		size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+
+		return sorted[index];
+	};
+
+	statistics.latest = iterator->second.latest;
+	statistics.average = sum / static_cast<double>(sorted.size());
+	statistics.minimum = sorted.front();
+	statistics.maximum = sorted.back();
+	statistics.p50 = percentile(0.50);
+	statistics.p95 = percentile(0.95);
+	statistics.p99 = percentile(0.99);
+	statistics.sampleCount = static_cast<uint32_t>(sorted.size());
+
+	return statistics;
+}
+
+GpuProfileScope::GpuProfileScope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name) : profiler(profiler), commandBuffer(commandBuffer) {
+	scopeIndex = profiler.beginScope(commandBuffer, name);
+}
+
+GpuProfileScope::~GpuProfileScope() {
+	profiler.endScope(commandBuffer, scopeIndex);
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#define gpu_profiler_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class GpuProfiler {
+	public:
+		struct timingStatistics {
+			double latest = 0.0;
+			double average = 0.0;
+			double minimum = 0.0;
+			double maximum = 0.0;
+			double p50 = 0.0;
+			double p95 = 0.0;
+			double p99 = 0.0;
+			uint32_t sampleCount = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+		uint32_t beginScope(VkCommandBuffer commandBuffer, const char* name);
+		void endScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex);
+
+		bool isEnabled();
+
+		timingStatistics getStatistics(const std::string& name);
+		std::vector<std::string> getScopeNames();
+	private:
+		Application* application = nullptr;
+
+		static const uint32_t MAX_SCOPES_PER_FRAME = 32;
+		static const uint32_t HISTORY_SIZE = 240;
+
+		struct scope {
+			const char* name;
+			uint32_t beginQuery;
+			uint32_t endQuery;
+		};
+
+		struct frameQueries {
+			VkQueryPool queryPool = VK_NULL_HANDLE;
+			std::vector<scope> scopes;
+			uint32_t queryCount = 0;
+			bool pending = false;
+		};
+
+		struct history {
+			std::vector<double> samples;
+			uint32_t next = 0;
+			double latest = 0.0;
+		};
+
+		bool enabled = false;
+		bool labelsEnabled = false;
+
+		float timestampPeriod = 1.0f;
+		uint64_t timestampMask = ~0ull;
+
+		std::vector<frameQueries> frames;
+		uint32_t currentFrame = 0;
+
+		std::unordered_map<std::string, history> histories;
+		std::vector<uint64_t> queryResults;
+
+		PFN_vkCmdBeginDebugUtilsLabelEXT cmdBeginDebugUtilsLabel = nullptr;
+		PFN_vkCmdEndDebugUtilsLabelEXT cmdEndDebugUtilsLabel = nullptr;
+
+		void createQueryPools(uint32_t frameCount);
+		void collectResults(frameQueries& frame);
+		void addSample(const char* name, double milliseconds);
+};
+
+class GpuProfileScope {
+	public:
+		GpuProfileScope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name);
+		~GpuProfileScope();
+	private:
+		GpuProfiler& profiler;
+		VkCommandBuffer commandBuffer;
+		uint32_t scopeIndex;
+};
\ No newline at end of file
@@ -0,0 +1,537 @@
+#include "occlusion_culling.h"
+#include "../application/application.h"
+
+void OcclusionCulling::init(Application& application) {
+	log_info("Initializing occlusion culling...");
+
+	this->application = &application;
+
+	createDescriptorSetLayouts();
+	createSampler();
+	createPipelines();
+
+	frames.resize(application.renderer.getMaxFramesInFlight());
+
+	std::vector<VkDescriptorSetLayout> setLayouts(frames.size(), testSetLayout);
+
+	VkDescriptorSetAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = descriptorPool;
+	allocateInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+	allocateInfo.pSetLayouts = setLayouts.data();
+
+	std::vector<VkDescriptorSet> testSets(frames.size());
+
+	if (vkAllocateDescriptorSets(application.renderer.getDevice(), &allocateInfo, testSets.data()) != VK_SUCCESS) {
+		log_error("Failed to allocate occlusion test descriptor sets!");
+	}
+
+	for (size_t i = 0; i < frames.size(); i++) {
+		frames[i].descriptorSet = testSets[i];
+	}
+
+	std::vector<VkDescriptorSetLayout> reduceLayouts(MAX_PYRAMID_LEVELS, reduceSetLayout);
+
+	allocateInfo.descriptorSetCount = MAX_PYRAMID_LEVELS;
+	allocateInfo.pSetLayouts = reduceLayouts.data();
+
+	if (vkAllocateDescriptorSets(application.renderer.getDevice(), &allocateInfo, reduceSets) != VK_SUCCESS) {
+		log_error("Failed to allocate depth pyramid descriptor sets!");
+	}
+
+	createPyramid();
+
+	log_info("Occlusion culling initialized with a " + std::to_string(pyramidExtent.width) + "x" + std::to_string(pyramidExtent.height) + " depth pyramid!");
+}
+
+void OcclusionCulling::createDescriptorSetLayouts() {
+	VkDevice device = application->renderer.getDevice();
+
+	VkDescriptorSetLayoutBinding reduceBindings[2]{};
+	reduceBindings[0].binding = 0;
+	reduceBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	reduceBindings[0].descriptorCount = 1;
+	reduceBindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	reduceBindings[1].binding = 1;
+	reduceBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	reduceBindings[1].descriptorCount = 1;
+	reduceBindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+	layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutCreateInfo.bindingCount = 2;
+	layoutCreateInfo.pBindings = reduceBindings;
+
+	if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &reduceSetLayout) != VK_SUCCESS) {
+		log_error("Failed to create depth pyramid descriptor set layout!");
+	}
+
+	VkDescriptorSetLayoutBinding testBindings[5]{};
+
+	for (uint32_t i = 0; i < 4; i++) {
+		testBindings[i].binding = i;
+		testBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		testBindings[i].descriptorCount = 1;
+		testBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	testBindings[4].binding = 4;
+	testBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	testBindings[4].descriptorCount = 1;
+	testBindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+	layoutCreateInfo.bindingCount = 5;
+	layoutCreateInfo.pBindings = testBindings;
+
+	if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &testSetLayout) != VK_SUCCESS) {
+		log_error("Failed to create occlusion test descriptor set layout!");
+	}
+
+	uint32_t frameCount = application->renderer.getMaxFramesInFlight();
+
+	VkDescriptorPoolSize poolSizes[3]{};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[0].descriptorCount = MAX_PYRAMID_LEVELS + frameCount;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	poolSizes[1].descriptorCount = MAX_PYRAMID_LEVELS;
+	poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[2].descriptorCount = 4 * frameCount;
+
+	VkDescriptorPoolCreateInfo poolCreateInfo{};
+	poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolCreateInfo.maxSets = MAX_PYRAMID_LEVELS + frameCount;
+	poolCreateInfo.poolSizeCount = 3;
+	poolCreateInfo.pPoolSizes = poolSizes;
+
+	if (vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+		log_error("Failed to create occlusion culling descriptor pool!");
+	}
+}
+
+void OcclusionCulling::createSampler() {
+	VkSamplerCreateInfo samplerCreateInfo{};
+	samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+	samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+	samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.minLod = 0.0f;
+	samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+	if (vkCreateSampler(application->renderer.getDevice(), &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS) {
+		log_error("Failed to create depth pyramid sampler!");
+	}
+}
+
+void OcclusionCulling::createPipelines() {
+	log_info("Creating occlusion culling pipelines...");
+
+	VkPushConstantRange reduceRange{};
+	reduceRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	reduceRange.offset = 0;
+	reduceRange.size = sizeof(reduceConstants);
+
+	VkPushConstantRange testRange{};
+	testRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	testRange.offset = 0;
+	testRange.size = sizeof(testConstants);
+
+	reducePipelineLayout = application->pipelines.createPipelineLayout({ reduceRange }, { reduceSetLayout });
+	testPipelineLayout = application->pipelines.createPipelineLayout({ testRange }, { testSetLayout });
+
+	reducePipeline = application->pipelines.createComputePipeline("src/renderer/shaders/hiz_reduce_comp.spv", reducePipelineLayout);
+	testPipeline = application->pipelines.createComputePipeline("src/renderer/shaders/occlusion_test_comp.spv", testPipelineLayout);
+
+	log_info("Successfully created occlusion culling pipelines!");
+}
+
+uint32_t OcclusionCulling::previousPowerOfTwo(uint32_t value) {
+	uint32_t result = 1;
+
+	while (result * 2 <= value) {
+		result *= 2;
+	}
+
+	return result;
+}
+
+void OcclusionCulling::createPyramid() {
+	VkDevice device = application->renderer.getDevice();
+	VkExtent2D extent = application->swapchain.getExtent();
+
+	pyramidExtent = { previousPowerOfTwo(std::max(extent.width, 1u)), previousPowerOfTwo(std::max(extent.height, 1u)) };
+	pyramidLevels = 1;
+
+	while (pyramidLevels < MAX_PYRAMID_LEVELS && (pyramidExtent.width >> pyramidLevels) + (pyramidExtent.height >> pyramidLevels) > 0) {
+		pyramidLevels++;
+	}
+
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+	imageCreateInfo.extent = { pyramidExtent.width, pyramidExtent.height, 1 };
+	imageCreateInfo.mipLevels = pyramidLevels;
+	imageCreateInfo.arrayLayers = 1;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	if (vkCreateImage(device, &imageCreateInfo, nullptr, &pyramidImage) != VK_SUCCESS) {
+		log_error("Failed to create depth pyramid image!");
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetImageMemoryRequirements(device, pyramidImage, &memoryRequirements);
+
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &pyramidMemory) != VK_SUCCESS) {
+		log_error("Failed to allocate depth pyramid memory!");
+	}
+
+	vkBindImageMemory(device, pyramidImage, pyramidMemory, 0);
+
+	VkImageViewCreateInfo viewCreateInfo{};
+	viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewCreateInfo.image = pyramidImage;
+	viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+	viewCreateInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, pyramidLevels, 0, 1 };
+
+	if (vkCreateImageView(device, &viewCreateInfo, nullptr, &pyramidView) != VK_SUCCESS) {
+		log_error("Failed to create depth pyramid view!");
+	}
+
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		viewCreateInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+
+		if (vkCreateImageView(device, &viewCreateInfo, nullptr, &levelViews[level]) != VK_SUCCESS) {
+			log_error("Failed to create depth pyramid level view!");
+		}
+	}
+
+	application->renderer.barrierTracker.trackImage(pyramidImage, VK_IMAGE_ASPECT_COLOR_BIT);
+
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		VkDescriptorImageInfo sourceInfo{};
+		sourceInfo.sampler = sampler;
+		sourceInfo.imageView = level == 0 ? application->swapchain.getDepthImageView() : levelViews[level - 1];
+		sourceInfo.imageLayout = level == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+		VkDescriptorImageInfo destinationInfo{};
+		destinationInfo.imageView = levelViews[level];
+		destinationInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		VkWriteDescriptorSet descriptorWrites[2]{};
+		descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[0].dstSet = reduceSets[level];
+		descriptorWrites[0].dstBinding = 0;
+		descriptorWrites[0].descriptorCount = 1;
+		descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites[0].pImageInfo = &sourceInfo;
+		descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[1].dstSet = reduceSets[level];
+		descriptorWrites[1].dstBinding = 1;
+		descriptorWrites[1].descriptorCount = 1;
+		descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		descriptorWrites[1].pImageInfo = &destinationInfo;
+
+		vkUpdateDescriptorSets(device, 2, descriptorWrites, 0, nullptr);
+	}
+
+	stats.pyramidLevels = pyramidLevels;
+	stats.pyramidExtent = pyramidExtent;
+}
+
+void OcclusionCulling::destroyPyramid() {
+	VkDevice device = application->renderer.getDevice();
+
+	if (pyramidImage == VK_NULL_HANDLE) {
+		return;
+	}
+
+	application->renderer.barrierTracker.forgetImage(pyramidImage);
+
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		vkDestroyImageView(device, levelViews[level], nullptr);
+		levelViews[level] = VK_NULL_HANDLE;
+	}
+
+	vkDestroyImageView(device, pyramidView, nullptr);
+	vkDestroyImage(device, pyramidImage, nullptr);
+	vkFreeMemory(device, pyramidMemory, nullptr);
+
+	pyramidImage = VK_NULL_HANDLE;
+	pyramidMemory = VK_NULL_HANDLE;
+	pyramidView = VK_NULL_HANDLE;
+	pyramidLevels = 0;
+}
+
+void OcclusionCulling::onSwapchainRecreated() {
+	if (application == nullptr) {
+		return;
+	}
+
+	destroyPyramid();
+	createPyramid();
+}
+
+void OcclusionCulling::ensureVisibilityBuffer(VkCommandBuffer commandBuffer, uint32_t objectCount) {
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	if (objectCount <= visibilityCapacity) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+
+	if (visibilityBuffer != VK_NULL_HANDLE) {
+		vkDeviceWaitIdle(device);
+
+		barrierTracker.forgetBuffer(visibilityBuffer);
+
+		vkDestroyBuffer(device, visibilityBuffer, nullptr);
+		vkFreeMemory(device, visibilityMemory, nullptr);
+	}
+
+	visibilityCapacity = std::max(objectCount, visibilityCapacity * 2);
+
+	application->renderer.createBuffer(static_cast<VkDeviceSize>(visibilityCapacity) * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, visibilityBuffer, visibilityMemory);
+
+	barrierTracker.trackBuffer(visibilityBuffer);
+	barrierTracker.accessBuffer(visibilityBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	vkCmdFillBuffer(commandBuffer, visibilityBuffer, 0, VK_WHOLE_SIZE, 0);
+}
+
+void OcclusionCulling::ensureFrameResources(frameResources& frame, uint32_t count) {
+	if (count <= frame.capacity) {
+		return;
+	}
+
+	uint32_t capacity = std::max(count, std::max(frame.capacity * 2, TEST_GROUP_SIZE));
+
+	destroyFrameResources(frame);
+
+	frame.capacity = capacity;
+
+	VkDevice device = application->renderer.getDevice();
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	application->renderer.createBuffer(static_cast<VkDeviceSize>(frame.capacity) * sizeof(candidate), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, frame.candidateBuffer, frame.candidateMemory);
+	vkMapMemory(device, frame.candidateMemory, 0, VK_WHOLE_SIZE, 0, &frame.mappedCandidates);
+
+	for (uint32_t phase = 0; phase < 2; phase++) {
+		application->renderer.createBuffer(static_cast<VkDeviceSize>(frame.capacity) * sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.drawBuffers[phase], frame.drawMemories[phase]);
+
+		barrierTracker.trackBuffer(frame.drawBuffers[phase]);
+	}
+}
+
+void OcclusionCulling::destroyFrameResources(frameResources& frame) {
+	VkDevice device = application->renderer.getDevice();
+
+	if (frame.candidateBuffer != VK_NULL_HANDLE) {
+		vkUnmapMemory(device, frame.candidateMemory);
+		vkDestroyBuffer(device, frame.candidateBuffer, nullptr);
+		vkFreeMemory(device, frame.candidateMemory, nullptr);
+
+		frame.candidateBuffer = VK_NULL_HANDLE;
+		frame.candidateMemory = VK_NULL_HANDLE;
+		frame.mappedCandidates = nullptr;
+	}
+
+	for (uint32_t phase = 0; phase < 2; phase++) {
+		if (frame.drawBuffers[phase] == VK_NULL_HANDLE) {
+			continue;
+		}
+
+		application->renderer.barrierTracker.forgetBuffer(frame.drawBuffers[phase]);
+
+		vkDestroyBuffer(device, frame.drawBuffers[phase], nullptr);
+		vkFreeMemory(device, frame.drawMemories[phase], nullptr);
+
+		frame.drawBuffers[phase] = VK_NULL_HANDLE;
+		frame.drawMemories[phase] = VK_NULL_HANDLE;
+	}
+
+	frame.capacity = 0;
+}
+
+void OcclusionCulling::writeTestDescriptorSet(frameResources& frame) {
+	VkDescriptorBufferInfo bufferInfos[4]{};
+	bufferInfos[0].buffer = frame.candidateBuffer;
+	bufferInfos[1].buffer = visibilityBuffer;
+	bufferInfos[2].buffer = frame.drawBuffers[0];
+	bufferInfos[3].buffer = frame.drawBuffers[1];
+
+	for (VkDescriptorBufferInfo& bufferInfo : bufferInfos) {
+		bufferInfo.offset = 0;
+		bufferInfo.range = VK_WHOLE_SIZE;
+	}
+
+	VkDescriptorImageInfo pyramidInfo{};
+	pyramidInfo.sampler = sampler;
+	pyramidInfo.imageView = pyramidView;
+	pyramidInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+	VkWriteDescriptorSet descriptorWrites[5]{};
+
+	for (uint32_t i = 0; i < 5; i++) {
+		descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[i].dstSet = frame.descriptorSet;
+		descriptorWrites[i].dstBinding = i;
+		descriptorWrites[i].descriptorCount = 1;
+		descriptorWrites[i].descriptorType = i < 4 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites[i].pBufferInfo = i < 4 ? &bufferInfos[i] : nullptr;
+		descriptorWrites[i].pImageInfo = i < 4 ? nullptr : &pyramidInfo;
+	}
+
+	vkUpdateDescriptorSets(application->renderer.getDevice(), 5, descriptorWrites, 0, nullptr);
+}
+
+void OcclusionCulling::recordFirstPhase(VkCommandBuffer commandBuffer, uint32_t frameIndex, const glm::mat4& viewProjection, const std::vector<candidate>& candidates, uint32_t objectCount) {
+	trace_zone("OcclusionCulling::recordFirstPhase");
+
+	currentFrame = frameIndex;
+	candidateCount = static_cast<uint32_t>(candidates.size());
+	this->viewProjection = viewProjection;
+
+	if (candidateCount == 0) {
+		return;
+	}
+
+	frameResources& frame = frames[currentFrame];
+
+	ensureVisibilityBuffer(commandBuffer, objectCount);
+	ensureFrameResources(frame, candidateCount);
+	writeTestDescriptorSet(frame);
+
+	std::memcpy(frame.mappedCandidates, candidates.data(), candidates.size() * sizeof(candidate));
+
+	recordTest(commandBuffer, 0);
+
+	stats.frames++;
+	stats.candidates += candidateCount;
+}
+
+void OcclusionCulling::recordSecondPhase(VkCommandBuffer commandBuffer) {
+	trace_zone("OcclusionCulling::recordSecondPhase");
+
+	if (candidateCount == 0) {
+		return;
+	}
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	barrierTracker.transitionImage(application->swapchain.getDepthImage(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+	barrierTracker.transitionImage(pyramidImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+
+	VkExtent2D depthExtent = application->swapchain.getExtent();
+
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		if (level > 0) {
+			barrierTracker.transitionImage(pyramidImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+			barrierTracker.flush(commandBuffer);
+		}
+
+		reduceConstants constants{};
+		constants.sourceSize = level == 0 ? glm::ivec2(depthExtent.width, depthExtent.height) : glm::ivec2(std::max(pyramidExtent.width >> (level - 1), 1u), std::max(pyramidExtent.height >> (level - 1), 1u));
+		constants.destinationSize = glm::ivec2(std::max(pyramidExtent.width >> level, 1u), std::max(pyramidExtent.height >> level, 1u));
+
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipelineLayout, 0, 1, &reduceSets[level], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, reducePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(reduceConstants), &constants);
+		vkCmdDispatch(commandBuffer, (constants.destinationSize.x + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE, (constants.destinationSize.y + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE, 1);
+	}
+
+	barrierTracker.transitionImage(pyramidImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+	recordTest(commandBuffer, 1);
+}
+
+void OcclusionCulling::recordTest(VkCommandBuffer commandBuffer, uint32_t phase) {
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+	frameResources& frame = frames[currentFrame];
+
+	barrierTracker.accessBuffer(visibilityBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, phase == 0 ? VK_ACCESS_2_SHADER_STORAGE_READ_BIT : VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+	barrierTracker.accessBuffer(frame.drawBuffers[phase], VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	testConstants constants{};
+	constants.viewProjection = viewProjection;
+	constants.pyramidSize = glm::vec2(static_cast<float>(pyramidExtent.width), static_cast<float>(pyramidExtent.height));
+	constants.candidateCount = candidateCount;
+	constants.phase = phase;
+	constants.maxLevel = static_cast<float>(pyramidLevels - 1);
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, testPipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, testPipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr);
+	vkCmdPushConstants(commandBuffer, testPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(testConstants), &constants);
+	vkCmdDispatch(commandBuffer, (candidateCount + TEST_GROUP_SIZE - 1) / TEST_GROUP_SIZE, 1, 1);
+
+	barrierTracker.accessBuffer(frame.drawBuffers[phase], VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+	barrierTracker.flush(commandBuffer);
+}
+
+VkBuffer OcclusionCulling::getDrawBuffer(uint32_t phase) {
+	return frames[currentFrame].drawBuffers[phase];
+}
+
+OcclusionCulling::statistics OcclusionCulling::getStatistics() {
+	return stats;
+}
+
+void OcclusionCulling::cleanup() {
+	log_info("Cleaning up occlusion culling...");
+
+	if (application == nullptr) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+
+	for (frameResources& frame : frames) {
+		destroyFrameResources(frame);
+	}
+
+	frames.clear();
+
+	if (visibilityBuffer != VK_NULL_HANDLE) {
+		application->renderer.barrierTracker.forgetBuffer(visibilityBuffer);
+
+		vkDestroyBuffer(device, visibilityBuffer, nullptr);
+		vkFreeMemory(device, visibilityMemory, nullptr);
+
+		visibilityBuffer = VK_NULL_HANDLE;
+		visibilityMemory = VK_NULL_HANDLE;
+		visibilityCapacity = 0;
+	}
+
+	destroyPyramid();
+
+	application->pipelines.destroyPipeline(reducePipeline);
+	application->pipelines.destroyPipeline(testPipeline);
+	vkDestroyPipelineLayout(device, reducePipelineLayout, nullptr);
+	vkDestroyPipelineLayout(device, testPipelineLayout, nullptr);
+
+	vkDestroySampler(device, sampler, nullptr);
+	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+	vkDestroyDescriptorSetLayout(device, reduceSetLayout, nullptr);
+	vkDestroyDescriptorSetLayout(device, testSetLayout, nullptr);
+
+	log_info("Occlusion culling tested " + std::to_string(stats.candidates) + " candidates over " + std::to_string(stats.frames) + " frames!");
+
+	log_info("Occlusion culling cleaned up!");
+}
\ No newline at end of file
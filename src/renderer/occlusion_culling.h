@@ -0,0 +1,113 @@
+#pragma once
+#define occlusion_culling_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class OcclusionCulling {
+	public:
+		static constexpr uint32_t MAX_PYRAMID_LEVELS = 16;
+		static constexpr uint32_t REDUCE_GROUP_SIZE = 8;
+		static constexpr uint32_t TEST_GROUP_SIZE = 64;
+
+		struct candidate {
+			glm::vec3 boundsMin;
+			uint32_t object;
+			glm::vec3 boundsMax;
+			uint32_t indexCount;
+		};
+
+		struct statistics {
+			uint64_t frames = 0;
+			uint64_t candidates = 0;
+			uint32_t pyramidLevels = 0;
+			VkExtent2D pyramidExtent{};
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		void onSwapchainRecreated();
+
+		void recordFirstPhase(VkCommandBuffer commandBuffer, uint32_t frameIndex, const glm::mat4& viewProjection, const std::vector<candidate>& candidates, uint32_t objectCount);
+		void recordSecondPhase(VkCommandBuffer commandBuffer);
+
+		VkBuffer getDrawBuffer(uint32_t phase);
+
+		statistics getStatistics();
+	private:
+		struct reduceConstants {
+			glm::ivec2 sourceSize;
+			glm::ivec2 destinationSize;
+		};
+
+		struct testConstants {
+			glm::mat4 viewProjection;
+			glm::vec2 pyramidSize;
+			uint32_t candidateCount;
+			uint32_t phase;
+			float maxLevel;
+		};
+
+		struct frameResources {
+			VkBuffer candidateBuffer = VK_NULL_HANDLE;
+			VkDeviceMemory candidateMemory = VK_NULL_HANDLE;
+			void* mappedCandidates = nullptr;
+			VkBuffer drawBuffers[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+			VkDeviceMemory drawMemories[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+			uint32_t capacity = 0;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		};
+
+		Application* application = nullptr;
+
+		VkDescriptorSetLayout reduceSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSetLayout testSetLayout = VK_NULL_HANDLE;
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkSampler sampler = VK_NULL_HANDLE;
+
+		VkPipelineLayout reducePipelineLayout = VK_NULL_HANDLE;
+		VkPipelineLayout testPipelineLayout = VK_NULL_HANDLE;
+		VkPipeline reducePipeline = VK_NULL_HANDLE;
+		VkPipeline testPipeline = VK_NULL_HANDLE;
+
+		VkImage pyramidImage = VK_NULL_HANDLE;
+		VkDeviceMemory pyramidMemory = VK_NULL_HANDLE;
+		VkImageView pyramidView = VK_NULL_HANDLE;
+		VkImageView levelViews[MAX_PYRAMID_LEVELS] = {};
+		VkDescriptorSet reduceSets[MAX_PYRAMID_LEVELS] = {};
+		VkExtent2D pyramidExtent{};
+		uint32_t pyramidLevels = 0;
+
+		VkBuffer visibilityBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory visibilityMemory = VK_NULL_HANDLE;
+		uint32_t visibilityCapacity = 0;
+
+		std::vector<frameResources> frames;
+		uint32_t currentFrame = 0;
+		uint32_t candidateCount = 0;
+		glm::mat4 viewProjection{ 1.0f };
+
+		statistics stats;
+
+		void createDescriptorSetLayouts();
+		void createSampler();
+		void createPipelines();
+
+		void createPyramid();
+		void destroyPyramid();
+
+		void ensureVisibilityBuffer(VkCommandBuffer commandBuffer, uint32_t objectCount);
+		void ensureFrameResources(frameResources& frame, uint32_t count);
+		void destroyFrameResources(frameResources& frame);
+		void writeTestDescriptorSet(frameResources& frame);
+
+		void recordTest(VkCommandBuffer commandBuffer, uint32_t phase);
+
+		static uint32_t previousPowerOfTwo(uint32_t value);
+};
\ No newline at end of file
@@ -10,13 +10,14 @@ void Pipelines::init(Application& application) {
 }
 
 VkPipeline Pipelines::createPipeline(const pipelineStructure pipelineStructure) {
+	trace_zone("Pipelines::createPipeline");
+
 	log_info("Creating pipeline...");
 	
-	auto vertexShaderCode = fileSystem.readFile(pipelineStructure.vertexShaderPath);
-	auto fragmentShaderCode = fileSystem.readFile(pipelineStructure.fragmentShaderPath);
+	auto shaderCode = loadShaderCode({ pipelineStructure.vertexShaderPath, pipelineStructure.fragmentShaderPath });
 
-	VkShaderModule vertexShaderModule = application->shaders.createShaderModule(vertexShaderCode);
-	VkShaderModule fragmentShaderModule = application->shaders.createShaderModule(fragmentShaderCode);
+	VkShaderModule vertexShaderModule = application->shaders.createShaderModule(shaderCode[0]);
+	VkShaderModule fragmentShaderModule = application->shaders.createShaderModule(shaderCode[1]);
 
 	VkPipelineShaderStageCreateInfo vertexShaderStageCreateInfo{};
 	vertexShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -73,17 +74,213 @@ VkPipeline Pipelines::createPipeline(const pipelineStructure pipelineStructure)
 	return pipeline;
 }
 
-VkPipelineLayout Pipelines::createPipelineLayout() {
+std::vector<std::vector<char>> Pipelines::loadShaderCode(const std::vector<std::string>& shaderPaths) {
+	std::vector<std::vector<char>> shaderCode(shaderPaths.size());
+	std::vector<std::string> missingPaths;
+	std::vector<size_t> missingIndices;
+
+	{
+		std::lock_guard<std::mutex> lock(shaderCacheMutex);
+
+		for (size_t i = 0; i < shaderPaths.size(); i++) {
+			auto cached = shaderCache.find(shaderPaths[i]);
+
+			if (cached != shaderCache.end()) {
+				shaderCode[i] = cached->second;
+			}
+			else {
+				missingPaths.push_back(shaderPaths[i]);
+				missingIndices.push_back(i);
+			}
+		}
+	}
+
+	if (missingPaths.empty()) {
+		return shaderCode;
+	}
+
+	std::vector<std::vector<char>> loadedCode = fileSystem.readFiles(application->jobSystem, missingPaths);
+
+	std::lock_guard<std::mutex> lock(shaderCacheMutex);
+
+	for (size_t i = 0; i < missingPaths.size(); i++) {
+		shaderCache[missingPaths[i]] = loadedCode[i];
+		shaderCode[missingIndices[i]] = std::move(loadedCode[i]);
+	}
+
+	return shaderCode;
+}
+
+void Pipelines::clearShaderCache() {
+	std::lock_guard<std::mutex> lock(shaderCacheMutex);
+
+	shaderCache.clear();
+}
+
+std::vector<VkPipeline> Pipelines::createPipelines(const std::vector<pipelineStructure>& pipelineStructures) {
+	trace_zone("Pipelines::createPipelines");
+
+	std::vector<VkPipeline> pipelines(pipelineStructures.size(), VK_NULL_HANDLE);
+
+	application->jobSystem.parallelFor(static_cast<uint32_t>(pipelineStructures.size()), 1, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) {
+			pipelines[i] = createPipeline(pipelineStructures[i]);
+		}
+	});
+
+	return pipelines;
+}
+
+VkPipeline Pipelines::createComputePipeline(const std::string& computeShaderPath, VkPipelineLayout pipelineLayout) {
+	trace_zone("Pipelines::createComputePipeline");
+
+	log_info("Creating compute pipeline...");
+
+	auto shaderCode = loadShaderCode({ computeShaderPath });
+
+	VkShaderModule computeShaderModule = application->shaders.createShaderModule(shaderCode[0]);
+
+	VkComputePipelineCreateInfo computePipelineCreateInfo{};
+	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	computePipelineCreateInfo.stage.module = computeShaderModule;
+	computePipelineCreateInfo.stage.pName = "main";
+	computePipelineCreateInfo.layout = pipelineLayout;
+	computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+	computePipelineCreateInfo.basePipelineIndex = -1;
+
+	VkPipeline pipeline;
+
+	VkResult computePipelineResult = vkCreateComputePipelines(application->renderer.getDevice(), VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &pipeline);
+
+	if (computePipelineResult != VK_SUCCESS) {
+		log_error("Failed to create compute pipeline!");
+	}
+	else {
+		log_info("Successfully created compute pipeline!");
+	}
+
+	application->shaders.destroyShaderModule(computeShaderModule);
+
+	return pipeline;
+}
+
+void Pipelines::hashBytes(uint64_t& hash, const void* data, size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+}
+
+uint64_t Pipelines::hashPipelineStructure(const pipelineStructure& pipelineStructure) {
+	uint64_t hash = 14695981039346656037ull;
+
+	hashBytes(hash, pipelineStructure.vertexShaderPath.data(), pipelineStructure.vertexShaderPath.size());
+	hashValue(hash, '\0');
+	hashBytes(hash, pipelineStructure.fragmentShaderPath.data(), pipelineStructure.fragmentShaderPath.size());
+	hashValue(hash, '\0');
+
+	const VkPipelineVertexInputStateCreateInfo& vertexInput = pipelineStructure.vertexInputStateCreateInfo;
+
+	hashValue(hash, vertexInput.vertexBindingDescriptionCount);
+
+	for (uint32_t i = 0; i < vertexInput.vertexBindingDescriptionCount; i++) {
+		hashValue(hash, vertexInput.pVertexBindingDescriptions[i].binding);
+		hashValue(hash, vertexInput.pVertexBindingDescriptions[i].stride);
+		hashValue(hash, vertexInput.pVertexBindingDescriptions[i].inputRate);
+	}
+
+	hashValue(hash, vertexInput.vertexAttributeDescriptionCount);
+
+	for (uint32_t i = 0; i < vertexInput.vertexAttributeDescriptionCount; i++) {
+		hashValue(hash, vertexInput.pVertexAttributeDescriptions[i].location);
+		hashValue(hash, vertexInput.pVertexAttributeDescriptions[i].binding);
+		hashValue(hash, vertexInput.pVertexAttributeDescriptions[i].format);
+		hashValue(hash, vertexInput.pVertexAttributeDescriptions[i].offset);
+	}
+
+	hashValue(hash, pipelineStructure.inputAssemblyStateCreateInfo.topology);
+	hashValue(hash, pipelineStructure.inputAssemblyStateCreateInfo.primitiveRestartEnable);
+
+	const VkPipelineRasterizationStateCreateInfo& rasterization = pipelineStructure.rasterizationStateCreateInfo;
+
+	hashValue(hash, rasterization.depthClampEnable);
+	hashValue(hash, rasterization.rasterizerDiscardEnable);
+	hashValue(hash, rasterization.polygonMode);
+	hashValue(hash, rasterization.cullMode);
+	hashValue(hash, rasterization.frontFace);
+	hashValue(hash, rasterization.depthBiasEnable);
+	hashValue(hash, rasterization.depthBiasConstantFactor);
+	hashValue(hash, rasterization.depthBiasClamp);
+	hashValue(hash, rasterization.depthBiasSlopeFactor);
+	hashValue(hash, rasterization.lineWidth);
+
+	const VkPipelineMultisampleStateCreateInfo& multisample = pipelineStructure.multisampleStateCreateInfo;
+
+	hashValue(hash, multisample.rasterizationSamples);
+	hashValue(hash, multisample.sampleShadingEnable);
+	hashValue(hash, multisample.minSampleShading);
+	hashValue(hash, multisample.alphaToCoverageEnable);
+	hashValue(hash, multisample.alphaToOneEnable);
+
+	const VkPipelineColorBlendStateCreateInfo& colorBlend = pipelineStructure.colorBlendStateCreateInfo;
+
+	hashValue(hash, colorBlend.logicOpEnable);
+	hashValue(hash, colorBlend.logicOp);
+	hashValue(hash, colorBlend.attachmentCount);
+
+	for (uint32_t i = 0; i < colorBlend.attachmentCount; i++) {
+		hashValue(hash, colorBlend.pAttachments[i]);
+	}
+
+	hashValue(hash, colorBlend.blendConstants);
+
+	if (pipelineStructure.depthStencilStateCreateInfo != nullptr) {
+		const VkPipelineDepthStencilStateCreateInfo& depthStencil = *pipelineStructure.depthStencilStateCreateInfo;
+
+		hashValue(hash, depthStencil.depthTestEnable);
+		hashValue(hash, depthStencil.depthWriteEnable);
+		hashValue(hash, depthStencil.depthCompareOp);
+		hashValue(hash, depthStencil.depthBoundsTestEnable);
+		hashValue(hash, depthStencil.stencilTestEnable);
+		hashValue(hash, depthStencil.front);
+		hashValue(hash, depthStencil.back);
+		hashValue(hash, depthStencil.minDepthBounds);
+		hashValue(hash, depthStencil.maxDepthBounds);
+	}
+	else {
+		hashValue(hash, VK_FALSE);
+	}
+
+	const VkPipelineDynamicStateCreateInfo& dynamicState = pipelineStructure.dynamicStateCreateInfo;
+
+	hashValue(hash, dynamicState.dynamicStateCount);
+
+	for (uint32_t i = 0; i < dynamicState.dynamicStateCount; i++) {
+		hashValue(hash, dynamicState.pDynamicStates[i]);
+	}
+
+	hashValue(hash, pipelineStructure.pipelineLayout);
+	hashValue(hash, pipelineStructure.renderPass);
+	hashValue(hash, pipelineStructure.subpass);
+
+	return hash;
+}
+
+VkPipelineLayout Pipelines::createPipelineLayout(const std::vector<VkPushConstantRange>& pushConstantRanges, const std::vector<VkDescriptorSetLayout>& setLayouts) {
 	log_info("Creating pipeline layout...");
 
 	VkPipelineLayout pipelineLayout;
 
 	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
 	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutCreateInfo.setLayoutCount = 0;
-	pipelineLayoutCreateInfo.pSetLayouts = nullptr;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+	pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+	pipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+	pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+	pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
 
 	VkResult pipelineLayoutResult = vkCreatePipelineLayout(application->renderer.getDevice(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout);
 
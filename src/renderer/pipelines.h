@@ -4,6 +4,8 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <mutex>
 
 #include <vulkan/vulkan.h>
 
@@ -35,9 +37,25 @@ class Pipelines {
 		};
 
 		VkPipeline createPipeline(const pipelineStructure pipelineStructure);
-		VkPipelineLayout createPipelineLayout();
+		std::vector<VkPipeline> createPipelines(const std::vector<pipelineStructure>& pipelineStructures);
+		VkPipeline createComputePipeline(const std::string& computeShaderPath, VkPipelineLayout pipelineLayout);
+		static uint64_t hashPipelineStructure(const pipelineStructure& pipelineStructure);
+		VkPipelineLayout createPipelineLayout(const std::vector<VkPushConstantRange>& pushConstantRanges = {}, const std::vector<VkDescriptorSetLayout>& setLayouts = {});
 
 		void destroyPipeline(VkPipeline pipeline);
+
+		std::vector<std::vector<char>> loadShaderCode(const std::vector<std::string>& shaderPaths);
+		void clearShaderCache();
 	private:
 		Application* application = nullptr;
+
+		std::mutex shaderCacheMutex;
+		std::unordered_map<std::string, std::vector<char>> shaderCache;
+
+		static void hashBytes(uint64_t& hash, const void* data, size_t size);
+
+		template<typename T>
+		static void hashValue(uint64_t& hash, const T& value) {
+			hashBytes(hash, &value, sizeof(value));
+		}
 };
\ No newline at end of file
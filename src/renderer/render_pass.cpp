@@ -12,41 +12,21 @@ void RenderPass::init(Application& application) {
 VkRenderPass RenderPass::createRenderPass(RenderPass::renderPassStructure renderPassStructure) {
 	VkRenderPass renderPass;
 
-	VkAttachmentDescription colorAttachment{};
-	colorAttachment.format = application->swapchain.getImageFormat();
-	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-	VkAttachmentReference colorAttachmentReference{};
-	colorAttachmentReference.attachment = 0;
-	colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-	VkSubpassDescription subpassDescription{};
-	subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpassDescription.colorAttachmentCount = 1;
-	subpassDescription.pColorAttachments = &colorAttachmentReference;
-
-	VkSubpassDependency subpassDependency{};
-	subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-	subpassDependency.dstSubpass = 0;
-	subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-	VkRenderPassCreateInfo renderPassCreateInfo{};
-	renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassCreateInfo.attachmentCount = 1;
-	renderPassCreateInfo.pAttachments = &colorAttachment;
-	renderPassCreateInfo.subpassCount = 1;
-	renderPassCreateInfo.pSubpasses = &subpassDescription;
-	renderPassCreateInfo.dependencyCount = 1;
-	renderPassCreateInfo.pDependencies = &subpassDependency;
-
-	VkResult result = vkCreateRenderPass(application->renderer.getDevice(), &renderPassCreateInfo, nullptr, &renderPass);
+	VkAttachmentDescription attachmentDescriptions[] = { renderPassStructure.attachmentDescription, renderPassStructure.depthAttachmentDescription };
+
+	renderPassStructure.subpassDescription.pColorAttachments = &renderPassStructure.attachmentReference;
+	renderPassStructure.subpassDescription.pDepthStencilAttachment = renderPassStructure.hasDepthAttachment ? &renderPassStructure.depthAttachmentReference : nullptr;
+
+	renderPassStructure.renderPassCreateInfo.attachmentCount = renderPassStructure.hasDepthAttachment ? 2 : 1;
+	renderPassStructure.renderPassCreateInfo.pAttachments = attachmentDescriptions;
+	renderPassStructure.renderPassCreateInfo.pSubpasses = &renderPassStructure.subpassDescription;
+	renderPassStructure.renderPassCreateInfo.pDependencies = &renderPassStructure.subpassDependency;
+
+	if (renderPassStructure.renderPassCreateInfo.dependencyCount > 0 && (renderPassStructure.subpassDependency.srcStageMask == 0 || renderPassStructure.subpassDependency.dstStageMask == 0)) {
+		log_error("Render pass dependency is missing a source or destination stage!");
+	}
+
+	VkResult result = vkCreateRenderPass(application->renderer.getDevice(), &renderPassStructure.renderPassCreateInfo, nullptr, &renderPass);
 
 	if (result != VK_SUCCESS) {
 		log_error("Failed to create render pass!");
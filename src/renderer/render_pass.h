@@ -10,6 +10,9 @@ class RenderPass {
 		struct renderPassStructure {
 			VkAttachmentDescription attachmentDescription;
 			VkAttachmentReference attachmentReference;
+			VkAttachmentDescription depthAttachmentDescription;
+			VkAttachmentReference depthAttachmentReference;
+			bool hasDepthAttachment;
 			VkSubpassDescription subpassDescription;
 			VkSubpassDependency subpassDependency;
 			VkRenderPassCreateInfo renderPassCreateInfo;
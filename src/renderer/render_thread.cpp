@@ -0,0 +1,142 @@
+#include "render_thread.h"
+#include "../application/application.h"
+
+void RenderThread::init(Application& application) {
+	log_info("Initializing render thread...");
+
+	this->application = &application;
+
+	if (!application.options.renderThread) {
+		log_info("Render thread disabled, rendering on the main thread!");
+
+		return;
+	}
+
+	for (uint32_t i = 0; i < PACKET_COUNT; i++) {
+		freePackets.push(i);
+	}
+
+	running.store(true, std::memory_order_release);
+
+	thread = std::thread(&RenderThread::renderLoop, this);
+
+	log_info("Render thread initialized with " + std::to_string(PACKET_COUNT) + " frame packets!");
+}
+
+void RenderThread::cleanup() {
+	if (!thread.joinable()) {
+		return;
+	}
+
+	log_info("Cleaning up render thread...");
+
+	running.store(false, std::memory_order_release);
+
+	readySignal.fetch_add(1, std::memory_order_release);
+	readySignal.notify_all();
+
+	thread.join();
+
+	log_info("Render thread cleaned up!");
+}
+
+bool RenderThread::isEnabled() {
+	return application != nullptr && application->options.renderThread;
+}
+
+uint64_t RenderThread::getSubmittedFrames() {
+	return submittedFrames.load(std::memory_order_acquire);
+}
+
+Renderer::framePacket& RenderThread::beginPacket() {
+	trace_zone("RenderThread::beginPacket");
+
+	throwIfFailed();
+
+	while (!freePackets.pop(currentPacket)) {
+		uint32_t seen = freeSignal.load(std::memory_order_acquire);
+
+		if (freePackets.pop(currentPacket)) {
+			break;
+		}
+
+		throwIfFailed();
+
+		freeSignal.wait(seen, std::memory_order_acquire);
+	}
+
+	return packets[currentPacket];
+}
+
+void RenderThread::submitPacket() {
+	readyPackets.push(currentPacket);
+	currentPacket = UINT32_MAX;
+
+	submittedFrames.fetch_add(1, std::memory_order_release);
+
+	readySignal.fetch_add(1, std::memory_order_release);
+	readySignal.notify_one();
+}
+
+void RenderThread::flush() {
+	trace_zone("RenderThread::flush");
+
+	while (true) {
+		uint32_t seen = freeSignal.load(std::memory_order_acquire);
+
+		if (completedFrames.load(std::memory_order_acquire) >= submittedFrames.load(std::memory_order_acquire)) {
+			return;
+		}
+
+		throwIfFailed();
+
+		freeSignal.wait(seen, std::memory_order_acquire);
+	}
+}
+
+void RenderThread::throwIfFailed() {
+	if (failed.load(std::memory_order_acquire)) {
+		log_warning("Render thread failed!");
+
+		std::rethrow_exception(failure);
+	}
+}
+
+void RenderThread::renderLoop() {
+	tracer.setThreadName("render");
+
+	try {
+		while (true) {
+			uint32_t packetIndex;
+
+			if (!readyPackets.pop(packetIndex)) {
+				uint32_t seen = readySignal.load(std::memory_order_acquire);
+
+				if (!readyPackets.pop(packetIndex)) {
+					if (!running.load(std::memory_order_acquire)) {
+						break;
+					}
+
+					readySignal.wait(seen, std::memory_order_acquire);
+
+					continue;
+				}
+			}
+
+			application->renderer.renderFrame(packets[packetIndex]);
+
+			freePackets.push(packetIndex);
+			completedFrames.fetch_add(1, std::memory_order_release);
+
+			freeSignal.fetch_add(1, std::memory_order_release);
+			freeSignal.notify_one();
+		}
+	}
+	catch (...) {
+		failure = std::current_exception();
+		failed.store(true, std::memory_order_release);
+	}
+
+	freeSignal.fetch_add(1, std::memory_order_release);
+	freeSignal.notify_all();
+}
\ No newline at end of file
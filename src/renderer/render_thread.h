@@ -0,0 +1,54 @@
+#pragma once
+#define render_thread_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "renderer.h"
+#include "../job_system/spsc_queue.h"
+
+class Application;
+
+class RenderThread {
+	public:
+		void init(Application& application);
+		void cleanup();
+
+		bool isEnabled();
+
+		Renderer::framePacket& beginPacket();
+		void submitPacket();
+		void flush();
+
+		uint64_t getSubmittedFrames();
+	private:
+		Application* application = nullptr;
+
+		static const uint32_t PACKET_COUNT = 3;
+
+		std::array<Renderer::framePacket, PACKET_COUNT> packets;
+
+		SpscQueue<uint32_t, 4> freePackets;
+		SpscQueue<uint32_t, 4> readyPackets;
+
+		std::atomic<uint32_t> freeSignal{ 0 };
+		std::atomic<uint32_t> readySignal{ 0 };
+
+		uint32_t currentPacket = UINT32_MAX;
+
+		std::atomic<uint64_t> submittedFrames{ 0 };
+		std::atomic<uint64_t> completedFrames{ 0 };
+
+		std::atomic<bool> running{ false };
+		std::atomic<bool> failed{ false };
+		std::exception_ptr failure;
+
+		std::thread thread;
+
+		void renderLoop();
+		void throwIfFailed();
+};
\ No newline at end of file
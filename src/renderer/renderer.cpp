@@ -9,22 +9,81 @@ void Renderer::init(Application& application) {
 	this->application->pipelines.init(application);
 	this->application->shaders.init(application);
 	this->application->renderpass.init(application);
+	drawQueue.init(application);
+	framePacer.init(application);
+	capabilities.init(application);
+	barrierTracker.init(application);
 
-	createInstance();
-	setupDebugMessenger();
-	createSurface();
-	pickPhysicalDevice();
-	createLogicalDevice();
-	this->application->swapchain.createSwapchain();
-	this->application->swapchain.createImageViews();
-	createRenderPass();
-	createGraphicsPipeline();
-	this->application->swapchain.createFramebuffers();
-	createCommandPool();
-	createCommandBuffers();
-	createSyncObjects();
+	maxFramesInFlight = framePacer.getFramesInFlight();
+}
 
-	log_info("Renderer initialized!");
+void Renderer::addInitSteps(InitGraph& graph) {
+	graph.addStep("instance", { "window" }, [this]() {
+		createInstance();
+	});
+
+	graph.addStep("debug messenger", { "instance" }, [this]() {
+		setupDebugMessenger();
+	});
+
+	graph.addStep("surface", { "instance" }, [this]() {
+		createSurface();
+	});
+
+	graph.addStep("physical device", { "surface" }, [this]() {
+		pickPhysicalDevice();
+	});
+
+	graph.addStep("logical device", { "physical device" }, [this]() {
+		createLogicalDevice();
+	});
+
+	graph.addStep("surface format", { "physical device" }, [this]() {
+		application->swapchain.selectImageFormat();
+	});
+
+	graph.addStep("depth format", { "physical device" }, [this]() {
+		application->swapchain.selectDepthFormat();
+	});
+
+	graph.addStep("swapchain", { "logical device", "surface format", "depth format" }, [this]() {
+		application->swapchain.createSwapchain();
+		application->swapchain.createImageViews();
+		application->swapchain.createDepthImage();
+	});
+
+	graph.addStep("render pass", { "logical device", "surface format", "depth format" }, [this]() {
+		createRenderPass();
+	});
+
+	graph.addStep("graphics pipeline", { "render pass", "shader files" }, [this]() {
+		createGraphicsPipeline();
+	});
+
+	graph.addStep("framebuffers", { "swapchain", "render pass" }, [this]() {
+		application->swapchain.createFramebuffers();
+	});
+
+	graph.addStep("command buffers", { "logical device" }, [this]() {
+		createCommandPool();
+		createCommandBuffers();
+	});
+
+	graph.addStep("sync objects", { "logical device" }, [this]() {
+		createSyncObjects();
+	});
+
+	graph.addStep("gpu profiler", { "logical device" }, [this]() {
+		gpuProfiler.init(*application);
+	});
+
+	graph.addStep("occlusion culling", { "swapchain", "shader files" }, [this]() {
+		occlusionCulling.init(*application);
+	});
+
+	graph.addStep("renderer", { "debug messenger", "graphics pipeline", "framebuffers", "command buffers", "sync objects", "gpu profiler", "occlusion culling" }, []() {
+		log_info("Renderer initialized!");
+	});
 }
 
 std::vector<VkCommandBuffer> Renderer::getCommandBuffers() {
@@ -46,6 +105,75 @@ uint32_t Renderer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags pro
 	log_error("Failed to find suitable memory type!");
 }
 
+void Renderer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+	VkBufferCreateInfo bufferCreateInfo{};
+	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usage;
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VkResult bufferResult = vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer);
+
+	if (bufferResult != VK_SUCCESS) {
+		log_error("Failed to create buffer!");
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, properties);
+
+	VkResult memoryResult = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &bufferMemory);
+
+	if (memoryResult != VK_SUCCESS) {
+		log_error("Failed to allocate buffer memory!");
+	}
+
+	vkBindBufferMemory(device, buffer, bufferMemory, 0);
+}
+
+VkCommandBuffer Renderer::beginSingleTimeCommands() {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+
+	VkCommandBuffer commandBuffer;
+
+	if (vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+		log_error("Failed to allocate single time command buffer!");
+	}
+
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+
+	return commandBuffer;
+}
+
+void Renderer::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
+	vkEndCommandBuffer(commandBuffer);
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+
+	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+		log_error("Failed to submit single time command buffer!");
+	}
+
+	vkQueueWaitIdle(graphicsQueue);
+
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+
 void Renderer::setApplication(Application& application) {
 	this->application = &application;
 }
@@ -59,7 +187,33 @@ VkDevice Renderer::getDevice() {
 	return device;
 }
 
+VkInstance Renderer::getInstance() {
+	return instance;
+}
+
+bool Renderer::getValidationLayersEnabled() {
+	return enableValidationLayers;
+}
+
+uint32_t Renderer::getMaxFramesInFlight() {
+	return maxFramesInFlight;
+}
+
+uint64_t Renderer::getFrameNumber() {
+	return frameNumber.load(std::memory_order_acquire);
+}
+
+VkExtent2D Renderer::getFramebufferExtent() {
+	return framebufferExtent;
+}
+
 void Renderer::createSurface() {
+	if (application->options.headless) {
+		surface = VK_NULL_HANDLE;
+
+		return;
+	}
+
 	log_info("Creating window surface...");
 
 	VkResult result = glfwCreateWindowSurface(instance, application->window.glfwWindow, nullptr, &surface);
@@ -95,15 +249,19 @@ void Renderer::createLogicalDevice() {
 		queueCreateInfos.push_back(createInfo);
 	}
 
-	VkPhysicalDeviceFeatures deviceFeatures{};
+	capabilities.query(physicalDevice, !application->options.headless, framePacer.wantsPresentWait());
+
+	std::vector<const char*> enabledExtensions = getDeviceExtensions();
+	enabledExtensions.insert(enabledExtensions.end(), capabilities.getExtensions().begin(), capabilities.getExtensions().end());
 
 	VkDeviceCreateInfo deviceCreateInfo{};
 	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceCreateInfo.pNext = capabilities.getFeatureChain();
 	deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
 	deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
-	deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
-	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-	deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
+	deviceCreateInfo.pEnabledFeatures = nullptr;
+	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+	deviceCreateInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
 	VkResult result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
 
@@ -116,6 +274,14 @@ void Renderer::createLogicalDevice() {
 	else if (result == VK_SUCCESS) {
 		log_info("Successfully created logical device!");
 	}
+
+	capabilities.logSummary();
+
+	barrierTracker.setSynchronization2(capabilities.get().synchronization2);
+
+	if (capabilities.get().presentWait) {
+		framePacer.enablePresentWait(device);
+	}
 }
 
 const VkRenderPass Renderer::getRenderPass() {
@@ -192,7 +358,14 @@ void Renderer::createGraphicsPipeline() {
 	VkPipelineLayout pipelineLayout = this->application->pipelines.createPipelineLayout();
 	graphicsPipelineLayout = pipelineLayout;
 
-	pipelineStructure.depthStencilStateCreateInfo = nullptr;
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo{};
+	depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencilStateCreateInfo.depthTestEnable = VK_FALSE;
+	depthStencilStateCreateInfo.depthWriteEnable = VK_FALSE;
+	depthStencilStateCreateInfo.depthCompareOp = VK_COMPARE_OP_ALWAYS;
+	depthStencilStateCreateInfo.maxDepthBounds = 1.0f;
+
+	pipelineStructure.depthStencilStateCreateInfo = &depthStencilStateCreateInfo;
 
 	pipelineStructure.pipelineLayout = pipelineLayout;
 	pipelineStructure.renderPass = renderPass;
@@ -207,20 +380,46 @@ void Renderer::createGraphicsPipeline() {
 void Renderer::createRenderPass() {
 	log_info("Creating render pass...");
 
+	renderPass = createRenderPass(VK_ATTACHMENT_LOAD_OP_CLEAR);
+	loadRenderPass = createRenderPass(VK_ATTACHMENT_LOAD_OP_LOAD);
+}
+
+VkRenderPass Renderer::createRenderPass(VkAttachmentLoadOp loadOp) {
+	const bool clear = loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR;
+
 	RenderPass::renderPassStructure renderPassStructure{};
 
 	renderPassStructure.attachmentDescription.format = application->swapchain.getImageFormat();
 	renderPassStructure.attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
-	renderPassStructure.attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	renderPassStructure.attachmentDescription.loadOp = loadOp;
 	renderPassStructure.attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 	renderPassStructure.attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	renderPassStructure.attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	renderPassStructure.attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	renderPassStructure.attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	renderPassStructure.attachmentDescription.initialLayout = clear ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	if (clear) {
+		renderPassStructure.attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	}
+	else {
+		renderPassStructure.attachmentDescription.finalLayout = application->options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	}
 
 	renderPassStructure.attachmentReference.attachment = 0;
 	renderPassStructure.attachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+	renderPassStructure.depthAttachmentDescription.format = application->swapchain.getDepthFormat();
+	renderPassStructure.depthAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+	renderPassStructure.depthAttachmentDescription.loadOp = loadOp;
+	renderPassStructure.depthAttachmentDescription.storeOp = clear ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	renderPassStructure.depthAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	renderPassStructure.depthAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	renderPassStructure.depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	renderPassStructure.depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+	renderPassStructure.depthAttachmentReference.attachment = 1;
+	renderPassStructure.depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	renderPassStructure.hasDepthAttachment = true;
+
 	renderPassStructure.subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 	renderPassStructure.subpassDescription.colorAttachmentCount = 1;
 	renderPassStructure.subpassDescription.pColorAttachments = &renderPassStructure.attachmentReference;
@@ -228,18 +427,17 @@ void Renderer::createRenderPass() {
 	renderPassStructure.subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
 	renderPassStructure.subpassDependency.dstSubpass = 0;
 	renderPassStructure.subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	renderPassStructure.subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	renderPassStructure.subpassDependency.srcAccessMask = clear ? 0 : VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	renderPassStructure.subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	renderPassStructure.subpassDependency.dstAccessMask = clear ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT : VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
 	renderPassStructure.renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassStructure.renderPassCreateInfo.attachmentCount = 1;
-	renderPassStructure.renderPassCreateInfo.pAttachments = &renderPassStructure.attachmentDescription;
 	renderPassStructure.renderPassCreateInfo.subpassCount = 1;
 	renderPassStructure.renderPassCreateInfo.pSubpasses = &renderPassStructure.subpassDescription;
 	renderPassStructure.renderPassCreateInfo.dependencyCount = 1;
 	renderPassStructure.renderPassCreateInfo.pDependencies = &renderPassStructure.subpassDependency;
 
-	VkRenderPass newRenderPass = application->renderpass.createRenderPass(renderPassStructure);
-	renderPass = newRenderPass;
+	return application->renderpass.createRenderPass(renderPassStructure);
 }
 
 void Renderer::createCommandPool() {
@@ -261,7 +459,7 @@ void Renderer::createCommandPool() {
 }
 
 void Renderer::createCommandBuffers() {
-	commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	commandBuffers.resize(maxFramesInFlight);
 
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
 	commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -279,7 +477,7 @@ void Renderer::createCommandBuffers() {
 	}
 }
 
-void Renderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+void Renderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, const framePacket& packet) {
 	VkCommandBufferBeginInfo commandBufferBeginInfo{};
 	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 	commandBufferBeginInfo.flags = 0;
@@ -291,41 +489,121 @@ void Renderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t image
 		log_error("Failed to begin recording command buffer!");
 	}
 
+	gpuProfiler.beginFrame(commandBuffer, currentFrame);
+
+	uint32_t frameScope = gpuProfiler.beginScope(commandBuffer, "frame");
+
+	application->ui.recordUploads(commandBuffer, currentFrame);
+	application->scene.recordUploads(commandBuffer, currentFrame);
+	application->textures.recordUploads(commandBuffer);
+
+	VkExtent2D extent = application->swapchain.getExtent();
+	VkImage depthImage = application->swapchain.getDepthImage();
+
+	if (application->options.occlusionCulling) {
+		application->meshes.writeOcclusionCandidates(extent, currentFrame, packet.visibleMeshes, occlusionCandidates);
+	}
+
+	occlusionCulling.recordFirstPhase(commandBuffer, currentFrame, application->meshes.getViewProjection(extent), occlusionCandidates, application->meshes.getMeshCount());
+
+	barrierTracker.transitionImage(depthImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
 	VkRenderPassBeginInfo renderPassBeginInfo{};
 	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 	renderPassBeginInfo.renderPass = renderPass;
 	renderPassBeginInfo.framebuffer = application->swapchain.getFramebuffers()[imageIndex];
 	renderPassBeginInfo.renderArea.offset = { 0, 0 };
-	renderPassBeginInfo.renderArea.extent = application->swapchain.getExtent();
+	renderPassBeginInfo.renderArea.extent = extent;
 
-	VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
-	renderPassBeginInfo.clearValueCount = 1;
-	renderPassBeginInfo.pClearValues = &clearColor;
+	VkClearValue clearValues[2]{};
+	clearValues[0].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
+	clearValues[1].depthStencil = { 1.0f, 0 };
+	renderPassBeginInfo.clearValueCount = 2;
+	renderPassBeginInfo.pClearValues = clearValues;
 
 	vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-
 	VkViewport viewport{};
 	viewport.x = 0.0f;
 	viewport.y = 0.0f;
-	viewport.width = static_cast<float>(application->swapchain.getExtent().width);
-	viewport.height = static_cast<float>(application->swapchain.getExtent().height);
+	viewport.width = static_cast<float>(extent.width);
+	viewport.height = static_cast<float>(extent.height);
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
 	VkRect2D scissor{};
 	scissor.offset = { 0, 0 };
-	scissor.extent = application->swapchain.getExtent();
+	scissor.extent = extent;
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-	vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+	drawQueue.clear();
+
+	if (!application->meshes.hasMeshes()) {
+		DrawQueue::drawPacket trianglePacket{};
+		trianglePacket.pipeline = graphicsPipeline;
+		trianglePacket.vertexCount = 3;
+		trianglePacket.sortKey = DrawQueue::makeSortKey(DrawQueue::pass::opaque, drawQueue.getPipelineId(graphicsPipeline), 0, 0.0f);
+		drawQueue.submit(trianglePacket);
+	}
+	else if (!application->options.occlusionCulling) {
+		application->meshes.submitDraws(drawQueue, extent, currentFrame, packet.visibleMeshes);
+	}
+
+	drawQueue.sort();
+	drawQueue.buildDrawCommands();
+
+	if (application->meshes.hasMeshes() && !application->options.occlusionCulling) {
+		application->meshes.writeDrawInstances(drawQueue.getInstances());
+	}
 
-	application->ui.render(commandBuffer);
+	{
+		GpuProfileScope scope(gpuProfiler, commandBuffer, "draw queue pass");
+		drawQueue.record(commandBuffer, DrawQueue::pass::opaque);
+		drawQueue.record(commandBuffer, DrawQueue::pass::transparent);
+	}
+
+	if (!occlusionCandidates.empty()) {
+		GpuProfileScope scope(gpuProfiler, commandBuffer, "mesh pass");
+		application->meshes.render(commandBuffer, occlusionCulling.getDrawBuffer(0));
+	}
 
 	vkCmdEndRenderPass(commandBuffer);
 
+	barrierTracker.setImageState(depthImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+	{
+		GpuProfileScope scope(gpuProfiler, commandBuffer, "occlusion culling");
+		occlusionCulling.recordSecondPhase(commandBuffer);
+	}
+
+	barrierTracker.transitionImage(depthImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	renderPassBeginInfo.renderPass = loadRenderPass;
+
+	vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+	if (!occlusionCandidates.empty()) {
+		GpuProfileScope scope(gpuProfiler, commandBuffer, "occluded mesh pass");
+		application->meshes.render(commandBuffer, occlusionCulling.getDrawBuffer(1));
+	}
+
+	{
+		GpuProfileScope scope(gpuProfiler, commandBuffer, "ui pass");
+		application->ui.render(commandBuffer, extent);
+	}
+
+	vkCmdEndRenderPass(commandBuffer);
+
+	barrierTracker.setImageState(application->swapchain.getImage(imageIndex), application->options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+
+	gpuProfiler.endScope(commandBuffer, frameScope);
+
 	VkResult commandBufferResult = vkEndCommandBuffer(commandBuffer);
 
 	if (commandBufferResult != VK_SUCCESS) {
@@ -334,9 +612,9 @@ void Renderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t image
 }
 
 void Renderer::createSyncObjects() {
-	imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+	imageAvailableSemaphores.resize(maxFramesInFlight);
+	renderFinishedSemaphores.resize(maxFramesInFlight);
+	inFlightFences.resize(maxFramesInFlight);
 
 	VkSemaphoreCreateInfo semaphoreCreateInfo{};
 	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -345,7 +623,7 @@ void Renderer::createSyncObjects() {
 	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 	fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 	
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+	for (uint32_t i = 0; i < maxFramesInFlight; i++) {
 		VkResult imageAvailableSemaphoreResult = vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &imageAvailableSemaphores[i]);
 		VkResult renderFinishedSemaphoreResult = vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &renderFinishedSemaphores[i]);
 		VkResult inFlightFenceResult = vkCreateFence(device, &fenceCreateInfo, nullptr, &inFlightFences[i]);
@@ -366,12 +644,19 @@ void Renderer::cleanup() {
 
 	application->swapchain.cleanup();
 
+	drawQueue.cleanup();
+	barrierTracker.cleanup();
+	gpuProfiler.cleanup();
+	occlusionCulling.cleanup();
+	framePacer.cleanup();
+
 	vkDestroyPipeline(device, graphicsPipeline, nullptr);
 	vkDestroyPipelineLayout(device, graphicsPipelineLayout, nullptr);
 
 	vkDestroyRenderPass(device, renderPass, nullptr);
+	vkDestroyRenderPass(device, loadRenderPass, nullptr);
 
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+	for (uint32_t i = 0; i < maxFramesInFlight; i++) {
 		vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
 		vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
 		vkDestroyFence(device, inFlightFences[i], nullptr);
@@ -392,14 +677,111 @@ void Renderer::cleanup() {
 }
 
 void Renderer::drawFrame() {
-	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+	trace_zone("Renderer::drawFrame");
+
+	application->ui.drawUI();
+
+	if (!isFrameNeeded()) {
+		return;
+	}
+
+	buildFramePacket(immediatePacket);
+	renderFrame(immediatePacket);
+}
+
+bool Renderer::isFrameNeeded() {
+	if (application->options.headless) {
+		return true;
+	}
+
+	if (application->window.isMinimized()) {
+		return false;
+	}
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	bool needed = !application->options.idleRendering || damaged.exchange(false) || application->ui.isDirty() || now - lastFrameTime >= std::chrono::milliseconds(application->options.maxIdleMilliseconds);
+
+	if (needed) {
+		lastFrameTime = now;
+	}
+
+	return needed;
+}
+
+bool Renderer::canIdle() {
+	return application->options.idleRendering && !damaged.load(std::memory_order_acquire) && !application->ui.isDirty();
+}
+
+double Renderer::getIdleTimeout() {
+	std::chrono::steady_clock::time_point nextRefresh = lastFrameTime + std::chrono::milliseconds(application->options.maxIdleMilliseconds);
+
+	return std::max(0.0, std::chrono::duration<double>(nextRefresh - std::chrono::steady_clock::now()).count());
+}
+
+void Renderer::markDamaged() {
+	if (!damaged.exchange(true) && !application->options.headless) {
+		glfwPostEmptyEvent();
+	}
+}
+
+void Renderer::buildFramePacket(framePacket& packet) {
+	trace_zone("Renderer::buildFramePacket");
+
+	application->ui.writeFrameData(packet.ui);
+	application->scene.writeFrameData(packet.scene);
+	application->input.writeFrameEvents(packet.inputEvents);
+
+	if (application->options.headless) {
+		packet.framebufferExtent = { application->window.getWindowWidth(*application), application->window.getWindowHeight(*application) };
+	}
+	else {
+		int width = 0, height = 0;
+		glfwGetFramebufferSize(application->window.glfwWindow, &width, &height);
+
+		packet.framebufferExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+	}
+
+	application->meshes.cull(packet.framebufferExtent, packet.visibleMeshes);
+
+	packet.frameNumber = builtFrames++;
+	packet.buildTime = std::chrono::steady_clock::now();
+}
+
+void Renderer::renderFrame(const framePacket& packet) {
+	trace_zone("Renderer::renderFrame");
 
-	uint32_t imageIndex;
-	VkResult acquireNextImageResult = vkAcquireNextImageKHR(device, application->swapchain.getSwapchain(), UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+	application->ui.applyFrameData(packet.ui);
+	application->scene.applyFrameData(packet.scene);
 
-	if (acquireNextImageResult == VK_ERROR_OUT_OF_DATE_KHR || acquireNextImageResult == VK_SUBOPTIMAL_KHR || framebufferResized) {
-		framebufferResized = false;
+	if (application->renderThread.isEnabled()) {
+		framePacer.waitForFrameStart();
+	}
+
+	framebufferExtent = packet.framebufferExtent;
+
+	if (framebufferExtent.width == 0 || framebufferExtent.height == 0) {
+		return;
+	}
+
+	{
+		trace_zone("fence wait");
+		vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+	}
+
+	const bool headless = application->options.headless;
+
+	uint32_t imageIndex = currentFrame;
+	VkResult acquireNextImageResult = VK_SUCCESS;
+
+	if (!headless) {
+		trace_zone("acquire");
+		acquireNextImageResult = vkAcquireNextImageKHR(device, application->swapchain.getSwapchain(), UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+	}
+
+	if (acquireNextImageResult == VK_ERROR_OUT_OF_DATE_KHR || acquireNextImageResult == VK_SUBOPTIMAL_KHR || framebufferResized.exchange(false)) {
 		application->swapchain.recreateSwapchain();
+		markDamaged();
 
 		log_info("Swap chain out of date, recreating...");
 
@@ -409,12 +791,13 @@ void Renderer::drawFrame() {
 		log_error("Failed to acquire swap chain image!");
 	}
 
-	application->ui.drawUI();
-
 	vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
-	vkResetCommandBuffer(commandBuffers[currentFrame], 0);
-	recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+	{
+		trace_zone("record");
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], imageIndex, packet);
+	}
 
 	VkSubmitInfo submitInfo{};
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -422,7 +805,7 @@ void Renderer::drawFrame() {
 	VkSemaphore waitSemaphores[] = { imageAvailableSemaphores[currentFrame]};
 	VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
 	
-	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.waitSemaphoreCount = headless ? 0 : 1;
 	submitInfo.pWaitSemaphores = waitSemaphores;
 	submitInfo.pWaitDstStageMask = waitStages;
 	submitInfo.commandBufferCount = 1;
@@ -430,15 +813,34 @@ void Renderer::drawFrame() {
 
 	VkSemaphore signalSemaphores[] = { renderFinishedSemaphores[currentFrame]};
 	
-	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.signalSemaphoreCount = headless ? 0 : 1;
 	submitInfo.pSignalSemaphores = signalSemaphores;
 
-	VkResult queueSubmitResult = vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]);
+	VkResult queueSubmitResult;
+
+	{
+		trace_zone("submit");
+		queueSubmitResult = vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]);
+	}
 
 	if (queueSubmitResult != VK_SUCCESS) {
 		log_error("Failed to submit draw!");
 	}
 
+	uint64_t renderedFrames = frameNumber.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+	if (headless) {
+		if (!application->options.readbackPath.empty() && renderedFrames == application->options.frameCount) {
+			vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+
+			application->swapchain.readbackImage(imageIndex, application->options.readbackPath);
+		}
+
+		currentFrame = (currentFrame + 1) % maxFramesInFlight;
+
+		return;
+	}
+
 	VkPresentInfoKHR presentInfo{};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 	presentInfo.waitSemaphoreCount = 1;
@@ -451,9 +853,32 @@ void Renderer::drawFrame() {
 	presentInfo.pImageIndices = &imageIndex;
 	presentInfo.pResults = nullptr;
 
-	vkQueuePresentKHR(graphicsQueue, &presentInfo);
+	uint64_t presentId = 0;
+
+	VkPresentIdKHR presentIdInfo{};
+	presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+	presentIdInfo.swapchainCount = 1;
+	presentIdInfo.pPresentIds = &presentId;
+
+	if (framePacer.isPresentWaitEnabled()) {
+		presentId = framePacer.nextPresentId();
+		presentInfo.pNext = &presentIdInfo;
+	}
+
+	{
+		trace_zone("present");
+		vkQueuePresentKHR(graphicsQueue, &presentInfo);
+	}
+
+	framePacer.onPresent(packet.buildTime);
+
+	if (renderedFrames == 1) {
+		log_info("First frame presented " + std::to_string(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - application->getLaunchTime()).count()) + " ms after launch!");
+	}
+
+	application->input.recordPresent(packet.inputEvents, std::chrono::steady_clock::now());
 
-	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	currentFrame = (currentFrame + 1) % maxFramesInFlight;
 }
 
 void Renderer::createInstance() {
@@ -532,9 +957,13 @@ bool Renderer::checkValidationLayerSupport() {
 }
 
 std::vector<const char*> Renderer::getRequiredExtensions() {
-	glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+	std::vector<const char*> extensions;
 
-	std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	if (!application->options.headless) {
+		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	if (enableValidationLayers) {
 		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -607,19 +1036,86 @@ void Renderer::pickPhysicalDevice() {
 	std::vector<VkPhysicalDevice> devices(deviceCount);
 	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+	VkPhysicalDevice cachedDevice = findCachedPhysicalDevice(devices);
+
+	if (cachedDevice != VK_NULL_HANDLE && isPhysicalDeviceSuitable(cachedDevice)) {
+		setPhysicalDevice(cachedDevice);
+
+		log_info("Successfully picked cached physical device!");
+
+		return;
+	}
+
+	VkPhysicalDevice bestDevice = VK_NULL_HANDLE;
+	int64_t bestScore = -1;
+
 	for (const auto& device : devices) {
-		if (isPhysicalDeviceSuitable(device)) {
-			setPhysicalDevice(device);
+		if (!isPhysicalDeviceSuitable(device)) {
+			continue;
+		}
 
-			log_info("Successfully picked physical device!");
+		int64_t score = DeviceCapabilities::scoreDevice(device);
 
-			break;
+		if (score > bestScore) {
+			bestDevice = device;
+			bestScore = score;
 		}
 	}
 
-	if (getPhysicalDevice() == VK_NULL_HANDLE) {
+	if (bestDevice == VK_NULL_HANDLE) {
 		log_error("Failed to find a suitable physical device!");
 	}
+
+	indices = findQueueFamilies(bestDevice);
+	setPhysicalDevice(bestDevice);
+
+	log_info("Successfully picked physical device with score " + std::to_string(bestScore) + "!");
+
+	writePhysicalDeviceCache(getPhysicalDevice());
+}
+
+VkPhysicalDevice Renderer::findCachedPhysicalDevice(const std::vector<VkPhysicalDevice>& devices) {
+	if (application->options.deviceCachePath.empty()) {
+		return VK_NULL_HANDLE;
+	}
+
+	std::ifstream file(application->options.deviceCachePath);
+
+	uint32_t vendorID = 0, deviceID = 0, driverVersion = 0;
+
+	if (!(file >> vendorID >> deviceID >> driverVersion)) {
+		return VK_NULL_HANDLE;
+	}
+
+	for (VkPhysicalDevice device : devices) {
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(device, &properties);
+
+		if (properties.vendorID == vendorID && properties.deviceID == deviceID && properties.driverVersion == driverVersion) {
+			return device;
+		}
+	}
+
+	return VK_NULL_HANDLE;
+}
+
+void Renderer::writePhysicalDeviceCache(VkPhysicalDevice physicalDevice) {
+	if (application->options.deviceCachePath.empty()) {
+		return;
+	}
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	std::ofstream file(application->options.deviceCachePath, std::ios::trunc);
+
+	if (!file.is_open()) {
+		log_warning("Failed to write physical device cache: " + application->options.deviceCachePath);
+
+		return;
+	}
+
+	file << properties.vendorID << " " << properties.deviceID << " " << properties.driverVersion << " " << properties.deviceName;
 }
 
 bool Renderer::isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice) {
@@ -628,8 +1124,11 @@ bool Renderer::isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice) {
 	bool extensionsSupported = checkPhysicalDeviceExtensionSupport(physicalDevice);
 
 	bool swapChainAdequate = false;
-	
-	if (extensionsSupported) {
+
+	if (application->options.headless) {
+		swapChainAdequate = true;
+	}
+	else if (extensionsSupported) {
 		Swapchain::swapchainSupportDetails swapchainSupport = application->swapchain.querySwapchainSupport(*application, physicalDevice);
 		swapChainAdequate = !swapchainSupport.surfaceFormats.empty() && !swapchainSupport.presentModes.empty();
 	}
@@ -637,6 +1136,14 @@ bool Renderer::isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice) {
 	return indices.isComplete() && extensionsSupported && swapChainAdequate;
 }
 
+const std::vector<const char*> Renderer::getDeviceExtensions() {
+	if (application->options.headless) {
+		return {};
+	}
+
+	return deviceExtensions;
+}
+
 bool Renderer::checkPhysicalDeviceExtensionSupport(VkPhysicalDevice physicalDevice) {
 	uint32_t extensionCount;
 
@@ -645,7 +1152,9 @@ bool Renderer::checkPhysicalDeviceExtensionSupport(VkPhysicalDevice physicalDevi
 	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
 	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
 	
-	std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+	const std::vector<const char*> enabledExtensions = getDeviceExtensions();
+
+	std::set<std::string> requiredExtensions(enabledExtensions.begin(), enabledExtensions.end());
 
 	for (const auto &extension : availableExtensions) {
 		requiredExtensions.erase(extension.extensionName);
@@ -671,7 +1180,13 @@ const Renderer::queueFamilyIndices Renderer::findQueueFamilies(VkPhysicalDevice
 			//log_info("Graphics support found!");
 
 			VkBool32 presentSupport = false;
-			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+
+			if (application->options.headless) {
+				presentSupport = true;
+			}
+			else {
+				vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+			}
 
 			if (presentSupport) {
 				indices.presentFamily = i;
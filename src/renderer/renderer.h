@@ -8,31 +8,74 @@
 #include <limits>
 #include <algorithm>
 #include <cstring>
+#include <atomic>
+#include <chrono>
 
 #include "vulkan/vulkan.h"
 #include "swapchain.h"
 #include "pipelines.h"
 #include "shaders/shaders.h"
 #include "render_pass.h"
-
+#include "draw_queue.h"
+#include "gpu_profiler.h"
+#include "occlusion_culling.h"
+#include "frame_pacer.h"
+#include "device_capabilities.h"
+#include "barrier_tracker.h"
+#include "../application/init_graph.h"
+#include "../ui/ui.h"
+#include "../scene/scene.h"
+#include "../input/input.h"
+
+#ifdef _WIN32
 #define VK_USE_PLATFORM_WIN32_KHR
+#endif
 
 class Renderer {
 	public:
 		void init(Application& application);
+		void addInitSteps(InitGraph& graph);
 		void cleanup();
 		
 		const VkRenderPass getRenderPass();
 
+		struct framePacket {
+			uint64_t frameNumber = 0;
+			std::chrono::steady_clock::time_point buildTime;
+			VkExtent2D framebufferExtent{};
+			UI::frameData ui;
+			Scene::frameData scene;
+			std::vector<uint32_t> visibleMeshes;
+			std::vector<Input::eventStamp> inputEvents;
+		};
+
 		void drawFrame();
+		void buildFramePacket(framePacket& packet);
+		void renderFrame(const framePacket& packet);
+
+		bool isFrameNeeded();
+		bool canIdle();
+		double getIdleTimeout();
+		void markDamaged();
 
 		VkSurfaceKHR surface;
-		bool framebufferResized = false;
+		std::atomic<bool> framebufferResized{ false };
 
 		Swapchain swapchain;
+		DrawQueue drawQueue;
+		GpuProfiler gpuProfiler;
+		OcclusionCulling occlusionCulling;
+		DeviceCapabilities capabilities;
+		BarrierTracker barrierTracker;
+		FramePacer framePacer;
 
 		const VkPhysicalDevice getPhysicalDevice();
 		VkDevice getDevice();
+		VkInstance getInstance();
+		bool getValidationLayersEnabled();
+		uint32_t getMaxFramesInFlight();
+		uint64_t getFrameNumber();
+		VkExtent2D getFramebufferExtent();
 		std::vector<VkCommandBuffer> getCommandBuffers();
 
 		struct queueFamilyIndices {
@@ -45,6 +88,10 @@ class Renderer {
 		};
 
 		uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+		void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
+
+		VkCommandBuffer beginSingleTimeCommands();
+		void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
 		queueFamilyIndices indices;
 		const queueFamilyIndices findQueueFamilies(VkPhysicalDevice physicalDevice);
@@ -55,7 +102,7 @@ class Renderer {
 		Application* application = nullptr;
 		void setApplication(Application& application);
 
-		const int MAX_FRAMES_IN_FLIGHT = 2;
+		uint32_t maxFramesInFlight = 2;
 
 		VkDevice device;
 
@@ -63,6 +110,7 @@ class Renderer {
 			VK_KHR_SWAPCHAIN_EXTENSION_NAME
 		};
 
+		const std::vector<const char*> getDeviceExtensions();
 		bool checkPhysicalDeviceExtensionSupport(VkPhysicalDevice physicalDevice);
 
 		void createInstance();
@@ -87,6 +135,8 @@ class Renderer {
 		VkInstance instance = VK_NULL_HANDLE;
 
 		void pickPhysicalDevice();
+		VkPhysicalDevice findCachedPhysicalDevice(const std::vector<VkPhysicalDevice>& devices);
+		void writePhysicalDeviceCache(VkPhysicalDevice physicalDevice);
 		bool isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice);
 
 		void createLogicalDevice();
@@ -97,9 +147,13 @@ class Renderer {
 		void createGraphicsPipeline();
 
 		VkRenderPass renderPass;
+		VkRenderPass loadRenderPass;
 		VkPipeline graphicsPipeline;
 		VkPipelineLayout graphicsPipelineLayout;
 		void createRenderPass();
+		VkRenderPass createRenderPass(VkAttachmentLoadOp loadOp);
+
+		std::vector<OcclusionCulling::candidate> occlusionCandidates;
 
 		VkQueue graphicsQueue;
 		VkQueue presentQueue;
@@ -108,9 +162,17 @@ class Renderer {
 		std::vector<VkCommandBuffer> commandBuffers;
 		void createCommandPool();
 		void createCommandBuffers();
-		void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+		void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, const framePacket& packet);
 
 		uint32_t currentFrame = 0;
+		std::atomic<uint64_t> frameNumber{ 0 };
+		uint64_t builtFrames = 0;
+
+		framePacket immediatePacket;
+		VkExtent2D framebufferExtent{};
+
+		std::atomic<bool> damaged{ true };
+		std::chrono::steady_clock::time_point lastFrameTime;
 
 		std::vector<VkSemaphore> imageAvailableSemaphores;
 		std::vector<VkSemaphore> renderFinishedSemaphores;
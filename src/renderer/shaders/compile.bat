@@ -1,3 +1,10 @@
 C:/VulkanSDK/1.4.321.1/Bin/glslc.exe ui.vert -o ui_vert.spv
 C:/VulkanSDK/1.4.321.1/Bin/glslc.exe ui.frag -o ui_frag.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe ui_image.frag -o ui_image_frag.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe ui_shape.vert -o ui_shape_vert.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe ui_shape.frag -o ui_shape_frag.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe mesh.vert -o mesh_vert.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe mesh.frag -o mesh_frag.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe hiz_reduce.comp -o hiz_reduce_comp.spv
+C:/VulkanSDK/1.4.321.1/Bin/glslc.exe occlusion_test.comp -o occlusion_test_comp.spv
 pause
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D albedoMap;
+
+layout(location = 0) in vec3 fragNormal;
+layout(location = 1) in vec2 fragUV;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float shade = 0.2 + 0.7 * max(dot(normalize(fragNormal), normalize(vec3(0.4, 0.8, 0.5))), 0.0);
+    outColor = vec4(texture(albedoMap, fragUV).rgb * shade, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#version 450
+
+struct Instance {
+    vec4 rows[3];
+};
+
+layout(set = 1, binding = 0) readonly buffer Instances {
+    Instance instances[];
+};
+
+layout(set = 1, binding = 1) readonly buffer DrawInstances {
+    uint drawInstances[];
+};
+
+layout(push_constant) uniform Mesh {
+    mat4 viewProjection;
+    vec4 positionOffset;
+    vec4 positionScale;
+} mesh;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec4 inNormal;
+layout(location = 2) in vec2 inUV;
+
+layout(location = 0) out vec3 fragNormal;
+layout(location = 1) out vec2 fragUV;
+
+void main() {
+    Instance instance = instances[drawInstances[gl_InstanceIndex]];
+    vec4 local = vec4(mesh.positionOffset.xyz + inPosition.xyz * mesh.positionScale.xyz, 1.0);
+    vec3 world = vec3(dot(instance.rows[0], local), dot(instance.rows[1], local), dot(instance.rows[2], local));
+
+    gl_Position = mesh.viewProjection * vec4(world, 1.0);
+    fragNormal = inNormal.xyz;
+    fragUV = inUV;
+}
\ No newline at end of file
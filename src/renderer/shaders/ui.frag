@@ -1,9 +1,16 @@
 #version 450
 
-layout(location = 0) in vec3 fragColor;
+layout(set = 0, binding = 0) uniform sampler2D atlas;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragAtlasCoord;
+layout(location = 2) in float fragSharpness;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = vec4(fragColor, 1.0);
+    float distance = texture(atlas, fragAtlasCoord).r;
+    float coverage = clamp((distance - 0.5) * fragSharpness + 0.5, 0.0, 1.0);
+
+    outColor = vec4(fragColor.rgb, fragColor.a * coverage);
 }
\ No newline at end of file
@@ -1,18 +1,27 @@
 #version 450
 
-layout(location = 0) in vec2 inPosition;
-layout(location = 1) in vec3 inColor;
+layout(push_constant) uniform Viewport {
+    vec2 scale;
+    vec2 offset;
+} viewport;
 
-layout(location = 0) out vec3 fragColor;
+layout(location = 0) in ivec4 inRect;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in uvec4 inAtlasRect;
 
-void main() {
-    vec2 ndc = vec2(
-        (inPosition.x / 1280.0) * 2.0 - 1.0,
-        (inPosition.y / 720.0) * 2.0 - 1.0
-    );
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragAtlasCoord;
+layout(location = 2) out float fragSharpness;
+
+const float ATLAS_SIZE = 1024.0;
+const float SDF_SPREAD = 4.0;
 
-    ndc.y = -ndc.y;
+void main() {
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    vec2 position = vec2(inRect.xy) + corner * vec2(inRect.zw);
 
-    gl_Position = vec4(ndc, 0.0, 1.0);
+    gl_Position = vec4(position * viewport.scale + viewport.offset, 0.0, 1.0);
     fragColor = inColor;
+    fragAtlasCoord = (vec2(inAtlasRect.xy) + corner * vec2(inAtlasRect.zw)) * (1.0 / ATLAS_SIZE);
+    fragSharpness = 2.0 * SDF_SPREAD * (float(inRect.w) / (float(inAtlasRect.w) + 1.0 / 256.0));
 }
\ No newline at end of file
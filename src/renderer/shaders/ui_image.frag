@@ -0,0 +1,12 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D image;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragImageCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    outColor = fragColor * texture(image, fragImageCoord);
+}
\ No newline at end of file
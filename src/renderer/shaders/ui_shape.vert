@@ -0,0 +1,16 @@
+#version 450
+
+layout(push_constant) uniform Viewport {
+    vec2 scale;
+    vec2 offset;
+} viewport;
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    gl_Position = vec4(inPosition * viewport.scale + viewport.offset, 0.0, 1.0);
+    fragColor = inColor;
+}
\ No newline at end of file
@@ -16,6 +16,22 @@ const VkFormat Swapchain::getImageFormat() {
 	return imageFormat;
 }
 
+const VkFormat Swapchain::getDepthFormat() {
+	return depthFormat;
+}
+
+VkImage Swapchain::getDepthImage() {
+	return depthImage;
+}
+
+VkImageView Swapchain::getDepthImageView() {
+	return depthImageView;
+}
+
+VkImage Swapchain::getImage(uint32_t imageIndex) {
+	return images[imageIndex];
+}
+
 VkExtent2D Swapchain::getExtent() {
 	return imageExtent;
 }
@@ -39,12 +55,77 @@ void Swapchain::cleanup() {
 		vkDestroyImageView(application->renderer.getDevice(), imageView, nullptr);
 	}
 
-	vkDestroySwapchainKHR(application->renderer.getDevice(), swapchain, nullptr);
+	for (VkImage image : images) {
+		application->renderer.barrierTracker.forgetImage(image);
+	}
+
+	if (depthImage != VK_NULL_HANDLE) {
+		application->renderer.barrierTracker.forgetImage(depthImage);
+
+		vkDestroyImageView(application->renderer.getDevice(), depthImageView, nullptr);
+		vkDestroyImage(application->renderer.getDevice(), depthImage, nullptr);
+		vkFreeMemory(application->renderer.getDevice(), depthImageMemory, nullptr);
+
+		depthImage = VK_NULL_HANDLE;
+		depthImageMemory = VK_NULL_HANDLE;
+		depthImageView = VK_NULL_HANDLE;
+	}
+
+	if (application->options.headless) {
+		for (size_t i = 0; i < images.size(); i++) {
+			vkDestroyImage(application->renderer.getDevice(), images[i], nullptr);
+			vkFreeMemory(application->renderer.getDevice(), imageMemories[i], nullptr);
+		}
+
+		images.clear();
+		imageMemories.clear();
+	}
+	else {
+		vkDestroySwapchainKHR(application->renderer.getDevice(), swapchain, nullptr);
+	}
 
 	log_info("Cleaned up swapchain!");
 }
 
+void Swapchain::selectDepthFormat() {
+	const VkFormat candidates[] = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT };
+	const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+	for (VkFormat candidate : candidates) {
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(application->renderer.getPhysicalDevice(), candidate, &formatProperties);
+
+		if ((formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures) {
+			depthFormat = candidate;
+
+			log_info("Selected depth format " + std::to_string(candidate));
+
+			return;
+		}
+	}
+
+	log_error("Failed to find a supported depth format!");
+}
+
+void Swapchain::selectImageFormat() {
+	if (application->options.headless) {
+		imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+		return;
+	}
+
+	Swapchain::swapchainSupportDetails swapchainSupportDetails = querySwapchainSupport(*application, application->renderer.getPhysicalDevice());
+
+	imageFormat = chooseSwapchainSurfaceFormat(swapchainSupportDetails.surfaceFormats).format;
+}
+
 void Swapchain::createSwapchain() {
+	if (application->options.headless) {
+		createOffscreenImages();
+
+		return;
+	}
+
 	log_info("Creating swapchain...");
 
 	Swapchain& swapchain = application->swapchain;
@@ -101,33 +182,151 @@ void Swapchain::createSwapchain() {
 		swapchain.images.resize(imageCount);
 		vkGetSwapchainImagesKHR(application->renderer.getDevice(), swapchain.swapchain, &imageCount, swapchain.images.data());
 
-		swapchain.imageFormat = surfaceFormat.format;
-		swapchain.imageExtent = swapChainExtent;
+		for (VkImage image : swapchain.images) {
+			application->renderer.barrierTracker.trackImage(image, VK_IMAGE_ASPECT_COLOR_BIT);
+		}
 
-		application->swapchain = swapchain;
+		if (swapchain.imageFormat != surfaceFormat.format) {
+			log_error("Swapchain format does not match the selected surface format!");
+		}
+
+		swapchain.imageExtent = swapChainExtent;
 
 		log_info("Successfully created swapchain!");
 	}
 }
 
-void Swapchain::recreateSwapchain() {
-	log_info("Recreating swapchain...");
+void Swapchain::createOffscreenImages() {
+	log_info("Creating offscreen images...");
+
+	VkDevice device = application->renderer.getDevice();
 
-	int width = 0, height = 0;
-	glfwGetFramebufferSize(application->window.glfwWindow, &width, &height);
-	while (width == 0 || height == 0) {
-		glfwGetFramebufferSize(application->window.glfwWindow, &width, &height);
-		glfwWaitEvents();
+	if (imageFormat != VK_FORMAT_R8G8B8A8_UNORM) {
+		log_error("Offscreen images require the R8G8B8A8 format!");
 	}
 
+	imageExtent = { application->window.getWindowWidth(*application), application->window.getWindowHeight(*application) };
+
+	uint32_t imageCount = application->renderer.getMaxFramesInFlight();
+
+	images.resize(imageCount);
+	imageMemories.resize(imageCount);
+
+	for (uint32_t i = 0; i < imageCount; i++) {
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.format = imageFormat;
+		imageCreateInfo.extent = { imageExtent.width, imageExtent.height, 1 };
+		imageCreateInfo.mipLevels = 1;
+		imageCreateInfo.arrayLayers = 1;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		if (vkCreateImage(device, &imageCreateInfo, nullptr, &images[i]) != VK_SUCCESS) {
+			log_error("Failed to create offscreen image!");
+		}
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetImageMemoryRequirements(device, images[i], &memoryRequirements);
+
+		VkMemoryAllocateInfo memoryAllocateInfo{};
+		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memoryAllocateInfo.allocationSize = memoryRequirements.size;
+		memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &imageMemories[i]) != VK_SUCCESS) {
+			log_error("Failed to allocate offscreen image memory!");
+		}
+
+		vkBindImageMemory(device, images[i], imageMemories[i], 0);
+
+		application->renderer.barrierTracker.trackImage(images[i], VK_IMAGE_ASPECT_COLOR_BIT);
+	}
+
+	log_info("Successfully created offscreen images!");
+}
+
+void Swapchain::readbackImage(uint32_t imageIndex, const std::string& path) {
+	log_info("Reading back offscreen image...");
+
+	VkDevice device = application->renderer.getDevice();
+	VkDeviceSize bufferSize = static_cast<VkDeviceSize>(imageExtent.width) * imageExtent.height * 4;
+
+	VkBuffer stagingBuffer;
+	VkDeviceMemory stagingBufferMemory;
+	application->renderer.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+	barrierTracker.trackBuffer(stagingBuffer);
+
+	VkCommandBuffer commandBuffer = application->renderer.beginSingleTimeCommands();
+
+	barrierTracker.transitionImage(images[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+	barrierTracker.accessBuffer(stagingBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	VkBufferImageCopy region{};
+	region.bufferOffset = 0;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+	region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	region.imageOffset = { 0, 0, 0 };
+	region.imageExtent = { imageExtent.width, imageExtent.height, 1 };
+
+	vkCmdCopyImageToBuffer(commandBuffer, images[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stagingBuffer, 1, &region);
+
+	barrierTracker.accessBuffer(stagingBuffer, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	application->renderer.endSingleTimeCommands(commandBuffer);
+
+	void* data;
+	vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open()) {
+		log_warning("Failed to open readback file: " + path);
+	}
+	else {
+		file << "P6\n" << imageExtent.width << " " << imageExtent.height << "\n255\n";
+
+		const uint8_t* pixels = static_cast<const uint8_t*>(data);
+
+		for (size_t pixel = 0; pixel < static_cast<size_t>(imageExtent.width) * imageExtent.height; pixel++) {
+			file.write(reinterpret_cast<const char*>(pixels + pixel * 4), 3);
+		}
+
+		log_info("Wrote readback image to " + path);
+	}
+
+	vkUnmapMemory(device, stagingBufferMemory);
+
+	barrierTracker.forgetBuffer(stagingBuffer);
+
+	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	vkFreeMemory(device, stagingBufferMemory, nullptr);
+}
+
+void Swapchain::recreateSwapchain() {
+	log_info("Recreating swapchain...");
+
 	vkDeviceWaitIdle(application->renderer.getDevice());
 
 	cleanup();
 
 	createSwapchain();
 	createImageViews();
+	createDepthImage();
 	createFramebuffers();
 
+	application->renderer.framePacer.onSwapchainRecreated();
+	application->renderer.occlusionCulling.onSwapchainRecreated();
+
 	log_info("Recreated swapchain!");
 }
 
@@ -165,6 +364,59 @@ void Swapchain::createImageViews() {
 	}
 }
 
+void Swapchain::createDepthImage() {
+	log_info("Creating depth image...");
+
+	VkDevice device = application->renderer.getDevice();
+
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = depthFormat;
+	imageCreateInfo.extent = { imageExtent.width, imageExtent.height, 1 };
+	imageCreateInfo.mipLevels = 1;
+	imageCreateInfo.arrayLayers = 1;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	if (vkCreateImage(device, &imageCreateInfo, nullptr, &depthImage) != VK_SUCCESS) {
+		log_error("Failed to create depth image!");
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetImageMemoryRequirements(device, depthImage, &memoryRequirements);
+
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &depthImageMemory) != VK_SUCCESS) {
+		log_error("Failed to allocate depth image memory!");
+	}
+
+	vkBindImageMemory(device, depthImage, depthImageMemory, 0);
+
+	VkImageViewCreateInfo viewCreateInfo{};
+	viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewCreateInfo.image = depthImage;
+	viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewCreateInfo.format = depthFormat;
+	viewCreateInfo.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+
+	if (vkCreateImageView(device, &viewCreateInfo, nullptr, &depthImageView) != VK_SUCCESS) {
+		log_error("Failed to create depth image view!");
+	}
+
+	VkImageAspectFlags aspectMask = depthFormat == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+	application->renderer.barrierTracker.trackImage(depthImage, aspectMask);
+
+	log_info("Successfully created depth image!");
+}
+
 Swapchain::swapchainSupportDetails Swapchain::querySwapchainSupport(Application& application, VkPhysicalDevice physicalDevice) {
 	log_info("Querying swapchain support...");
 	
@@ -198,13 +450,14 @@ void Swapchain::createFramebuffers() {
 
 	for (size_t i = 0; i < imageViews.size(); i++) {
 		VkImageView attachments[] = {
-			imageViews[i]
+			imageViews[i],
+			depthImageView
 		};
 
 		VkFramebufferCreateInfo framebufferInfo{};
 		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
 		framebufferInfo.renderPass = application->renderer.getRenderPass();
-		framebufferInfo.attachmentCount = 1;
+		framebufferInfo.attachmentCount = 2;
 		framebufferInfo.pAttachments = attachments;
 		framebufferInfo.width = imageExtent.width;
 		framebufferInfo.height = imageExtent.height;
@@ -232,13 +485,7 @@ VkSurfaceFormatKHR Swapchain::chooseSwapchainSurfaceFormat(const std::vector<VkS
 }
 
 VkPresentModeKHR Swapchain::chooseSwapchainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
-	for (const auto& availablePresentMode : availablePresentModes) {
-		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-			return availablePresentMode;
-		}
-	}
-
-	return VK_PRESENT_MODE_FIFO_KHR;
+	return application->renderer.framePacer.choosePresentMode(availablePresentModes);
 }
 
 VkExtent2D Swapchain::chooseSwapchainExtent(const VkSurfaceCapabilitiesKHR& surfaceCapabilities) {
@@ -250,13 +497,17 @@ VkExtent2D Swapchain::chooseSwapchainExtent(const VkSurfaceCapabilitiesKHR& surf
 		return surfaceCapabilities.currentExtent;
 	}
 	else {
-		int width, height;
-		glfwGetFramebufferSize(application->window.glfwWindow, &width, &height);
+		VkExtent2D actualExtent = application->renderer.getFramebufferExtent();
 
-		VkExtent2D actualExtent = {
-			static_cast<uint32_t>(width),
-			static_cast<uint32_t>(height)
-		};
+		if (actualExtent.width == 0 || actualExtent.height == 0) {
+			int width, height;
+			glfwGetFramebufferSize(application->window.glfwWindow, &width, &height);
+
+			actualExtent = {
+				static_cast<uint32_t>(width),
+				static_cast<uint32_t>(height)
+			};
+		}
 
 		actualExtent.width = std::clamp(actualExtent.width, surfaceCapabilities.minImageExtent.width, surfaceCapabilities.maxImageExtent.width);
 		actualExtent.height = std::clamp(actualExtent.height, surfaceCapabilities.minImageExtent.height, surfaceCapabilities.maxImageExtent.height);
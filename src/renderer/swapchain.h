@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <iostream>
+#include <string>
 
 #include "vulkan/vulkan.h"
 
@@ -14,15 +15,25 @@ public:
 
 	void cleanup();
 
+	void selectImageFormat();
+	void selectDepthFormat();
 	void createSwapchain();
 	void recreateSwapchain();
 
+	void createOffscreenImages();
+	void readbackImage(uint32_t imageIndex, const std::string& path);
+
 	void createImageViews();
+	void createDepthImage();
 	void createFramebuffers();
 
 	const VkFormat getImageFormat();
+	const VkFormat getDepthFormat();
+	VkImage getDepthImage();
+	VkImageView getDepthImageView();
 	VkExtent2D getExtent();
 	std::vector<VkFramebuffer> getFramebuffers();
+	VkImage getImage(uint32_t imageIndex);
 	const VkSwapchainKHR getSwapchain();
 
 	struct swapchainSupportDetails {
@@ -36,12 +47,18 @@ private:
 	Application* application = nullptr;
 	void setApplication(Application& application);
 
-	VkSwapchainKHR swapchain;
+	VkSwapchainKHR swapchain = VK_NULL_HANDLE;
 	std::vector<VkImage> images;
+	std::vector<VkDeviceMemory> imageMemories;
 	std::vector<VkImageView> imageViews;
 	std::vector<VkFramebuffer> framebuffers;
 
+	VkImage depthImage = VK_NULL_HANDLE;
+	VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+	VkImageView depthImageView = VK_NULL_HANDLE;
+
 	VkFormat imageFormat;
+	VkFormat depthFormat = VK_FORMAT_UNDEFINED;
 	VkExtent2D imageExtent;
 
 	VkSurfaceFormatKHR chooseSwapchainSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
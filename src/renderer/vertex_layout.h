@@ -0,0 +1,322 @@
+#pragma once
+#define vertex_layout_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <vulkan/vulkan.h>
+
+class VertexPacking {
+	public:
+		struct half2 {
+			uint16_t x;
+			uint16_t y;
+		};
+
+		struct half4 {
+			uint16_t x;
+			uint16_t y;
+			uint16_t z;
+			uint16_t w;
+		};
+
+		struct unorm8x4 {
+			uint32_t value;
+		};
+
+		struct snorm8x4 {
+			uint32_t value;
+		};
+
+		struct unorm16x2 {
+			uint16_t x;
+			uint16_t y;
+		};
+
+		struct snorm16x2 {
+			int16_t x;
+			int16_t y;
+		};
+
+		struct unorm16x4 {
+			uint16_t x;
+			uint16_t y;
+			uint16_t z;
+			uint16_t w;
+		};
+
+		struct snorm16x4 {
+			int16_t x;
+			int16_t y;
+			int16_t z;
+			int16_t w;
+		};
+
+		struct unorm1010102 {
+			uint32_t value;
+		};
+
+		struct snorm1010102 {
+			uint32_t value;
+		};
+
+		static half2 packHalf2(glm::vec2 value) {
+			uint32_t packed = glm::packHalf2x16(value);
+
+			return { static_cast<uint16_t>(packed), static_cast<uint16_t>(packed >> 16) };
+		}
+
+		static half4 packHalf4(glm::vec4 value) {
+			uint64_t packed = glm::packHalf4x16(value);
+
+			return { static_cast<uint16_t>(packed), static_cast<uint16_t>(packed >> 16), static_cast<uint16_t>(packed >> 32), static_cast<uint16_t>(packed >> 48) };
+		}
+
+		static unorm8x4 packUnorm8x4(glm::vec4 value) {
+			return { glm::packUnorm4x8(value) };
+		}
+
+		static snorm8x4 packSnorm8x4(glm::vec4 value) {
+			return { glm::packSnorm4x8(value) };
+		}
+
+		static unorm16x2 packUnorm16x2(glm::vec2 value) {
+			uint32_t packed = glm::packUnorm2x16(value);
+
+			return { static_cast<uint16_t>(packed), static_cast<uint16_t>(packed >> 16) };
+		}
+
+		static snorm16x2 packSnorm16x2(glm::vec2 value) {
+			uint32_t packed = glm::packSnorm2x16(value);
+
+			return { static_cast<int16_t>(packed), static_cast<int16_t>(packed >> 16) };
+		}
+
+		static unorm16x4 packUnorm16x4(glm::vec4 value) {
+			uint64_t packed = glm::packUnorm4x16(value);
+
+			return { static_cast<uint16_t>(packed), static_cast<uint16_t>(packed >> 16), static_cast<uint16_t>(packed >> 32), static_cast<uint16_t>(packed >> 48) };
+		}
+
+		static snorm16x4 packSnorm16x4(glm::vec4 value) {
+			uint64_t packed = glm::packSnorm4x16(value);
+
+			return { static_cast<int16_t>(packed), static_cast<int16_t>(packed >> 16), static_cast<int16_t>(packed >> 32), static_cast<int16_t>(packed >> 48) };
+		}
+
+		static unorm1010102 packUnorm1010102(glm::vec4 value) {
+			return { glm::packUnorm3x10_1x2(value) };
+		}
+
+		static snorm1010102 packSnorm1010102(glm::vec4 value) {
+			return { glm::packSnorm3x10_1x2(value) };
+		}
+};
+
+template<typename T>
+struct VertexFormat;
+
+template<> struct VertexFormat<float> { static constexpr VkFormat FORMAT = VK_FORMAT_R32_SFLOAT; };
+template<> struct VertexFormat<glm::vec2> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32_SFLOAT; };
+template<> struct VertexFormat<glm::vec3> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32_SFLOAT; };
+template<> struct VertexFormat<glm::vec4> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32A32_SFLOAT; };
+template<> struct VertexFormat<int32_t> { static constexpr VkFormat FORMAT = VK_FORMAT_R32_SINT; };
+template<> struct VertexFormat<glm::ivec2> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32_SINT; };
+template<> struct VertexFormat<glm::ivec4> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32A32_SINT; };
+template<> struct VertexFormat<uint32_t> { static constexpr VkFormat FORMAT = VK_FORMAT_R32_UINT; };
+template<> struct VertexFormat<glm::uvec2> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32_UINT; };
+template<> struct VertexFormat<glm::uvec4> { static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32A32_UINT; };
+template<> struct VertexFormat<glm::i16vec2> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_SINT; };
+template<> struct VertexFormat<glm::i16vec4> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SINT; };
+template<> struct VertexFormat<glm::u16vec2> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_UINT; };
+template<> struct VertexFormat<glm::u16vec4> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_UINT; };
+template<> struct VertexFormat<VertexPacking::half2> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_SFLOAT; };
+template<> struct VertexFormat<VertexPacking::half4> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT; };
+template<> struct VertexFormat<VertexPacking::unorm8x4> { static constexpr VkFormat FORMAT = VK_FORMAT_R8G8B8A8_UNORM; };
+template<> struct VertexFormat<VertexPacking::snorm8x4> { static constexpr VkFormat FORMAT = VK_FORMAT_R8G8B8A8_SNORM; };
+template<> struct VertexFormat<VertexPacking::unorm16x2> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_UNORM; };
+template<> struct VertexFormat<VertexPacking::snorm16x2> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_SNORM; };
+template<> struct VertexFormat<VertexPacking::unorm16x4> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_UNORM; };
+template<> struct VertexFormat<VertexPacking::snorm16x4> { static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SNORM; };
+template<> struct VertexFormat<VertexPacking::unorm1010102> { static constexpr VkFormat FORMAT = VK_FORMAT_A2B10G10R10_UNORM_PACK32; };
+template<> struct VertexFormat<VertexPacking::snorm1010102> { static constexpr VkFormat FORMAT = VK_FORMAT_A2B10G10R10_SNORM_PACK32; };
+
+class VertexReflection {
+	public:
+		static constexpr uint32_t getFormatSize(VkFormat format) {
+			switch (format) {
+				case VK_FORMAT_R8G8B8A8_UNORM:
+				case VK_FORMAT_R8G8B8A8_SNORM:
+				case VK_FORMAT_R8G8B8A8_UINT:
+				case VK_FORMAT_R8G8B8A8_SINT:
+				case VK_FORMAT_R16G16_SFLOAT:
+				case VK_FORMAT_R16G16_UNORM:
+				case VK_FORMAT_R16G16_SNORM:
+				case VK_FORMAT_R16G16_UINT:
+				case VK_FORMAT_R16G16_SINT:
+				case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+				case VK_FORMAT_A2B10G10R10_SNORM_PACK32:
+				case VK_FORMAT_R32_SFLOAT:
+				case VK_FORMAT_R32_UINT:
+				case VK_FORMAT_R32_SINT:
+					return 4;
+				case VK_FORMAT_R16G16B16A16_SFLOAT:
+				case VK_FORMAT_R16G16B16A16_UNORM:
+				case VK_FORMAT_R16G16B16A16_SNORM:
+				case VK_FORMAT_R16G16B16A16_UINT:
+				case VK_FORMAT_R16G16B16A16_SINT:
+				case VK_FORMAT_R32G32_SFLOAT:
+				case VK_FORMAT_R32G32_UINT:
+				case VK_FORMAT_R32G32_SINT:
+					return 8;
+				case VK_FORMAT_R32G32B32_SFLOAT:
+				case VK_FORMAT_R32G32B32_UINT:
+				case VK_FORMAT_R32G32B32_SINT:
+					return 12;
+				case VK_FORMAT_R32G32B32A32_SFLOAT:
+				case VK_FORMAT_R32G32B32A32_UINT:
+				case VK_FORMAT_R32G32B32A32_SINT:
+					return 16;
+				default:
+					return 0;
+			}
+		}
+
+		static constexpr uint32_t getComponentSize(VkFormat format) {
+			switch (format) {
+				case VK_FORMAT_R8G8B8A8_UNORM:
+				case VK_FORMAT_R8G8B8A8_SNORM:
+				case VK_FORMAT_R8G8B8A8_UINT:
+				case VK_FORMAT_R8G8B8A8_SINT:
+					return 1;
+				case VK_FORMAT_R16G16_SFLOAT:
+				case VK_FORMAT_R16G16_UNORM:
+				case VK_FORMAT_R16G16_SNORM:
+				case VK_FORMAT_R16G16_UINT:
+				case VK_FORMAT_R16G16_SINT:
+				case VK_FORMAT_R16G16B16A16_SFLOAT:
+				case VK_FORMAT_R16G16B16A16_UNORM:
+				case VK_FORMAT_R16G16B16A16_SNORM:
+				case VK_FORMAT_R16G16B16A16_UINT:
+				case VK_FORMAT_R16G16B16A16_SINT:
+					return 2;
+				default:
+					return 4;
+			}
+		}
+
+		template<typename... Fields>
+		static constexpr bool isDisjoint() {
+			const uint32_t offsets[] = { Fields::OFFSET... };
+			const uint32_t sizes[] = { Fields::SIZE... };
+
+			for (size_t i = 0; i < sizeof...(Fields); i++) {
+				for (size_t j = i + 1; j < sizeof...(Fields); j++) {
+					if (offsets[i] < offsets[j] + sizes[j] && offsets[j] < offsets[i] + sizes[i]) {
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+};
+
+template<typename T, size_t fieldOffset, VkFormat fieldFormat = VertexFormat<T>::FORMAT>
+struct VertexField {
+	typedef T type;
+
+	static constexpr uint32_t OFFSET = static_cast<uint32_t>(fieldOffset);
+	static constexpr uint32_t SIZE = sizeof(T);
+	static constexpr VkFormat FORMAT = fieldFormat;
+
+	static_assert(std::is_trivially_copyable_v<T>, "Vertex fields must be trivially copyable");
+	static_assert(VertexReflection::getFormatSize(fieldFormat) == sizeof(T), "Vertex attribute format does not match the size of its field");
+	static_assert(fieldOffset % VertexReflection::getComponentSize(fieldFormat) == 0, "Vertex attribute is not aligned to its component size");
+};
+
+#define VERTEX_FIELD(vertex, member) VertexField<decltype(vertex::member), offsetof(vertex, member)>
+#define VERTEX_FIELD_AS(vertex, member, format) VertexField<decltype(vertex::member), offsetof(vertex, member), format>
+
+template<typename Vertex, typename... Fields>
+class VertexLayout {
+	public:
+		typedef Vertex vertexType;
+
+		static constexpr uint32_t ATTRIBUTE_COUNT = sizeof...(Fields);
+		static constexpr uint32_t STRIDE = sizeof(Vertex);
+
+		static_assert(sizeof...(Fields) > 0, "Vertex layouts need at least one field");
+		static_assert(std::is_standard_layout_v<Vertex> && std::is_trivially_copyable_v<Vertex>, "Vertex types must be standard layout and trivially copyable");
+		static_assert(((Fields::OFFSET + Fields::SIZE <= sizeof(Vertex)) && ...), "Vertex field lies outside of its vertex");
+		static_assert(VertexReflection::isDisjoint<Fields...>(), "Vertex fields overlap");
+		static_assert((Fields::SIZE + ...) == sizeof(Vertex), "Vertex layout does not cover the whole vertex, a field is missing or padding was inserted");
+
+		static constexpr VkVertexInputBindingDescription getBinding(uint32_t binding, VkVertexInputRate inputRate) {
+			return { binding, STRIDE, inputRate };
+		}
+
+		static constexpr std::array<VkVertexInputAttributeDescription, ATTRIBUTE_COUNT> getAttributes(uint32_t binding, uint32_t firstLocation) {
+			const VkFormat formats[] = { Fields::FORMAT... };
+			const uint32_t offsets[] = { Fields::OFFSET... };
+
+			std::array<VkVertexInputAttributeDescription, ATTRIBUTE_COUNT> attributes{};
+
+			for (uint32_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+				attributes[i] = { firstLocation + i, binding, formats[i], offsets[i] };
+			}
+
+			return attributes;
+		}
+};
+
+template<typename Layout, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX>
+struct VertexBinding {
+	typedef Layout layout;
+
+	static constexpr VkVertexInputRate INPUT_RATE = inputRate;
+};
+
+template<typename... Bindings>
+class VertexInput {
+	public:
+		static constexpr uint32_t BINDING_COUNT = sizeof...(Bindings);
+		static constexpr uint32_t ATTRIBUTE_COUNT = (Bindings::layout::ATTRIBUTE_COUNT + ...);
+
+		std::array<VkVertexInputBindingDescription, BINDING_COUNT> bindings{};
+		std::array<VkVertexInputAttributeDescription, ATTRIBUTE_COUNT> attributes{};
+
+		constexpr VertexInput() {
+			uint32_t binding = 0;
+			uint32_t location = 0;
+
+			(addBinding<Bindings>(binding, location), ...);
+		}
+
+		VkPipelineVertexInputStateCreateInfo getCreateInfo() const {
+			VkPipelineVertexInputStateCreateInfo createInfo{};
+			createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+			createInfo.vertexBindingDescriptionCount = BINDING_COUNT;
+			createInfo.pVertexBindingDescriptions = bindings.data();
+			createInfo.vertexAttributeDescriptionCount = ATTRIBUTE_COUNT;
+			createInfo.pVertexAttributeDescriptions = attributes.data();
+
+			return createInfo;
+		}
+	private:
+		template<typename Binding>
+		constexpr void addBinding(uint32_t& binding, uint32_t& location) {
+			bindings[binding] = Binding::layout::getBinding(binding, Binding::INPUT_RATE);
+
+			for (const VkVertexInputAttributeDescription& attribute : Binding::layout::getAttributes(binding, location)) {
+				attributes[location++] = attribute;
+			}
+
+			binding++;
+		}
+};
\ No newline at end of file
@@ -0,0 +1,742 @@
+#include "scene.h"
+#include "../application/application.h"
+#include "../simd/simd.h"
+
+#include <algorithm>
+
+static const Scene::instance IDENTITY_INSTANCE = { { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+
+static void coalesceRanges(std::vector<Scene::range>& ranges) {
+	if (ranges.size() < 2) {
+		return;
+	}
+
+	std::sort(ranges.begin(), ranges.end(), [](const Scene::range& a, const Scene::range& b) {
+		return a.first < b.first;
+	});
+
+	size_t count = 1;
+
+	for (size_t i = 1; i < ranges.size(); i++) {
+		Scene::range& last = ranges[count - 1];
+		uint32_t lastEnd = last.first + last.count;
+
+		if (ranges[i].first <= lastEnd) {
+			last.count = std::max(lastEnd, ranges[i].first + ranges[i].count) - last.first;
+		}
+		else {
+			ranges[count++] = ranges[i];
+		}
+	}
+
+	ranges.resize(count);
+}
+
+static SimdFloat loadLanes(const float* data, uint32_t count) {
+	if (count == SimdFloat::WIDTH) {
+		return SimdFloat::load(data);
+	}
+
+	float lanes[SimdFloat::WIDTH] = {};
+	std::copy(data, data + count, lanes);
+
+	return SimdFloat::load(lanes);
+}
+
+static glm::mat4 toMatrix(const Scene::instance& transform) {
+	glm::mat4 matrix(1.0f);
+
+	for (uint32_t row = 0; row < 3; row++) {
+		for (uint32_t column = 0; column < 4; column++) {
+			matrix[column][row] = transform.rows[row][column];
+		}
+	}
+
+	return matrix;
+}
+
+void Scene::init(Application& application) {
+	log_info("Initializing scene...");
+
+	this->application = &application;
+
+	log_info("Scene initialized with " + std::string(SimdFloat::getInstructionSet()) + " transform kernels!");
+}
+
+Scene::nodeHandle Scene::createNode(nodeHandle parent) {
+	uint32_t parentIndex = NO_PARENT;
+
+	if (parent != NO_NODE) {
+		parentIndex = getIndex(parent);
+
+		if (parentIndex == NO_INDEX) {
+			log_error("Invalid scene parent node!");
+		}
+	}
+
+	nodeHandle handle;
+
+	if (!freeHandles.empty()) {
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else {
+		handle = static_cast<nodeHandle>(handleToIndex.size());
+		handleToIndex.push_back(NO_INDEX);
+	}
+
+	handleToIndex[handle] = static_cast<uint32_t>(handles.size());
+
+	translationX.push_back(0.0f);
+	translationY.push_back(0.0f);
+	translationZ.push_back(0.0f);
+	rotationX.push_back(0.0f);
+	rotationY.push_back(0.0f);
+	rotationZ.push_back(0.0f);
+	rotationW.push_back(1.0f);
+	scaleX.push_back(1.0f);
+	scaleY.push_back(1.0f);
+	scaleZ.push_back(1.0f);
+
+	parents.push_back(parentIndex);
+	handles.push_back(handle);
+	dirty.push_back(1);
+	removed.push_back(0);
+	worlds.push_back(IDENTITY_INSTANCE);
+
+	structureChanged = true;
+
+	return handle;
+}
+
+void Scene::destroyNode(nodeHandle handle) {
+	uint32_t index = getIndex(handle);
+
+	if (index == NO_INDEX) {
+		return;
+	}
+
+	removed[index] = 1;
+	structureChanged = true;
+}
+
+void Scene::setParent(nodeHandle handle, nodeHandle parent) {
+	uint32_t index = getIndex(handle);
+	uint32_t parentIndex = parent == NO_NODE ? NO_PARENT : getIndex(parent);
+
+	if (index == NO_INDEX || (parent != NO_NODE && parentIndex == NO_INDEX)) {
+		log_error("Invalid scene node!");
+	}
+
+	for (uint32_t ancestor = parentIndex; ancestor != NO_PARENT; ancestor = parents[ancestor]) {
+		if (ancestor == index) {
+			log_error("Scene node cannot be parented to its own descendant!");
+		}
+	}
+
+	parents[index] = parentIndex;
+	dirty[index] = 1;
+	structureChanged = true;
+}
+
+bool Scene::isValid(nodeHandle handle) {
+	return getIndex(handle) != NO_INDEX;
+}
+
+uint32_t Scene::getIndex(nodeHandle handle) {
+	if (handle >= handleToIndex.size()) {
+		return NO_INDEX;
+	}
+
+	uint32_t index = handleToIndex[handle];
+
+	return index != NO_INDEX && !removed[index] ? index : NO_INDEX;
+}
+
+void Scene::setTranslation(nodeHandle handle, glm::vec3 translation) {
+	uint32_t index = getIndex(handle);
+
+	if (index == NO_INDEX) {
+		return;
+	}
+
+	translationX[index] = translation.x;
+	translationY[index] = translation.y;
+	translationZ[index] = translation.z;
+	dirty[index] = 1;
+	localChanged = true;
+}
+
+void Scene::setRotation(nodeHandle handle, glm::quat rotation) {
+	uint32_t index = getIndex(handle);
+
+	if (index == NO_INDEX) {
+		return;
+	}
+
+	rotation = glm::normalize(rotation);
+
+	rotationX[index] = rotation.x;
+	rotationY[index] = rotation.y;
+	rotationZ[index] = rotation.z;
+	rotationW[index] = rotation.w;
+	dirty[index] = 1;
+	localChanged = true;
+}
+
+void Scene::setScale(nodeHandle handle, glm::vec3 scale) {
+	uint32_t index = getIndex(handle);
+
+	if (index == NO_INDEX) {
+		return;
+	}
+
+	scaleX[index] = scale.x;
+	scaleY[index] = scale.y;
+	scaleZ[index] = scale.z;
+	dirty[index] = 1;
+	localChanged = true;
+}
+
+void Scene::permute(std::vector<float>& values, uint32_t count) {
+	floatScratch.resize(count);
+
+	for (uint32_t i = 0; i < values.size(); i++) {
+		if (newIndices[i] != NO_INDEX) {
+			floatScratch[newIndices[i]] = values[i];
+		}
+	}
+
+	values.swap(floatScratch);
+}
+
+void Scene::rebuildHierarchy() {
+	trace_zone("Scene::rebuildHierarchy");
+
+	const uint32_t UNKNOWN_DEPTH = UINT32_MAX;
+	const uint32_t DEAD = UINT32_MAX - 1;
+
+	uint32_t nodeCount = static_cast<uint32_t>(handles.size());
+
+	depths.assign(nodeCount, UNKNOWN_DEPTH);
+
+	for (uint32_t i = 0; i < nodeCount; i++) {
+		chain.clear();
+
+		uint32_t current = i;
+
+		while (current != NO_PARENT && depths[current] == UNKNOWN_DEPTH) {
+			chain.push_back(current);
+			current = parents[current];
+		}
+
+		bool dead = current != NO_PARENT && depths[current] == DEAD;
+		uint32_t depth = current == NO_PARENT || dead ? 0 : depths[current] + 1;
+
+		for (size_t link = chain.size(); link-- > 0;) {
+			uint32_t index = chain[link];
+
+			dead = dead || removed[index];
+			depths[index] = dead ? DEAD : depth++;
+		}
+	}
+
+	levelStarts.clear();
+
+	for (uint32_t i = 0; i < nodeCount; i++) {
+		if (depths[i] != DEAD) {
+			if (depths[i] + 2 > levelStarts.size()) {
+				levelStarts.resize(depths[i] + 2, 0);
+			}
+
+			levelStarts[depths[i] + 1]++;
+		}
+	}
+
+	for (size_t level = 1; level < levelStarts.size(); level++) {
+		levelStarts[level] += levelStarts[level - 1];
+	}
+
+	indexScratch.assign(levelStarts.begin(), levelStarts.end());
+	newIndices.assign(nodeCount, NO_INDEX);
+
+	for (uint32_t i = 0; i < nodeCount; i++) {
+		if (depths[i] == DEAD) {
+			handleToIndex[handles[i]] = NO_INDEX;
+			freeHandles.push_back(handles[i]);
+		}
+		else {
+			newIndices[i] = indexScratch[depths[i]]++;
+		}
+	}
+
+	uint32_t count = levelStarts.empty() ? 0 : levelStarts.back();
+
+	permute(translationX, count);
+	permute(translationY, count);
+	permute(translationZ, count);
+	permute(rotationX, count);
+	permute(rotationY, count);
+	permute(rotationZ, count);
+	permute(rotationW, count);
+	permute(scaleX, count);
+	permute(scaleY, count);
+	permute(scaleZ, count);
+
+	indexScratch.resize(count);
+
+	for (uint32_t i = 0; i < nodeCount; i++) {
+		if (newIndices[i] != NO_INDEX) {
+			indexScratch[newIndices[i]] = parents[i] == NO_PARENT ? NO_PARENT : newIndices[parents[i]];
+		}
+	}
+
+	parents.swap(indexScratch);
+
+	for (uint32_t i = 0; i < nodeCount; i++) {
+		if (newIndices[i] != NO_INDEX) {
+			indexScratch[newIndices[i]] = handles[i];
+			handleToIndex[handles[i]] = newIndices[i];
+		}
+	}
+
+	indexScratch.resize(count);
+	handles.swap(indexScratch);
+
+	dirty.assign(count, 1);
+	removed.assign(count, 0);
+	worlds.resize(count);
+	pendingRanges.clear();
+
+	structureChanged = false;
+	orderChanged = true;
+
+	stats.rebuilds++;
+	stats.nodes = count;
+	stats.levels = levelStarts.empty() ? 0 : static_cast<uint32_t>(levelStarts.size() - 1);
+}
+
+void Scene::updateRange(uint32_t begin, uint32_t end, range& changed, uint64_t& updated) {
+	const uint32_t WIDTH = SimdFloat::WIDTH;
+
+	float parentWorld[12][WIDTH];
+	float result[12][WIDTH];
+
+	uint32_t first = end;
+	uint32_t last = begin;
+	updated = 0;
+
+	SimdFloat one = SimdFloat::broadcast(1.0f);
+	SimdFloat two = SimdFloat::broadcast(2.0f);
+
+	for (uint32_t block = begin; block < end; block += WIDTH) {
+		uint32_t count = std::min(WIDTH, end - block);
+		uint32_t dirtyLanes = 0;
+
+		for (uint32_t lane = 0; lane < count; lane++) {
+			uint32_t parent = parents[block + lane];
+			uint8_t nodeDirty = dirty[block + lane] | (parent != NO_PARENT ? dirty[parent] : 0);
+
+			dirty[block + lane] = nodeDirty;
+			dirtyLanes += nodeDirty;
+		}
+
+		if (dirtyLanes == 0) {
+			continue;
+		}
+
+		for (uint32_t lane = 0; lane < WIDTH; lane++) {
+			uint32_t parent = lane < count ? parents[block + lane] : NO_PARENT;
+			const instance& parentTransform = parent != NO_PARENT ? worlds[parent] : IDENTITY_INSTANCE;
+
+			for (uint32_t element = 0; element < 12; element++) {
+				parentWorld[element][lane] = parentTransform.rows[element / 4][element % 4];
+			}
+		}
+
+		first = std::min(first, block);
+		last = std::max(last, block + count);
+		updated += dirtyLanes;
+
+		SimdFloat x = loadLanes(&rotationX[block], count);
+		SimdFloat y = loadLanes(&rotationY[block], count);
+		SimdFloat z = loadLanes(&rotationZ[block], count);
+		SimdFloat w = loadLanes(&rotationW[block], count);
+
+		SimdFloat sx = loadLanes(&scaleX[block], count);
+		SimdFloat sy = loadLanes(&scaleY[block], count);
+		SimdFloat sz = loadLanes(&scaleZ[block], count);
+
+		SimdFloat xx = x * x * two, yy = y * y * two, zz = z * z * two;
+		SimdFloat xy = x * y * two, xz = x * z * two, yz = y * z * two;
+		SimdFloat wx = w * x * two, wy = w * y * two, wz = w * z * two;
+
+		SimdFloat local[3][4] = {
+			{ (one - yy - zz) * sx, (xy - wz) * sy, (xz + wy) * sz, loadLanes(&translationX[block], count) },
+			{ (xy + wz) * sx, (one - xx - zz) * sy, (yz - wx) * sz, loadLanes(&translationY[block], count) },
+			{ (xz - wy) * sx, (yz + wx) * sy, (one - xx - yy) * sz, loadLanes(&translationZ[block], count) }
+		};
+
+		for (uint32_t row = 0; row < 3; row++) {
+			SimdFloat p0 = SimdFloat::load(parentWorld[row * 4 + 0]);
+			SimdFloat p1 = SimdFloat::load(parentWorld[row * 4 + 1]);
+			SimdFloat p2 = SimdFloat::load(parentWorld[row * 4 + 2]);
+			SimdFloat p3 = SimdFloat::load(parentWorld[row * 4 + 3]);
+
+			for (uint32_t column = 0; column < 4; column++) {
+				SimdFloat value = p0 * local[0][column] + p1 * local[1][column] + p2 * local[2][column];
+
+				if (column == 3) {
+					value = value + p3;
+				}
+
+				value.store(result[row * 4 + column]);
+			}
+		}
+
+		for (uint32_t lane = 0; lane < count; lane++) {
+			instance& world = worlds[block + lane];
+
+			for (uint32_t element = 0; element < 12; element++) {
+				world.rows[element / 4][element % 4] = result[element][lane];
+			}
+		}
+	}
+
+	changed = first < last ? range{ first, last - first } : range{ 0, 0 };
+}
+
+bool Scene::update() {
+	if (!structureChanged && !localChanged) {
+		return false;
+	}
+
+	trace_zone("Scene::update");
+
+	if (structureChanged) {
+		rebuildHierarchy();
+	}
+
+	JobSystem& jobSystem = application->jobSystem;
+
+	for (size_t level = 0; level + 1 < levelStarts.size(); level++) {
+		uint32_t levelStart = levelStarts[level];
+		uint32_t levelSize = levelStarts[level + 1] - levelStart;
+		uint32_t chunkCount = (levelSize + UPDATE_GRAIN - 1) / UPDATE_GRAIN;
+
+		chunkRanges.assign(chunkCount, { 0, 0 });
+		chunkUpdates.assign(chunkCount, 0);
+
+		jobSystem.parallelFor(levelSize, UPDATE_GRAIN, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t chunk = begin / UPDATE_GRAIN; chunk * UPDATE_GRAIN < end; chunk++) {
+				uint32_t chunkBegin = levelStart + chunk * UPDATE_GRAIN;
+				uint32_t chunkEnd = levelStart + std::min(end, (chunk + 1) * UPDATE_GRAIN);
+
+				updateRange(chunkBegin, chunkEnd, chunkRanges[chunk], chunkUpdates[chunk]);
+			}
+		});
+
+		for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+			if (chunkRanges[chunk].count > 0) {
+				changedRanges.push_back(chunkRanges[chunk]);
+			}
+
+			stats.updatedTransforms += chunkUpdates[chunk];
+		}
+	}
+
+	for (uint32_t chunk = 0; chunk < changedRanges.size(); chunk++) {
+		uint32_t end = changedRanges[chunk].first + changedRanges[chunk].count;
+		uint32_t index = changedRanges[chunk].first;
+
+		while (index < end) {
+			while (index < end && !dirty[index]) {
+				index++;
+			}
+
+			if (index == end) {
+				break;
+			}
+
+			uint32_t first = index;
+			uint32_t last = index;
+
+			while (index < end && index - last <= RANGE_GAP) {
+				if (dirty[index]) {
+					dirty[index] = 0;
+					last = index;
+				}
+
+				index++;
+			}
+
+			pendingRanges.push_back({ first, last + 1 - first });
+		}
+	}
+
+	changedRanges.clear();
+	coalesceRanges(pendingRanges);
+
+	localChanged = false;
+	stats.updates++;
+
+	return true;
+}
+
+glm::mat4 Scene::getWorldMatrix(nodeHandle handle) {
+	uint32_t index = getIndex(handle);
+
+	return index != NO_INDEX && !structureChanged ? toMatrix(worlds[index]) : glm::mat4(1.0f);
+}
+
+void Scene::getChangedNodes(std::vector<nodeHandle>& changed) {
+	changed.clear();
+
+	for (const range& pending : pendingRanges) {
+		changed.insert(changed.end(), handles.begin() + pending.first, handles.begin() + pending.first + pending.count);
+	}
+}
+
+void Scene::writeFrameData(frameData& frame) {
+	trace_zone("Scene::writeFrameData");
+
+	frame.instanceCount = static_cast<uint32_t>(worlds.size());
+	frame.orderChanged = orderChanged;
+
+	if (orderChanged) {
+		frame.instanceIndices.assign(handleToIndex.begin(), handleToIndex.end());
+	}
+	else {
+		frame.instanceIndices.clear();
+	}
+
+	frame.ranges.assign(pendingRanges.begin(), pendingRanges.end());
+	frame.instances.clear();
+
+	for (const range& changed : pendingRanges) {
+		frame.instances.insert(frame.instances.end(), worlds.begin() + changed.first, worlds.begin() + changed.first + changed.count);
+	}
+
+	pendingRanges.clear();
+	orderChanged = false;
+}
+
+void Scene::applyFrameData(const frameData& frame) {
+	renderInstances.resize(frame.instanceCount);
+
+	if (frame.orderChanged) {
+		renderIndices.assign(frame.instanceIndices.begin(), frame.instanceIndices.end());
+	}
+
+	const instance* source = frame.instances.data();
+
+	for (const range& changed : frame.ranges) {
+		std::copy(source, source + changed.count, renderInstances.begin() + changed.first);
+		source += changed.count;
+
+		uploadRanges.push_back(changed);
+	}
+}
+
+void Scene::createInstanceBuffer(uint32_t capacity) {
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	if (instanceBuffer != VK_NULL_HANDLE) {
+		barrierTracker.forgetBuffer(instanceBuffer);
+
+		retiredBuffer old;
+		old.frame = application->renderer.getFrameNumber();
+		old.buffer = instanceBuffer;
+		old.memory = instanceBufferMemory;
+
+		retired.push_back(old);
+	}
+
+	instanceCapacity = std::max(capacity, instanceCapacity * 2);
+
+	application->renderer.createBuffer(static_cast<VkDeviceSize>(instanceCapacity) * sizeof(instance), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, instanceBuffer, instanceBufferMemory);
+
+	barrierTracker.trackBuffer(instanceBuffer);
+
+	uploadRanges.clear();
+	uploadRanges.push_back({ 0, static_cast<uint32_t>(renderInstances.size()) });
+}
+
+void Scene::ensureStagingBuffer(uint32_t frameIndex, VkDeviceSize size) {
+	if (stagingBuffers.size() <= frameIndex) {
+		stagingBuffers.resize(frameIndex + 1, VK_NULL_HANDLE);
+		stagingBufferMemories.resize(frameIndex + 1, VK_NULL_HANDLE);
+		mappedStagingBuffers.resize(frameIndex + 1, nullptr);
+		stagingSizes.resize(frameIndex + 1, 0);
+	}
+
+	if (stagingSizes[frameIndex] >= size) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+
+	if (stagingBuffers[frameIndex] != VK_NULL_HANDLE) {
+		vkUnmapMemory(device, stagingBufferMemories[frameIndex]);
+		vkDestroyBuffer(device, stagingBuffers[frameIndex], nullptr);
+		vkFreeMemory(device, stagingBufferMemories[frameIndex], nullptr);
+	}
+
+	stagingSizes[frameIndex] = std::max(size, stagingSizes[frameIndex] * 2);
+
+	application->renderer.createBuffer(stagingSizes[frameIndex], VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffers[frameIndex], stagingBufferMemories[frameIndex]);
+
+	if (vkMapMemory(device, stagingBufferMemories[frameIndex], 0, stagingSizes[frameIndex], 0, &mappedStagingBuffers[frameIndex]) != VK_SUCCESS) {
+		log_error("Failed to map scene staging buffer!");
+	}
+}
+
+void Scene::releaseRetired(bool all) {
+	VkDevice device = application->renderer.getDevice();
+	uint64_t frame = application->renderer.getFrameNumber();
+	uint64_t framesInFlight = application->renderer.getMaxFramesInFlight();
+
+	size_t kept = 0;
+
+	for (size_t i = 0; i < retired.size(); i++) {
+		if (!all && retired[i].frame + framesInFlight > frame) {
+			retired[kept++] = retired[i];
+
+			continue;
+		}
+
+		vkDestroyBuffer(device, retired[i].buffer, nullptr);
+		vkFreeMemory(device, retired[i].memory, nullptr);
+	}
+
+	retired.resize(kept);
+}
+
+void Scene::recordUploads(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	releaseRetired(false);
+
+	if (uploadRanges.empty() || renderInstances.empty()) {
+		uploadRanges.clear();
+
+		return;
+	}
+
+	trace_zone("Scene::recordUploads");
+
+	if (renderInstances.size() > instanceCapacity) {
+		createInstanceBuffer(static_cast<uint32_t>(renderInstances.size()));
+	}
+
+	coalesceRanges(uploadRanges);
+
+	VkDeviceSize size = 0;
+
+	for (const range& changed : uploadRanges) {
+		size += static_cast<VkDeviceSize>(changed.count) * sizeof(instance);
+	}
+
+	ensureStagingBuffer(frameIndex, size);
+
+	uint8_t* staging = static_cast<uint8_t*>(mappedStagingBuffers[frameIndex]);
+	VkDeviceSize offset = 0;
+
+	copyRegions.clear();
+
+	for (const range& changed : uploadRanges) {
+		VkDeviceSize bytes = static_cast<VkDeviceSize>(changed.count) * sizeof(instance);
+
+		std::copy(renderInstances.begin() + changed.first, renderInstances.begin() + changed.first + changed.count, reinterpret_cast<instance*>(staging + offset));
+
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = offset;
+		copyRegion.dstOffset = static_cast<VkDeviceSize>(changed.first) * sizeof(instance);
+		copyRegion.size = bytes;
+
+		copyRegions.push_back(copyRegion);
+
+		offset += bytes;
+
+		stats.uploadedInstances += changed.count;
+	}
+
+	stats.uploadRanges += uploadRanges.size();
+	uploadRanges.clear();
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	barrierTracker.accessBuffer(instanceBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	vkCmdCopyBuffer(commandBuffer, stagingBuffers[frameIndex], instanceBuffer, static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+	barrierTracker.accessBuffer(instanceBuffer, VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+	barrierTracker.flush(commandBuffer);
+}
+
+glm::mat4 Scene::getRenderMatrix(nodeHandle handle) {
+	if (handle >= renderIndices.size() || renderIndices[handle] >= renderInstances.size()) {
+		return glm::mat4(1.0f);
+	}
+
+	return toMatrix(renderInstances[renderIndices[handle]]);
+}
+
+uint32_t Scene::getRenderInstance(nodeHandle handle) {
+	if (handle >= renderIndices.size() || renderIndices[handle] >= renderInstances.size()) {
+		return NO_INSTANCE;
+	}
+
+	return renderIndices[handle];
+}
+
+VkBuffer Scene::getInstanceBuffer() {
+	return instanceBuffer;
+}
+
+Scene::statistics Scene::getStatistics() {
+	return stats;
+}
+
+void Scene::cleanup() {
+	log_info("Cleaning up scene...");
+
+	if (application == nullptr) {
+		return;
+	}
+
+	VkDevice device = application->renderer.getDevice();
+
+	if (instanceBuffer != VK_NULL_HANDLE || !stagingBuffers.empty()) {
+		vkDeviceWaitIdle(device);
+	}
+
+	releaseRetired(true);
+
+	if (instanceBuffer != VK_NULL_HANDLE) {
+		application->renderer.barrierTracker.forgetBuffer(instanceBuffer);
+
+		vkDestroyBuffer(device, instanceBuffer, nullptr);
+		vkFreeMemory(device, instanceBufferMemory, nullptr);
+
+		instanceBuffer = VK_NULL_HANDLE;
+		instanceBufferMemory = VK_NULL_HANDLE;
+		instanceCapacity = 0;
+	}
+
+	for (size_t i = 0; i < stagingBuffers.size(); i++) {
+		if (stagingBuffers[i] != VK_NULL_HANDLE) {
+			vkUnmapMemory(device, stagingBufferMemories[i]);
+			vkDestroyBuffer(device, stagingBuffers[i], nullptr);
+			vkFreeMemory(device, stagingBufferMemories[i], nullptr);
+		}
+	}
+
+	stagingBuffers.clear();
+	stagingBufferMemories.clear();
+	mappedStagingBuffers.clear();
+	stagingSizes.clear();
+
+	log_info("Scene updated " + std::to_string(stats.updatedTransforms) + " transforms over " + std::to_string(stats.updates) + " updates and uploaded " + std::to_string(stats.uploadedInstances) + " instances in " + std::to_string(stats.uploadRanges) + " ranges");
+
+	log_info("Scene cleaned up!");
+}
\ No newline at end of file
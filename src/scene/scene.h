@@ -0,0 +1,147 @@
+#pragma once
+#define scene_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vulkan/vulkan.h>
+
+class Application;
+
+class Scene {
+	public:
+		typedef uint32_t nodeHandle;
+
+		static constexpr nodeHandle NO_NODE = UINT32_MAX;
+		static constexpr uint32_t NO_INSTANCE = UINT32_MAX;
+		static constexpr uint32_t UPDATE_GRAIN = 4096;
+
+		struct instance {
+			float rows[3][4];
+		};
+
+		struct range {
+			uint32_t first;
+			uint32_t count;
+		};
+
+		struct frameData {
+			uint32_t instanceCount = 0;
+			bool orderChanged = false;
+			std::vector<uint32_t> instanceIndices;
+			std::vector<range> ranges;
+			std::vector<instance> instances;
+		};
+
+		struct statistics {
+			uint32_t nodes = 0;
+			uint32_t levels = 0;
+			uint64_t updates = 0;
+			uint64_t updatedTransforms = 0;
+			uint64_t rebuilds = 0;
+			uint64_t uploadedInstances = 0;
+			uint64_t uploadRanges = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		nodeHandle createNode(nodeHandle parent = NO_NODE);
+		void destroyNode(nodeHandle handle);
+		void setParent(nodeHandle handle, nodeHandle parent);
+		bool isValid(nodeHandle handle);
+
+		void setTranslation(nodeHandle handle, glm::vec3 translation);
+		void setRotation(nodeHandle handle, glm::quat rotation);
+		void setScale(nodeHandle handle, glm::vec3 scale);
+
+		bool update();
+		glm::mat4 getWorldMatrix(nodeHandle handle);
+		void getChangedNodes(std::vector<nodeHandle>& changed);
+
+		void writeFrameData(frameData& frame);
+		void applyFrameData(const frameData& frame);
+		void recordUploads(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+		glm::mat4 getRenderMatrix(nodeHandle handle);
+		uint32_t getRenderInstance(nodeHandle handle);
+		VkBuffer getInstanceBuffer();
+
+		statistics getStatistics();
+	private:
+		static constexpr uint32_t NO_PARENT = UINT32_MAX;
+		static constexpr uint32_t NO_INDEX = UINT32_MAX;
+		static constexpr uint32_t RANGE_GAP = 16;
+
+		struct retiredBuffer {
+			uint64_t frame = 0;
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+		};
+
+		Application* application = nullptr;
+
+		std::vector<float> translationX;
+		std::vector<float> translationY;
+		std::vector<float> translationZ;
+		std::vector<float> rotationX;
+		std::vector<float> rotationY;
+		std::vector<float> rotationZ;
+		std::vector<float> rotationW;
+		std::vector<float> scaleX;
+		std::vector<float> scaleY;
+		std::vector<float> scaleZ;
+
+		std::vector<uint32_t> parents;
+		std::vector<nodeHandle> handles;
+		std::vector<uint8_t> dirty;
+		std::vector<uint8_t> removed;
+		std::vector<instance> worlds;
+
+		std::vector<uint32_t> levelStarts;
+		std::vector<uint32_t> handleToIndex;
+		std::vector<nodeHandle> freeHandles;
+
+		bool structureChanged = false;
+		bool localChanged = false;
+		bool orderChanged = false;
+
+		std::vector<range> chunkRanges;
+		std::vector<uint64_t> chunkUpdates;
+		std::vector<range> changedRanges;
+		std::vector<range> pendingRanges;
+
+		std::vector<uint32_t> depths;
+		std::vector<uint32_t> chain;
+		std::vector<uint32_t> newIndices;
+		std::vector<float> floatScratch;
+		std::vector<uint32_t> indexScratch;
+
+		std::vector<instance> renderInstances;
+		std::vector<uint32_t> renderIndices;
+		std::vector<range> uploadRanges;
+		std::vector<VkBufferCopy> copyRegions;
+
+		VkBuffer instanceBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory instanceBufferMemory = VK_NULL_HANDLE;
+		uint32_t instanceCapacity = 0;
+		std::vector<retiredBuffer> retired;
+
+		std::vector<VkBuffer> stagingBuffers;
+		std::vector<VkDeviceMemory> stagingBufferMemories;
+		std::vector<void*> mappedStagingBuffers;
+		std::vector<VkDeviceSize> stagingSizes;
+
+		statistics stats;
+
+		uint32_t getIndex(nodeHandle handle);
+		void rebuildHierarchy();
+		void permute(std::vector<float>& values, uint32_t count);
+		void updateRange(uint32_t begin, uint32_t end, range& changed, uint64_t& updated);
+
+		void createInstanceBuffer(uint32_t capacity);
+		void ensureStagingBuffer(uint32_t frameIndex, VkDeviceSize size);
+		void releaseRetired(bool all);
+};
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+#define simd_h
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(SIMD_FORCE_SCALAR)
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_HAS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_HAS_SSE 1
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SIMD_HAS_NEON 1
+#endif
+
+class SimdFloat {
+	public:
+#if defined(SIMD_HAS_AVX2)
+		typedef __m256 nativeType;
+		static constexpr uint32_t WIDTH = 8;
+#elif defined(SIMD_HAS_SSE)
+		typedef __m128 nativeType;
+		static constexpr uint32_t WIDTH = 4;
+#elif defined(SIMD_HAS_NEON)
+		typedef float32x4_t nativeType;
+		static constexpr uint32_t WIDTH = 4;
+#else
+		typedef float nativeType;
+		static constexpr uint32_t WIDTH = 1;
+#endif
+
+		nativeType value;
+
+		static const char* getInstructionSet() {
+#if defined(SIMD_HAS_AVX2)
+			return "AVX2";
+#elif defined(SIMD_HAS_SSE)
+			return "SSE2";
+#elif defined(SIMD_HAS_NEON)
+			return "NEON";
+#else
+			return "scalar";
+#endif
+		}
+
+		static SimdFloat load(const float* data) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_loadu_ps(data) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_loadu_ps(data) };
+#elif defined(SIMD_HAS_NEON)
+			return { vld1q_f32(data) };
+#else
+			return { *data };
+#endif
+		}
+
+		static SimdFloat broadcast(float scalar) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_set1_ps(scalar) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_set1_ps(scalar) };
+#elif defined(SIMD_HAS_NEON)
+			return { vdupq_n_f32(scalar) };
+#else
+			return { scalar };
+#endif
+		}
+
+		void store(float* data) const {
+#if defined(SIMD_HAS_AVX2)
+			_mm256_storeu_ps(data, value);
+#elif defined(SIMD_HAS_SSE)
+			_mm_storeu_ps(data, value);
+#elif defined(SIMD_HAS_NEON)
+			vst1q_f32(data, value);
+#else
+			*data = value;
+#endif
+		}
+
+		static void loadInterleaved(const float* data, SimdFloat& x, SimdFloat& y) {
+#if defined(SIMD_HAS_AVX2)
+			__m256 low = _mm256_loadu_ps(data);
+			__m256 high = _mm256_loadu_ps(data + 8);
+			__m256 evens = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+			__m256 odds = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+
+			x.value = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(evens), _MM_SHUFFLE(3, 1, 2, 0)));
+			y.value = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odds), _MM_SHUFFLE(3, 1, 2, 0)));
+#elif defined(SIMD_HAS_SSE)
+			__m128 low = _mm_loadu_ps(data);
+			__m128 high = _mm_loadu_ps(data + 4);
+
+			x.value = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+			y.value = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+#elif defined(SIMD_HAS_NEON)
+			float32x4x2_t pairs = vld2q_f32(data);
+
+			x.value = pairs.val[0];
+			y.value = pairs.val[1];
+#else
+			x.value = data[0];
+			y.value = data[1];
+#endif
+		}
+
+		static void storeInterleaved(float* data, SimdFloat x, SimdFloat y) {
+#if defined(SIMD_HAS_AVX2)
+			__m256 low = _mm256_unpacklo_ps(x.value, y.value);
+			__m256 high = _mm256_unpackhi_ps(x.value, y.value);
+
+			_mm256_storeu_ps(data, _mm256_permute2f128_ps(low, high, 0x20));
+			_mm256_storeu_ps(data + 8, _mm256_permute2f128_ps(low, high, 0x31));
+#elif defined(SIMD_HAS_SSE)
+			_mm_storeu_ps(data, _mm_unpacklo_ps(x.value, y.value));
+			_mm_storeu_ps(data + 4, _mm_unpackhi_ps(x.value, y.value));
+#elif defined(SIMD_HAS_NEON)
+			float32x4x2_t pairs = { { x.value, y.value } };
+
+			vst2q_f32(data, pairs);
+#else
+			data[0] = x.value;
+			data[1] = y.value;
+#endif
+		}
+
+		friend SimdFloat operator+(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_add_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_add_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vaddq_f32(a.value, b.value) };
+#else
+			return { a.value + b.value };
+#endif
+		}
+
+		friend SimdFloat operator-(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_sub_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_sub_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vsubq_f32(a.value, b.value) };
+#else
+			return { a.value - b.value };
+#endif
+		}
+
+		friend SimdFloat operator*(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_mul_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_mul_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vmulq_f32(a.value, b.value) };
+#else
+			return { a.value * b.value };
+#endif
+		}
+
+		friend SimdFloat operator/(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_div_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_div_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vdivq_f32(a.value, b.value) };
+#else
+			return { a.value / b.value };
+#endif
+		}
+
+		static SimdFloat min(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_min_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_min_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vminq_f32(a.value, b.value) };
+#else
+			return { a.value < b.value ? a.value : b.value };
+#endif
+		}
+
+		static SimdFloat max(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_max_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_max_ps(a.value, b.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vmaxq_f32(a.value, b.value) };
+#else
+			return { a.value > b.value ? a.value : b.value };
+#endif
+		}
+
+		static uint32_t lessThanMask(SimdFloat a, SimdFloat b) {
+#if defined(SIMD_HAS_AVX2)
+			return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)));
+#elif defined(SIMD_HAS_SSE)
+			return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(a.value, b.value)));
+#elif defined(SIMD_HAS_NEON)
+			static const uint32_t LANE_BITS[4] = { 1, 2, 4, 8 };
+
+			return vaddvq_u32(vandq_u32(vcltq_f32(a.value, b.value), vld1q_u32(LANE_BITS)));
+#else
+			return a.value < b.value ? 1u : 0u;
+#endif
+		}
+
+		static SimdFloat sqrt(SimdFloat a) {
+#if defined(SIMD_HAS_AVX2)
+			return { _mm256_sqrt_ps(a.value) };
+#elif defined(SIMD_HAS_SSE)
+			return { _mm_sqrt_ps(a.value) };
+#elif defined(SIMD_HAS_NEON)
+			return { vsqrtq_f32(a.value) };
+#else
+			return { std::sqrt(a.value) };
+#endif
+		}
+};
\ No newline at end of file
@@ -0,0 +1,571 @@
+#include "font.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../logger/logger.h"
+
+bool Font::load(std::vector<char> fontData) {
+	data = std::move(fontData);
+	loaded = false;
+
+	if (data.size() < 12) {
+		log_warning("Font file is too small!");
+
+		return false;
+	}
+
+	uint32_t version = readU32(0);
+
+	if (version == 0x4F54544F) {
+		log_warning("Fonts with CFF outlines are not supported!");
+
+		return false;
+	}
+
+	if (version != 0x00010000 && version != 0x74727565) {
+		log_warning("Unknown font file format!");
+
+		return false;
+	}
+
+	uint32_t headTable = findTable("head");
+	uint32_t maxpTable = findTable("maxp");
+	uint32_t hheaTable = findTable("hhea");
+
+	hmtxTable = findTable("hmtx");
+	locaTable = findTable("loca");
+	glyfTable = findTable("glyf");
+	cmapTable = findTable("cmap");
+
+	if (headTable == 0 || maxpTable == 0 || hheaTable == 0 || hmtxTable == 0 || locaTable == 0 || glyfTable == 0 || cmapTable == 0) {
+		log_warning("Font file is missing required tables!");
+
+		return false;
+	}
+
+	unitsPerEm = readU16(headTable + 18);
+	indexToLocFormat = readI16(headTable + 50);
+	glyphCount = readU16(maxpTable + 4);
+	ascender = readI16(hheaTable + 4);
+	descender = readI16(hheaTable + 6);
+	lineGap = readI16(hheaTable + 8);
+	horizontalMetricCount = readU16(hheaTable + 34);
+
+	cmapTable = findCharacterMap();
+
+	if (cmapTable == 0 || unitsPerEm == 0 || horizontalMetricCount == 0) {
+		log_warning("Font file has no usable character map!");
+
+		return false;
+	}
+
+	kernTable = findTable("kern");
+	kernPairCount = 0;
+
+	if (kernTable != 0 && readU16(kernTable) == 0 && readU16(kernTable + 2) > 0) {
+		uint16_t coverage = readU16(kernTable + 8);
+
+		if ((coverage >> 8) == 0 && (coverage & 1) != 0) {
+			kernPairCount = readU16(kernTable + 10);
+			kernTable += 18;
+		}
+	}
+
+	loaded = true;
+
+	return true;
+}
+
+bool Font::isLoaded() {
+	return loaded;
+}
+
+uint8_t Font::readU8(uint32_t offset) {
+	if (offset >= data.size()) {
+		return 0;
+	}
+
+	return static_cast<uint8_t>(data[offset]);
+}
+
+uint16_t Font::readU16(uint32_t offset) {
+	return static_cast<uint16_t>((readU8(offset) << 8) | readU8(offset + 1));
+}
+
+int16_t Font::readI16(uint32_t offset) {
+	return static_cast<int16_t>(readU16(offset));
+}
+
+uint32_t Font::readU32(uint32_t offset) {
+	return (static_cast<uint32_t>(readU16(offset)) << 16) | readU16(offset + 2);
+}
+
+uint32_t Font::findTable(const char* tag) {
+	uint16_t tableCount = readU16(4);
+
+	for (uint32_t i = 0; i < tableCount; i++) {
+		uint32_t record = 12 + i * 16;
+
+		if (record + 16 <= data.size() && memcmp(data.data() + record, tag, 4) == 0) {
+			return readU32(record + 8);
+		}
+	}
+
+	return 0;
+}
+
+uint32_t Font::findCharacterMap() {
+	uint16_t tableCount = readU16(cmapTable + 2);
+
+	uint32_t bestTable = 0;
+	int32_t bestScore = 0;
+
+	for (uint32_t i = 0; i < tableCount; i++) {
+		uint32_t record = cmapTable + 4 + i * 8;
+
+		uint16_t platform = readU16(record);
+		uint16_t encoding = readU16(record + 2);
+		uint32_t table = cmapTable + readU32(record + 4);
+		uint16_t format = readU16(table);
+
+		bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+		int32_t score = !unicode ? 0 : format == 12 ? 2 : format == 4 ? 1 : 0;
+
+		if (score > bestScore) {
+			bestScore = score;
+			bestTable = table;
+		}
+	}
+
+	return bestTable;
+}
+
+uint32_t Font::getGlyphIndex(uint32_t codepoint) {
+	if (!loaded) {
+		return 0;
+	}
+
+	uint16_t format = readU16(cmapTable);
+
+	if (format == 4) {
+		if (codepoint > 0xFFFF) {
+			return 0;
+		}
+
+		uint32_t segmentCount = readU16(cmapTable + 6) / 2;
+		uint32_t endCodes = cmapTable + 14;
+		uint32_t startCodes = endCodes + segmentCount * 2 + 2;
+		uint32_t idDeltas = startCodes + segmentCount * 2;
+		uint32_t idRangeOffsets = idDeltas + segmentCount * 2;
+
+		uint32_t low = 0;
+		uint32_t high = segmentCount;
+
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+
+			if (readU16(endCodes + middle * 2) < codepoint) {
+				low = middle + 1;
+			}
+			else {
+				high = middle;
+			}
+		}
+
+		if (low == segmentCount || readU16(startCodes + low * 2) > codepoint) {
+			return 0;
+		}
+
+		uint16_t idDelta = readU16(idDeltas + low * 2);
+		uint16_t idRangeOffset = readU16(idRangeOffsets + low * 2);
+
+		if (idRangeOffset == 0) {
+			return static_cast<uint16_t>(codepoint + idDelta);
+		}
+
+		uint16_t glyph = readU16(idRangeOffsets + low * 2 + idRangeOffset + (codepoint - readU16(startCodes + low * 2)) * 2);
+
+		return glyph == 0 ? 0 : static_cast<uint16_t>(glyph + idDelta);
+	}
+
+	if (format == 12) {
+		uint32_t groupCount = readU32(cmapTable + 12);
+
+		uint32_t low = 0;
+		uint32_t high = groupCount;
+
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			uint32_t group = cmapTable + 16 + middle * 12;
+
+			if (codepoint < readU32(group)) {
+				high = middle;
+			}
+			else if (codepoint > readU32(group + 4)) {
+				low = middle + 1;
+			}
+			else {
+				return readU32(group + 8) + codepoint - readU32(group);
+			}
+		}
+	}
+
+	return 0;
+}
+
+uint32_t Font::getGlyphOffset(uint32_t glyph, uint32_t& length) {
+	length = 0;
+
+	if (glyph >= glyphCount) {
+		return 0;
+	}
+
+	uint32_t start;
+	uint32_t end;
+
+	if (indexToLocFormat == 0) {
+		start = readU16(locaTable + glyph * 2) * 2u;
+		end = readU16(locaTable + glyph * 2 + 2) * 2u;
+	}
+	else {
+		start = readU32(locaTable + glyph * 4);
+		end = readU32(locaTable + glyph * 4 + 4);
+	}
+
+	if (end <= start) {
+		return 0;
+	}
+
+	length = end - start;
+
+	return glyfTable + start;
+}
+
+Font::glyphMetrics Font::getGlyphMetrics(uint32_t glyph) {
+	glyphMetrics metrics{};
+
+	if (!loaded) {
+		return metrics;
+	}
+
+	if (glyph < horizontalMetricCount) {
+		metrics.advance = static_cast<int16_t>(readU16(hmtxTable + glyph * 4));
+		metrics.leftSideBearing = readI16(hmtxTable + glyph * 4 + 2);
+	}
+	else {
+		metrics.advance = static_cast<int16_t>(readU16(hmtxTable + (horizontalMetricCount - 1) * 4));
+		metrics.leftSideBearing = readI16(hmtxTable + horizontalMetricCount * 4 + (glyph - horizontalMetricCount) * 2);
+	}
+
+	uint32_t length;
+	uint32_t offset = getGlyphOffset(glyph, length);
+
+	if (length >= 10) {
+		metrics.xMin = readI16(offset + 2);
+		metrics.yMin = readI16(offset + 4);
+		metrics.xMax = readI16(offset + 6);
+		metrics.yMax = readI16(offset + 8);
+	}
+
+	return metrics;
+}
+
+int16_t Font::getKerning(uint32_t leftGlyph, uint32_t rightGlyph) {
+	uint32_t key = (leftGlyph << 16) | rightGlyph;
+
+	uint32_t low = 0;
+	uint32_t high = kernPairCount;
+
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+		uint32_t pair = readU32(kernTable + middle * 6);
+
+		if (pair < key) {
+			low = middle + 1;
+		}
+		else if (pair > key) {
+			high = middle;
+		}
+		else {
+			return readI16(kernTable + middle * 6 + 4);
+		}
+	}
+
+	return 0;
+}
+
+uint16_t Font::getUnitsPerEm() {
+	return unitsPerEm;
+}
+
+int16_t Font::getAscender() {
+	return ascender;
+}
+
+int16_t Font::getDescender() {
+	return descender;
+}
+
+int16_t Font::getLineGap() {
+	return lineGap;
+}
+
+void Font::getGlyphOutline(uint32_t glyph, float flatness, std::vector<segment>& segments) {
+	segments.clear();
+
+	if (loaded) {
+		appendGlyphOutline(glyph, glm::mat3(1.0f), flatness, 0, segments);
+	}
+}
+
+void Font::appendGlyphOutline(uint32_t glyph, const glm::mat3& transform, float flatness, uint32_t depth, std::vector<segment>& segments) {
+	uint32_t length;
+	uint32_t offset = getGlyphOffset(glyph, length);
+
+	if (length < 10) {
+		return;
+	}
+
+	int16_t contourCount = readI16(offset);
+
+	if (contourCount < 0) {
+		uint32_t position = offset + 10;
+		uint16_t flags;
+
+		do {
+			flags = readU16(position);
+			uint16_t component = readU16(position + 2);
+			position += 4;
+
+			float dx = 0.0f;
+			float dy = 0.0f;
+
+			if (flags & 0x0001) {
+				dx = readI16(position);
+				dy = readI16(position + 2);
+				position += 4;
+			}
+			else {
+				dx = static_cast<int8_t>(readU8(position));
+				dy = static_cast<int8_t>(readU8(position + 1));
+				position += 2;
+			}
+
+			if (!(flags & 0x0002)) {
+				dx = 0.0f;
+				dy = 0.0f;
+			}
+
+			float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+
+			if (flags & 0x0008) {
+				a = d = readI16(position) / 16384.0f;
+				position += 2;
+			}
+			else if (flags & 0x0040) {
+				a = readI16(position) / 16384.0f;
+				d = readI16(position + 2) / 16384.0f;
+				position += 4;
+			}
+			else if (flags & 0x0080) {
+				a = readI16(position) / 16384.0f;
+				b = readI16(position + 2) / 16384.0f;
+				c = readI16(position + 4) / 16384.0f;
+				d = readI16(position + 6) / 16384.0f;
+				position += 8;
+			}
+
+			if (depth < MAX_COMPOUND_DEPTH) {
+				glm::mat3 componentTransform(a, b, 0.0f, c, d, 0.0f, dx, dy, 1.0f);
+
+				appendGlyphOutline(component, transform * componentTransform, flatness, depth + 1, segments);
+			}
+		} while (flags & 0x0020);
+
+		return;
+	}
+
+	if (contourCount == 0) {
+		return;
+	}
+
+	uint32_t endPoints = offset + 10;
+	uint32_t pointCount = readU16(endPoints + (contourCount - 1) * 2) + 1u;
+	uint32_t position = endPoints + contourCount * 2;
+	position += 2 + readU16(position);
+
+	std::vector<uint8_t> flags(pointCount);
+
+	for (uint32_t i = 0; i < pointCount; i++) {
+		uint8_t flag = readU8(position++);
+		flags[i] = flag;
+
+		if (flag & 0x08) {
+			uint8_t repeat = readU8(position++);
+
+			for (uint32_t r = 0; r < repeat && i + 1 < pointCount; r++) {
+				flags[++i] = flag;
+			}
+		}
+	}
+
+	std::vector<glm::vec2> points(pointCount);
+	int32_t value = 0;
+
+	for (uint32_t i = 0; i < pointCount; i++) {
+		if (flags[i] & 0x02) {
+			int32_t delta = readU8(position++);
+			value += (flags[i] & 0x10) ? delta : -delta;
+		}
+		else if (!(flags[i] & 0x10)) {
+			value += readI16(position);
+			position += 2;
+		}
+
+		points[i].x = static_cast<float>(value);
+	}
+
+	value = 0;
+
+	for (uint32_t i = 0; i < pointCount; i++) {
+		if (flags[i] & 0x04) {
+			int32_t delta = readU8(position++);
+			value += (flags[i] & 0x20) ? delta : -delta;
+		}
+		else if (!(flags[i] & 0x20)) {
+			value += readI16(position);
+			position += 2;
+		}
+
+		points[i].y = static_cast<float>(value);
+	}
+
+	for (glm::vec2& point : points) {
+		point = glm::vec2(transform * glm::vec3(point, 1.0f));
+	}
+
+	std::vector<glm::vec2> contour;
+	std::vector<bool> onCurve;
+
+	uint32_t first = 0;
+
+	for (int16_t c = 0; c < contourCount; c++) {
+		uint32_t last = std::min<uint32_t>(readU16(endPoints + c * 2), pointCount - 1);
+
+		if (last < first) {
+			continue;
+		}
+
+		contour.clear();
+		onCurve.clear();
+
+		uint32_t count = last - first + 1;
+
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t current = first + i;
+			uint32_t next = first + (i + 1) % count;
+
+			contour.push_back(points[current]);
+			onCurve.push_back(flags[current] & 0x01);
+
+			if (!(flags[current] & 0x01) && !(flags[next] & 0x01)) {
+				contour.push_back((points[current] + points[next]) * 0.5f);
+				onCurve.push_back(true);
+			}
+		}
+
+		first = last + 1;
+
+		auto start = std::find(onCurve.begin(), onCurve.end(), true);
+
+		if (start == onCurve.end()) {
+			continue;
+		}
+
+		size_t startIndex = start - onCurve.begin();
+		size_t size = contour.size();
+
+		glm::vec2 current = contour[startIndex];
+
+		for (size_t i = 1; i <= size; ) {
+			size_t index = (startIndex + i) % size;
+
+			if (onCurve[index]) {
+				segments.push_back({ current, contour[index] });
+				current = contour[index];
+				i++;
+
+				continue;
+			}
+
+			glm::vec2 control = contour[index];
+			glm::vec2 end = contour[(index + 1) % size];
+
+			float deviation = glm::length(current - control * 2.0f + end) * 0.25f;
+			uint32_t steps = std::clamp(static_cast<uint32_t>(std::ceil(std::sqrt(deviation / flatness))), 1u, 16u);
+
+			for (uint32_t step = 1; step <= steps; step++) {
+				float t = static_cast<float>(step) / static_cast<float>(steps);
+				float u = 1.0f - t;
+
+				glm::vec2 point = current * (u * u) + control * (2.0f * u * t) + end * (t * t);
+
+				segments.push_back({ step == 1 ? current : segments.back().end, point });
+			}
+
+			current = end;
+			i += 2;
+		}
+	}
+}
+
+void Font::renderGlyphSdf(uint32_t glyph, float scale, float spread, int32_t left, int32_t top, uint32_t width, uint32_t height, uint8_t* output, uint32_t stride) {
+	std::vector<segment> segments;
+	getGlyphOutline(glyph, 0.25f / scale, segments);
+
+	for (segment& edge : segments) {
+		edge.start *= scale;
+		edge.end *= scale;
+	}
+
+	float maxDistanceSquared = spread * spread;
+
+	for (uint32_t y = 0; y < height; y++) {
+		float pixelY = static_cast<float>(top) - static_cast<float>(y) - 0.5f;
+
+		for (uint32_t x = 0; x < width; x++) {
+			glm::vec2 pixel(static_cast<float>(left) + static_cast<float>(x) + 0.5f, pixelY);
+
+			float distanceSquared = maxDistanceSquared;
+			int32_t winding = 0;
+
+			for (const segment& edge : segments) {
+				if ((edge.start.y <= pixel.y) != (edge.end.y <= pixel.y)) {
+					float crossing = edge.start.x + (pixel.y - edge.start.y) * (edge.end.x - edge.start.x) / (edge.end.y - edge.start.y);
+
+					if (crossing > pixel.x) {
+						winding += edge.end.y > edge.start.y ? 1 : -1;
+					}
+				}
+
+				glm::vec2 direction = edge.end - edge.start;
+				glm::vec2 offset = pixel - edge.start;
+
+				float lengthSquared = glm::dot(direction, direction);
+				float t = lengthSquared > 0.0f ? std::clamp(glm::dot(offset, direction) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+
+				glm::vec2 nearest = offset - direction * t;
+
+				distanceSquared = std::min(distanceSquared, glm::dot(nearest, nearest));
+			}
+
+			float distance = std::sqrt(distanceSquared);
+			float signedDistance = winding != 0 ? distance : -distance;
+			float value = std::clamp(0.5f + signedDistance / (2.0f * spread), 0.0f, 1.0f);
+
+			output[y * stride + x] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#define font_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class Font {
+	public:
+		struct glyphMetrics {
+			int16_t advance = 0;
+			int16_t leftSideBearing = 0;
+			int16_t xMin = 0;
+			int16_t yMin = 0;
+			int16_t xMax = 0;
+			int16_t yMax = 0;
+		};
+
+		struct segment {
+			glm::vec2 start;
+			glm::vec2 end;
+		};
+
+		bool load(std::vector<char> fontData);
+		bool isLoaded();
+
+		uint32_t getGlyphIndex(uint32_t codepoint);
+		glyphMetrics getGlyphMetrics(uint32_t glyph);
+		int16_t getKerning(uint32_t leftGlyph, uint32_t rightGlyph);
+
+		uint16_t getUnitsPerEm();
+		int16_t getAscender();
+		int16_t getDescender();
+		int16_t getLineGap();
+
+		void getGlyphOutline(uint32_t glyph, float flatness, std::vector<segment>& segments);
+		void renderGlyphSdf(uint32_t glyph, float scale, float spread, int32_t left, int32_t top, uint32_t width, uint32_t height, uint8_t* output, uint32_t stride);
+	private:
+		static const uint32_t MAX_COMPOUND_DEPTH = 8;
+
+		std::vector<char> data;
+		bool loaded = false;
+
+		uint32_t cmapTable = 0;
+		uint32_t locaTable = 0;
+		uint32_t glyfTable = 0;
+		uint32_t hmtxTable = 0;
+		uint32_t kernTable = 0;
+		uint32_t kernPairCount = 0;
+
+		uint16_t unitsPerEm = 0;
+		int16_t indexToLocFormat = 0;
+		uint16_t glyphCount = 0;
+		uint16_t horizontalMetricCount = 0;
+		int16_t ascender = 0;
+		int16_t descender = 0;
+		int16_t lineGap = 0;
+
+		uint8_t readU8(uint32_t offset);
+		uint16_t readU16(uint32_t offset);
+		int16_t readI16(uint32_t offset);
+		uint32_t readU32(uint32_t offset);
+
+		uint32_t findTable(const char* tag);
+		uint32_t findCharacterMap();
+		uint32_t getGlyphOffset(uint32_t glyph, uint32_t& length);
+
+		void appendGlyphOutline(uint32_t glyph, const glm::mat3& transform, float flatness, uint32_t depth, std::vector<segment>& segments);
+};
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "glyph_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+void GlyphAtlas::init() {
+	pixels.assign(SIZE * SIZE, 0);
+	pages.assign(PAGE_COUNT, page{});
+	dirtyRegions.clear();
+
+	for (uint32_t i = 0; i < PAGE_COUNT; i++) {
+		resetPage(i);
+	}
+
+	dirtyRegions.clear();
+}
+
+void GlyphAtlas::writeSolidBlock(uint8_t* pixels) {
+	for (uint32_t y = 0; y < SOLID_BLOCK_SIZE; y++) {
+		memset(pixels + y * SIZE, 0xFF, SOLID_BLOCK_SIZE);
+	}
+}
+
+void GlyphAtlas::resetPage(uint32_t index) {
+	page& target = pages[index];
+	target.skyline.clear();
+	target.lastUsed = 0;
+
+	memset(pixels.data() + index * PAGE_HEIGHT * SIZE, 0, PAGE_HEIGHT * SIZE);
+
+	if (index == 0) {
+		writeSolidBlock(pixels.data());
+
+		target.skyline.push_back({ 0, static_cast<int32_t>(SOLID_BLOCK_SIZE + PADDING), static_cast<int32_t>(SOLID_BLOCK_SIZE + PADDING) });
+		target.skyline.push_back({ static_cast<int32_t>(SOLID_BLOCK_SIZE + PADDING), 0, static_cast<int32_t>(SIZE - SOLID_BLOCK_SIZE - PADDING) });
+	}
+	else {
+		target.skyline.push_back({ 0, 0, static_cast<int32_t>(SIZE) });
+	}
+
+	markDirty({ 0, static_cast<uint16_t>(index * PAGE_HEIGHT), static_cast<uint16_t>(SIZE), static_cast<uint16_t>(PAGE_HEIGHT) });
+}
+
+bool GlyphAtlas::allocate(uint32_t width, uint32_t height, uint64_t frame, region& allocated, uint32_t& evictedPage) {
+	evictedPage = NO_PAGE;
+
+	int32_t paddedWidth = static_cast<int32_t>(width + PADDING);
+	int32_t paddedHeight = static_cast<int32_t>(height + PADDING);
+
+	if (paddedWidth > static_cast<int32_t>(SIZE) || paddedHeight > static_cast<int32_t>(PAGE_HEIGHT)) {
+		stats.failedAllocations++;
+
+		return false;
+	}
+
+	int32_t x;
+	int32_t y;
+
+	for (uint32_t i = 0; i < PAGE_COUNT; i++) {
+		if (allocateInPage(pages[i], paddedWidth, paddedHeight, x, y)) {
+			pages[i].lastUsed = frame;
+			allocated = { static_cast<uint16_t>(x), static_cast<uint16_t>(i * PAGE_HEIGHT + y), static_cast<uint16_t>(width), static_cast<uint16_t>(height) };
+
+			stats.allocations++;
+
+			return true;
+		}
+	}
+
+	uint32_t leastRecentlyUsed = NO_PAGE;
+
+	for (uint32_t i = 0; i < PAGE_COUNT; i++) {
+		if (pages[i].lastUsed < frame && (leastRecentlyUsed == NO_PAGE || pages[i].lastUsed < pages[leastRecentlyUsed].lastUsed)) {
+			leastRecentlyUsed = i;
+		}
+	}
+
+	if (leastRecentlyUsed == NO_PAGE) {
+		stats.failedAllocations++;
+
+		return false;
+	}
+
+	resetPage(leastRecentlyUsed);
+	evictedPage = leastRecentlyUsed;
+
+	stats.evictions++;
+
+	if (!allocateInPage(pages[leastRecentlyUsed], paddedWidth, paddedHeight, x, y)) {
+		stats.failedAllocations++;
+
+		return false;
+	}
+
+	pages[leastRecentlyUsed].lastUsed = frame;
+	allocated = { static_cast<uint16_t>(x), static_cast<uint16_t>(leastRecentlyUsed * PAGE_HEIGHT + y), static_cast<uint16_t>(width), static_cast<uint16_t>(height) };
+
+	stats.allocations++;
+
+	return true;
+}
+
+int32_t GlyphAtlas::fitSkyline(const page& target, size_t index, int32_t width, int32_t height) {
+	int32_t x = target.skyline[index].x;
+
+	if (x + width > static_cast<int32_t>(SIZE)) {
+		return -1;
+	}
+
+	int32_t remaining = width;
+	int32_t y = 0;
+
+	for (size_t i = index; remaining > 0; i++) {
+		y = std::max(y, target.skyline[i].y);
+
+		if (y + height > static_cast<int32_t>(PAGE_HEIGHT)) {
+			return -1;
+		}
+
+		remaining -= target.skyline[i].width;
+	}
+
+	return y;
+}
+
+bool GlyphAtlas::allocateInPage(page& target, int32_t width, int32_t height, int32_t& x, int32_t& y) {
+	size_t bestIndex = SIZE_MAX;
+	int32_t bestBottom = INT32_MAX;
+	int32_t bestWidth = INT32_MAX;
+
+	for (size_t i = 0; i < target.skyline.size(); i++) {
+		int32_t fitY = fitSkyline(target, i, width, height);
+
+		if (fitY < 0) {
+			continue;
+		}
+
+		if (fitY + height < bestBottom || (fitY + height == bestBottom && target.skyline[i].width < bestWidth)) {
+			bestIndex = i;
+			bestBottom = fitY + height;
+			bestWidth = target.skyline[i].width;
+			y = fitY;
+		}
+	}
+
+	if (bestIndex == SIZE_MAX) {
+		return false;
+	}
+
+	x = target.skyline[bestIndex].x;
+
+	std::vector<skylineNode>& skyline = target.skyline;
+	skyline.insert(skyline.begin() + bestIndex, { x, y + height, width });
+
+	for (size_t i = bestIndex + 1; i < skyline.size(); ) {
+		int32_t previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+
+		if (skyline[i].x >= previousEnd) {
+			break;
+		}
+
+		int32_t shrink = previousEnd - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+
+		if (skyline[i].width > 0) {
+			break;
+		}
+
+		skyline.erase(skyline.begin() + i);
+	}
+
+	for (size_t i = 0; i + 1 < skyline.size(); ) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else {
+			i++;
+		}
+	}
+
+	return true;
+}
+
+void GlyphAtlas::touch(uint32_t page, uint64_t frame) {
+	pages[page].lastUsed = std::max(pages[page].lastUsed, frame);
+}
+
+uint32_t GlyphAtlas::getPage(const region& allocated) {
+	return allocated.y / PAGE_HEIGHT;
+}
+
+uint8_t* GlyphAtlas::getPixels() {
+	return pixels.data();
+}
+
+void GlyphAtlas::markDirty(const region& dirtyRegion) {
+	dirtyRegions.push_back(dirtyRegion);
+}
+
+bool GlyphAtlas::hasDirtyRegions() {
+	return !dirtyRegions.empty();
+}
+
+void GlyphAtlas::writeDirtyRegions(std::vector<region>& regions, std::vector<uint8_t>& regionPixels) {
+	regions.assign(dirtyRegions.begin(), dirtyRegions.end());
+	regionPixels.clear();
+
+	for (const region& dirtyRegion : dirtyRegions) {
+		for (uint32_t row = 0; row < dirtyRegion.height; row++) {
+			const uint8_t* source = pixels.data() + (dirtyRegion.y + row) * SIZE + dirtyRegion.x;
+
+			regionPixels.insert(regionPixels.end(), source, source + dirtyRegion.width);
+		}
+	}
+
+	dirtyRegions.clear();
+}
+
+GlyphAtlas::statistics GlyphAtlas::getStatistics() {
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#define glyph_atlas_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GlyphAtlas {
+	public:
+		struct region {
+			uint16_t x = 0;
+			uint16_t y = 0;
+			uint16_t width = 0;
+			uint16_t height = 0;
+		};
+
+		struct statistics {
+			uint64_t allocations = 0;
+			uint64_t failedAllocations = 0;
+			uint64_t evictions = 0;
+		};
+
+		static const uint32_t SIZE = 1024;
+		static const uint32_t PAGE_HEIGHT = 256;
+		static const uint32_t PAGE_COUNT = SIZE / PAGE_HEIGHT;
+		static const uint32_t PADDING = 1;
+		static const uint32_t SOLID_BLOCK_SIZE = 4;
+		static const uint32_t SOLID_TEXEL = SOLID_BLOCK_SIZE / 2;
+		static const uint32_t NO_PAGE = UINT32_MAX;
+
+		void init();
+
+		bool allocate(uint32_t width, uint32_t height, uint64_t frame, region& allocated, uint32_t& evictedPage);
+		void touch(uint32_t page, uint64_t frame);
+
+		static uint32_t getPage(const region& allocated);
+		static void writeSolidBlock(uint8_t* pixels);
+
+		uint8_t* getPixels();
+		void markDirty(const region& dirtyRegion);
+		bool hasDirtyRegions();
+		void writeDirtyRegions(std::vector<region>& regions, std::vector<uint8_t>& regionPixels);
+
+		statistics getStatistics();
+	private:
+		struct skylineNode {
+			int32_t x;
+			int32_t y;
+			int32_t width;
+		};
+
+		struct page {
+			std::vector<skylineNode> skyline;
+			uint64_t lastUsed = 0;
+		};
+
+		std::vector<page> pages;
+		std::vector<uint8_t> pixels;
+		std::vector<region> dirtyRegions;
+
+		statistics stats;
+
+		void resetPage(uint32_t index);
+		bool allocateInPage(page& target, int32_t width, int32_t height, int32_t& x, int32_t& y);
+		int32_t fitSkyline(const page& target, size_t index, int32_t width, int32_t height);
+};
\ No newline at end of file
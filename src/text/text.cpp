@@ -0,0 +1,360 @@
+#include "text.h"
+
+#include <cmath>
+#include <filesystem>
+
+#include "../application/application.h"
+
+void Text::init(Application& application) {
+	log_info("Initializing text...");
+
+	this->application = &application;
+
+	if (loadDefaultFont(application.options.fontPath) == NO_FONT) {
+		log_warning("No usable font found, text rendering disabled!");
+	}
+
+	log_info("Text initialized!");
+}
+
+void Text::cleanup() {
+	log_info("Cleaning up text...");
+
+	log_info("Text: " + std::to_string(stats.shapeHits) + " shape hits, " + std::to_string(stats.shapeMisses) + " misses, " + std::to_string(stats.rasterizedGlyphs) + " glyphs rasterized, " + std::to_string(stats.evictedPages) + " atlas pages evicted, " + std::to_string(stats.missingGlyphs) + " glyphs dropped");
+
+	fonts.clear();
+	shapeCaches.clear();
+	glyphCache.clear();
+	pendingGlyphs.clear();
+
+	defaultFont = NO_FONT;
+
+	log_info("Text cleaned up!");
+}
+
+Text::fontHandle Text::loadFont(std::vector<char> fontData) {
+	if (!atlasInitialized) {
+		atlas.init();
+		atlasInitialized = true;
+	}
+
+	Font font;
+
+	if (!font.load(std::move(fontData))) {
+		return NO_FONT;
+	}
+
+	fonts.push_back(std::move(font));
+	shapeCaches.emplace_back();
+
+	fontHandle handle = static_cast<fontHandle>(fonts.size() - 1);
+
+	if (defaultFont == NO_FONT) {
+		defaultFont = handle;
+	}
+
+	return handle;
+}
+
+Text::fontHandle Text::loadFontFile(const std::string& path) {
+	std::error_code error;
+
+	if (!std::filesystem::is_regular_file(path, error)) {
+		return NO_FONT;
+	}
+
+	return loadFont(fileSystem.readFile(path));
+}
+
+std::vector<std::string> Text::getDefaultFontPaths() {
+#ifdef _WIN32
+	return { "C:/Windows/Fonts/segoeui.ttf", "C:/Windows/Fonts/arial.ttf" };
+#else
+	return { "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", "/usr/share/fonts/TTF/DejaVuSans.ttf", "/System/Library/Fonts/Supplemental/Arial.ttf" };
+#endif
+}
+
+Text::fontHandle Text::loadDefaultFont(const std::string& path) {
+	std::vector<std::string> candidates = path.empty() ? getDefaultFontPaths() : std::vector<std::string>{ path };
+
+	for (const std::string& candidate : candidates) {
+		fontHandle font = loadFontFile(candidate);
+
+		if (font != NO_FONT) {
+			log_info("Successfully loaded font: " + candidate);
+
+			return font;
+		}
+	}
+
+	return NO_FONT;
+}
+
+Text::fontHandle Text::getDefaultFont() {
+	return defaultFont;
+}
+
+bool Text::isFontLoaded(fontHandle font) {
+	return font < fonts.size();
+}
+
+bool Text::decodeUtf8(const std::string& text, size_t& position, uint32_t& codepoint) {
+	if (position >= text.size()) {
+		return false;
+	}
+
+	uint8_t lead = static_cast<uint8_t>(text[position]);
+	uint32_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x06 ? 2 : (lead >> 4) == 0x0E ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+
+	if (length == 0 || position + length > text.size()) {
+		codepoint = 0xFFFD;
+		position++;
+
+		return true;
+	}
+
+	codepoint = length == 1 ? lead : lead & (0x7F >> length);
+
+	for (uint32_t i = 1; i < length; i++) {
+		uint8_t continuation = static_cast<uint8_t>(text[position + i]);
+
+		if ((continuation & 0xC0) != 0x80) {
+			codepoint = 0xFFFD;
+			position += i;
+
+			return true;
+		}
+
+		codepoint = (codepoint << 6) | (continuation & 0x3F);
+	}
+
+	position += length;
+
+	return true;
+}
+
+const Text::shapedText& Text::shape(fontHandle font, const std::string& text) {
+	if (!isFontLoaded(font)) {
+		return emptyShape;
+	}
+
+	std::unordered_map<std::string, shapedText>& cache = shapeCaches[font];
+
+	auto cached = cache.find(text);
+
+	if (cached != cache.end()) {
+		stats.shapeHits++;
+
+		return cached->second;
+	}
+
+	stats.shapeMisses++;
+
+	if (cache.size() >= MAX_SHAPED_STRINGS) {
+		cache.clear();
+	}
+
+	Font& shapingFont = fonts[font];
+
+	shapedText shaped;
+	uint32_t previousGlyph = 0;
+	float pen = 0.0f;
+
+	size_t position = 0;
+	uint32_t codepoint;
+
+	while (decodeUtf8(text, position, codepoint)) {
+		uint32_t glyph = shapingFont.getGlyphIndex(codepoint);
+
+		if (previousGlyph != 0) {
+			pen += shapingFont.getKerning(previousGlyph, glyph);
+		}
+
+		Font::glyphMetrics metrics = shapingFont.getGlyphMetrics(glyph);
+
+		if (metrics.xMax > metrics.xMin && metrics.yMax > metrics.yMin) {
+			shaped.glyphs.push_back({ glyph, pen });
+		}
+
+		pen += metrics.advance;
+		previousGlyph = glyph;
+	}
+
+	shaped.advance = pen;
+
+	return cache.emplace(text, std::move(shaped)).first->second;
+}
+
+uint32_t Text::getGlyphCount(fontHandle font, const std::string& text) {
+	return static_cast<uint32_t>(shape(font, text).glyphs.size());
+}
+
+float Text::getLineHeight(fontHandle font, float size) {
+	if (!isFontLoaded(font)) {
+		return 0.0f;
+	}
+
+	Font& lineFont = fonts[font];
+
+	return (lineFont.getAscender() - lineFont.getDescender() + lineFont.getLineGap()) * size / lineFont.getUnitsPerEm();
+}
+
+float Text::getTextWidth(fontHandle font, const std::string& text, float size) {
+	if (!isFontLoaded(font)) {
+		return 0.0f;
+	}
+
+	return shape(font, text).advance * size / fonts[font].getUnitsPerEm();
+}
+
+const Text::cachedGlyph& Text::acquireGlyph(fontHandle font, uint32_t glyph) {
+	uint64_t key = (static_cast<uint64_t>(font) << 32) | glyph;
+
+	auto cached = glyphCache.find(key);
+
+	if (cached != glyphCache.end()) {
+		atlas.touch(GlyphAtlas::getPage(cached->second.atlasRegion), frame);
+
+		return cached->second;
+	}
+
+	Font& glyphFont = fonts[font];
+	Font::glyphMetrics metrics = glyphFont.getGlyphMetrics(glyph);
+
+	float scale = static_cast<float>(SDF_SIZE) / glyphFont.getUnitsPerEm();
+	int32_t spread = static_cast<int32_t>(std::ceil(SDF_SPREAD));
+
+	cachedGlyph placement;
+	placement.left = static_cast<int32_t>(std::floor(metrics.xMin * scale)) - spread;
+	placement.top = static_cast<int32_t>(std::ceil(metrics.yMax * scale)) + spread;
+
+	int32_t right = static_cast<int32_t>(std::ceil(metrics.xMax * scale)) + spread;
+	int32_t bottom = static_cast<int32_t>(std::floor(metrics.yMin * scale)) - spread;
+
+	uint32_t evictedPage;
+	bool allocated = atlas.allocate(right - placement.left, placement.top - bottom, frame, placement.atlasRegion, evictedPage);
+
+	if (evictedPage != GlyphAtlas::NO_PAGE) {
+		evictPage(evictedPage);
+	}
+
+	if (!allocated) {
+		stats.missingGlyphs++;
+
+		return missingGlyph;
+	}
+
+	placement.resident = true;
+
+	pendingGlyphs.push_back({ font, glyph, placement });
+
+	return glyphCache.emplace(key, placement).first->second;
+}
+
+void Text::evictPage(uint32_t page) {
+	for (auto glyph = glyphCache.begin(); glyph != glyphCache.end(); ) {
+		if (GlyphAtlas::getPage(glyph->second.atlasRegion) == page) {
+			glyph = glyphCache.erase(glyph);
+		}
+		else {
+			++glyph;
+		}
+	}
+
+	evictedPages |= 1u << page;
+
+	stats.evictedPages++;
+}
+
+uint32_t Text::layout(fontHandle font, const std::string& text, float size, glm::vec2 origin, glyphQuad* output, uint32_t& pageMask) {
+	pageMask = 0;
+
+	if (!isFontLoaded(font)) {
+		return 0;
+	}
+
+	const shapedText& shaped = shape(font, text);
+	Font& layoutFont = fonts[font];
+
+	float unitScale = size / layoutFont.getUnitsPerEm();
+	float atlasScale = size / static_cast<float>(SDF_SIZE);
+	float baseline = origin.y + layoutFont.getAscender() * unitScale;
+
+	for (size_t i = 0; i < shaped.glyphs.size(); i++) {
+		const cachedGlyph& cached = acquireGlyph(font, shaped.glyphs[i].glyph);
+
+		if (!cached.resident) {
+			output[i] = {};
+
+			continue;
+		}
+
+		output[i].x = origin.x + shaped.glyphs[i].x * unitScale + cached.left * atlasScale;
+		output[i].y = baseline - cached.top * atlasScale;
+		output[i].width = cached.atlasRegion.width * atlasScale;
+		output[i].height = cached.atlasRegion.height * atlasScale;
+		output[i].atlasRegion = cached.atlasRegion;
+
+		pageMask |= 1u << GlyphAtlas::getPage(cached.atlasRegion);
+	}
+
+	return static_cast<uint32_t>(shaped.glyphs.size());
+}
+
+void Text::update() {
+	trace_zone("Text::update");
+
+	if (!pendingGlyphs.empty()) {
+		uint8_t* pixels = atlas.getPixels();
+
+		auto rasterize = [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++) {
+				const pendingGlyph& pending = pendingGlyphs[i];
+				const GlyphAtlas::region& target = pending.placement.atlasRegion;
+
+				Font& glyphFont = fonts[pending.font];
+				float scale = static_cast<float>(SDF_SIZE) / glyphFont.getUnitsPerEm();
+
+				glyphFont.renderGlyphSdf(pending.glyph, scale, SDF_SPREAD, pending.placement.left, pending.placement.top, target.width, target.height, pixels + target.y * GlyphAtlas::SIZE + target.x, GlyphAtlas::SIZE);
+			}
+		};
+
+		uint32_t count = static_cast<uint32_t>(pendingGlyphs.size());
+
+		if (application != nullptr) {
+			application->jobSystem.parallelFor(count, 1, rasterize);
+		}
+		else {
+			rasterize(0, count);
+		}
+
+		for (const pendingGlyph& pending : pendingGlyphs) {
+			atlas.markDirty(pending.placement.atlasRegion);
+		}
+
+		stats.rasterizedGlyphs += count;
+
+		pendingGlyphs.clear();
+	}
+
+	frame++;
+}
+
+uint32_t Text::takeEvictedPages() {
+	uint32_t pages = evictedPages;
+	evictedPages = 0;
+
+	return pages;
+}
+
+bool Text::hasAtlasUploads() {
+	return atlas.hasDirtyRegions();
+}
+
+void Text::writeAtlasUploads(std::vector<GlyphAtlas::region>& regions, std::vector<uint8_t>& regionPixels) {
+	atlas.writeDirtyRegions(regions, regionPixels);
+}
+
+Text::statistics Text::getStatistics() {
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+#define text_h
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "font.h"
+#include "glyph_atlas.h"
+
+class Application;
+
+class Text {
+	public:
+		typedef uint32_t fontHandle;
+
+		static const fontHandle NO_FONT = UINT32_MAX;
+		static const uint32_t SDF_SIZE = 32;
+		static constexpr float SDF_SPREAD = 4.0f;
+		static const uint32_t MAX_SHAPED_STRINGS = 4096;
+
+		struct shapedGlyph {
+			uint32_t glyph;
+			float x;
+		};
+
+		struct shapedText {
+			std::vector<shapedGlyph> glyphs;
+			float advance = 0.0f;
+		};
+
+		struct glyphQuad {
+			float x;
+			float y;
+			float width;
+			float height;
+			GlyphAtlas::region atlasRegion;
+		};
+
+		struct statistics {
+			uint64_t shapeHits = 0;
+			uint64_t shapeMisses = 0;
+			uint64_t rasterizedGlyphs = 0;
+			uint64_t missingGlyphs = 0;
+			uint64_t evictedPages = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		fontHandle loadFont(std::vector<char> fontData);
+		fontHandle loadFontFile(const std::string& path);
+		fontHandle loadDefaultFont(const std::string& path);
+		static std::vector<std::string> getDefaultFontPaths();
+		fontHandle getDefaultFont();
+		bool isFontLoaded(fontHandle font);
+
+		const shapedText& shape(fontHandle font, const std::string& text);
+		uint32_t getGlyphCount(fontHandle font, const std::string& text);
+		float getLineHeight(fontHandle font, float size);
+		float getTextWidth(fontHandle font, const std::string& text, float size);
+
+		uint32_t layout(fontHandle font, const std::string& text, float size, glm::vec2 origin, glyphQuad* output, uint32_t& pageMask);
+		void update();
+
+		uint32_t takeEvictedPages();
+		bool hasAtlasUploads();
+		void writeAtlasUploads(std::vector<GlyphAtlas::region>& regions, std::vector<uint8_t>& regionPixels);
+
+		statistics getStatistics();
+	private:
+		struct cachedGlyph {
+			GlyphAtlas::region atlasRegion;
+			int32_t left = 0;
+			int32_t top = 0;
+			bool resident = false;
+		};
+
+		struct pendingGlyph {
+			fontHandle font;
+			uint32_t glyph;
+			cachedGlyph placement;
+		};
+
+		Application* application = nullptr;
+
+		std::vector<Font> fonts;
+		std::vector<std::unordered_map<std::string, shapedText>> shapeCaches;
+		std::unordered_map<uint64_t, cachedGlyph> glyphCache;
+		std::vector<pendingGlyph> pendingGlyphs;
+
+		GlyphAtlas atlas;
+		bool atlasInitialized = false;
+
+		uint64_t frame = 1;
+		uint32_t evictedPages = 0;
+		fontHandle defaultFont = NO_FONT;
+
+		shapedText emptyShape;
+		cachedGlyph missingGlyph;
+
+		statistics stats;
+
+		const cachedGlyph& acquireGlyph(fontHandle font, uint32_t glyph);
+		void evictPage(uint32_t page);
+		static bool decodeUtf8(const std::string& text, size_t& position, uint32_t& codepoint);
+};
\ No newline at end of file
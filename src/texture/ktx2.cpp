@@ -0,0 +1,69 @@
+#include "ktx2.h"
+#include "texture_transcoder.h"
+#include "../logger/logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(Ktx2::header) == 80, "KTX2 header must match the container layout!");
+static_assert(sizeof(Ktx2::levelIndex) == 24, "KTX2 level index must match the container layout!");
+
+Ktx2::container Ktx2::parse(const char* data, size_t size, const std::string& name) {
+	header fileHeader;
+
+	if (size < sizeof(fileHeader)) {
+		log_error("KTX2 file is truncated: " + name);
+	}
+
+	std::memcpy(&fileHeader, data, sizeof(fileHeader));
+
+	if (std::memcmp(fileHeader.identifier, IDENTIFIER, sizeof(IDENTIFIER)) != 0) {
+		log_error("Not a KTX2 file: " + name);
+	}
+
+	if (fileHeader.supercompressionScheme == static_cast<uint32_t>(supercompression::basisLZ) || fileHeader.vkFormat == VK_FORMAT_UNDEFINED) {
+		log_error("Basis Universal payloads need a Basis transcoder, which is not available: " + name);
+	}
+
+	if (fileHeader.supercompressionScheme != static_cast<uint32_t>(supercompression::none)) {
+		log_error("Unsupported KTX2 supercompression scheme " + std::to_string(fileHeader.supercompressionScheme) + ": " + name);
+	}
+
+	if (fileHeader.pixelWidth == 0 || fileHeader.pixelHeight == 0 || fileHeader.pixelDepth > 1 || fileHeader.layerCount > 1 || fileHeader.faceCount != 1) {
+		log_error("Only single 2D KTX2 images are supported: " + name);
+	}
+
+	container image;
+	image.format = static_cast<VkFormat>(fileHeader.vkFormat);
+	image.width = fileHeader.pixelWidth;
+	image.height = fileHeader.pixelHeight;
+
+	if (TextureTranscoder::getFormatInfo(image.format).blockBytes == 0) {
+		log_error("Unsupported KTX2 format " + std::to_string(fileHeader.vkFormat) + ": " + name);
+	}
+
+	uint32_t levelCount = std::max(fileHeader.levelCount, 1u);
+	uint32_t maxLevels = 1;
+
+	while ((std::max(image.width, image.height) >> maxLevels) > 0) {
+		maxLevels++;
+	}
+
+	if (levelCount > maxLevels || sizeof(fileHeader) + static_cast<uint64_t>(levelCount) * sizeof(levelIndex) > size) {
+		log_error("Invalid KTX2 level index: " + name);
+	}
+
+	image.levels.resize(levelCount);
+	std::memcpy(image.levels.data(), data + sizeof(fileHeader), levelCount * sizeof(levelIndex));
+
+	for (uint32_t level = 0; level < levelCount; level++) {
+		const levelIndex& index = image.levels[level];
+		VkDeviceSize expectedSize = TextureTranscoder::getLevelSize(image.format, std::max(image.width >> level, 1u), std::max(image.height >> level, 1u));
+
+		if (index.byteLength < expectedSize || index.byteOffset > size || index.byteLength > size - index.byteOffset) {
+			log_error("KTX2 level " + std::to_string(level) + " is out of range: " + name);
+		}
+	}
+
+	return image;
+}
\ No newline at end of file
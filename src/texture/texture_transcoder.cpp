@@ -0,0 +1,220 @@
+#include "texture_transcoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+TextureTranscoder::formatInfo TextureTranscoder::getFormatInfo(VkFormat format) {
+	switch (format) {
+		case VK_FORMAT_R8_UNORM:
+			return { 1, 1, 1 };
+		case VK_FORMAT_R8G8_UNORM:
+			return { 1, 1, 2 };
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+			return { 1, 1, 4 };
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+			return { 1, 1, 8 };
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_BC4_SNORM_BLOCK:
+			return { 4, 4, 8, compression::bc };
+		case VK_FORMAT_BC2_UNORM_BLOCK:
+		case VK_FORMAT_BC2_SRGB_BLOCK:
+		case VK_FORMAT_BC3_UNORM_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+		case VK_FORMAT_BC5_SNORM_BLOCK:
+		case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+		case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			return { 4, 4, 16, compression::bc };
+		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+			return { 4, 4, 8, compression::etc2 };
+		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+			return { 4, 4, 16, compression::etc2 };
+		case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+			return { 4, 4, 16, compression::astc };
+		case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+			return { 5, 5, 16, compression::astc };
+		case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+			return { 6, 6, 16, compression::astc };
+		case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+			return { 8, 8, 16, compression::astc };
+		default:
+			return {};
+	}
+}
+
+VkDeviceSize TextureTranscoder::getLevelSize(VkFormat format, uint32_t width, uint32_t height) {
+	formatInfo info = getFormatInfo(format);
+
+	VkDeviceSize blocksWide = (width + info.blockWidth - 1) / info.blockWidth;
+	VkDeviceSize blocksHigh = (height + info.blockHeight - 1) / info.blockHeight;
+
+	return blocksWide * blocksHigh * info.blockBytes;
+}
+
+bool TextureTranscoder::canTranscode(VkFormat format) {
+	switch (format) {
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC3_UNORM_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+			return true;
+		default:
+			return false;
+	}
+}
+
+VkFormat TextureTranscoder::getTranscodeFormat(VkFormat format) {
+	switch (format) {
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+			return VK_FORMAT_R8G8B8A8_SRGB;
+		default:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+void TextureTranscoder::decodeColorBlock(const uint8_t* block, bool allowTransparent, uint8_t* pixels) {
+	uint16_t endpoints[2];
+	std::memcpy(endpoints, block, sizeof(endpoints));
+
+	uint8_t palette[4][4];
+
+	for (uint32_t i = 0; i < 2; i++) {
+		uint32_t red = (endpoints[i] >> 11) & 0x1F;
+		uint32_t green = (endpoints[i] >> 5) & 0x3F;
+		uint32_t blue = endpoints[i] & 0x1F;
+
+		palette[i][0] = static_cast<uint8_t>((red << 3) | (red >> 2));
+		palette[i][1] = static_cast<uint8_t>((green << 2) | (green >> 4));
+		palette[i][2] = static_cast<uint8_t>((blue << 3) | (blue >> 2));
+		palette[i][3] = 255;
+	}
+
+	bool fourColors = !allowTransparent || endpoints[0] > endpoints[1];
+
+	for (uint32_t channel = 0; channel < 3; channel++) {
+		uint32_t first = palette[0][channel];
+		uint32_t second = palette[1][channel];
+
+		if (fourColors) {
+			palette[2][channel] = static_cast<uint8_t>((2 * first + second + 1) / 3);
+			palette[3][channel] = static_cast<uint8_t>((first + 2 * second + 1) / 3);
+		}
+		else {
+			palette[2][channel] = static_cast<uint8_t>((first + second) / 2);
+			palette[3][channel] = 0;
+		}
+	}
+
+	palette[2][3] = 255;
+	palette[3][3] = fourColors ? 255 : 0;
+
+	uint32_t indices;
+	std::memcpy(&indices, block + 4, sizeof(indices));
+
+	for (uint32_t pixel = 0; pixel < 16; pixel++) {
+		std::memcpy(pixels + pixel * 4, palette[(indices >> (pixel * 2)) & 0x3], 4);
+	}
+}
+
+void TextureTranscoder::decodeChannelBlock(const uint8_t* block, uint8_t* pixels, uint32_t channel) {
+	uint32_t first = block[0];
+	uint32_t second = block[1];
+
+	uint8_t palette[8];
+	palette[0] = static_cast<uint8_t>(first);
+	palette[1] = static_cast<uint8_t>(second);
+
+	if (first > second) {
+		for (uint32_t i = 1; i < 7; i++) {
+			palette[i + 1] = static_cast<uint8_t>(((7 - i) * first + i * second + 3) / 7);
+		}
+	}
+	else {
+		for (uint32_t i = 1; i < 5; i++) {
+			palette[i + 1] = static_cast<uint8_t>(((5 - i) * first + i * second + 2) / 5);
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0;
+	std::memcpy(&indices, block + 2, 6);
+
+	for (uint32_t pixel = 0; pixel < 16; pixel++) {
+		pixels[pixel * 4 + channel] = palette[(indices >> (pixel * 3)) & 0x7];
+	}
+}
+
+void TextureTranscoder::transcode(VkFormat format, const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination) {
+	const uint32_t blocksWide = (width + 3) / 4;
+	const uint32_t blocksHigh = (height + 3) / 4;
+	const uint32_t blockBytes = getFormatInfo(format).blockBytes;
+
+	uint8_t pixels[16 * 4];
+
+	for (uint32_t blockY = 0; blockY < blocksHigh; blockY++) {
+		for (uint32_t blockX = 0; blockX < blocksWide; blockX++) {
+			const uint8_t* block = source + (static_cast<size_t>(blockY) * blocksWide + blockX) * blockBytes;
+
+			switch (format) {
+				case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+				case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+				case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+				case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+					decodeColorBlock(block, true, pixels);
+					break;
+				case VK_FORMAT_BC3_UNORM_BLOCK:
+				case VK_FORMAT_BC3_SRGB_BLOCK:
+					decodeColorBlock(block + 8, false, pixels);
+					decodeChannelBlock(block, pixels, 3);
+					break;
+				case VK_FORMAT_BC4_UNORM_BLOCK:
+					std::memset(pixels, 0, sizeof(pixels));
+					decodeChannelBlock(block, pixels, 0);
+					break;
+				case VK_FORMAT_BC5_UNORM_BLOCK:
+					std::memset(pixels, 0, sizeof(pixels));
+					decodeChannelBlock(block, pixels, 0);
+					decodeChannelBlock(block + 8, pixels, 1);
+					break;
+				default:
+					return;
+			}
+
+			if (format == VK_FORMAT_BC4_UNORM_BLOCK || format == VK_FORMAT_BC5_UNORM_BLOCK) {
+				for (uint32_t pixel = 0; pixel < 16; pixel++) {
+					pixels[pixel * 4 + 3] = 255;
+				}
+			}
+
+			uint32_t columns = std::min(4u, width - blockX * 4);
+			uint32_t rows = std::min(4u, height - blockY * 4);
+
+			for (uint32_t row = 0; row < rows; row++) {
+				std::memcpy(destination + ((static_cast<size_t>(blockY) * 4 + row) * width + blockX * 4) * 4, pixels + row * 16, columns * 4);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#define texture_transcoder_h
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+class TextureTranscoder {
+	public:
+		enum class compression : uint8_t {
+			none,
+			bc,
+			etc2,
+			astc
+		};
+
+		struct formatInfo {
+			uint32_t blockWidth = 1;
+			uint32_t blockHeight = 1;
+			uint32_t blockBytes = 0;
+			compression family = compression::none;
+		};
+
+		static formatInfo getFormatInfo(VkFormat format);
+		static VkDeviceSize getLevelSize(VkFormat format, uint32_t width, uint32_t height);
+
+		static bool canTranscode(VkFormat format);
+		static VkFormat getTranscodeFormat(VkFormat format);
+		static void transcode(VkFormat format, const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination);
+	private:
+		static void decodeColorBlock(const uint8_t* block, bool allowTransparent, uint8_t* pixels);
+		static void decodeChannelBlock(const uint8_t* block, uint8_t* pixels, uint32_t channel);
+};
\ No newline at end of file
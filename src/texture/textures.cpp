@@ -0,0 +1,750 @@
+#include "textures.h"
+#include "texture_transcoder.h"
+#include "../application/application.h"
+
+#include <cmath>
+#include <queue>
+
+void Textures::init(Application& application) {
+	log_info("Initializing textures...");
+
+	this->application = &application;
+
+	textures.reserve(MAX_TEXTURES);
+
+	createDescriptorSetLayout();
+	createSampler();
+	chooseBudget();
+
+	texture fallback;
+	fallback.name = "default texture";
+	fallback.embeddedData = { 255, 255, 255, 255 };
+	fallback.container.format = VK_FORMAT_R8G8B8A8_UNORM;
+	fallback.container.width = 1;
+	fallback.container.height = 1;
+	fallback.container.levels = { { 0, 4, 4 } };
+
+	addTexture(fallback);
+
+	log_info("Textures initialized with a " + std::to_string(budget / (1024 * 1024)) + " MB budget!");
+}
+
+void Textures::createDescriptorSetLayout() {
+	VkDevice device = application->renderer.getDevice();
+
+	VkDescriptorSetLayoutBinding textureBinding{};
+	textureBinding.binding = 0;
+	textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	textureBinding.descriptorCount = 1;
+	textureBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+	textureBinding.pImmutableSamplers = nullptr;
+
+	VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+	layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutCreateInfo.bindingCount = 1;
+	layoutCreateInfo.pBindings = &textureBinding;
+
+	if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+		log_error("Failed to create texture descriptor set layout!");
+	}
+
+	uint32_t maxSets = MAX_TEXTURES * (application->renderer.getMaxFramesInFlight() + 1);
+
+	VkDescriptorPoolSize poolSize{};
+	poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSize.descriptorCount = maxSets;
+
+	VkDescriptorPoolCreateInfo poolCreateInfo{};
+	poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+	poolCreateInfo.maxSets = maxSets;
+	poolCreateInfo.poolSizeCount = 1;
+	poolCreateInfo.pPoolSizes = &poolSize;
+
+	if (vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+		log_error("Failed to create texture descriptor pool!");
+	}
+}
+
+void Textures::createSampler() {
+	const DeviceCapabilities::capabilities& capabilities = application->renderer.capabilities.get();
+
+	VkSamplerCreateInfo samplerCreateInfo{};
+	samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+	samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+	samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerCreateInfo.anisotropyEnable = capabilities.samplerAnisotropy ? VK_TRUE : VK_FALSE;
+	samplerCreateInfo.maxAnisotropy = capabilities.samplerAnisotropy ? capabilities.maxSamplerAnisotropy : 1.0f;
+	samplerCreateInfo.minLod = 0.0f;
+	samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+	if (vkCreateSampler(application->renderer.getDevice(), &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS) {
+		log_error("Failed to create texture sampler!");
+	}
+}
+
+void Textures::chooseBudget() {
+	if (application->options.textureBudgetMegabytes != 0) {
+		budget = static_cast<VkDeviceSize>(application->options.textureBudgetMegabytes) * 1024 * 1024;
+	}
+	else {
+		budget = DEFAULT_BUDGET;
+
+		for (const DeviceCapabilities::heapBudget& heap : application->renderer.capabilities.getHeapBudgets()) {
+			if (heap.deviceLocal && heap.budget > 0) {
+				budget = std::min(budget, heap.budget / 4);
+			}
+		}
+	}
+
+	stats.budgetBytes = budget;
+}
+
+Textures::textureHandle Textures::loadTexture(const std::string& path) {
+	trace_zone("Textures::loadTexture");
+
+	texture loaded;
+	loaded.name = path;
+
+	try {
+		loaded.file = fileSystem.mapFile(path);
+		loaded.container = Ktx2::parse(loaded.file.data, loaded.file.size, path);
+
+		return addTexture(loaded);
+	}
+	catch (const std::runtime_error& error) {
+		fileSystem.unmapFile(loaded.file);
+
+		log_warning("Falling back to the default texture: " + std::string(error.what()));
+
+		return DEFAULT_TEXTURE;
+	}
+}
+
+Textures::textureHandle Textures::addTexture(texture& loaded) {
+	if (textures.size() >= MAX_TEXTURES) {
+		log_error("Too many textures!");
+	}
+
+	loaded.format = loaded.container.format;
+
+	if (!isFormatSupported(loaded.format)) {
+		if (!TextureTranscoder::canTranscode(loaded.format)) {
+			log_error("Texture format is not supported by the device and cannot be transcoded: " + loaded.name);
+		}
+
+		loaded.format = TextureTranscoder::getTranscodeFormat(loaded.format);
+		loaded.transcoded = true;
+	}
+
+	loaded.levelCount = static_cast<uint32_t>(loaded.container.levels.size());
+	loaded.levelBytes.resize(loaded.levelCount);
+	loaded.residentBytes.assign(loaded.levelCount + 1, 0);
+	loaded.baseMip = loaded.levelCount - 1;
+
+	for (uint32_t level = 0; level < loaded.levelCount; level++) {
+		uint32_t width = std::max(loaded.container.width >> level, 1u);
+		uint32_t height = std::max(loaded.container.height >> level, 1u);
+
+		loaded.levelBytes[level] = TextureTranscoder::getLevelSize(loaded.format, width, height);
+
+		if (std::max(width, height) <= RESIDENT_SIZE) {
+			loaded.baseMip = std::min(loaded.baseMip, level);
+		}
+	}
+
+	for (uint32_t level = loaded.levelCount; level > 0; level--) {
+		loaded.residentBytes[level - 1] = loaded.residentBytes[level] + loaded.levelBytes[level - 1];
+	}
+
+	loaded.desiredMip = loaded.baseMip;
+
+	textureHandle handle = static_cast<textureHandle>(textures.size());
+	textures.push_back(std::move(loaded));
+
+	texture& current = textures.back();
+
+	std::unique_ptr<streamingRequest> upload = createRequest(current, handle, current.baseMip, current.levelCount);
+	prepareRequest(*upload);
+
+	VkCommandBuffer commandBuffer = application->renderer.beginSingleTimeCommands();
+	replaceImage(commandBuffer, current, current.baseMip, upload.get());
+	application->renderer.endSingleTimeCommands(commandBuffer);
+
+	VkDevice device = application->renderer.getDevice();
+
+	vkUnmapMemory(device, upload->stagingMemory);
+	vkDestroyBuffer(device, upload->stagingBuffer, nullptr);
+	vkFreeMemory(device, upload->stagingMemory, nullptr);
+
+	stats.textures++;
+	stats.transcodedTextures += current.transcoded ? 1 : 0;
+
+	log_info("Loaded texture " + current.name + " (" + std::to_string(current.container.width) + "x" + std::to_string(current.container.height) + ", " + std::to_string(current.levelCount) + " levels" + (current.transcoded ? ", transcoded" : "") + ") with " + std::to_string(current.levelCount - current.baseMip) + " resident levels");
+
+	return handle;
+}
+
+bool Textures::isFormatSupported(VkFormat format) {
+	const DeviceCapabilities::capabilities& capabilities = application->renderer.capabilities.get();
+
+	switch (TextureTranscoder::getFormatInfo(format).family) {
+		case TextureTranscoder::compression::bc:
+			if (!capabilities.textureCompressionBC) {
+				return false;
+			}
+
+			break;
+		case TextureTranscoder::compression::etc2:
+			if (!capabilities.textureCompressionETC2) {
+				return false;
+			}
+
+			break;
+		case TextureTranscoder::compression::astc:
+			if (!capabilities.textureCompressionASTC) {
+				return false;
+			}
+
+			break;
+		default:
+			break;
+	}
+
+	VkFormatProperties properties{};
+	vkGetPhysicalDeviceFormatProperties(application->renderer.getPhysicalDevice(), format, &properties);
+
+	return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+}
+
+const uint8_t* Textures::getLevelData(const texture& current, uint32_t level) {
+	const uint8_t* data = current.file.data != nullptr ? reinterpret_cast<const uint8_t*>(current.file.data) : current.embeddedData.data();
+
+	return data + current.container.levels[level].byteOffset;
+}
+
+void Textures::createImage(texture& current, uint32_t firstMip, VkImage& image, VkDeviceMemory& memory, VkImageView& view) {
+	VkDevice device = application->renderer.getDevice();
+
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = current.format;
+	imageCreateInfo.extent = { std::max(current.container.width >> firstMip, 1u), std::max(current.container.height >> firstMip, 1u), 1 };
+	imageCreateInfo.mipLevels = current.levelCount - firstMip;
+	imageCreateInfo.arrayLayers = 1;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	if (vkCreateImage(device, &imageCreateInfo, nullptr, &image) != VK_SUCCESS) {
+		log_error("Failed to create texture image: " + current.name);
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &memory) != VK_SUCCESS) {
+		log_error("Failed to allocate texture image memory: " + current.name);
+	}
+
+	vkBindImageMemory(device, image, memory, 0);
+
+	VkImageViewCreateInfo viewCreateInfo{};
+	viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewCreateInfo.image = image;
+	viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewCreateInfo.format = current.format;
+	viewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	viewCreateInfo.subresourceRange.baseMipLevel = 0;
+	viewCreateInfo.subresourceRange.levelCount = imageCreateInfo.mipLevels;
+	viewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	viewCreateInfo.subresourceRange.layerCount = 1;
+
+	if (vkCreateImageView(device, &viewCreateInfo, nullptr, &view) != VK_SUCCESS) {
+		log_error("Failed to create texture image view: " + current.name);
+	}
+}
+
+void Textures::writeDescriptorSet(texture& current) {
+	VkDevice device = application->renderer.getDevice();
+
+	VkDescriptorSetAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = descriptorPool;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &descriptorSetLayout;
+
+	if (vkAllocateDescriptorSets(device, &allocateInfo, &current.descriptorSet) != VK_SUCCESS) {
+		log_error("Failed to allocate texture descriptor set: " + current.name);
+	}
+
+	VkDescriptorImageInfo imageInfo{};
+	imageInfo.sampler = sampler;
+	imageInfo.imageView = current.view;
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+	VkWriteDescriptorSet descriptorWrite{};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = current.descriptorSet;
+	descriptorWrite.dstBinding = 0;
+	descriptorWrite.dstArrayElement = 0;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pImageInfo = &imageInfo;
+
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+}
+
+std::unique_ptr<Textures::streamingRequest> Textures::createRequest(texture& current, textureHandle handle, uint32_t firstMip, uint32_t lastMip) {
+	std::unique_ptr<streamingRequest> request = std::make_unique<streamingRequest>();
+	request->handle = handle;
+	request->firstMip = firstMip;
+	request->lastMip = lastMip;
+
+	VkDeviceSize size = 0;
+
+	for (uint32_t level = firstMip; level < lastMip; level++) {
+		VkBufferImageCopy region{};
+		region.bufferOffset = size;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = level - firstMip;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { std::max(current.container.width >> level, 1u), std::max(current.container.height >> level, 1u), 1 };
+
+		request->regions.push_back(region);
+
+		size += (current.levelBytes[level] + 15) & ~static_cast<VkDeviceSize>(15);
+	}
+
+	application->renderer.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, request->stagingBuffer, request->stagingMemory);
+
+	void* data;
+	vkMapMemory(application->renderer.getDevice(), request->stagingMemory, 0, size, 0, &data);
+	request->mapped = static_cast<uint8_t*>(data);
+
+	return request;
+}
+
+void Textures::prepareRequest(streamingRequest& request) {
+	trace_zone("Textures::prepareRequest");
+
+	const texture& current = textures[request.handle];
+
+	for (const VkBufferImageCopy& region : request.regions) {
+		uint32_t level = request.firstMip + region.imageSubresource.mipLevel;
+		const uint8_t* source = getLevelData(current, level);
+
+		if (current.transcoded) {
+			TextureTranscoder::transcode(current.container.format, source, region.imageExtent.width, region.imageExtent.height, request.mapped + region.bufferOffset);
+		}
+		else {
+			std::memcpy(request.mapped + region.bufferOffset, source, current.levelBytes[level]);
+		}
+	}
+
+	request.ready.store(true, std::memory_order_release);
+}
+
+void Textures::replaceImage(VkCommandBuffer commandBuffer, texture& current, uint32_t firstMip, const streamingRequest* request) {
+	VkImage image;
+	VkDeviceMemory memory;
+	VkImageView view;
+	createImage(current, firstMip, image, memory, view);
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+	barrierTracker.trackImage(image, VK_IMAGE_ASPECT_COLOR_BIT);
+	barrierTracker.transitionImage(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+	if (current.image != VK_NULL_HANDLE) {
+		barrierTracker.transitionImage(current.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+	}
+
+	barrierTracker.flush(commandBuffer);
+
+	if (current.image != VK_NULL_HANDLE) {
+		std::vector<VkImageCopy> copies;
+
+		for (uint32_t level = std::max(firstMip, current.residentMip); level < current.levelCount; level++) {
+			VkImageCopy copy{};
+			copy.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - current.residentMip, 0, 1 };
+			copy.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - firstMip, 0, 1 };
+			copy.extent = { std::max(current.container.width >> level, 1u), std::max(current.container.height >> level, 1u), 1 };
+
+			copies.push_back(copy);
+		}
+
+		vkCmdCopyImage(commandBuffer, current.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data());
+	}
+
+	if (request != nullptr && !request->regions.empty()) {
+		vkCmdCopyBufferToImage(commandBuffer, request->stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(request->regions.size()), request->regions.data());
+	}
+
+	barrierTracker.transitionImage(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+	barrierTracker.flush(commandBuffer);
+
+	if (current.image != VK_NULL_HANDLE) {
+		barrierTracker.forgetImage(current.image);
+
+		retiredResources old;
+		old.frame = frame;
+		old.image = current.image;
+		old.memory = current.memory;
+		old.view = current.view;
+		old.descriptorSet = current.descriptorSet;
+
+		retired.push_back(old);
+
+		if (firstMip > current.residentMip) {
+			stats.evictedLevels += firstMip - current.residentMip;
+		}
+	}
+
+	current.image = image;
+	current.memory = memory;
+	current.view = view;
+	current.residentMip = firstMip;
+	current.replacedFrame = frame;
+
+	writeDescriptorSet(current);
+}
+
+void Textures::recordUploads(VkCommandBuffer commandBuffer) {
+	if (application == nullptr || textures.empty()) {
+		return;
+	}
+
+	trace_zone("Textures::recordUploads");
+
+	frame = application->renderer.getFrameNumber();
+
+	releaseRetired(false);
+	completeRequests(commandBuffer);
+	updateResidency(commandBuffer);
+
+	if (!requests.empty()) {
+		application->renderer.markDamaged();
+	}
+}
+
+void Textures::completeRequests(VkCommandBuffer commandBuffer) {
+	size_t kept = 0;
+
+	for (size_t i = 0; i < requests.size(); i++) {
+		streamingRequest& request = *requests[i];
+
+		if (!request.ready.load(std::memory_order_acquire)) {
+			requests[kept++] = std::move(requests[i]);
+
+			continue;
+		}
+
+		texture& current = textures[request.handle];
+
+		replaceImage(commandBuffer, current, request.firstMip, &request);
+		current.streaming = false;
+
+		stats.streamedLevels += request.lastMip - request.firstMip;
+		stats.streamedBytes += current.residentBytes[request.firstMip] - current.residentBytes[request.lastMip];
+
+		retiredResources staging;
+		staging.frame = frame;
+		staging.stagingBuffer = request.stagingBuffer;
+		staging.stagingMemory = request.stagingMemory;
+
+		retired.push_back(staging);
+	}
+
+	requests.resize(kept);
+}
+
+void Textures::updateResidency(VkCommandBuffer commandBuffer) {
+	candidates.resize(textures.size());
+
+	for (size_t i = 0; i < textures.size(); i++) {
+		texture& current = textures[i];
+
+		if (frame > current.lastRequestFrame + FEEDBACK_FRAMES) {
+			current.desiredMip = current.baseMip;
+		}
+
+		residencyCandidate& candidate = candidates[i];
+		candidate.baseMip = current.baseMip;
+		candidate.desiredMip = current.desiredMip;
+		candidate.targetMip = current.residentMip;
+		candidate.lastRequestFrame = current.lastRequestFrame;
+		candidate.residentBytes = current.residentBytes.data();
+	}
+
+	if (planResidency(candidates, budget) > budget) {
+		stats.overBudgetFrames++;
+	}
+
+	VkDeviceSize streamingBytes = 0;
+
+	for (const std::unique_ptr<streamingRequest>& request : requests) {
+		const texture& current = textures[request->handle];
+
+		streamingBytes += current.residentBytes[request->firstMip] - current.residentBytes[request->lastMip];
+	}
+
+	for (size_t i = 0; i < textures.size(); i++) {
+		texture& current = textures[i];
+		uint32_t targetMip = candidates[i].targetMip;
+
+		if (current.streaming || current.replacedFrame == frame || targetMip == current.residentMip) {
+			continue;
+		}
+
+		if (targetMip > current.residentMip) {
+			replaceImage(commandBuffer, current, targetMip, nullptr);
+
+			continue;
+		}
+
+		if (requests.size() >= MAX_STREAMING_REQUESTS) {
+			continue;
+		}
+
+		uint32_t firstMip = targetMip;
+
+		while (firstMip + 1 < current.residentMip && current.residentBytes[firstMip] - current.residentBytes[current.residentMip] > MAX_STREAMING_BYTES) {
+			firstMip++;
+		}
+
+		VkDeviceSize requestBytes = current.residentBytes[firstMip] - current.residentBytes[current.residentMip];
+
+		if (streamingBytes != 0 && streamingBytes + requestBytes > MAX_STREAMING_BYTES) {
+			continue;
+		}
+
+		streamingBytes += requestBytes;
+		current.streaming = true;
+
+		requests.push_back(createRequest(current, static_cast<textureHandle>(i), firstMip, current.residentMip));
+
+		streamingRequest* pending = requests.back().get();
+
+		if (application->jobSystem.getThreadCount() > 1) {
+			application->jobSystem.submit([this, pending]() {
+				prepareRequest(*pending);
+			}, &streamingJobs);
+		}
+		else {
+			prepareRequest(*pending);
+		}
+	}
+
+	VkDeviceSize residentBytes = 0;
+
+	for (const texture& current : textures) {
+		residentBytes += current.residentBytes[current.residentMip];
+	}
+
+	stats.residentBytes = residentBytes;
+	stats.peakResidentBytes = std::max(stats.peakResidentBytes, residentBytes);
+}
+
+VkDeviceSize Textures::planResidency(std::vector<residencyCandidate>& candidates, VkDeviceSize budget) {
+	VkDeviceSize total = 0;
+
+	for (residencyCandidate& candidate : candidates) {
+		candidate.targetMip = std::min(candidate.desiredMip, candidate.baseMip);
+		total += candidate.residentBytes[candidate.targetMip];
+	}
+
+	if (total <= budget) {
+		return total;
+	}
+
+	struct eviction {
+		uint64_t lastRequestFrame;
+		VkDeviceSize bytes;
+		uint32_t index;
+
+		bool operator<(const eviction& other) const {
+			if (lastRequestFrame != other.lastRequestFrame) {
+				return lastRequestFrame > other.lastRequestFrame;
+			}
+
+			return bytes < other.bytes;
+		}
+	};
+
+	std::priority_queue<eviction> evictions;
+
+	auto pushEviction = [&](uint32_t index) {
+		const residencyCandidate& candidate = candidates[index];
+
+		if (candidate.targetMip < candidate.baseMip) {
+			evictions.push({ candidate.lastRequestFrame, candidate.residentBytes[candidate.targetMip] - candidate.residentBytes[candidate.targetMip + 1], index });
+		}
+	};
+
+	for (uint32_t i = 0; i < candidates.size(); i++) {
+		pushEviction(i);
+	}
+
+	while (total > budget && !evictions.empty()) {
+		eviction next = evictions.top();
+		evictions.pop();
+
+		candidates[next.index].targetMip++;
+		total -= next.bytes;
+
+		pushEviction(next.index);
+	}
+
+	return total;
+}
+
+uint32_t Textures::getDesiredMip(uint32_t width, uint32_t height, uint32_t levelCount, float screenPixels) {
+	if (levelCount == 0) {
+		return 0;
+	}
+
+	if (!(screenPixels > 0.0f)) {
+		return levelCount - 1;
+	}
+
+	float ratio = static_cast<float>(std::max(width, height)) / screenPixels;
+
+	if (ratio <= 1.0f) {
+		return 0;
+	}
+
+	return std::min(static_cast<uint32_t>(std::floor(std::log2(ratio))), levelCount - 1);
+}
+
+void Textures::requestResolution(textureHandle handle, float screenPixels) {
+	if (handle >= textures.size()) {
+		return;
+	}
+
+	texture& current = textures[handle];
+
+	uint32_t desiredMip = getDesiredMip(current.container.width, current.container.height, current.levelCount, screenPixels);
+	uint64_t requestFrame = application->renderer.getFrameNumber();
+
+	current.desiredMip = current.lastRequestFrame == requestFrame ? std::min(current.desiredMip, desiredMip) : desiredMip;
+	current.lastRequestFrame = requestFrame;
+}
+
+VkDescriptorSet Textures::useTexture(textureHandle handle) {
+	texture& current = textures[handle < textures.size() ? handle : DEFAULT_TEXTURE];
+
+	application->renderer.barrierTracker.useImage(current.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+	return current.descriptorSet;
+}
+
+VkDescriptorSetLayout Textures::getDescriptorSetLayout() {
+	return descriptorSetLayout;
+}
+
+Textures::statistics Textures::getStatistics() {
+	return stats;
+}
+
+void Textures::releaseRetired(bool all) {
+	VkDevice device = application->renderer.getDevice();
+	uint64_t framesInFlight = application->renderer.getMaxFramesInFlight();
+
+	size_t kept = 0;
+
+	for (size_t i = 0; i < retired.size(); i++) {
+		retiredResources& resources = retired[i];
+
+		if (!all && resources.frame + framesInFlight > frame) {
+			retired[kept++] = resources;
+
+			continue;
+		}
+
+		if (resources.descriptorSet != VK_NULL_HANDLE) {
+			vkFreeDescriptorSets(device, descriptorPool, 1, &resources.descriptorSet);
+		}
+
+		if (resources.image != VK_NULL_HANDLE) {
+			vkDestroyImageView(device, resources.view, nullptr);
+			vkDestroyImage(device, resources.image, nullptr);
+			vkFreeMemory(device, resources.memory, nullptr);
+		}
+
+		if (resources.stagingBuffer != VK_NULL_HANDLE) {
+			vkUnmapMemory(device, resources.stagingMemory);
+			vkDestroyBuffer(device, resources.stagingBuffer, nullptr);
+			vkFreeMemory(device, resources.stagingMemory, nullptr);
+		}
+	}
+
+	retired.resize(kept);
+}
+
+void Textures::cleanup() {
+	log_info("Cleaning up textures...");
+
+	if (application == nullptr) {
+		return;
+	}
+
+	application->jobSystem.wait(streamingJobs);
+
+	VkDevice device = application->renderer.getDevice();
+
+	vkDeviceWaitIdle(device);
+
+	for (std::unique_ptr<streamingRequest>& request : requests) {
+		vkUnmapMemory(device, request->stagingMemory);
+		vkDestroyBuffer(device, request->stagingBuffer, nullptr);
+		vkFreeMemory(device, request->stagingMemory, nullptr);
+	}
+
+	requests.clear();
+
+	releaseRetired(true);
+
+	for (texture& current : textures) {
+		application->renderer.barrierTracker.forgetImage(current.image);
+
+		vkDestroyImageView(device, current.view, nullptr);
+		vkDestroyImage(device, current.image, nullptr);
+		vkFreeMemory(device, current.memory, nullptr);
+
+		fileSystem.unmapFile(current.file);
+	}
+
+	textures.clear();
+
+	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+	vkDestroySampler(device, sampler, nullptr);
+
+	descriptorPool = VK_NULL_HANDLE;
+	descriptorSetLayout = VK_NULL_HANDLE;
+	sampler = VK_NULL_HANDLE;
+
+	log_info("Textures streamed " + std::to_string(stats.streamedLevels) + " levels (" + std::to_string(stats.streamedBytes) + " bytes), evicted " + std::to_string(stats.evictedLevels) + " levels and peaked at " + std::to_string(stats.peakResidentBytes) + " of " + std::to_string(stats.budgetBytes) + " budgeted bytes");
+
+	log_info("Textures cleaned up!");
+}
\ No newline at end of file
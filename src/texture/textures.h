@@ -0,0 +1,149 @@
+#pragma once
+#define textures_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ktx2.h"
+#include "../file_system/file_system.h"
+#include "../job_system/job_system.h"
+
+class Application;
+
+class Textures {
+	public:
+		typedef uint32_t textureHandle;
+
+		static constexpr textureHandle DEFAULT_TEXTURE = 0;
+		static constexpr uint32_t MAX_TEXTURES = 256;
+		static constexpr uint32_t RESIDENT_SIZE = 64;
+		static constexpr uint64_t FEEDBACK_FRAMES = 120;
+		static constexpr uint32_t MAX_STREAMING_REQUESTS = 8;
+		static constexpr VkDeviceSize MAX_STREAMING_BYTES = 64ull * 1024 * 1024;
+		static constexpr VkDeviceSize DEFAULT_BUDGET = 256ull * 1024 * 1024;
+
+		struct residencyCandidate {
+			uint32_t baseMip = 0;
+			uint32_t desiredMip = 0;
+			uint32_t targetMip = 0;
+			uint64_t lastRequestFrame = 0;
+			const VkDeviceSize* residentBytes = nullptr;
+		};
+
+		struct statistics {
+			uint32_t textures = 0;
+			uint32_t transcodedTextures = 0;
+			VkDeviceSize budgetBytes = 0;
+			VkDeviceSize residentBytes = 0;
+			VkDeviceSize peakResidentBytes = 0;
+			VkDeviceSize streamedBytes = 0;
+			uint64_t streamedLevels = 0;
+			uint64_t evictedLevels = 0;
+			uint64_t overBudgetFrames = 0;
+		};
+
+		void init(Application& application);
+		void cleanup();
+
+		textureHandle loadTexture(const std::string& path);
+		void requestResolution(textureHandle handle, float screenPixels);
+
+		void recordUploads(VkCommandBuffer commandBuffer);
+		VkDescriptorSet useTexture(textureHandle handle);
+
+		VkDescriptorSetLayout getDescriptorSetLayout();
+		statistics getStatistics();
+
+		static uint32_t getDesiredMip(uint32_t width, uint32_t height, uint32_t levelCount, float screenPixels);
+		static VkDeviceSize planResidency(std::vector<residencyCandidate>& candidates, VkDeviceSize budget);
+	private:
+		struct texture {
+			std::string name;
+			FileSystem::mappedFile file;
+			std::vector<uint8_t> embeddedData;
+			Ktx2::container container;
+
+			VkFormat format = VK_FORMAT_UNDEFINED;
+			bool transcoded = false;
+			uint32_t levelCount = 0;
+			std::vector<VkDeviceSize> levelBytes;
+			std::vector<VkDeviceSize> residentBytes;
+
+			uint32_t baseMip = 0;
+			uint32_t residentMip = 0;
+			uint32_t desiredMip = 0;
+			uint64_t lastRequestFrame = 0;
+			uint64_t replacedFrame = UINT64_MAX;
+			bool streaming = false;
+
+			VkImage image = VK_NULL_HANDLE;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			VkImageView view = VK_NULL_HANDLE;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		};
+
+		struct streamingRequest {
+			textureHandle handle = DEFAULT_TEXTURE;
+			uint32_t firstMip = 0;
+			uint32_t lastMip = 0;
+
+			VkBuffer stagingBuffer = VK_NULL_HANDLE;
+			VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+			uint8_t* mapped = nullptr;
+
+			std::vector<VkBufferImageCopy> regions;
+			std::atomic<bool> ready{ false };
+		};
+
+		struct retiredResources {
+			uint64_t frame = 0;
+			VkImage image = VK_NULL_HANDLE;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			VkImageView view = VK_NULL_HANDLE;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			VkBuffer stagingBuffer = VK_NULL_HANDLE;
+			VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+		};
+
+		Application* application = nullptr;
+
+		std::vector<texture> textures;
+		std::vector<std::unique_ptr<streamingRequest>> requests;
+		std::vector<retiredResources> retired;
+		std::vector<residencyCandidate> candidates;
+
+		JobSystem::counter streamingJobs;
+
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkSampler sampler = VK_NULL_HANDLE;
+
+		VkDeviceSize budget = DEFAULT_BUDGET;
+		uint64_t frame = 0;
+
+		statistics stats;
+
+		void createDescriptorSetLayout();
+		void createSampler();
+		void chooseBudget();
+
+		textureHandle addTexture(texture& loaded);
+		bool isFormatSupported(VkFormat format);
+		const uint8_t* getLevelData(const texture& current, uint32_t level);
+
+		void createImage(texture& current, uint32_t firstMip, VkImage& image, VkDeviceMemory& memory, VkImageView& view);
+		void writeDescriptorSet(texture& current);
+
+		std::unique_ptr<streamingRequest> createRequest(texture& current, textureHandle handle, uint32_t firstMip, uint32_t lastMip);
+		void prepareRequest(streamingRequest& request);
+		void replaceImage(VkCommandBuffer commandBuffer, texture& current, uint32_t firstMip, const streamingRequest* request);
+
+		void completeRequests(VkCommandBuffer commandBuffer);
+		void updateResidency(VkCommandBuffer commandBuffer);
+		void releaseRetired(bool all);
+};
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "tracer.h"
+#include "../logger/logger.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define TRACER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACER_HAS_TSC 1
+#endif
+
+Tracer tracer;
+
+static thread_local Tracer::threadBuffer* currentThreadBuffer = nullptr;
+
+static uint64_t steadyClockNanoseconds() {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Tracer::init(bool enabled) {
+	log_info("Initializing tracer...");
+
+	this->enabled.store(enabled, std::memory_order_relaxed);
+
+	if (!enabled) {
+		log_info("Tracer disabled!");
+
+		return;
+	}
+
+	calibrate();
+	setThreadName("main");
+
+	log_info("Tracer initialized!");
+}
+
+void Tracer::cleanup() {
+	log_info("Cleaning up tracer...");
+
+	if (isEnabled()) {
+		exportChromeTrace("trace.json");
+	}
+
+	log_info("Tracer cleaned up!");
+}
+
+void Tracer::calibrate() {
+#ifdef TRACER_HAS_TSC
+	useTsc = true;
+
+	uint64_t clockBegin = steadyClockNanoseconds();
+	uint64_t tscBegin = __rdtsc();
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	uint64_t clockEnd = steadyClockNanoseconds();
+	uint64_t tscEnd = __rdtsc();
+
+	ticksPerMicrosecond = static_cast<double>(tscEnd - tscBegin) / (static_cast<double>(clockEnd - clockBegin) / 1000.0);
+#else
+	useTsc = false;
+	ticksPerMicrosecond = 1000.0;
+#endif
+
+	startTicks = now();
+}
+
+uint64_t Tracer::now() {
+#ifdef TRACER_HAS_TSC
+	if (useTsc) {
+		return __rdtsc();
+	}
+#endif
+
+	return steadyClockNanoseconds();
+}
+
+Tracer::threadBuffer* Tracer::getThreadBuffer() {
+	if (currentThreadBuffer != nullptr) {
+		return currentThreadBuffer;
+	}
+
+	std::unique_ptr<threadBuffer> buffer = std::make_unique<threadBuffer>();
+	buffer->events = std::make_unique<event[]>(EVENTS_PER_THREAD);
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	buffer->threadId = static_cast<uint32_t>(threadBuffers.size());
+	buffer->threadName = "thread " + std::to_string(buffer->threadId);
+
+	currentThreadBuffer = buffer.get();
+	threadBuffers.push_back(std::move(buffer));
+
+	return currentThreadBuffer;
+}
+
+void Tracer::record(const char* name, uint64_t begin, uint64_t end) {
+	if (!enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	threadBuffer* buffer = getThreadBuffer();
+
+	uint64_t index = buffer->count.load(std::memory_order_relaxed);
+
+	buffer->events[index & (EVENTS_PER_THREAD - 1)] = { name, begin, end };
+	buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+	if (!enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	threadBuffer* buffer = getThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	buffer->threadName = name;
+}
+
+bool Tracer::isEnabled() {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+static void writeJsonString(std::ofstream& file, const std::string& value) {
+	file << '"';
+
+	for (char character : value) {
+		switch (character) {
+			case '"':
+				file << "\\\"";
+				break;
+			case '\\':
+				file << "\\\\";
+				break;
+			case '\n':
+				file << "\\n";
+				break;
+			default:
+				file << character;
+				break;
+		}
+	}
+
+	file << '"';
+}
+
+bool Tracer::exportChromeTrace(const std::string& path) {
+	std::ofstream file(path, std::ios::trunc);
+
+	if (!file.is_open()) {
+		log_warning("Failed to open trace file: " + path);
+
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool first = true;
+	size_t eventCount = 0;
+
+	for (const std::unique_ptr<threadBuffer>& buffer : threadBuffers) {
+		if (!first) {
+			file << ",";
+		}
+
+		first = false;
+
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+		writeJsonString(file, buffer->threadName);
+		file << "}}";
+
+		uint64_t count = buffer->count.load(std::memory_order_acquire);
+		uint64_t firstIndex = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+
+		for (uint64_t index = firstIndex; index < count; index++) {
+			const event& traceEvent = buffer->events[index & (EVENTS_PER_THREAD - 1)];
+
+			double timestamp = static_cast<double>(traceEvent.begin - startTicks) / ticksPerMicrosecond;
+			double duration = static_cast<double>(traceEvent.end - traceEvent.begin) / ticksPerMicrosecond;
+
+			file << ",{\"name\":";
+			writeJsonString(file, traceEvent.name);
+			file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":" << timestamp << ",\"dur\":" << duration << "}";
+
+			eventCount++;
+		}
+	}
+
+	file << "]}";
+
+	log_info("Exported " + std::to_string(eventCount) + " trace events to " + path);
+
+	return true;
+}
\ No newline at end of file
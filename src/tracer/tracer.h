@@ -0,0 +1,69 @@
+#pragma once
+#define tracer_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Tracer {
+	public:
+		struct event {
+			const char* name;
+			uint64_t begin;
+			uint64_t end;
+		};
+
+		struct threadBuffer {
+			std::unique_ptr<event[]> events;
+			std::atomic<uint64_t> count{ 0 };
+			uint32_t threadId = 0;
+			std::string threadName;
+		};
+
+		void init(bool enabled);
+		void cleanup();
+
+		uint64_t now();
+		void record(const char* name, uint64_t begin, uint64_t end);
+
+		void setThreadName(const std::string& name);
+		bool isEnabled();
+
+		bool exportChromeTrace(const std::string& path);
+	private:
+		static const uint64_t EVENTS_PER_THREAD = 1 << 16;
+
+		threadBuffer* getThreadBuffer();
+		void calibrate();
+
+		std::mutex registryMutex;
+		std::vector<std::unique_ptr<threadBuffer>> threadBuffers;
+
+		std::atomic<bool> enabled{ false };
+		bool useTsc = false;
+
+		uint64_t startTicks = 0;
+		double ticksPerMicrosecond = 1000.0;
+};
+
+extern Tracer tracer;
+
+class TraceZone {
+	public:
+		explicit TraceZone(const char* name) : name(name), begin(tracer.now()) {}
+		~TraceZone() { tracer.record(name, begin, tracer.now()); }
+
+		TraceZone(const TraceZone&) = delete;
+		TraceZone& operator=(const TraceZone&) = delete;
+	private:
+		const char* name;
+		uint64_t begin;
+};
+
+#define trace_concat_inner(a, b) a##b
+#define trace_concat(a, b) trace_concat_inner(a, b)
+
+#define trace_zone(name) TraceZone trace_concat(traceZone, __LINE__)("" name)
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "draw_list.h"
+
+#include <algorithm>
+#include <cmath>
+
+void DrawList::clear() {
+	commands.clear();
+	clipStack.clear();
+	translationStack.clear();
+
+	clipStack.push_back({ -UNBOUNDED, -UNBOUNDED, UNBOUNDED, UNBOUNDED });
+	translationStack.push_back(glm::vec2(0.0f));
+
+	discontinuities = 0;
+}
+
+void DrawList::pushClipRect(glm::vec4 rect) {
+	const glm::vec2& translation = translationStack.back();
+	clipRect clip = toClipRect({ rect.x + translation.x, rect.y + translation.y, rect.z, rect.w });
+	const clipRect& current = clipStack.back();
+
+	clip.left = std::max(clip.left, current.left);
+	clip.top = std::max(clip.top, current.top);
+	clip.right = std::min(clip.right, current.right);
+	clip.bottom = std::min(clip.bottom, current.bottom);
+
+	clipStack.push_back(clip);
+}
+
+void DrawList::popClipRect() {
+	clipStack.pop_back();
+}
+
+void DrawList::pushTranslation(glm::vec2 translation) {
+	translationStack.push_back(translationStack.back() + translation);
+}
+
+void DrawList::popTranslation() {
+	translationStack.pop_back();
+}
+
+void DrawList::addRange(uint32_t pipeline, uint32_t texture, uint32_t first, uint32_t count, glm::vec4 bounds) {
+	if (count == 0) {
+		return;
+	}
+
+	const clipRect& clip = clipStack.back();
+	const glm::vec2& translation = translationStack.back();
+
+	stats.ranges++;
+
+	if (!commands.empty()) {
+		command& last = commands.back();
+
+		if (last.pipeline == pipeline && last.texture == texture && last.translation == translation) {
+			bool sameClip = isEqual(last.clip, clip);
+
+			if (!sameClip) {
+				clipRect quadBounds = toClipRect({ bounds.x + translation.x, bounds.y + translation.y, bounds.z, bounds.w });
+
+				sameClip = contains(clip, quadBounds) && contains(last.clip, quadBounds);
+
+				if (sameClip) {
+					stats.elidedClips++;
+				}
+			}
+
+			if (sameClip) {
+				if (last.first + last.count == first) {
+					last.count += count;
+
+					stats.mergedRanges++;
+
+					return;
+				}
+
+				discontinuities++;
+				stats.discontinuities++;
+			}
+		}
+	}
+
+	commands.push_back({ clip, translation, pipeline, texture, first, count });
+}
+
+void DrawList::addHiddenRange(uint32_t pipeline, uint32_t first, uint32_t count) {
+	if (count == 0 || commands.empty()) {
+		return;
+	}
+
+	command& last = commands.back();
+
+	if (last.pipeline == pipeline && last.first + last.count == first) {
+		last.count += count;
+	}
+}
+
+bool DrawList::isClipEmpty() {
+	return isEmpty(clipStack.back());
+}
+
+uint32_t DrawList::getDiscontinuities() {
+	return discontinuities;
+}
+
+const std::vector<DrawList::command>& DrawList::getCommands() {
+	return commands;
+}
+
+DrawList::statistics DrawList::getStatistics() {
+	return stats;
+}
+
+bool DrawList::isEmpty(const clipRect& clip) {
+	return clip.left >= clip.right || clip.top >= clip.bottom;
+}
+
+bool DrawList::isEqual(const clipRect& a, const clipRect& b) {
+	return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+DrawList::clipRect DrawList::toClipRect(glm::vec4 rect) {
+	auto toPixel = [](float value) {
+		return static_cast<int32_t>(std::clamp(std::floor(value + 0.5f), static_cast<float>(-UNBOUNDED), static_cast<float>(UNBOUNDED)));
+	};
+
+	return { toPixel(rect.x), toPixel(rect.y), toPixel(rect.x + rect.z), toPixel(rect.y + rect.w) };
+}
+
+bool DrawList::contains(const clipRect& outer, const clipRect& inner) {
+	return inner.left >= outer.left && inner.top >= outer.top && inner.right <= outer.right && inner.bottom <= outer.bottom;
+}
\ No newline at end of file
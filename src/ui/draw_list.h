@@ -0,0 +1,64 @@
+#pragma once
+#define draw_list_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class DrawList {
+	public:
+		struct clipRect {
+			int32_t left;
+			int32_t top;
+			int32_t right;
+			int32_t bottom;
+		};
+
+		struct command {
+			clipRect clip;
+			glm::vec2 translation;
+			uint32_t pipeline;
+			uint32_t texture;
+			uint32_t first;
+			uint32_t count;
+		};
+
+		struct statistics {
+			uint64_t ranges = 0;
+			uint64_t mergedRanges = 0;
+			uint64_t elidedClips = 0;
+			uint64_t discontinuities = 0;
+		};
+
+		static const int32_t UNBOUNDED = 1 << 30;
+
+		void clear();
+
+		void pushClipRect(glm::vec4 rect);
+		void popClipRect();
+		void pushTranslation(glm::vec2 translation);
+		void popTranslation();
+
+		void addRange(uint32_t pipeline, uint32_t texture, uint32_t first, uint32_t count, glm::vec4 bounds);
+		void addHiddenRange(uint32_t pipeline, uint32_t first, uint32_t count);
+
+		bool isClipEmpty();
+		uint32_t getDiscontinuities();
+		const std::vector<command>& getCommands();
+		statistics getStatistics();
+
+		static bool isEmpty(const clipRect& clip);
+		static bool isEqual(const clipRect& a, const clipRect& b);
+	private:
+		std::vector<command> commands;
+		std::vector<clipRect> clipStack;
+		std::vector<glm::vec2> translationStack;
+
+		uint32_t discontinuities = 0;
+
+		statistics stats;
+
+		static clipRect toClipRect(glm::vec4 rect);
+		static bool contains(const clipRect& outer, const clipRect& inner);
+};
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "layout.h"
+
+#include <algorithm>
+
+Layout::nodeHandle Layout::createNode(nodeHandle parent) {
+	nodeHandle handle;
+
+	if (!freeNodes.empty()) {
+		handle = freeNodes.back();
+		freeNodes.pop_back();
+	}
+	else {
+		handle = static_cast<nodeHandle>(nodes.size());
+		nodes.emplace_back();
+	}
+
+	nodes[handle] = node{};
+	nodes[handle].alive = true;
+
+	linkNode(handle, parent);
+
+	if (parent != NO_NODE) {
+		markDirty(parent);
+	}
+
+	stats.nodes++;
+
+	return handle;
+}
+
+void Layout::destroyNode(nodeHandle handle) {
+	if (handle == NO_NODE || !nodes[handle].alive) {
+		return;
+	}
+
+	nodeHandle parent = nodes[handle].parent;
+
+	unlinkNode(handle);
+
+	if (parent != NO_NODE) {
+		markDirty(parent);
+	}
+
+	subtreeStack.clear();
+	subtreeStack.push_back(handle);
+
+	while (!subtreeStack.empty()) {
+		nodeHandle current = subtreeStack.back();
+		subtreeStack.pop_back();
+
+		for (nodeHandle child = nodes[current].firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+			subtreeStack.push_back(child);
+		}
+
+		nodes[current].alive = false;
+		freeNodes.push_back(current);
+
+		stats.nodes--;
+	}
+}
+
+bool Layout::isAlive(nodeHandle handle) {
+	return handle < nodes.size() && nodes[handle].alive;
+}
+
+void Layout::setStyle(nodeHandle handle, const style& nodeStyle) {
+	nodes[handle].layoutStyle = nodeStyle;
+
+	markDirty(handle);
+
+	if (nodes[handle].parent != NO_NODE) {
+		markDirty(nodes[handle].parent);
+	}
+}
+
+const Layout::style& Layout::getStyle(nodeHandle handle) {
+	return nodes[handle].layoutStyle;
+}
+
+void Layout::setContentSize(nodeHandle handle, glm::vec2 contentSize) {
+	if (nodes[handle].contentSize == contentSize) {
+		return;
+	}
+
+	nodes[handle].contentSize = contentSize;
+
+	markDirty(handle);
+}
+
+void Layout::markDirty(nodeHandle handle) {
+	nodeHandle current = handle;
+
+	while (current != NO_NODE) {
+		node& dirtyNode = nodes[current];
+		dirtyNode.measureDirty = true;
+		dirtyNode.layoutDirty = true;
+
+		if (isFixedSize(dirtyNode.layoutStyle)) {
+			markChildDirty(current);
+
+			return;
+		}
+
+		current = dirtyNode.parent;
+	}
+}
+
+void Layout::markChildDirty(nodeHandle handle) {
+	for (nodeHandle parent = nodes[handle].parent; parent != NO_NODE && !nodes[parent].childDirty; parent = nodes[parent].parent) {
+		nodes[parent].childDirty = true;
+	}
+}
+
+bool Layout::isFixedSize(const style& nodeStyle) {
+	return nodeStyle.size.x >= 0.0f && nodeStyle.size.y >= 0.0f;
+}
+
+void Layout::update(glm::vec2 viewport) {
+	changedNodes.clear();
+
+	for (nodeHandle root = firstRoot; root != NO_NODE; root = nodes[root].nextSibling) {
+		const node& rootNode = nodes[root];
+		const glm::vec2& size = rootNode.layoutStyle.size;
+
+		glm::vec4 rect(0.0f, 0.0f, size.x >= 0.0f ? size.x : viewport.x, size.y >= 0.0f ? size.y : viewport.y);
+
+		if (rootNode.layoutDirty || rootNode.childDirty || rootNode.rect != rect) {
+			layoutNode(root, rect);
+		}
+	}
+
+	stats.updates++;
+	stats.changedNodes += changedNodes.size();
+}
+
+void Layout::layoutNode(nodeHandle handle, glm::vec4 rect) {
+	node& current = nodes[handle];
+
+	bool resized = current.rect.z != rect.z || current.rect.w != rect.w;
+
+	if (current.rect != rect) {
+		current.rect = rect;
+		changedNodes.push_back(handle);
+	}
+
+	if (resized || current.layoutDirty) {
+		arrangeChildren(handle);
+	}
+	else if (current.childDirty) {
+		for (nodeHandle child = current.firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+			if (nodes[child].layoutDirty || nodes[child].childDirty) {
+				layoutNode(child, nodes[child].rect);
+			}
+		}
+	}
+
+	current.layoutDirty = false;
+	current.childDirty = false;
+}
+
+glm::vec2 Layout::measure(nodeHandle handle) {
+	node& current = nodes[handle];
+
+	if (!current.measureDirty) {
+		stats.measureCacheHits++;
+
+		return current.measured;
+	}
+
+	const style& nodeStyle = current.layoutStyle;
+	glm::vec2 content = current.contentSize;
+
+	if (!isFixedSize(nodeStyle) && current.firstChild != NO_NODE) {
+		uint32_t mainAxis = nodeStyle.flexDirection == direction::row ? 0 : 1;
+		uint32_t crossAxis = 1 - mainAxis;
+
+		glm::vec2 children(0.0f);
+		uint32_t count = 0;
+
+		for (nodeHandle child = current.firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+			glm::vec2 childSize = measure(child);
+
+			children[mainAxis] += childSize[mainAxis];
+			children[crossAxis] = std::max(children[crossAxis], childSize[crossAxis]);
+			count++;
+		}
+
+		children[mainAxis] += nodeStyle.gap * static_cast<float>(count - 1);
+		content = glm::max(content, children);
+	}
+
+	glm::vec2 size = content + glm::vec2(nodeStyle.padding.x + nodeStyle.padding.z, nodeStyle.padding.y + nodeStyle.padding.w);
+
+	if (nodeStyle.size.x >= 0.0f) {
+		size.x = nodeStyle.size.x;
+	}
+
+	if (nodeStyle.size.y >= 0.0f) {
+		size.y = nodeStyle.size.y;
+	}
+
+	current.measured = size;
+	current.measureDirty = false;
+
+	stats.measuredNodes++;
+
+	return size;
+}
+
+void Layout::arrangeChildren(nodeHandle handle) {
+	const node& parent = nodes[handle];
+
+	if (parent.firstChild == NO_NODE) {
+		return;
+	}
+
+	const style& parentStyle = parent.layoutStyle;
+
+	uint32_t mainAxis = parentStyle.flexDirection == direction::row ? 0 : 1;
+	uint32_t crossAxis = 1 - mainAxis;
+
+	glm::vec2 origin(parentStyle.padding.x, parentStyle.padding.y);
+	glm::vec2 inner = glm::max(glm::vec2(parent.rect.z, parent.rect.w) - origin - glm::vec2(parentStyle.padding.z, parentStyle.padding.w), glm::vec2(0.0f));
+
+	float totalBase = 0.0f;
+	float totalGrow = 0.0f;
+	float totalShrink = 0.0f;
+	uint32_t count = 0;
+
+	for (nodeHandle child = parent.firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+		float base = measure(child)[mainAxis];
+
+		totalBase += base;
+		totalGrow += nodes[child].layoutStyle.grow;
+		totalShrink += nodes[child].layoutStyle.shrink * base;
+		count++;
+	}
+
+	float freeSpace = inner[mainAxis] - totalBase - parentStyle.gap * static_cast<float>(count - 1);
+	bool growing = freeSpace > 0.0f && totalGrow > 0.0f;
+	bool shrinking = freeSpace < 0.0f && totalShrink > 0.0f;
+	float remaining = growing || shrinking ? 0.0f : std::max(freeSpace, 0.0f);
+
+	float position = origin[mainAxis];
+	float between = parentStyle.gap;
+
+	switch (parentStyle.justifyContent) {
+		case justify::center:
+			position += remaining * 0.5f;
+			break;
+		case justify::end:
+			position += remaining;
+			break;
+		case justify::spaceBetween:
+			between += count > 1 ? remaining / static_cast<float>(count - 1) : 0.0f;
+			break;
+		default:
+			break;
+	}
+
+	for (nodeHandle child = parent.firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+		const node& childNode = nodes[child];
+		const style& childStyle = childNode.layoutStyle;
+
+		float mainSize = childNode.measured[mainAxis];
+
+		if (growing) {
+			mainSize += freeSpace * childStyle.grow / totalGrow;
+		}
+		else if (shrinking) {
+			mainSize = std::max(mainSize + freeSpace * childStyle.shrink * mainSize / totalShrink, 0.0f);
+		}
+
+		float crossSize = childNode.measured[crossAxis];
+		float crossPosition = origin[crossAxis];
+
+		switch (parentStyle.alignItems) {
+			case align::stretch:
+				crossSize = childStyle.size[crossAxis] >= 0.0f ? crossSize : inner[crossAxis];
+				break;
+			case align::center:
+				crossPosition += (inner[crossAxis] - crossSize) * 0.5f;
+				break;
+			case align::end:
+				crossPosition += inner[crossAxis] - crossSize;
+				break;
+			default:
+				break;
+		}
+
+		glm::vec4 rect;
+		rect[mainAxis] = position;
+		rect[crossAxis] = crossPosition;
+		rect[2 + mainAxis] = mainSize;
+		rect[2 + crossAxis] = crossSize;
+
+		layoutNode(child, rect);
+
+		position += mainSize + between;
+	}
+
+	stats.arrangedNodes++;
+}
+
+glm::vec4 Layout::getRect(nodeHandle handle) {
+	return nodes[handle].rect;
+}
+
+glm::vec2 Layout::getMeasuredSize(nodeHandle handle) {
+	return measure(handle);
+}
+
+const std::vector<Layout::nodeHandle>& Layout::getChangedNodes() {
+	return changedNodes;
+}
+
+Layout::statistics Layout::getStatistics() {
+	return stats;
+}
+
+void Layout::linkNode(nodeHandle handle, nodeHandle parent) {
+	nodeHandle& first = parent != NO_NODE ? nodes[parent].firstChild : firstRoot;
+	nodeHandle& last = parent != NO_NODE ? nodes[parent].lastChild : lastRoot;
+
+	node& linked = nodes[handle];
+	linked.parent = parent;
+	linked.previousSibling = last;
+	linked.nextSibling = NO_NODE;
+
+	if (last != NO_NODE) {
+		nodes[last].nextSibling = handle;
+	}
+	else {
+		first = handle;
+	}
+
+	last = handle;
+}
+
+void Layout::unlinkNode(nodeHandle handle) {
+	node& unlinked = nodes[handle];
+
+	nodeHandle& first = unlinked.parent != NO_NODE ? nodes[unlinked.parent].firstChild : firstRoot;
+	nodeHandle& last = unlinked.parent != NO_NODE ? nodes[unlinked.parent].lastChild : lastRoot;
+
+	if (unlinked.previousSibling != NO_NODE) {
+		nodes[unlinked.previousSibling].nextSibling = unlinked.nextSibling;
+	}
+	else {
+		first = unlinked.nextSibling;
+	}
+
+	if (unlinked.nextSibling != NO_NODE) {
+		nodes[unlinked.nextSibling].previousSibling = unlinked.previousSibling;
+	}
+	else {
+		last = unlinked.previousSibling;
+	}
+
+	unlinked.parent = NO_NODE;
+	unlinked.previousSibling = NO_NODE;
+	unlinked.nextSibling = NO_NODE;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+#define layout_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class Layout {
+	public:
+		typedef uint32_t nodeHandle;
+
+		static const nodeHandle NO_NODE = UINT32_MAX;
+		static constexpr float AUTO = -1.0f;
+
+		enum class direction : uint8_t {
+			row,
+			column
+		};
+
+		enum class justify : uint8_t {
+			start,
+			center,
+			end,
+			spaceBetween
+		};
+
+		enum class align : uint8_t {
+			start,
+			center,
+			end,
+			stretch
+		};
+
+		struct style {
+			direction flexDirection = direction::column;
+			justify justifyContent = justify::start;
+			align alignItems = align::stretch;
+			glm::vec2 size{ AUTO, AUTO };
+			glm::vec4 padding{};
+			float gap = 0.0f;
+			float grow = 0.0f;
+			float shrink = 1.0f;
+		};
+
+		struct statistics {
+			uint32_t nodes = 0;
+			uint64_t updates = 0;
+			uint64_t measuredNodes = 0;
+			uint64_t measureCacheHits = 0;
+			uint64_t arrangedNodes = 0;
+			uint64_t changedNodes = 0;
+		};
+
+		nodeHandle createNode(nodeHandle parent = NO_NODE);
+		void destroyNode(nodeHandle handle);
+		bool isAlive(nodeHandle handle);
+
+		void setStyle(nodeHandle handle, const style& nodeStyle);
+		const style& getStyle(nodeHandle handle);
+		void setContentSize(nodeHandle handle, glm::vec2 contentSize);
+		void markDirty(nodeHandle handle);
+
+		void update(glm::vec2 viewport);
+
+		glm::vec4 getRect(nodeHandle handle);
+		glm::vec2 getMeasuredSize(nodeHandle handle);
+		const std::vector<nodeHandle>& getChangedNodes();
+
+		statistics getStatistics();
+	private:
+		struct node {
+			style layoutStyle;
+			glm::vec4 rect{};
+			glm::vec2 contentSize{};
+			glm::vec2 measured{};
+			nodeHandle parent = NO_NODE;
+			nodeHandle firstChild = NO_NODE;
+			nodeHandle lastChild = NO_NODE;
+			nodeHandle previousSibling = NO_NODE;
+			nodeHandle nextSibling = NO_NODE;
+			bool measureDirty = true;
+			bool layoutDirty = true;
+			bool childDirty = false;
+			bool alive = false;
+		};
+
+		static bool isFixedSize(const style& nodeStyle);
+
+		void linkNode(nodeHandle handle, nodeHandle parent);
+		void unlinkNode(nodeHandle handle);
+		void markChildDirty(nodeHandle handle);
+		glm::vec2 measure(nodeHandle handle);
+		void layoutNode(nodeHandle handle, glm::vec4 rect);
+		void arrangeChildren(nodeHandle handle);
+
+		std::vector<node> nodes;
+		std::vector<nodeHandle> freeNodes;
+		std::vector<nodeHandle> subtreeStack;
+		std::vector<nodeHandle> changedNodes;
+		nodeHandle firstRoot = NO_NODE;
+		nodeHandle lastRoot = NO_NODE;
+
+		statistics stats;
+};
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "range_allocator.h"
+
+#include <algorithm>
+
+void RangeAllocator::init(uint32_t capacity) {
+	this->capacity = capacity;
+
+	clear();
+}
+
+void RangeAllocator::clear() {
+	used = 0;
+	highWatermark = 0;
+	freeRanges.clear();
+}
+
+uint32_t RangeAllocator::allocate(uint32_t count) {
+	if (count == 0) {
+		return INVALID_OFFSET;
+	}
+
+	for (size_t i = 0; i < freeRanges.size(); i++) {
+		if (freeRanges[i].count < count) {
+			continue;
+		}
+
+		uint32_t offset = freeRanges[i].offset;
+
+		freeRanges[i].offset += count;
+		freeRanges[i].count -= count;
+
+		if (freeRanges[i].count == 0) {
+			freeRanges.erase(freeRanges.begin() + i);
+		}
+
+		used += count;
+
+		return offset;
+	}
+
+	if (capacity - highWatermark < count) {
+		return INVALID_OFFSET;
+	}
+
+	uint32_t offset = highWatermark;
+
+	highWatermark += count;
+	used += count;
+
+	return offset;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t count) {
+	if (offset == INVALID_OFFSET || count == 0) {
+		return;
+	}
+
+	used -= count;
+
+	auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset, [](const range& freeRange, uint32_t value) {
+		return freeRange.offset < value;
+	});
+
+	next = freeRanges.insert(next, { offset, count });
+
+	if (next + 1 != freeRanges.end() && next->offset + next->count == (next + 1)->offset) {
+		next->count += (next + 1)->count;
+		freeRanges.erase(next + 1);
+	}
+
+	if (next != freeRanges.begin() && (next - 1)->offset + (next - 1)->count == next->offset) {
+		(next - 1)->count += next->count;
+		next = freeRanges.erase(next) - 1;
+	}
+
+	if (next->offset + next->count == highWatermark) {
+		highWatermark = next->offset;
+		freeRanges.erase(next);
+	}
+}
+
+uint32_t RangeAllocator::getCapacity() {
+	return capacity;
+}
+
+uint32_t RangeAllocator::getUsed() {
+	return used;
+}
+
+uint32_t RangeAllocator::getHighWatermark() {
+	return highWatermark;
+}
+
+uint32_t RangeAllocator::getFragmentedCount() {
+	return highWatermark - used;
+}
\ No newline at end of file
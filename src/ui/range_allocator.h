@@ -0,0 +1,32 @@
+#pragma once
+#define range_allocator_h
+
+#include <cstdint>
+#include <vector>
+
+class RangeAllocator {
+	public:
+		static const uint32_t INVALID_OFFSET = UINT32_MAX;
+
+		void init(uint32_t capacity);
+		void clear();
+
+		uint32_t allocate(uint32_t count);
+		void free(uint32_t offset, uint32_t count);
+
+		uint32_t getCapacity();
+		uint32_t getUsed();
+		uint32_t getHighWatermark();
+		uint32_t getFragmentedCount();
+	private:
+		struct range {
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		uint32_t capacity = 0;
+		uint32_t used = 0;
+		uint32_t highWatermark = 0;
+
+		std::vector<range> freeRanges;
+};
\ No newline at end of file
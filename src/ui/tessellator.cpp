@@ -0,0 +1,442 @@
+#include "tessellator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "../simd/simd.h"
+
+static const float HALF_PI = 1.57079632679f;
+static const float MIN_SEGMENT_LENGTH = 1e-12f;
+static const float MIN_MITER_LENGTH = 1e-6f;
+static const float MAX_MITER_SCALE = Tessellator::MITER_LIMIT * Tessellator::MITER_LIMIT;
+
+struct quarterCircleTable {
+	std::vector<float> values;
+	std::array<uint32_t, Tessellator::MAX_ARC_SEGMENTS + 1> offsets{};
+};
+
+static quarterCircleTable buildQuarterCircleTable() {
+	quarterCircleTable table;
+
+	for (uint32_t segments = 1; segments <= Tessellator::MAX_ARC_SEGMENTS; segments++) {
+		table.offsets[segments] = static_cast<uint32_t>(table.values.size());
+
+		for (uint32_t i = 0; i <= segments; i++) {
+			table.values.push_back(std::cos(HALF_PI * static_cast<float>(i) / static_cast<float>(segments)));
+		}
+
+		for (uint32_t i = 0; i <= segments; i++) {
+			table.values.push_back(std::sin(HALF_PI * static_cast<float>(i) / static_cast<float>(segments)));
+		}
+	}
+
+	table.values.resize(table.values.size() + SimdFloat::WIDTH, 0.0f);
+
+	return table;
+}
+
+static void storePairs(float* positions, SimdFloat x, SimdFloat y, uint32_t count) {
+	if (count == SimdFloat::WIDTH) {
+		SimdFloat::storeInterleaved(positions, x, y);
+
+		return;
+	}
+
+	float pairs[SimdFloat::WIDTH * 2];
+	SimdFloat::storeInterleaved(pairs, x, y);
+
+	memcpy(positions, pairs, count * 2 * sizeof(float));
+}
+
+uint32_t Tessellator::getArcSegments(float radius, float angle) {
+	if (radius <= 0.25f || angle <= 0.0f) {
+		return 1;
+	}
+
+	float step = 2.0f * std::acos(1.0f - 0.25f / radius);
+
+	return std::clamp(static_cast<uint32_t>(std::ceil(angle / step)), 1u, MAX_ARC_SEGMENTS);
+}
+
+uint32_t Tessellator::getPolylineVertexCount(uint32_t pointCount) {
+	return pointCount < 2 ? 0 : pointCount * 4;
+}
+
+uint32_t Tessellator::getPolylineIndexCount(uint32_t pointCount) {
+	return pointCount < 2 ? 0 : (pointCount - 1) * 18;
+}
+
+uint32_t Tessellator::getRoundedRectVertexCount(uint32_t segments) {
+	return (segments + 1) * 8;
+}
+
+uint32_t Tessellator::getRoundedRectIndexCount(uint32_t segments) {
+	uint32_t outline = (segments + 1) * 4;
+
+	return (outline - 2) * 3 + outline * 6;
+}
+
+uint32_t Tessellator::getArcVertexCount(uint32_t segments) {
+	return (segments + 1) * 4;
+}
+
+uint32_t Tessellator::getArcIndexCount(uint32_t segments) {
+	return segments * 18;
+}
+
+const float* Tessellator::getQuarterCircle(uint32_t segments) {
+	static const quarterCircleTable table = buildQuarterCircleTable();
+
+	return table.values.data() + table.offsets[segments];
+}
+
+void Tessellator::getCorners(glm::vec4 rect, float radius, corner corners[4]) {
+	float left = rect.x + radius;
+	float top = rect.y + radius;
+	float right = rect.x + rect.z - radius;
+	float bottom = rect.y + rect.w - radius;
+
+	corners[0] = { { left, top }, { -1.0f, 0.0f }, { 0.0f, -1.0f } };
+	corners[1] = { { right, top }, { 0.0f, -1.0f }, { 1.0f, 0.0f } };
+	corners[2] = { { right, bottom }, { 1.0f, 0.0f }, { 0.0f, 1.0f } };
+	corners[3] = { { left, bottom }, { 0.0f, 1.0f }, { -1.0f, 0.0f } };
+}
+
+void Tessellator::getStroke(float thickness, uint32_t& color, float& core) {
+	if (thickness >= FEATHER) {
+		core = (thickness - FEATHER) * 0.5f;
+
+		return;
+	}
+
+	uint32_t alpha = static_cast<uint32_t>(static_cast<float>(color >> 24) * std::max(thickness, 0.0f) / FEATHER + 0.5f);
+
+	color = (color & 0x00FFFFFF) | (alpha << 24);
+	core = 0.0f;
+}
+
+void Tessellator::polylinePoint(const glm::vec2* points, uint32_t pointCount, uint32_t index, glm::vec2 offset, float core, float* positions) {
+	glm::vec2 previous = index > 0 ? points[index] - points[index - 1] : points[1] - points[0];
+	glm::vec2 next = index + 1 < pointCount ? points[index + 1] - points[index] : points[index] - points[index - 1];
+
+	float previousInverse = 1.0f / std::sqrt(std::max(previous.x * previous.x + previous.y * previous.y, MIN_SEGMENT_LENGTH));
+	float nextInverse = 1.0f / std::sqrt(std::max(next.x * next.x + next.y * next.y, MIN_SEGMENT_LENGTH));
+
+	float miterX = (previous.y * previousInverse + next.y * nextInverse) * 0.5f;
+	float miterY = ((0.0f - previous.x) * previousInverse + (0.0f - next.x) * nextInverse) * 0.5f;
+	float scale = std::min(1.0f / std::max(miterX * miterX + miterY * miterY, MIN_MITER_LENGTH), MAX_MITER_SCALE);
+
+	miterX = miterX * scale;
+	miterY = miterY * scale;
+
+	float x = points[index].x + offset.x;
+	float y = points[index].y + offset.y;
+	float outer = core + FEATHER;
+	size_t stride = static_cast<size_t>(pointCount) * 2;
+	float* output = positions + index * 2;
+
+	output[0] = x + miterX * outer;
+	output[1] = y + miterY * outer;
+	output[stride] = x + miterX * core;
+	output[stride + 1] = y + miterY * core;
+	output[stride * 2] = x - miterX * core;
+	output[stride * 2 + 1] = y - miterY * core;
+	output[stride * 3] = x - miterX * outer;
+	output[stride * 3 + 1] = y - miterY * outer;
+}
+
+void Tessellator::writeStrip(uint32_t* indices, uint32_t firstVertex, uint32_t length, uint32_t streams, bool closed) {
+	uint32_t segments = closed ? length : length - 1;
+
+	for (uint32_t stream = 0; stream + 1 < streams; stream++) {
+		uint32_t base = firstVertex + stream * length;
+
+		for (uint32_t i = 0; i < segments; i++) {
+			uint32_t a = base + i;
+			uint32_t b = base + (i + 1 == length ? 0 : i + 1);
+
+			indices[0] = a;
+			indices[1] = b;
+			indices[2] = b + length;
+			indices[3] = a;
+			indices[4] = b + length;
+			indices[5] = a + length;
+			indices += 6;
+		}
+	}
+}
+
+void Tessellator::writeFan(uint32_t* indices, uint32_t firstVertex, uint32_t count) {
+	for (uint32_t i = 1; i + 1 < count; i++) {
+		indices[0] = firstVertex;
+		indices[1] = firstVertex + i;
+		indices[2] = firstVertex + i + 1;
+		indices += 3;
+	}
+}
+
+void Tessellator::writeFeatheredColors(uint32_t* colors, uint32_t length, uint32_t streams, uint32_t color) {
+	uint32_t transparent = color & 0x00FFFFFF;
+
+	std::fill_n(colors, length, transparent);
+	std::fill_n(colors + length, length * (streams - 2), color);
+	std::fill_n(colors + length * (streams - 1), length, transparent);
+}
+
+void Tessellator::polyline(const glm::vec2* points, uint32_t pointCount, glm::vec2 offset, float thickness, uint32_t color, const vertexStream& stream) {
+	if (pointCount < 2) {
+		return;
+	}
+
+	float core;
+	getStroke(thickness, color, core);
+
+	const float* coordinates = &points[0].x;
+	size_t streamStride = static_cast<size_t>(pointCount) * 2;
+
+	SimdFloat offsetX = SimdFloat::broadcast(offset.x);
+	SimdFloat offsetY = SimdFloat::broadcast(offset.y);
+	SimdFloat coreWidth = SimdFloat::broadcast(core);
+	SimdFloat outerWidth = SimdFloat::broadcast(core + FEATHER);
+	SimdFloat zero = SimdFloat::broadcast(0.0f);
+	SimdFloat half = SimdFloat::broadcast(0.5f);
+	SimdFloat one = SimdFloat::broadcast(1.0f);
+	SimdFloat minSegmentLength = SimdFloat::broadcast(MIN_SEGMENT_LENGTH);
+	SimdFloat minMiterLength = SimdFloat::broadcast(MIN_MITER_LENGTH);
+	SimdFloat maxMiterScale = SimdFloat::broadcast(MAX_MITER_SCALE);
+
+	polylinePoint(points, pointCount, 0, offset, core, stream.positions);
+
+	uint32_t index = 1;
+
+	for (; index + SimdFloat::WIDTH < pointCount; index += SimdFloat::WIDTH) {
+		SimdFloat previousX, previousY, currentX, currentY, nextX, nextY;
+		SimdFloat::loadInterleaved(coordinates + (index - 1) * 2, previousX, previousY);
+		SimdFloat::loadInterleaved(coordinates + index * 2, currentX, currentY);
+		SimdFloat::loadInterleaved(coordinates + (index + 1) * 2, nextX, nextY);
+
+		SimdFloat inX = currentX - previousX;
+		SimdFloat inY = currentY - previousY;
+		SimdFloat outX = nextX - currentX;
+		SimdFloat outY = nextY - currentY;
+
+		SimdFloat inInverse = one / SimdFloat::sqrt(SimdFloat::max(inX * inX + inY * inY, minSegmentLength));
+		SimdFloat outInverse = one / SimdFloat::sqrt(SimdFloat::max(outX * outX + outY * outY, minSegmentLength));
+
+		SimdFloat miterX = (inY * inInverse + outY * outInverse) * half;
+		SimdFloat miterY = ((zero - inX) * inInverse + (zero - outX) * outInverse) * half;
+		SimdFloat scale = SimdFloat::min(one / SimdFloat::max(miterX * miterX + miterY * miterY, minMiterLength), maxMiterScale);
+
+		miterX = miterX * scale;
+		miterY = miterY * scale;
+
+		SimdFloat x = currentX + offsetX;
+		SimdFloat y = currentY + offsetY;
+		float* output = stream.positions + index * 2;
+
+		SimdFloat::storeInterleaved(output, x + miterX * outerWidth, y + miterY * outerWidth);
+		SimdFloat::storeInterleaved(output + streamStride, x + miterX * coreWidth, y + miterY * coreWidth);
+		SimdFloat::storeInterleaved(output + streamStride * 2, x - miterX * coreWidth, y - miterY * coreWidth);
+		SimdFloat::storeInterleaved(output + streamStride * 3, x - miterX * outerWidth, y - miterY * outerWidth);
+	}
+
+	for (; index < pointCount; index++) {
+		polylinePoint(points, pointCount, index, offset, core, stream.positions);
+	}
+
+	writeFeatheredColors(stream.colors, pointCount, 4, color);
+	writeStrip(stream.indices, stream.firstVertex, pointCount, 4, false);
+}
+
+void Tessellator::polylineScalar(const glm::vec2* points, uint32_t pointCount, glm::vec2 offset, float thickness, uint32_t color, const vertexStream& stream) {
+	if (pointCount < 2) {
+		return;
+	}
+
+	float core;
+	getStroke(thickness, color, core);
+
+	for (uint32_t index = 0; index < pointCount; index++) {
+		polylinePoint(points, pointCount, index, offset, core, stream.positions);
+	}
+
+	writeFeatheredColors(stream.colors, pointCount, 4, color);
+	writeStrip(stream.indices, stream.firstVertex, pointCount, 4, false);
+}
+
+void Tessellator::roundedRect(glm::vec4 rect, float radius, uint32_t segments, uint32_t color, const vertexStream& stream) {
+	segments = std::clamp(segments, 1u, MAX_ARC_SEGMENTS);
+	radius = std::clamp(radius, 0.0f, std::min(rect.z, rect.w) * 0.5f);
+
+	corner corners[4];
+	getCorners(rect, radius, corners);
+
+	const float* cosines = getQuarterCircle(segments);
+	const float* sines = cosines + segments + 1;
+
+	uint32_t cornerLength = segments + 1;
+	uint32_t outline = cornerLength * 4;
+
+	SimdFloat outerRadius = SimdFloat::broadcast(radius + FEATHER * 0.5f);
+	SimdFloat innerRadius = SimdFloat::broadcast(radius - FEATHER * 0.5f);
+
+	for (uint32_t c = 0; c < 4; c++) {
+		const corner& current = corners[c];
+
+		SimdFloat centerX = SimdFloat::broadcast(current.center.x);
+		SimdFloat centerY = SimdFloat::broadcast(current.center.y);
+		SimdFloat cosineX = SimdFloat::broadcast(current.cosineAxis.x);
+		SimdFloat cosineY = SimdFloat::broadcast(current.cosineAxis.y);
+		SimdFloat sineX = SimdFloat::broadcast(current.sineAxis.x);
+		SimdFloat sineY = SimdFloat::broadcast(current.sineAxis.y);
+
+		for (uint32_t i = 0; i < cornerLength; i += SimdFloat::WIDTH) {
+			uint32_t count = std::min(SimdFloat::WIDTH, cornerLength - i);
+
+			SimdFloat cosine = SimdFloat::load(cosines + i);
+			SimdFloat sine = SimdFloat::load(sines + i);
+			SimdFloat directionX = cosine * cosineX + sine * sineX;
+			SimdFloat directionY = cosine * cosineY + sine * sineY;
+
+			float* output = stream.positions + (c * cornerLength + i) * 2;
+
+			storePairs(output, centerX + directionX * outerRadius, centerY + directionY * outerRadius, count);
+			storePairs(output + outline * 2, centerX + directionX * innerRadius, centerY + directionY * innerRadius, count);
+		}
+	}
+
+	std::fill_n(stream.colors, outline, color & 0x00FFFFFF);
+	std::fill_n(stream.colors + outline, outline, color);
+
+	writeFan(stream.indices, stream.firstVertex + outline, outline);
+	writeStrip(stream.indices + (outline - 2) * 3, stream.firstVertex, outline, 2, true);
+}
+
+void Tessellator::roundedRectScalar(glm::vec4 rect, float radius, uint32_t segments, uint32_t color, const vertexStream& stream) {
+	segments = std::clamp(segments, 1u, MAX_ARC_SEGMENTS);
+	radius = std::clamp(radius, 0.0f, std::min(rect.z, rect.w) * 0.5f);
+
+	corner corners[4];
+	getCorners(rect, radius, corners);
+
+	const float* cosines = getQuarterCircle(segments);
+	const float* sines = cosines + segments + 1;
+
+	uint32_t cornerLength = segments + 1;
+	uint32_t outline = cornerLength * 4;
+
+	float outerRadius = radius + FEATHER * 0.5f;
+	float innerRadius = radius - FEATHER * 0.5f;
+
+	for (uint32_t c = 0; c < 4; c++) {
+		const corner& current = corners[c];
+
+		for (uint32_t i = 0; i < cornerLength; i++) {
+			float directionX = cosines[i] * current.cosineAxis.x + sines[i] * current.sineAxis.x;
+			float directionY = cosines[i] * current.cosineAxis.y + sines[i] * current.sineAxis.y;
+
+			float* output = stream.positions + (c * cornerLength + i) * 2;
+
+			output[0] = current.center.x + directionX * outerRadius;
+			output[1] = current.center.y + directionY * outerRadius;
+			output[outline * 2] = current.center.x + directionX * innerRadius;
+			output[outline * 2 + 1] = current.center.y + directionY * innerRadius;
+		}
+	}
+
+	std::fill_n(stream.colors, outline, color & 0x00FFFFFF);
+	std::fill_n(stream.colors + outline, outline, color);
+
+	writeFan(stream.indices, stream.firstVertex + outline, outline);
+	writeStrip(stream.indices + (outline - 2) * 3, stream.firstVertex, outline, 2, true);
+}
+
+void Tessellator::arc(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t segments, uint32_t color, const vertexStream& stream) {
+	segments = std::clamp(segments, 1u, MAX_ARC_SEGMENTS);
+
+	float core;
+	getStroke(thickness, color, core);
+
+	uint32_t length = segments + 1;
+	float step = (endAngle - startAngle) / static_cast<float>(segments);
+
+	float laneCosines[SimdFloat::WIDTH];
+	float laneSines[SimdFloat::WIDTH];
+
+	for (uint32_t lane = 0; lane < SimdFloat::WIDTH; lane++) {
+		laneCosines[lane] = std::cos(startAngle + step * static_cast<float>(lane));
+		laneSines[lane] = std::sin(startAngle + step * static_cast<float>(lane));
+	}
+
+	SimdFloat cosine = SimdFloat::load(laneCosines);
+	SimdFloat sine = SimdFloat::load(laneSines);
+	SimdFloat rotationCosine = SimdFloat::broadcast(std::cos(step * static_cast<float>(SimdFloat::WIDTH)));
+	SimdFloat rotationSine = SimdFloat::broadcast(std::sin(step * static_cast<float>(SimdFloat::WIDTH)));
+
+	SimdFloat centerX = SimdFloat::broadcast(center.x);
+	SimdFloat centerY = SimdFloat::broadcast(center.y);
+
+	const SimdFloat radii[4] = {
+		SimdFloat::broadcast(radius + core + FEATHER),
+		SimdFloat::broadcast(radius + core),
+		SimdFloat::broadcast(std::max(radius - core, 0.0f)),
+		SimdFloat::broadcast(std::max(radius - core - FEATHER, 0.0f))
+	};
+
+	for (uint32_t i = 0; i < length; i += SimdFloat::WIDTH) {
+		uint32_t count = std::min(SimdFloat::WIDTH, length - i);
+		float* output = stream.positions + i * 2;
+
+		for (uint32_t ring = 0; ring < 4; ring++) {
+			storePairs(output + ring * length * 2, centerX + cosine * radii[ring], centerY + sine * radii[ring], count);
+		}
+
+		SimdFloat rotatedCosine = cosine * rotationCosine - sine * rotationSine;
+		sine = sine * rotationCosine + cosine * rotationSine;
+		cosine = rotatedCosine;
+	}
+
+	writeFeatheredColors(stream.colors, length, 4, color);
+	writeStrip(stream.indices, stream.firstVertex, length, 4, false);
+}
+
+void Tessellator::arcScalar(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t segments, uint32_t color, const vertexStream& stream) {
+	segments = std::clamp(segments, 1u, MAX_ARC_SEGMENTS);
+
+	float core;
+	getStroke(thickness, color, core);
+
+	uint32_t length = segments + 1;
+	float step = (endAngle - startAngle) / static_cast<float>(segments);
+
+	float cosine = std::cos(startAngle);
+	float sine = std::sin(startAngle);
+	float rotationCosine = std::cos(step);
+	float rotationSine = std::sin(step);
+
+	const float radii[4] = {
+		radius + core + FEATHER,
+		radius + core,
+		std::max(radius - core, 0.0f),
+		std::max(radius - core - FEATHER, 0.0f)
+	};
+
+	for (uint32_t i = 0; i < length; i++) {
+		float* output = stream.positions + i * 2;
+
+		for (uint32_t ring = 0; ring < 4; ring++) {
+			output[ring * length * 2] = center.x + cosine * radii[ring];
+			output[ring * length * 2 + 1] = center.y + sine * radii[ring];
+		}
+
+		float rotatedCosine = cosine * rotationCosine - sine * rotationSine;
+		sine = sine * rotationCosine + cosine * rotationSine;
+		cosine = rotatedCosine;
+	}
+
+	writeFeatheredColors(stream.colors, length, 4, color);
+	writeStrip(stream.indices, stream.firstVertex, length, 4, false);
+}
\ No newline at end of file
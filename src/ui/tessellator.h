@@ -0,0 +1,52 @@
+#pragma once
+#define tessellator_h
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+class Tessellator {
+	public:
+		struct vertexStream {
+			float* positions = nullptr;
+			uint32_t* colors = nullptr;
+			uint32_t* indices = nullptr;
+			uint32_t firstVertex = 0;
+		};
+
+		static constexpr uint32_t MAX_ARC_SEGMENTS = 64;
+		static constexpr float FEATHER = 1.0f;
+		static constexpr float MITER_LIMIT = 4.0f;
+
+		static uint32_t getArcSegments(float radius, float angle);
+
+		static uint32_t getPolylineVertexCount(uint32_t pointCount);
+		static uint32_t getPolylineIndexCount(uint32_t pointCount);
+		static uint32_t getRoundedRectVertexCount(uint32_t segments);
+		static uint32_t getRoundedRectIndexCount(uint32_t segments);
+		static uint32_t getArcVertexCount(uint32_t segments);
+		static uint32_t getArcIndexCount(uint32_t segments);
+
+		static void polyline(const glm::vec2* points, uint32_t pointCount, glm::vec2 offset, float thickness, uint32_t color, const vertexStream& stream);
+		static void roundedRect(glm::vec4 rect, float radius, uint32_t segments, uint32_t color, const vertexStream& stream);
+		static void arc(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t segments, uint32_t color, const vertexStream& stream);
+
+		static void polylineScalar(const glm::vec2* points, uint32_t pointCount, glm::vec2 offset, float thickness, uint32_t color, const vertexStream& stream);
+		static void roundedRectScalar(glm::vec4 rect, float radius, uint32_t segments, uint32_t color, const vertexStream& stream);
+		static void arcScalar(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t segments, uint32_t color, const vertexStream& stream);
+	private:
+		struct corner {
+			glm::vec2 center;
+			glm::vec2 cosineAxis;
+			glm::vec2 sineAxis;
+		};
+
+		static const float* getQuarterCircle(uint32_t segments);
+		static void getCorners(glm::vec4 rect, float radius, corner corners[4]);
+		static void getStroke(float thickness, uint32_t& color, float& core);
+
+		static void polylinePoint(const glm::vec2* points, uint32_t pointCount, uint32_t index, glm::vec2 offset, float core, float* positions);
+		static void writeStrip(uint32_t* indices, uint32_t firstVertex, uint32_t length, uint32_t streams, bool closed);
+		static void writeFan(uint32_t* indices, uint32_t firstVertex, uint32_t count);
+		static void writeFeatheredColors(uint32_t* colors, uint32_t length, uint32_t streams, uint32_t color);
+};
\ No newline at end of file
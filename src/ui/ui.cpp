@@ -1,141 +1,1573 @@
 #include "ui.h"
 
 #include <array>
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/constants.hpp>
 
 #include "../application/application.h"
 #include "../logger/logger.h"
 
-void UI::init(Application& application) {
-	log_info("Initializing UI...");
+void UI::init(Application& application) {
+	log_info("Initializing UI...");
+
+	this->application = &application;
+
+	attachText(application.text);
+
+	createAtlasImage();
+	createDescriptorSet();
+	createUIPipeline();
+
+	createQuadBuffers();
+
+	widgetHandle root = createBox(glm::vec4(0.0f), 0);
+
+	Layout::style rootStyle;
+	rootStyle.justifyContent = Layout::justify::center;
+	rootStyle.alignItems = Layout::align::center;
+	setLayout(root, rootStyle);
+
+	widgetHandle box = createBox({ 0.0f, 0.0f, 300.0f, 50.0f }, DEFAULT_COLOR, root);
+
+	Layout::style boxStyle;
+	boxStyle.flexDirection = Layout::direction::row;
+	boxStyle.alignItems = Layout::align::center;
+	boxStyle.size = { 300.0f, 50.0f };
+	boxStyle.padding = glm::vec4(12.0f);
+	setLayout(box, boxStyle);
+
+	widgetHandle label = createText({ 0.0f, 0.0f }, "Hello, world!", 24.0f, packColor(0.0f, 0.0f, 0.0f), box);
+
+	if (label != NO_WIDGET) {
+		setLayout(label, Layout::style{});
+	}
+
+	log_info("UI initialized!");
+}
+
+static void coalesceRanges(std::vector<UI::range>& ranges) {
+	if (ranges.size() < 2) {
+		return;
+	}
+
+	std::sort(ranges.begin(), ranges.end(), [](const UI::range& a, const UI::range& b) {
+		return a.first < b.first;
+	});
+
+	size_t count = 1;
+
+	for (size_t i = 1; i < ranges.size(); i++) {
+		UI::range& last = ranges[count - 1];
+		uint32_t lastEnd = last.first + last.count;
+
+		if (ranges[i].first <= lastEnd) {
+			last.count = std::max(lastEnd, ranges[i].first + ranges[i].count) - last.first;
+		}
+		else {
+			ranges[count++] = ranges[i];
+		}
+	}
+
+	ranges.resize(count);
+}
+
+void UI::drawUI() {
+	trace_zone("UI::drawUI");
+
+	VkExtent2D extent = application->swapchain.getExtent();
+	setViewport({ static_cast<float>(extent.width), static_cast<float>(extent.height) });
+
+	update();
+}
+
+void UI::attachText(Text& text) {
+	this->text = &text;
+}
+
+void UI::update() {
+	trace_zone("UI::update");
+
+	applyLayout();
+
+	bool quadsFragmented = quadAllocator.getHighWatermark() >= MIN_COMPACTION_QUADS && quadAllocator.getFragmentedCount() * 2 > quadAllocator.getHighWatermark();
+	bool shapesFragmented = vertexAllocator.getHighWatermark() >= MIN_COMPACTION_SHAPE_VERTICES && vertexAllocator.getFragmentedCount() * 2 > vertexAllocator.getHighWatermark();
+
+	if (quadsFragmented || shapesFragmented) {
+		compact();
+	}
+	else {
+		regenerateDirtyWidgets();
+	}
+
+	if (text != nullptr) {
+		regenerateEvictedText();
+
+		text->update();
+	}
+
+	if (drawListDirty) {
+		buildDrawList();
+
+		if (drawList.getDiscontinuities() > MAX_DRAW_DISCONTINUITIES) {
+			compact();
+			buildDrawList();
+		}
+	}
+}
+
+void UI::setViewport(glm::vec2 size) {
+	viewport = size;
+}
+
+void UI::applyLayout() {
+	trace_zone("UI::applyLayout");
+
+	layout.update(viewport);
+
+	for (Layout::nodeHandle node : layout.getChangedNodes()) {
+		widgetHandle handle = layoutWidgets[node];
+
+		if (handle != NO_WIDGET) {
+			setRect(handle, layout.getRect(node));
+		}
+	}
+
+	stats.layoutUpdates++;
+}
+
+void UI::buildDrawList() {
+	trace_zone("UI::buildDrawList");
+
+	drawList.clear();
+	imageResolutions.clear();
+
+	for (widgetHandle root = firstRoot; root != NO_WIDGET; root = widgets[root].nextSibling) {
+		appendWidget(root, glm::vec2(0.0f));
+	}
+
+	drawListDirty = false;
+	drawListChanged = true;
+
+	stats.drawListBuilds++;
+	stats.drawCommands = static_cast<uint32_t>(drawList.getCommands().size());
+}
+
+void UI::appendWidget(widgetHandle handle, glm::vec2 origin) {
+	const widget& current = widgets[handle];
+
+	if (!current.visible) {
+		appendHiddenWidget(handle);
+
+		return;
+	}
+
+	origin += glm::vec2(current.rect);
+
+	if (isShape(current.type)) {
+		glm::vec2 feather(Tessellator::FEATHER);
+
+		drawList.addRange(SHAPE_PIPELINE, ATLAS_TEXTURE, current.firstIndex, current.indexCount, { origin - feather, glm::vec2(current.rect.z, current.rect.w) + feather * 2.0f });
+	}
+	else {
+		drawList.addRange(getPipeline(current.type), current.texture, current.firstQuad, current.quadCount, { origin, current.rect.z, current.rect.w });
+	}
+
+	if (current.type == widgetType::image) {
+		imageResolutions.push_back({ current.texture, std::max(current.rect.z, current.rect.w) });
+	}
+
+	if (current.firstChild == NO_WIDGET) {
+		return;
+	}
+
+	if (current.clip) {
+		drawList.pushClipRect({ origin, current.rect.z, current.rect.w });
+	}
+
+	if (current.scroll != glm::vec2(0.0f)) {
+		drawList.pushTranslation(-current.scroll);
+	}
+
+	if (!drawList.isClipEmpty()) {
+		for (widgetHandle child = current.firstChild; child != NO_WIDGET; child = widgets[child].nextSibling) {
+			appendWidget(child, origin);
+		}
+	}
+
+	if (current.scroll != glm::vec2(0.0f)) {
+		drawList.popTranslation();
+	}
+
+	if (current.clip) {
+		drawList.popClipRect();
+	}
+}
+
+void UI::appendHiddenWidget(widgetHandle handle) {
+	const widget& hidden = widgets[handle];
+
+	if (isShape(hidden.type)) {
+		drawList.addHiddenRange(SHAPE_PIPELINE, hidden.firstIndex, hidden.indexCount);
+	}
+	else {
+		drawList.addHiddenRange(getPipeline(hidden.type), hidden.firstQuad, hidden.quadCount);
+	}
+
+	for (widgetHandle child = hidden.firstChild; child != NO_WIDGET; child = widgets[child].nextSibling) {
+		appendHiddenWidget(child);
+	}
+}
+
+void UI::regenerateEvictedText() {
+	for (uint32_t pass = 0; pass < GlyphAtlas::PAGE_COUNT; pass++) {
+		uint32_t evictedPages = text->takeEvictedPages();
+
+		if (evictedPages == 0) {
+			return;
+		}
+
+		for (widgetHandle handle = 0; handle < widgets.size(); handle++) {
+			if (widgets[handle].alive && (widgets[handle].pageMask & evictedPages) != 0) {
+				markWidgetDirty(handle);
+			}
+		}
+
+		regenerateDirtyWidgets();
+	}
+}
+
+void UI::regenerateDirtyWidgets() {
+	for (widgetHandle handle : dirtyWidgets) {
+		widget& current = widgets[handle];
+		current.dirty = false;
+
+		if (!current.alive || (current.quadCount == 0 && current.vertexCount == 0)) {
+			continue;
+		}
+
+		regenerateWidget(handle);
+		queueUploads(current);
+	}
+
+	stats.regeneratedWidgets += dirtyWidgets.size();
+
+	dirtyWidgets.clear();
+}
+
+void UI::compact() {
+	trace_zone("UI::compact");
+
+	quadAllocator.clear();
+	vertexAllocator.clear();
+	indexAllocator.clear();
+
+	uint32_t regenerated = 0;
+
+	subtreeStack.clear();
+
+	for (widgetHandle root = lastRoot; root != NO_WIDGET; root = widgets[root].previousSibling) {
+		subtreeStack.push_back(root);
+	}
+
+	while (!subtreeStack.empty()) {
+		widgetHandle handle = subtreeStack.back();
+		subtreeStack.pop_back();
+
+		widget& current = widgets[handle];
+		current.firstQuad = quadAllocator.allocate(current.quadCount);
+		current.firstVertex = vertexAllocator.allocate(current.vertexCount);
+		current.firstIndex = indexAllocator.allocate(current.indexCount);
+		current.dirty = false;
+
+		if (current.quadCount != 0 || current.vertexCount != 0) {
+			regenerateWidget(handle);
+		}
+
+		regenerated++;
+
+		for (widgetHandle child = current.lastChild; child != NO_WIDGET; child = widgets[child].previousSibling) {
+			subtreeStack.push_back(child);
+		}
+	}
+
+	dirtyWidgets.clear();
+	pendingRanges.clear();
+	pendingRanges.push_back({ 0, quadAllocator.getHighWatermark() });
+	pendingVertexRanges.clear();
+	pendingIndexRanges.clear();
+
+	if (vertexAllocator.getHighWatermark() != 0) {
+		pendingVertexRanges.push_back({ 0, vertexAllocator.getHighWatermark() });
+		pendingIndexRanges.push_back({ 0, indexAllocator.getHighWatermark() });
+	}
+
+	drawListDirty = true;
+
+	stats.regeneratedWidgets += regenerated;
+	stats.compactions++;
+}
+
+uint32_t UI::getQuadCount(widgetType type) {
+	switch (type) {
+		case widgetType::panel:
+			return 5;
+		case widgetType::roundedRect:
+		case widgetType::polyline:
+		case widgetType::arc:
+			return 0;
+		default:
+			return 1;
+	}
+}
+
+bool UI::isShape(widgetType type) {
+	return type == widgetType::roundedRect || type == widgetType::polyline || type == widgetType::arc;
+}
+
+uint32_t UI::getPipeline(widgetType type) {
+	if (isShape(type)) {
+		return SHAPE_PIPELINE;
+	}
+
+	return type == widgetType::image ? IMAGE_PIPELINE : SDF_PIPELINE;
+}
+
+uint32_t UI::getShapeSegments(const widget& shape) {
+	switch (shape.type) {
+		case widgetType::roundedRect:
+			return Tessellator::getArcSegments(shape.radius, glm::half_pi<float>());
+		case widgetType::arc:
+			return Tessellator::getArcSegments(shape.radius + shape.thickness * 0.5f, std::abs(shape.endAngle - shape.startAngle));
+		default:
+			return 0;
+	}
+}
+
+void UI::getShapeCounts(const widget& shape, uint32_t& vertexCount, uint32_t& indexCount) {
+	uint32_t segments = getShapeSegments(shape);
+
+	switch (shape.type) {
+		case widgetType::roundedRect:
+			vertexCount = Tessellator::getRoundedRectVertexCount(segments);
+			indexCount = Tessellator::getRoundedRectIndexCount(segments);
+			break;
+		case widgetType::polyline:
+			vertexCount = Tessellator::getPolylineVertexCount(static_cast<uint32_t>(shape.points.size()));
+			indexCount = Tessellator::getPolylineIndexCount(static_cast<uint32_t>(shape.points.size()));
+			break;
+		case widgetType::arc:
+			vertexCount = Tessellator::getArcVertexCount(segments);
+			indexCount = Tessellator::getArcIndexCount(segments);
+			break;
+		default:
+			vertexCount = 0;
+			indexCount = 0;
+			break;
+	}
+}
+
+UI::widgetHandle UI::createBox(glm::vec4 rect, uint32_t color, widgetHandle parent) {
+	return createWidget(widgetType::box, rect, color, 0, getQuadCount(widgetType::box), parent);
+}
+
+UI::widgetHandle UI::createPanel(glm::vec4 rect, uint32_t color, uint32_t borderColor, widgetHandle parent) {
+	return createWidget(widgetType::panel, rect, color, borderColor, getQuadCount(widgetType::panel), parent);
+}
+
+UI::widgetHandle UI::createText(glm::vec2 position, const std::string& text, float size, uint32_t color, widgetHandle parent, Text::fontHandle font) {
+	if (this->text == nullptr) {
+		log_warning("UI has no text renderer, text widget not created!");
+
+		return NO_WIDGET;
+	}
+
+	font = font == Text::NO_FONT ? this->text->getDefaultFont() : font;
+
+	if (!this->text->isFontLoaded(font)) {
+		return NO_WIDGET;
+	}
+
+	glm::vec4 rect(position, this->text->getTextWidth(font, text, size), this->text->getLineHeight(font, size));
+
+	widgetHandle handle = createWidget(widgetType::text, rect, color, 0, this->text->getGlyphCount(font, text), parent);
+
+	if (handle != NO_WIDGET) {
+		widgets[handle].text = text;
+		widgets[handle].font = font;
+		widgets[handle].fontSize = size;
+	}
+
+	return handle;
+}
+
+UI::widgetHandle UI::createImage(glm::vec4 rect, textureHandle texture, uint32_t color, widgetHandle parent) {
+	widgetHandle handle = createWidget(widgetType::image, rect, color, 0, getQuadCount(widgetType::image), parent);
+
+	if (handle != NO_WIDGET) {
+		widgets[handle].texture = texture;
+	}
+
+	return handle;
+}
+
+UI::widgetHandle UI::createRoundedRect(glm::vec4 rect, float radius, uint32_t color, widgetHandle parent) {
+	widgetHandle handle = createWidget(widgetType::roundedRect, rect, color, 0, 0, parent);
+
+	if (handle == NO_WIDGET) {
+		return NO_WIDGET;
+	}
+
+	widgets[handle].radius = radius;
+
+	if (!allocateShape(handle)) {
+		log_warning("UI shape buffer is full, rounded rect not created!");
+		destroyWidget(handle);
+
+		return NO_WIDGET;
+	}
+
+	return handle;
+}
+
+UI::widgetHandle UI::createCircle(glm::vec2 center, float radius, uint32_t color, widgetHandle parent) {
+	return createRoundedRect({ center - glm::vec2(radius), radius * 2.0f, radius * 2.0f }, radius, color, parent);
+}
+
+UI::widgetHandle UI::createPolyline(const std::vector<glm::vec2>& points, float thickness, uint32_t color, widgetHandle parent) {
+	widgetHandle handle = createWidget(widgetType::polyline, glm::vec4(0.0f), color, 0, 0, parent);
+
+	if (handle == NO_WIDGET) {
+		return NO_WIDGET;
+	}
+
+	widgets[handle].thickness = thickness;
+	setPolylinePoints(widgets[handle], points);
+
+	if (!allocateShape(handle)) {
+		log_warning("UI shape buffer is full, polyline not created!");
+		destroyWidget(handle);
+
+		return NO_WIDGET;
+	}
+
+	return handle;
+}
+
+UI::widgetHandle UI::createArc(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t color, widgetHandle parent) {
+	float extent = radius + std::max(thickness, Tessellator::FEATHER) * 0.5f + Tessellator::FEATHER * 0.5f;
+
+	widgetHandle handle = createWidget(widgetType::arc, { center - glm::vec2(extent), extent * 2.0f, extent * 2.0f }, color, 0, 0, parent);
+
+	if (handle == NO_WIDGET) {
+		return NO_WIDGET;
+	}
+
+	widget& created = widgets[handle];
+	created.radius = radius;
+	created.startAngle = startAngle;
+	created.endAngle = endAngle;
+	created.thickness = thickness;
+
+	if (!allocateShape(handle)) {
+		log_warning("UI shape buffer is full, arc not created!");
+		destroyWidget(handle);
+
+		return NO_WIDGET;
+	}
+
+	return handle;
+}
+
+UI::widgetHandle UI::createWidget(widgetType type, glm::vec4 rect, uint32_t color, uint32_t borderColor, uint32_t quadCount, widgetHandle parent) {
+	if (quads.empty()) {
+		quadAllocator.init(MAX_QUADS);
+		quads.resize(MAX_QUADS);
+	}
+
+	uint32_t firstQuad = quadAllocator.allocate(quadCount);
+
+	if (quadCount != 0 && firstQuad == RangeAllocator::INVALID_OFFSET) {
+		log_warning("UI quad buffer is full, widget not created!");
+
+		return NO_WIDGET;
+	}
+
+	widgetHandle handle;
+
+	if (!freeWidgets.empty()) {
+		handle = freeWidgets.back();
+		freeWidgets.pop_back();
+	}
+	else {
+		handle = static_cast<widgetHandle>(widgets.size());
+		widgets.emplace_back();
+	}
+
+	widget& created = widgets[handle];
+	created = widget{};
+	created.type = type;
+	created.rect = rect;
+	created.color = color;
+	created.borderColor = borderColor;
+	created.firstQuad = firstQuad;
+	created.quadCount = quadCount;
+	created.alive = true;
+
+	linkWidget(handle, parent);
+	markWidgetDirty(handle);
+
+	drawListDirty = true;
+
+	stats.widgets++;
+
+	return handle;
+}
+
+void UI::destroyWidget(widgetHandle handle) {
+	if (handle == NO_WIDGET || !widgets[handle].alive) {
+		return;
+	}
+
+	unlinkWidget(handle);
+
+	subtreeStack.clear();
+	subtreeStack.push_back(handle);
+
+	while (!subtreeStack.empty()) {
+		widgetHandle current = subtreeStack.back();
+		subtreeStack.pop_back();
+
+		widget& destroyed = widgets[current];
+
+		for (widgetHandle child = destroyed.firstChild; child != NO_WIDGET; child = widgets[child].nextSibling) {
+			subtreeStack.push_back(child);
+		}
+
+		releaseQuads(current);
+		releaseShape(current);
+
+		if (destroyed.layoutNode != Layout::NO_NODE) {
+			layout.destroyNode(destroyed.layoutNode);
+			layoutWidgets[destroyed.layoutNode] = NO_WIDGET;
+			destroyed.layoutNode = Layout::NO_NODE;
+		}
+
+		destroyed.alive = false;
+		freeWidgets.push_back(current);
+
+		stats.widgets--;
+	}
+
+	drawListDirty = true;
+}
+
+void UI::releaseQuads(widgetHandle handle) {
+	widget& released = widgets[handle];
+
+	if (released.quadCount != 0) {
+		std::fill(quads.begin() + released.firstQuad, quads.begin() + released.firstQuad + released.quadCount, quad{});
+		pendingRanges.push_back({ released.firstQuad, released.quadCount });
+
+		quadAllocator.free(released.firstQuad, released.quadCount);
+	}
+
+	released.firstQuad = RangeAllocator::INVALID_OFFSET;
+	released.quadCount = 0;
+	released.pageMask = 0;
+}
+
+bool UI::allocateShape(widgetHandle handle) {
+	if (shapePositions.empty()) {
+		vertexAllocator.init(MAX_SHAPE_VERTICES);
+		indexAllocator.init(MAX_SHAPE_INDICES);
+		shapePositions.resize(MAX_SHAPE_VERTICES * 2);
+		shapeColors.resize(MAX_SHAPE_VERTICES);
+		shapeIndices.resize(MAX_SHAPE_INDICES);
+	}
+
+	widget& shape = widgets[handle];
+
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	getShapeCounts(shape, vertexCount, indexCount);
+
+	if (vertexCount == 0) {
+		return true;
+	}
+
+	uint32_t firstVertex = vertexAllocator.allocate(vertexCount);
+	uint32_t firstIndex = indexAllocator.allocate(indexCount);
+
+	if (firstVertex == RangeAllocator::INVALID_OFFSET || firstIndex == RangeAllocator::INVALID_OFFSET) {
+		if (firstVertex != RangeAllocator::INVALID_OFFSET) {
+			vertexAllocator.free(firstVertex, vertexCount);
+		}
+
+		if (firstIndex != RangeAllocator::INVALID_OFFSET) {
+			indexAllocator.free(firstIndex, indexCount);
+		}
+
+		return false;
+	}
+
+	shape.firstVertex = firstVertex;
+	shape.vertexCount = vertexCount;
+	shape.firstIndex = firstIndex;
+	shape.indexCount = indexCount;
+
+	return true;
+}
+
+void UI::releaseShape(widgetHandle handle) {
+	widget& released = widgets[handle];
+
+	if (released.vertexCount != 0) {
+		vertexAllocator.free(released.firstVertex, released.vertexCount);
+		indexAllocator.free(released.firstIndex, released.indexCount);
+	}
+
+	released.firstVertex = RangeAllocator::INVALID_OFFSET;
+	released.vertexCount = 0;
+	released.firstIndex = RangeAllocator::INVALID_OFFSET;
+	released.indexCount = 0;
+}
+
+void UI::setPolylinePoints(widget& shape, const std::vector<glm::vec2>& points) {
+	if (points.empty()) {
+		shape.points.clear();
+
+		return;
+	}
+
+	glm::vec2 minimum = points[0];
+	glm::vec2 maximum = points[0];
+
+	for (const glm::vec2& point : points) {
+		minimum = glm::min(minimum, point);
+		maximum = glm::max(maximum, point);
+	}
+
+	float padding = Tessellator::MITER_LIMIT * (std::max(shape.thickness, Tessellator::FEATHER) * 0.5f + Tessellator::FEATHER * 0.5f);
+
+	minimum -= glm::vec2(padding);
+	maximum += glm::vec2(padding);
+
+	shape.rect = { minimum, maximum - minimum };
+	shape.points.resize(points.size());
+
+	for (size_t i = 0; i < points.size(); i++) {
+		shape.points[i] = points[i] - minimum;
+	}
+}
+
+void UI::linkWidget(widgetHandle handle, widgetHandle parent) {
+	widgetHandle& first = parent != NO_WIDGET ? widgets[parent].firstChild : firstRoot;
+	widgetHandle& last = parent != NO_WIDGET ? widgets[parent].lastChild : lastRoot;
+
+	widget& linked = widgets[handle];
+	linked.parent = parent;
+	linked.previousSibling = last;
+	linked.nextSibling = NO_WIDGET;
+
+	if (last != NO_WIDGET) {
+		widgets[last].nextSibling = handle;
+	}
+	else {
+		first = handle;
+	}
+
+	last = handle;
+}
+
+void UI::unlinkWidget(widgetHandle handle) {
+	widget& unlinked = widgets[handle];
+
+	widgetHandle& first = unlinked.parent != NO_WIDGET ? widgets[unlinked.parent].firstChild : firstRoot;
+	widgetHandle& last = unlinked.parent != NO_WIDGET ? widgets[unlinked.parent].lastChild : lastRoot;
+
+	if (unlinked.previousSibling != NO_WIDGET) {
+		widgets[unlinked.previousSibling].nextSibling = unlinked.nextSibling;
+	}
+	else {
+		first = unlinked.nextSibling;
+	}
+
+	if (unlinked.nextSibling != NO_WIDGET) {
+		widgets[unlinked.nextSibling].previousSibling = unlinked.previousSibling;
+	}
+	else {
+		last = unlinked.previousSibling;
+	}
+
+	unlinked.parent = NO_WIDGET;
+	unlinked.previousSibling = NO_WIDGET;
+	unlinked.nextSibling = NO_WIDGET;
+}
+
+void UI::setRect(widgetHandle handle, glm::vec4 rect) {
+	if (widgets[handle].rect == rect) {
+		return;
+	}
+
+	widgets[handle].rect = rect;
+
+	markSubtreeDirty(handle);
+
+	drawListDirty = true;
+}
+
+void UI::setColor(widgetHandle handle, uint32_t color) {
+	if (widgets[handle].color == color) {
+		return;
+	}
+
+	widgets[handle].color = color;
+
+	markWidgetDirty(handle);
+}
+
+void UI::setVisible(widgetHandle handle, bool visible) {
+	if (widgets[handle].visible == visible) {
+		return;
+	}
+
+	widgets[handle].visible = visible;
+
+	markSubtreeDirty(handle);
+
+	drawListDirty = true;
+}
+
+void UI::setText(widgetHandle handle, const std::string& text) {
+	widget& changed = widgets[handle];
+
+	if (changed.type != widgetType::text || changed.text == text) {
+		return;
+	}
+
+	uint32_t quadCount = this->text->getGlyphCount(changed.font, text);
+
+	changed.text = text;
+	changed.rect.z = this->text->getTextWidth(changed.font, text, changed.fontSize);
+
+	if (changed.layoutNode != Layout::NO_NODE) {
+		layout.setContentSize(changed.layoutNode, { changed.rect.z, this->text->getLineHeight(changed.font, changed.fontSize) });
+	}
+
+	if (quadCount < changed.quadCount) {
+		uint32_t tailQuad = changed.firstQuad + quadCount;
+		uint32_t tailCount = changed.quadCount - quadCount;
+
+		std::fill(quads.begin() + tailQuad, quads.begin() + tailQuad + tailCount, quad{});
+		pendingRanges.push_back({ tailQuad, tailCount });
+
+		quadAllocator.free(tailQuad, tailCount);
+
+		changed.quadCount = quadCount;
+
+		if (quadCount == 0) {
+			changed.firstQuad = RangeAllocator::INVALID_OFFSET;
+		}
+
+		drawListDirty = true;
+	}
+	else if (quadCount > changed.quadCount) {
+		uint32_t firstQuad = quadAllocator.allocate(quadCount);
+
+		if (firstQuad == RangeAllocator::INVALID_OFFSET) {
+			log_warning("UI quad buffer is full, text truncated!");
+		}
+		else {
+			releaseQuads(handle);
+
+			changed.firstQuad = firstQuad;
+			changed.quadCount = quadCount;
+		}
+
+		drawListDirty = true;
+	}
+
+	markWidgetDirty(handle);
+}
+
+void UI::setClip(widgetHandle handle, bool clip) {
+	if (widgets[handle].clip == clip) {
+		return;
+	}
+
+	widgets[handle].clip = clip;
+
+	drawListDirty = true;
+}
+
+void UI::setScroll(widgetHandle handle, glm::vec2 scroll) {
+	if (widgets[handle].scroll == scroll) {
+		return;
+	}
+
+	widgets[handle].scroll = scroll;
+
+	drawListDirty = true;
+}
+
+void UI::setPolyline(widgetHandle handle, const std::vector<glm::vec2>& points) {
+	widget& changed = widgets[handle];
+
+	if (changed.type != widgetType::polyline) {
+		return;
+	}
+
+	size_t previousCount = changed.points.size();
+
+	setPolylinePoints(changed, points);
+
+	if (points.size() != previousCount) {
+		releaseShape(handle);
+
+		if (!allocateShape(handle)) {
+			log_warning("UI shape buffer is full, polyline truncated!");
+		}
+	}
+
+	markSubtreeDirty(handle);
+
+	drawListDirty = true;
+}
+
+void UI::setLayout(widgetHandle handle, const Layout::style& style) {
+	widget& target = widgets[handle];
+
+	if (target.layoutNode == Layout::NO_NODE) {
+		Layout::nodeHandle parentNode = target.parent != NO_WIDGET ? widgets[target.parent].layoutNode : Layout::NO_NODE;
+
+		target.layoutNode = layout.createNode(parentNode);
+
+		if (layoutWidgets.size() <= target.layoutNode) {
+			layoutWidgets.resize(target.layoutNode + 1, NO_WIDGET);
+		}
+
+		layoutWidgets[target.layoutNode] = handle;
 
-	this->application = &application;
+		layout.setContentSize(target.layoutNode, { target.rect.z, target.rect.w });
+	}
 
-	createUIPipeline();
+	layout.setStyle(target.layoutNode, style);
+}
 
-	createVertexBuffer(1000 * sizeof(vertex2D));
+void UI::markWidgetDirty(widgetHandle handle) {
+	widget& marked = widgets[handle];
 
-	log_info("UI initialized!");
+	if (!marked.dirty) {
+		marked.dirty = true;
+		dirtyWidgets.push_back(handle);
+	}
 }
 
-void UI::drawUI() {
-	application->ui.clearVertices();
+void UI::markSubtreeDirty(widgetHandle handle) {
+	subtreeStack.clear();
+	subtreeStack.push_back(handle);
+
+	while (!subtreeStack.empty()) {
+		widgetHandle current = subtreeStack.back();
+		subtreeStack.pop_back();
 
-	application->ui.drawBox(500, 200, 300, 50);
+		markWidgetDirty(current);
+
+		for (widgetHandle child = widgets[current].firstChild; child != NO_WIDGET; child = widgets[child].nextSibling) {
+			subtreeStack.push_back(child);
+		}
+	}
 }
 
-void UI::clearVertices() {
-	vertices.clear();
+void UI::regenerateWidget(widgetHandle handle) {
+	widget& current = widgets[handle];
+
+	glm::vec2 origin = glm::vec2(current.rect);
+	bool visible = current.visible;
+
+	for (widgetHandle parent = current.parent; parent != NO_WIDGET && visible; parent = widgets[parent].parent) {
+		origin += glm::vec2(widgets[parent].rect);
+		visible = widgets[parent].visible;
+	}
+
+	if (isShape(current.type)) {
+		regenerateShape(current, origin, visible);
+
+		return;
+	}
+
+	quad* output = quads.data() + current.firstQuad;
+
+	if (!visible) {
+		std::fill(output, output + current.quadCount, quad{});
+		current.pageMask = 0;
+
+		return;
+	}
+
+	if (current.type == widgetType::text) {
+		glyphQuads.resize(std::max(current.quadCount, text->getGlyphCount(current.font, current.text)));
+
+		uint32_t glyphCount = std::min(current.quadCount, text->layout(current.font, current.text, current.fontSize, origin, glyphQuads.data(), current.pageMask));
+
+		std::fill(output + glyphCount, output + current.quadCount, quad{});
+
+		for (uint32_t i = 0; i < glyphCount; i++) {
+			const Text::glyphQuad& glyph = glyphQuads[i];
+
+			output[i] = makeQuad(glyph.x, glyph.y, glyph.width, glyph.height, glyph.atlasRegion.width != 0 ? current.color : 0);
+			output[i].atlasRect = { glyph.atlasRegion.x, glyph.atlasRegion.y, glyph.atlasRegion.width, glyph.atlasRegion.height };
+		}
+
+		return;
+	}
+
+	float width = current.rect.z;
+	float height = current.rect.w;
+
+	output[0] = makeQuad(origin.x, origin.y, width, height, current.color);
+
+	if (current.type == widgetType::image) {
+		output[0].atlasRect = { 0, 0, GlyphAtlas::SIZE, GlyphAtlas::SIZE };
+	}
+
+	if (current.type == widgetType::panel) {
+		output[1] = makeQuad(origin.x, origin.y, width, 1.0f, current.borderColor);
+		output[2] = makeQuad(origin.x, origin.y + height - 1.0f, width, 1.0f, current.borderColor);
+		output[3] = makeQuad(origin.x, origin.y, 1.0f, height, current.borderColor);
+		output[4] = makeQuad(origin.x + width - 1.0f, origin.y, 1.0f, height, current.borderColor);
+	}
 }
 
-void UI::drawBox(float x, float y, float width, float height) {
-	glm::vec3 color = {0.0f, 1.0f, 0.0f};
+void UI::regenerateShape(widget& shape, glm::vec2 origin, bool visible) {
+	Tessellator::vertexStream stream;
+	stream.positions = shapePositions.data() + shape.firstVertex * 2;
+	stream.colors = shapeColors.data() + shape.firstVertex;
+	stream.indices = shapeIndices.data() + shape.firstIndex;
+	stream.firstVertex = shape.firstVertex;
+
+	uint32_t segments = getShapeSegments(shape);
+
+	switch (shape.type) {
+		case widgetType::roundedRect:
+			Tessellator::roundedRect({ origin, shape.rect.z, shape.rect.w }, shape.radius, segments, shape.color, stream);
+			break;
+		case widgetType::polyline:
+			Tessellator::polyline(shape.points.data(), static_cast<uint32_t>(shape.points.size()), origin, shape.thickness, shape.color, stream);
+			break;
+		case widgetType::arc:
+			Tessellator::arc(origin + glm::vec2(shape.rect.z, shape.rect.w) * 0.5f, shape.radius, shape.startAngle, shape.endAngle, shape.thickness, segments, shape.color, stream);
+			break;
+		default:
+			break;
+	}
 
-	vertex2D topLeft = { {x, y}, color };
-	vertex2D topRight = { {x + width, y}, color };
-	vertex2D bottomLeft = { {x, y + height}, color };
-	vertex2D bottomRight = { {x + width, y + height}, color };
+	if (!visible) {
+		std::fill(stream.positions, stream.positions + shape.vertexCount * 2, 0.0f);
+	}
+}
 
-	vertices.push_back(topLeft);
-	vertices.push_back(bottomLeft);
-	vertices.push_back(topRight);
+void UI::queueUploads(const widget& current) {
+	if (current.quadCount != 0) {
+		pendingRanges.push_back({ current.firstQuad, current.quadCount });
+	}
 
-	vertices.push_back(topRight);
-	vertices.push_back(bottomLeft);
-	vertices.push_back(bottomRight);
+	if (current.vertexCount != 0) {
+		pendingVertexRanges.push_back({ current.firstVertex, current.vertexCount });
+		pendingIndexRanges.push_back({ current.firstIndex, current.indexCount });
+	}
 }
 
-void UI::createVertexBuffer(size_t bufferSize) {
-	VkDevice device = application->renderer.getDevice();
+void UI::writeFrameData(frameData& frame) {
+	trace_zone("UI::writeFrameData");
+
+	coalesceRanges(pendingRanges);
+
+	frame.ranges.assign(pendingRanges.begin(), pendingRanges.end());
+	frame.quads.clear();
 
-	VkBufferCreateInfo bufferCreateInfo{};
-	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	bufferCreateInfo.size = bufferSize;
-	bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	for (const range& quadRange : pendingRanges) {
+		frame.quads.insert(frame.quads.end(), quads.begin() + quadRange.first, quads.begin() + quadRange.first + quadRange.count);
+	}
+
+	coalesceRanges(pendingVertexRanges);
+	coalesceRanges(pendingIndexRanges);
+
+	frame.shapeVertexRanges.assign(pendingVertexRanges.begin(), pendingVertexRanges.end());
+	frame.shapePositions.clear();
+	frame.shapeColors.clear();
+
+	for (const range& vertexRange : pendingVertexRanges) {
+		frame.shapePositions.insert(frame.shapePositions.end(), shapePositions.begin() + vertexRange.first * 2, shapePositions.begin() + (vertexRange.first + vertexRange.count) * 2);
+		frame.shapeColors.insert(frame.shapeColors.end(), shapeColors.begin() + vertexRange.first, shapeColors.begin() + vertexRange.first + vertexRange.count);
+	}
+
+	frame.shapeIndexRanges.assign(pendingIndexRanges.begin(), pendingIndexRanges.end());
+	frame.shapeIndices.clear();
+
+	for (const range& indexRange : pendingIndexRanges) {
+		frame.shapeIndices.insert(frame.shapeIndices.end(), shapeIndices.begin() + indexRange.first, shapeIndices.begin() + indexRange.first + indexRange.count);
+	}
 
-	VkResult bufferResult = vkCreateBuffer(device, &bufferCreateInfo, nullptr, &vertexBuffer);
+	frame.drawListChanged = drawListChanged;
 
-	if (bufferResult != VK_SUCCESS) {
-		log_error("Failed to create vertex buffer!");
+	if (drawListChanged) {
+		frame.drawCommands.assign(drawList.getCommands().begin(), drawList.getCommands().end());
+		frame.imageResolutions.assign(imageResolutions.begin(), imageResolutions.end());
+	}
+
+	if (text != nullptr) {
+		text->writeAtlasUploads(frame.atlasRegions, frame.atlasPixels);
 	}
 	else {
-		log_info("Successfully created vertex buffer!");
+		frame.atlasRegions.clear();
+		frame.atlasPixels.clear();
+	}
+
+	stats.uploadedQuads += frame.quads.size();
+	stats.uploadedShapeVertices += frame.shapeColors.size();
+	stats.uploadRegions += pendingRanges.size() + pendingVertexRanges.size() + pendingIndexRanges.size();
+
+	pendingRanges.clear();
+	pendingVertexRanges.clear();
+	pendingIndexRanges.clear();
+	drawListChanged = false;
+	dirty = false;
+}
+
+bool UI::isDirty() {
+	return dirty || drawListChanged || drawListDirty || !pendingRanges.empty() || !pendingVertexRanges.empty() || !pendingIndexRanges.empty() || (text != nullptr && text->hasAtlasUploads());
+}
+
+void UI::markDirty() {
+	dirty = true;
+}
+
+UI::statistics UI::getStatistics() {
+	return stats;
+}
+
+uint32_t UI::packColor(float red, float green, float blue, float alpha) {
+	auto toByte = [](float value) {
+		return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+
+	return toByte(red) | (toByte(green) << 8) | (toByte(blue) << 16) | (toByte(alpha) << 24);
+}
+
+UI::quad UI::makeQuad(float x, float y, float width, float height, uint32_t color) {
+	auto toPixel = [](float value) {
+		value = std::clamp(value, -32768.0f, 32767.0f);
+
+		return static_cast<int16_t>(value + (value < 0.0f ? -0.5f : 0.5f));
+	};
+
+	return { { toPixel(x), toPixel(y), toPixel(width), toPixel(height) }, { GlyphAtlas::SOLID_TEXEL, GlyphAtlas::SOLID_TEXEL, 0, 0 }, { color } };
+}
+
+void UI::createQuadBuffers() {
+	VkDevice device = application->renderer.getDevice();
+
+	application->renderer.createBuffer(MAX_QUADS * sizeof(quad), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, quadBuffer, quadBufferMemory);
+
+	log_info("Successfully created UI quad buffer!");
+
+	application->renderer.createBuffer(SHAPE_BUFFER_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, shapeBuffer, shapeBufferMemory);
+
+	log_info("Successfully created UI shape buffer!");
+
+	uint32_t framesInFlight = application->renderer.getMaxFramesInFlight();
+
+	stagingBuffers.resize(framesInFlight);
+	stagingBufferMemories.resize(framesInFlight);
+	mappedStagingBuffers.resize(framesInFlight);
+
+	VkDeviceSize stagingSize = SHAPE_STAGING_OFFSET + SHAPE_BUFFER_SIZE;
+
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		application->renderer.createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffers[i], stagingBufferMemories[i]);
+
+		VkResult mapResult = vkMapMemory(device, stagingBufferMemories[i], 0, stagingSize, 0, &mappedStagingBuffers[i]);
+
+		if (mapResult != VK_SUCCESS) {
+			log_error("Failed to map UI staging buffer!");
+		}
+	}
+
+	log_info("Successfully created UI staging buffers!");
+
+	renderQuads.resize(MAX_QUADS);
+	renderShapePositions.resize(MAX_SHAPE_VERTICES * 2);
+	renderShapeColors.resize(MAX_SHAPE_VERTICES);
+	renderShapeIndices.resize(MAX_SHAPE_INDICES);
+
+	renderAtlas.assign(GlyphAtlas::SIZE * GlyphAtlas::SIZE, 0);
+	GlyphAtlas::writeSolidBlock(renderAtlas.data());
+
+	atlasUploadRegions.push_back({ 0, 0, static_cast<uint16_t>(GlyphAtlas::SIZE), static_cast<uint16_t>(GlyphAtlas::SIZE) });
+
+	const std::array<uint16_t, 6> quadIndices = { 0, 2, 1, 1, 2, 3 };
+
+	application->renderer.createBuffer(sizeof(quadIndices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, indexBuffer, indexBufferMemory);
+
+	void* data;
+	vkMapMemory(device, indexBufferMemory, 0, sizeof(quadIndices), 0, &data);
+	memcpy(data, quadIndices.data(), sizeof(quadIndices));
+	vkUnmapMemory(device, indexBufferMemory);
+
+	log_info("Successfully created UI index buffer!");
+}
+
+void UI::createAtlasImage() {
+	log_info("Creating UI atlas image...");
+
+	VkDevice device = application->renderer.getDevice();
+
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = VK_FORMAT_R8_UNORM;
+	imageCreateInfo.extent = { GlyphAtlas::SIZE, GlyphAtlas::SIZE, 1 };
+	imageCreateInfo.mipLevels = 1;
+	imageCreateInfo.arrayLayers = 1;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	if (vkCreateImage(device, &imageCreateInfo, nullptr, &atlasImage) != VK_SUCCESS) {
+		log_error("Failed to create UI atlas image!");
 	}
 
 	VkMemoryRequirements memoryRequirements;
-	vkGetBufferMemoryRequirements(device, vertexBuffer, &memoryRequirements);
+	vkGetImageMemoryRequirements(device, atlasImage, &memoryRequirements);
 
 	VkMemoryAllocateInfo memoryAllocateInfo{};
 	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 	memoryAllocateInfo.allocationSize = memoryRequirements.size;
-	memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	memoryAllocateInfo.memoryTypeIndex = application->renderer.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &atlasImageMemory) != VK_SUCCESS) {
+		log_error("Failed to allocate UI atlas image memory!");
+	}
+
+	vkBindImageMemory(device, atlasImage, atlasImageMemory, 0);
+
+	VkImageViewCreateInfo viewCreateInfo{};
+	viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewCreateInfo.image = atlasImage;
+	viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewCreateInfo.format = VK_FORMAT_R8_UNORM;
+	viewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	viewCreateInfo.subresourceRange.baseMipLevel = 0;
+	viewCreateInfo.subresourceRange.levelCount = 1;
+	viewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	viewCreateInfo.subresourceRange.layerCount = 1;
+
+	if (vkCreateImageView(device, &viewCreateInfo, nullptr, &atlasImageView) != VK_SUCCESS) {
+		log_error("Failed to create UI atlas image view!");
+	}
+
+	VkSamplerCreateInfo samplerCreateInfo{};
+	samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+	samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+	samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCreateInfo.anisotropyEnable = VK_FALSE;
+	samplerCreateInfo.maxAnisotropy = 1.0f;
+	samplerCreateInfo.minLod = 0.0f;
+	samplerCreateInfo.maxLod = 0.0f;
 
-	VkResult memoryResult = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &vertexBufferMemory);
+	VkResult samplerResult = vkCreateSampler(device, &samplerCreateInfo, nullptr, &atlasSampler);
 
-	if (memoryResult != VK_SUCCESS) {
-		log_error("Failed to allocate vertex buffer memory!")
+	if (samplerResult != VK_SUCCESS) {
+		log_error("Failed to create UI atlas sampler!");
 	}
 	else {
-		log_info("Successfully allocated vertex buffer memory!");
+		log_info("Successfully created UI atlas image!");
 	}
-
-	vkBindBufferMemory(device, vertexBuffer, vertexBufferMemory, 0);
 }
 
-void UI::updateVertexBuffer() {
+void UI::createDescriptorSet() {
+	log_info("Creating UI descriptor set...");
+
 	VkDevice device = application->renderer.getDevice();
 
-	void* data;
-	vkMapMemory(device, vertexBufferMemory, 0, vertices.size() * sizeof(vertex2D), 0, &data);
-	memcpy(data, vertices.data(), vertices.size() * sizeof(vertex2D));
-	vkUnmapMemory(device, vertexBufferMemory);
+	VkDescriptorSetLayoutBinding atlasBinding{};
+	atlasBinding.binding = 0;
+	atlasBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	atlasBinding.descriptorCount = 1;
+	atlasBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+	atlasBinding.pImmutableSamplers = nullptr;
+
+	VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+	layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutCreateInfo.bindingCount = 1;
+	layoutCreateInfo.pBindings = &atlasBinding;
+
+	if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+		log_error("Failed to create UI descriptor set layout!");
+	}
+
+	VkDescriptorPoolSize poolSize{};
+	poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSize.descriptorCount = 1;
+
+	VkDescriptorPoolCreateInfo poolCreateInfo{};
+	poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolCreateInfo.maxSets = 1;
+	poolCreateInfo.poolSizeCount = 1;
+	poolCreateInfo.pPoolSizes = &poolSize;
+
+	if (vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+		log_error("Failed to create UI descriptor pool!");
+	}
+
+	VkDescriptorSetAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = descriptorPool;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &descriptorSetLayout;
+
+	if (vkAllocateDescriptorSets(device, &allocateInfo, &atlasSet) != VK_SUCCESS) {
+		log_error("Failed to allocate UI descriptor set!");
+	}
+
+	VkDescriptorImageInfo imageInfo{};
+	imageInfo.sampler = atlasSampler;
+	imageInfo.imageView = atlasImageView;
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+	VkWriteDescriptorSet descriptorWrite{};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = atlasSet;
+	descriptorWrite.dstBinding = 0;
+	descriptorWrite.dstArrayElement = 0;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pImageInfo = &imageInfo;
+
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+
+	log_info("Successfully created UI descriptor set!");
+}
+
+void UI::applyFrameData(const frameData& frame) {
+	const quad* source = frame.quads.data();
+
+	for (const range& quadRange : frame.ranges) {
+		memcpy(renderQuads.data() + quadRange.first, source, quadRange.count * sizeof(quad));
+		source += quadRange.count;
+
+		uploadRanges.push_back(quadRange);
+	}
+
+	const float* positionSource = frame.shapePositions.data();
+	const uint32_t* colorSource = frame.shapeColors.data();
+
+	for (const range& vertexRange : frame.shapeVertexRanges) {
+		memcpy(renderShapePositions.data() + vertexRange.first * 2, positionSource, vertexRange.count * sizeof(float) * 2);
+		memcpy(renderShapeColors.data() + vertexRange.first, colorSource, vertexRange.count * sizeof(uint32_t));
+		positionSource += vertexRange.count * 2;
+		colorSource += vertexRange.count;
+
+		shapeVertexUploads.push_back(vertexRange);
+	}
+
+	const uint32_t* indexSource = frame.shapeIndices.data();
+
+	for (const range& indexRange : frame.shapeIndexRanges) {
+		memcpy(renderShapeIndices.data() + indexRange.first, indexSource, indexRange.count * sizeof(uint32_t));
+		indexSource += indexRange.count;
+
+		shapeIndexUploads.push_back(indexRange);
+	}
+
+	const uint8_t* atlasSource = frame.atlasPixels.data();
+
+	for (const GlyphAtlas::region& atlasRegion : frame.atlasRegions) {
+		for (uint32_t row = 0; row < atlasRegion.height; row++) {
+			memcpy(renderAtlas.data() + (atlasRegion.y + row) * GlyphAtlas::SIZE + atlasRegion.x, atlasSource, atlasRegion.width);
+			atlasSource += atlasRegion.width;
+		}
+
+		atlasUploadRegions.push_back(atlasRegion);
+	}
+
+	if (frame.drawListChanged) {
+		renderCommands.assign(frame.drawCommands.begin(), frame.drawCommands.end());
+		renderImageResolutions.assign(frame.imageResolutions.begin(), frame.imageResolutions.end());
+	}
+}
+
+void UI::recordUploads(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (uploadRanges.empty() && atlasUploadRegions.empty() && shapeVertexUploads.empty() && shapeIndexUploads.empty()) {
+		return;
+	}
+
+	trace_zone("UI::recordUploads");
+
+	BarrierTracker& barrierTracker = application->renderer.barrierTracker;
+
+	if (!quadBufferTracked) {
+		barrierTracker.trackBuffer(quadBuffer);
+		quadBufferTracked = true;
+	}
+
+	if (!atlasImageTracked) {
+		barrierTracker.trackImage(atlasImage, VK_IMAGE_ASPECT_COLOR_BIT);
+		atlasImageTracked = true;
+	}
+
+	if (!shapeBufferTracked) {
+		barrierTracker.trackBuffer(shapeBuffer);
+		shapeBufferTracked = true;
+	}
+
+	uint8_t* staging = static_cast<uint8_t*>(mappedStagingBuffers[frameIndex]);
+
+	coalesceRanges(uploadRanges);
+
+	copyRegions.clear();
+
+	for (const range& quadRange : uploadRanges) {
+		memcpy(staging + quadRange.first * sizeof(quad), renderQuads.data() + quadRange.first, quadRange.count * sizeof(quad));
+
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = quadRange.first * sizeof(quad);
+		copyRegion.dstOffset = quadRange.first * sizeof(quad);
+		copyRegion.size = quadRange.count * sizeof(quad);
+
+		copyRegions.push_back(copyRegion);
+	}
+
+	coalesceRanges(shapeVertexUploads);
+	coalesceRanges(shapeIndexUploads);
+
+	shapeCopyRegions.clear();
+
+	auto addShapeCopy = [&](const void* source, VkDeviceSize offset, VkDeviceSize size) {
+		memcpy(staging + SHAPE_STAGING_OFFSET + offset, source, size);
+
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = SHAPE_STAGING_OFFSET + offset;
+		copyRegion.dstOffset = offset;
+		copyRegion.size = size;
+
+		shapeCopyRegions.push_back(copyRegion);
+	};
+
+	for (const range& vertexRange : shapeVertexUploads) {
+		addShapeCopy(renderShapePositions.data() + vertexRange.first * 2, vertexRange.first * sizeof(float) * 2, vertexRange.count * sizeof(float) * 2);
+		addShapeCopy(renderShapeColors.data() + vertexRange.first, SHAPE_COLOR_OFFSET + vertexRange.first * sizeof(uint32_t), vertexRange.count * sizeof(uint32_t));
+	}
+
+	for (const range& indexRange : shapeIndexUploads) {
+		addShapeCopy(renderShapeIndices.data() + indexRange.first, SHAPE_INDEX_OFFSET + indexRange.first * sizeof(uint32_t), indexRange.count * sizeof(uint32_t));
+	}
+
+	shapeVertexUploads.clear();
+	shapeIndexUploads.clear();
+
+	atlasCopyRegions.clear();
+
+	for (const GlyphAtlas::region& atlasRegion : atlasUploadRegions) {
+		VkDeviceSize offset = ATLAS_STAGING_OFFSET + atlasRegion.y * GlyphAtlas::SIZE + atlasRegion.x;
+
+		for (uint32_t row = 0; row < atlasRegion.height; row++) {
+			memcpy(staging + offset + row * GlyphAtlas::SIZE, renderAtlas.data() + (atlasRegion.y + row) * GlyphAtlas::SIZE + atlasRegion.x, atlasRegion.width);
+		}
+
+		VkBufferImageCopy copyRegion{};
+		copyRegion.bufferOffset = offset;
+		copyRegion.bufferRowLength = GlyphAtlas::SIZE;
+		copyRegion.bufferImageHeight = 0;
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.mipLevel = 0;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageOffset = { atlasRegion.x, atlasRegion.y, 0 };
+		copyRegion.imageExtent = { atlasRegion.width, atlasRegion.height, 1 };
+
+		atlasCopyRegions.push_back(copyRegion);
+	}
+
+	uploadRanges.clear();
+	atlasUploadRegions.clear();
+
+	if (!copyRegions.empty()) {
+		barrierTracker.accessBuffer(quadBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	}
+
+	if (!shapeCopyRegions.empty()) {
+		barrierTracker.accessBuffer(shapeBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	}
+
+	if (!atlasCopyRegions.empty()) {
+		barrierTracker.transitionImage(atlasImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	}
+
+	barrierTracker.flush(commandBuffer);
+
+	if (!copyRegions.empty()) {
+		vkCmdCopyBuffer(commandBuffer, stagingBuffers[frameIndex], quadBuffer, static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+		barrierTracker.accessBuffer(quadBuffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+	}
+
+	if (!shapeCopyRegions.empty()) {
+		vkCmdCopyBuffer(commandBuffer, stagingBuffers[frameIndex], shapeBuffer, static_cast<uint32_t>(shapeCopyRegions.size()), shapeCopyRegions.data());
+
+		barrierTracker.accessBuffer(shapeBuffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT);
+	}
+
+	if (!atlasCopyRegions.empty()) {
+		vkCmdCopyBufferToImage(commandBuffer, stagingBuffers[frameIndex], atlasImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(atlasCopyRegions.size()), atlasCopyRegions.data());
+
+		barrierTracker.transitionImage(atlasImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+	}
+
+	barrierTracker.flush(commandBuffer);
 }
 
-void UI::render(VkCommandBuffer commandBuffer) {
-	if (vertices.empty()) {
+void UI::render(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+	if (renderCommands.empty()) {
 		return;
 	}
 
-	updateVertexBuffer();
+	trace_zone("UI::render");
+
+	application->renderer.barrierTracker.useBuffer(quadBuffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+	application->renderer.barrierTracker.useImage(atlasImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+	if (shapeBufferTracked) {
+		application->renderer.barrierTracker.useBuffer(shapeBuffer, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT);
+	}
+
+	for (const imageResolution& image : renderImageResolutions) {
+		application->textures.requestResolution(image.texture, image.screenPixels);
+	}
+
+	const std::array<VkBuffer, 2> shapeBuffers = { shapeBuffer, shapeBuffer };
+	const std::array<VkDeviceSize, 2> shapeOffsets = { 0, SHAPE_COLOR_OFFSET };
+	VkDeviceSize offset = 0;
+	bool shapeStream = false;
+
+	vkCmdBindVertexBuffers(commandBuffer, 0, 1, &quadBuffer, &offset);
+	vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+	viewportConstants constants{};
+	constants.scale = { 2.0f / static_cast<float>(extent.width), -2.0f / static_cast<float>(extent.height) };
+
+	const DrawList::clipRect framebufferClip = { 0, 0, static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height) };
+
+	uint32_t boundPipeline = PIPELINE_COUNT;
+	VkDescriptorSet boundSet = VK_NULL_HANDLE;
+	DrawList::clipRect boundClip = { 0, 0, 0, 0 };
+	glm::vec2 boundTranslation(0.0f);
+	bool first = true;
+
+	for (const DrawList::command& command : renderCommands) {
+		DrawList::clipRect clip = {
+			std::max(command.clip.left, framebufferClip.left),
+			std::max(command.clip.top, framebufferClip.top),
+			std::min(command.clip.right, framebufferClip.right),
+			std::min(command.clip.bottom, framebufferClip.bottom)
+		};
+
+		if (DrawList::isEmpty(clip)) {
+			continue;
+		}
+
+		if (command.pipeline != boundPipeline) {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, uiPipelines[command.pipeline]);
+			boundPipeline = command.pipeline;
+
+			stats.pipelineBinds++;
+		}
+
+		if ((command.pipeline == SHAPE_PIPELINE) != shapeStream) {
+			shapeStream = command.pipeline == SHAPE_PIPELINE;
+
+			if (shapeStream) {
+				vkCmdBindVertexBuffers(commandBuffer, 0, static_cast<uint32_t>(shapeBuffers.size()), shapeBuffers.data(), shapeOffsets.data());
+				vkCmdBindIndexBuffer(commandBuffer, shapeBuffer, SHAPE_INDEX_OFFSET, VK_INDEX_TYPE_UINT32);
+			}
+			else {
+				vkCmdBindVertexBuffers(commandBuffer, 0, 1, &quadBuffer, &offset);
+				vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+			}
+		}
+
+		VkDescriptorSet textureSet = command.texture == ATLAS_TEXTURE ? atlasSet : application->textures.useTexture(command.texture);
+
+		if (textureSet != boundSet) {
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, uiPipelineLayout, 0, 1, &textureSet, 0, nullptr);
+			boundSet = textureSet;
+
+			stats.textureBinds++;
+		}
+
+		if (first || command.translation != boundTranslation) {
+			constants.offset = glm::vec2(-1.0f, 1.0f) + command.translation * constants.scale;
+
+			vkCmdPushConstants(commandBuffer, uiPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(viewportConstants), &constants);
+			boundTranslation = command.translation;
+		}
+
+		if (first || !DrawList::isEqual(clip, boundClip)) {
+			VkRect2D scissor{};
+			scissor.offset = { clip.left, clip.top };
+			scissor.extent = { static_cast<uint32_t>(clip.right - clip.left), static_cast<uint32_t>(clip.bottom - clip.top) };
 
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, uiPipeline);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+			boundClip = clip;
 
-	VkBuffer vertexBuffers[] = { vertexBuffer };
-	VkDeviceSize offsets[] = { 0 };
-	vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+			stats.scissorChanges++;
+		}
 
-	vkCmdDraw(commandBuffer, static_cast<uint32_t>(vertices.size()), 1, 0, 0);
+		first = false;
+
+		if (shapeStream) {
+			vkCmdDrawIndexed(commandBuffer, command.count, 1, command.first, 0, 0);
+		}
+		else {
+			vkCmdDrawIndexed(commandBuffer, 6, command.count, 0, 0, command.first);
+		}
+
+		stats.drawCalls++;
+	}
+
+	if (!first && !DrawList::isEqual(boundClip, framebufferClip)) {
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = extent;
+
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	}
 }
 
 void UI::createUIPipeline() {
-	log_info("Creating UI pipeline...");
+	log_info("Creating UI pipelines...");
 
 	Pipelines::pipelineStructure pipelineStructure{};
 
 	pipelineStructure.vertexShaderPath = "src/renderer/shaders/ui_vert.spv";
 	pipelineStructure.fragmentShaderPath = "src/renderer/shaders/ui_frag.spv";
 
-	static VkVertexInputBindingDescription vertexInputBindingDescription{};
-	vertexInputBindingDescription.binding = 0;
-	vertexInputBindingDescription.stride = sizeof(vertex2D);
-	vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-	static std::array<VkVertexInputAttributeDescription, 2> vertexInputAttributeDescriptions{};
-	vertexInputAttributeDescriptions[0].binding = 0;
-	vertexInputAttributeDescriptions[0].location = 0;
-	vertexInputAttributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
-	vertexInputAttributeDescriptions[0].offset = offsetof(vertex2D, position);
-
-	vertexInputAttributeDescriptions[1].binding = 0;
-	vertexInputAttributeDescriptions[1].location = 1;
-	vertexInputAttributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;
-	vertexInputAttributeDescriptions[1].offset = offsetof(vertex2D, position);
+	static constexpr VertexInput<VertexBinding<quadLayout, VK_VERTEX_INPUT_RATE_INSTANCE>> quadInput;
 
-	pipelineStructure.vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	pipelineStructure.vertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
-	pipelineStructure.vertexInputStateCreateInfo.pVertexBindingDescriptions = &vertexInputBindingDescription;
-	pipelineStructure.vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputAttributeDescriptions.size());
-	pipelineStructure.vertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions.data();
+	pipelineStructure.vertexInputStateCreateInfo = quadInput.getCreateInfo();
 
 	pipelineStructure.inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 	pipelineStructure.inputAssemblyStateCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
@@ -162,12 +1594,12 @@ void UI::createUIPipeline() {
 	pipelineStructure.multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
 
 	pipelineStructure.colorBlendAttachmentStateCreateInfo.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-	pipelineStructure.colorBlendAttachmentStateCreateInfo.blendEnable = VK_FALSE;
-	pipelineStructure.colorBlendAttachmentStateCreateInfo.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.blendEnable = VK_TRUE;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 	pipelineStructure.colorBlendAttachmentStateCreateInfo.colorBlendOp = VK_BLEND_OP_ADD;
 	pipelineStructure.colorBlendAttachmentStateCreateInfo.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+	pipelineStructure.colorBlendAttachmentStateCreateInfo.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 	pipelineStructure.colorBlendAttachmentStateCreateInfo.alphaBlendOp = VK_BLEND_OP_ADD;
 
 	pipelineStructure.colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
@@ -190,23 +1622,119 @@ void UI::createUIPipeline() {
 	pipelineStructure.dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
 	pipelineStructure.dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
 
-	VkPipelineLayout pipelineLayout = application->pipelines.createPipelineLayout();
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(viewportConstants);
+
+	VkPipelineLayout pipelineLayout = application->pipelines.createPipelineLayout({ pushConstantRange }, { descriptorSetLayout });
 	uiPipelineLayout = pipelineLayout;
 
-	pipelineStructure.depthStencilStateCreateInfo = nullptr;
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo{};
+	depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencilStateCreateInfo.depthTestEnable = VK_FALSE;
+	depthStencilStateCreateInfo.depthWriteEnable = VK_FALSE;
+	depthStencilStateCreateInfo.depthCompareOp = VK_COMPARE_OP_ALWAYS;
+	depthStencilStateCreateInfo.maxDepthBounds = 1.0f;
+
+	pipelineStructure.depthStencilStateCreateInfo = &depthStencilStateCreateInfo;
 
 	pipelineStructure.pipelineLayout = pipelineLayout;
 	pipelineStructure.renderPass = application->renderer.getRenderPass();
 	pipelineStructure.subpass = 0;
 
-	VkPipeline pipeline = application->pipelines.createPipeline(pipelineStructure);
-	uiPipeline = pipeline;
+	Pipelines::pipelineStructure imagePipelineStructure = pipelineStructure;
+	imagePipelineStructure.fragmentShaderPath = "src/renderer/shaders/ui_image_frag.spv";
+
+	static constexpr VertexInput<VertexBinding<shapePositionLayout>, VertexBinding<shapeColorLayout>> shapeInput;
+
+	Pipelines::pipelineStructure shapePipelineStructure = pipelineStructure;
+	shapePipelineStructure.vertexShaderPath = "src/renderer/shaders/ui_shape_vert.spv";
+	shapePipelineStructure.fragmentShaderPath = "src/renderer/shaders/ui_shape_frag.spv";
+	shapePipelineStructure.vertexInputStateCreateInfo = shapeInput.getCreateInfo();
+	shapePipelineStructure.rasterizationStateCreateInfo.cullMode = VK_CULL_MODE_NONE;
 
-	log_info("Successfully created UI pipeline!");
+	std::vector<VkPipeline> pipelines = application->pipelines.createPipelines({ pipelineStructure, imagePipelineStructure, shapePipelineStructure });
+	uiPipelines[SDF_PIPELINE] = pipelines[0];
+	uiPipelines[IMAGE_PIPELINE] = pipelines[1];
+	uiPipelines[SHAPE_PIPELINE] = pipelines[2];
+
+	log_info("Successfully created UI pipelines!");
 }
 
 void UI::cleanup() {
 	log_info("Cleaning up UI...");
 
+	VkDevice device = application->renderer.getDevice();
+
+	vkDeviceWaitIdle(device);
+
+	if (quadBufferTracked) {
+		application->renderer.barrierTracker.forgetBuffer(quadBuffer);
+		quadBufferTracked = false;
+	}
+
+	if (atlasImageTracked) {
+		application->renderer.barrierTracker.forgetImage(atlasImage);
+		atlasImageTracked = false;
+	}
+
+	if (shapeBufferTracked) {
+		application->renderer.barrierTracker.forgetBuffer(shapeBuffer);
+		shapeBufferTracked = false;
+	}
+
+	for (size_t i = 0; i < stagingBuffers.size(); i++) {
+		vkUnmapMemory(device, stagingBufferMemories[i]);
+		vkDestroyBuffer(device, stagingBuffers[i], nullptr);
+		vkFreeMemory(device, stagingBufferMemories[i], nullptr);
+	}
+
+	stagingBuffers.clear();
+	stagingBufferMemories.clear();
+	mappedStagingBuffers.clear();
+
+	vkDestroyBuffer(device, quadBuffer, nullptr);
+	vkFreeMemory(device, quadBufferMemory, nullptr);
+	vkDestroyBuffer(device, indexBuffer, nullptr);
+	vkFreeMemory(device, indexBufferMemory, nullptr);
+	vkDestroyBuffer(device, shapeBuffer, nullptr);
+	vkFreeMemory(device, shapeBufferMemory, nullptr);
+
+	for (VkPipeline& uiPipeline : uiPipelines) {
+		if (uiPipeline != VK_NULL_HANDLE) {
+			application->pipelines.destroyPipeline(uiPipeline);
+			uiPipeline = VK_NULL_HANDLE;
+		}
+	}
+
+	vkDestroyPipelineLayout(device, uiPipelineLayout, nullptr);
+	uiPipelineLayout = VK_NULL_HANDLE;
+
+	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+	vkDestroySampler(device, atlasSampler, nullptr);
+	vkDestroyImageView(device, atlasImageView, nullptr);
+	vkDestroyImage(device, atlasImage, nullptr);
+	vkFreeMemory(device, atlasImageMemory, nullptr);
+
+	quadBuffer = VK_NULL_HANDLE;
+	quadBufferMemory = VK_NULL_HANDLE;
+	indexBuffer = VK_NULL_HANDLE;
+	indexBufferMemory = VK_NULL_HANDLE;
+	shapeBuffer = VK_NULL_HANDLE;
+	shapeBufferMemory = VK_NULL_HANDLE;
+	descriptorPool = VK_NULL_HANDLE;
+	descriptorSetLayout = VK_NULL_HANDLE;
+	atlasSet = VK_NULL_HANDLE;
+	atlasSampler = VK_NULL_HANDLE;
+	atlasImageView = VK_NULL_HANDLE;
+	atlasImage = VK_NULL_HANDLE;
+	atlasImageMemory = VK_NULL_HANDLE;
+
+	log_info("UI regenerated " + std::to_string(stats.regeneratedWidgets) + " widgets, uploaded " + std::to_string(stats.uploadedQuads) + " quads and " + std::to_string(stats.uploadedShapeVertices) + " shape vertices in " + std::to_string(stats.uploadRegions) + " regions, compacted " + std::to_string(stats.compactions) + " times");
+	log_info("UI draw list rebuilt " + std::to_string(stats.drawListBuilds) + " times with " + std::to_string(drawList.getStatistics().mergedRanges) + " merged ranges and " + std::to_string(drawList.getStatistics().elidedClips) + " elided clips, recorded " + std::to_string(stats.drawCalls) + " draws with " + std::to_string(stats.scissorChanges) + " scissor changes, " + std::to_string(stats.pipelineBinds) + " pipeline binds and " + std::to_string(stats.textureBinds) + " texture binds");
+	log_info("UI layout updated " + std::to_string(stats.layoutUpdates) + " times, measured " + std::to_string(layout.getStatistics().measuredNodes) + " nodes with " + std::to_string(layout.getStatistics().measureCacheHits) + " cache hits and arranged " + std::to_string(layout.getStatistics().arrangedNodes) + " nodes");
+
 	log_info("UI cleaned up!");
 }
\ No newline at end of file
@@ -1,39 +1,308 @@
 #pragma once
 #define ui_h
 
+#include <array>
 #include <vector>
+#include <cstdint>
+#include <string>
 
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.h>
 
+#include "range_allocator.h"
+#include "draw_list.h"
+#include "layout.h"
+#include "tessellator.h"
+#include "../renderer/vertex_layout.h"
+#include "../text/text.h"
+#include "../texture/textures.h"
+
 class Application;
 
 class UI {
 	public:
+		struct quad {
+			glm::i16vec4 rect;
+			glm::u16vec4 atlasRect;
+			VertexPacking::unorm8x4 color;
+		};
+
+		struct shapePosition {
+			glm::vec2 position;
+		};
+
+		struct shapeColor {
+			VertexPacking::unorm8x4 color;
+		};
+
+		typedef VertexLayout<quad, VERTEX_FIELD(quad, rect), VERTEX_FIELD(quad, color), VERTEX_FIELD(quad, atlasRect)> quadLayout;
+		typedef VertexLayout<shapePosition, VERTEX_FIELD(shapePosition, position)> shapePositionLayout;
+		typedef VertexLayout<shapeColor, VERTEX_FIELD(shapeColor, color)> shapeColorLayout;
+
+		struct viewportConstants {
+			glm::vec2 scale;
+			glm::vec2 offset;
+		};
+
+		struct range {
+			uint32_t first;
+			uint32_t count;
+		};
+
+		struct imageResolution {
+			Textures::textureHandle texture;
+			float screenPixels;
+		};
+
+		struct frameData {
+			std::vector<range> ranges;
+			std::vector<quad> quads;
+			std::vector<range> shapeVertexRanges;
+			std::vector<float> shapePositions;
+			std::vector<uint32_t> shapeColors;
+			std::vector<range> shapeIndexRanges;
+			std::vector<uint32_t> shapeIndices;
+			std::vector<DrawList::command> drawCommands;
+			std::vector<imageResolution> imageResolutions;
+			bool drawListChanged = false;
+			std::vector<GlyphAtlas::region> atlasRegions;
+			std::vector<uint8_t> atlasPixels;
+		};
+
+		struct statistics {
+			uint32_t widgets = 0;
+			uint64_t regeneratedWidgets = 0;
+			uint64_t uploadedQuads = 0;
+			uint64_t uploadedShapeVertices = 0;
+			uint64_t uploadRegions = 0;
+			uint64_t compactions = 0;
+			uint64_t drawListBuilds = 0;
+			uint64_t layoutUpdates = 0;
+			uint32_t drawCommands = 0;
+			uint64_t drawCalls = 0;
+			uint64_t scissorChanges = 0;
+			uint64_t pipelineBinds = 0;
+			uint64_t textureBinds = 0;
+		};
+
+		typedef uint32_t widgetHandle;
+		typedef Textures::textureHandle textureHandle;
+
+		static constexpr widgetHandle NO_WIDGET = UINT32_MAX;
+		static constexpr textureHandle ATLAS_TEXTURE = UINT32_MAX;
+		static const uint32_t DEFAULT_COLOR = 0xFF00FF00;
+		static const uint32_t WHITE = 0xFFFFFFFF;
+
+		enum class widgetType : uint8_t {
+			box,
+			panel,
+			text,
+			image,
+			roundedRect,
+			polyline,
+			arc
+		};
+
 		void init(Application& application);
 		void cleanup();
-		void render(VkCommandBuffer commandBuffer);
+		void render(VkCommandBuffer commandBuffer, VkExtent2D extent);
+		void attachText(Text& text);
 
 		void drawUI();
-		void drawBox(float x, float y, float width, float height);
+		void update();
+		void setViewport(glm::vec2 size);
+
+		widgetHandle createBox(glm::vec4 rect, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET);
+		widgetHandle createPanel(glm::vec4 rect, uint32_t color, uint32_t borderColor, widgetHandle parent = NO_WIDGET);
+		widgetHandle createText(glm::vec2 position, const std::string& text, float size, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET, Text::fontHandle font = Text::NO_FONT);
+		widgetHandle createImage(glm::vec4 rect, textureHandle texture, uint32_t color = WHITE, widgetHandle parent = NO_WIDGET);
+		widgetHandle createRoundedRect(glm::vec4 rect, float radius, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET);
+		widgetHandle createCircle(glm::vec2 center, float radius, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET);
+		widgetHandle createPolyline(const std::vector<glm::vec2>& points, float thickness, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET);
+		widgetHandle createArc(glm::vec2 center, float radius, float startAngle, float endAngle, float thickness, uint32_t color = DEFAULT_COLOR, widgetHandle parent = NO_WIDGET);
+		void destroyWidget(widgetHandle handle);
 
-		void createVertexBuffer(size_t bufferSize);
-		void updateVertexBuffer();
-		void clearVertices();
+		void setRect(widgetHandle handle, glm::vec4 rect);
+		void setColor(widgetHandle handle, uint32_t color);
+		void setVisible(widgetHandle handle, bool visible);
+		void setText(widgetHandle handle, const std::string& text);
+		void setClip(widgetHandle handle, bool clip);
+		void setScroll(widgetHandle handle, glm::vec2 scroll);
+		void setPolyline(widgetHandle handle, const std::vector<glm::vec2>& points);
+		void setLayout(widgetHandle handle, const Layout::style& style);
+
+		static uint32_t packColor(float red, float green, float blue, float alpha = 1.0f);
+		static quad makeQuad(float x, float y, float width, float height, uint32_t color);
+
+		void createQuadBuffers();
+		void writeFrameData(frameData& frame);
+		void applyFrameData(const frameData& frame);
+		void recordUploads(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+		bool isDirty();
+		void markDirty();
+
+		statistics getStatistics();
 	private:
 		Application* application = nullptr;
 
 		void createUIPipeline();
+		void createAtlasImage();
+		void createDescriptorSet();
 
-		VkPipeline uiPipeline;
-		VkPipelineLayout uiPipelineLayout;
+		enum pipelineIndex : uint32_t {
+			SDF_PIPELINE,
+			IMAGE_PIPELINE,
+			SHAPE_PIPELINE,
+			PIPELINE_COUNT
+		};
 
-		struct vertex2D {
-			glm::vec2 position;
-			glm::vec3 color;
+		std::array<VkPipeline, PIPELINE_COUNT> uiPipelines{};
+		VkPipelineLayout uiPipelineLayout = VK_NULL_HANDLE;
+
+		static const uint32_t MAX_QUADS = 100000;
+		static const uint32_t MIN_COMPACTION_QUADS = 1024;
+		static const uint32_t MAX_SHAPE_VERTICES = 65536;
+		static const uint32_t MAX_SHAPE_INDICES = MAX_SHAPE_VERTICES * 3;
+		static const uint32_t MIN_COMPACTION_SHAPE_VERTICES = 4096;
+		static const uint32_t MAX_DRAW_DISCONTINUITIES = 512;
+		static const VkDeviceSize ATLAS_STAGING_OFFSET = MAX_QUADS * sizeof(quad);
+		static const VkDeviceSize SHAPE_STAGING_OFFSET = ATLAS_STAGING_OFFSET + GlyphAtlas::SIZE * GlyphAtlas::SIZE;
+		static const VkDeviceSize SHAPE_COLOR_OFFSET = MAX_SHAPE_VERTICES * sizeof(float) * 2;
+		static const VkDeviceSize SHAPE_INDEX_OFFSET = SHAPE_COLOR_OFFSET + MAX_SHAPE_VERTICES * sizeof(uint32_t);
+		static const VkDeviceSize SHAPE_BUFFER_SIZE = SHAPE_INDEX_OFFSET + MAX_SHAPE_INDICES * sizeof(uint32_t);
+
+		struct widget {
+			widgetType type = widgetType::box;
+			widgetHandle parent = NO_WIDGET;
+			widgetHandle firstChild = NO_WIDGET;
+			widgetHandle lastChild = NO_WIDGET;
+			widgetHandle previousSibling = NO_WIDGET;
+			widgetHandle nextSibling = NO_WIDGET;
+			glm::vec4 rect{};
+			uint32_t color = DEFAULT_COLOR;
+			uint32_t borderColor = 0;
+			std::string text;
+			Text::fontHandle font = Text::NO_FONT;
+			float fontSize = 0.0f;
+			uint32_t pageMask = 0;
+			textureHandle texture = ATLAS_TEXTURE;
+			Layout::nodeHandle layoutNode = Layout::NO_NODE;
+			glm::vec2 scroll{};
+			float radius = 0.0f;
+			float thickness = 0.0f;
+			float startAngle = 0.0f;
+			float endAngle = 0.0f;
+			std::vector<glm::vec2> points;
+			uint32_t firstQuad = RangeAllocator::INVALID_OFFSET;
+			uint32_t quadCount = 0;
+			uint32_t firstVertex = RangeAllocator::INVALID_OFFSET;
+			uint32_t vertexCount = 0;
+			uint32_t firstIndex = RangeAllocator::INVALID_OFFSET;
+			uint32_t indexCount = 0;
+			bool visible = true;
+			bool clip = false;
+			bool dirty = false;
+			bool alive = false;
 		};
 
-		std::vector<vertex2D> vertices;
-		VkBuffer vertexBuffer = VK_NULL_HANDLE;
-		VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
+		static uint32_t getQuadCount(widgetType type);
+		static bool isShape(widgetType type);
+		static uint32_t getPipeline(widgetType type);
+		static uint32_t getShapeSegments(const widget& shape);
+		static void getShapeCounts(const widget& shape, uint32_t& vertexCount, uint32_t& indexCount);
+
+		widgetHandle createWidget(widgetType type, glm::vec4 rect, uint32_t color, uint32_t borderColor, uint32_t quadCount, widgetHandle parent);
+		void linkWidget(widgetHandle handle, widgetHandle parent);
+		void unlinkWidget(widgetHandle handle);
+		void releaseQuads(widgetHandle handle);
+		bool allocateShape(widgetHandle handle);
+		void releaseShape(widgetHandle handle);
+		void setPolylinePoints(widget& shape, const std::vector<glm::vec2>& points);
+		void markWidgetDirty(widgetHandle handle);
+		void markSubtreeDirty(widgetHandle handle);
+		void regenerateWidget(widgetHandle handle);
+		void regenerateShape(widget& shape, glm::vec2 origin, bool visible);
+		void queueUploads(const widget& current);
+		void regenerateDirtyWidgets();
+		void regenerateEvictedText();
+		void compact();
+		void applyLayout();
+		void buildDrawList();
+		void appendWidget(widgetHandle handle, glm::vec2 origin);
+		void appendHiddenWidget(widgetHandle handle);
+
+		std::vector<widget> widgets;
+		std::vector<widgetHandle> freeWidgets;
+		std::vector<widgetHandle> dirtyWidgets;
+		std::vector<widgetHandle> subtreeStack;
+		widgetHandle firstRoot = NO_WIDGET;
+		widgetHandle lastRoot = NO_WIDGET;
+
+		Layout layout;
+		std::vector<widgetHandle> layoutWidgets;
+		glm::vec2 viewport{};
+
+		Text* text = nullptr;
+		std::vector<Text::glyphQuad> glyphQuads;
+
+		RangeAllocator quadAllocator;
+		std::vector<quad> quads;
+		std::vector<range> pendingRanges;
+		RangeAllocator vertexAllocator;
+		RangeAllocator indexAllocator;
+		std::vector<float> shapePositions;
+		std::vector<uint32_t> shapeColors;
+		std::vector<uint32_t> shapeIndices;
+		std::vector<range> pendingVertexRanges;
+		std::vector<range> pendingIndexRanges;
+		DrawList drawList;
+		std::vector<imageResolution> imageResolutions;
+		bool drawListDirty = true;
+		bool drawListChanged = false;
+		bool dirty = true;
+
+		statistics stats;
+
+		std::vector<quad> renderQuads;
+		std::vector<range> uploadRanges;
+		std::vector<VkBufferCopy> copyRegions;
+		std::vector<DrawList::command> renderCommands;
+		std::vector<imageResolution> renderImageResolutions;
+		bool quadBufferTracked = false;
+
+		std::vector<float> renderShapePositions;
+		std::vector<uint32_t> renderShapeColors;
+		std::vector<uint32_t> renderShapeIndices;
+		std::vector<range> shapeVertexUploads;
+		std::vector<range> shapeIndexUploads;
+		std::vector<VkBufferCopy> shapeCopyRegions;
+		bool shapeBufferTracked = false;
+
+		std::vector<uint8_t> renderAtlas;
+		std::vector<GlyphAtlas::region> atlasUploadRegions;
+		std::vector<VkBufferImageCopy> atlasCopyRegions;
+		bool atlasImageTracked = false;
+
+		VkBuffer quadBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory quadBufferMemory = VK_NULL_HANDLE;
+
+		VkBuffer shapeBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory shapeBufferMemory = VK_NULL_HANDLE;
+
+		std::vector<VkBuffer> stagingBuffers;
+		std::vector<VkDeviceMemory> stagingBufferMemories;
+		std::vector<void*> mappedStagingBuffers;
+
+		VkBuffer indexBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
+
+		VkImage atlasImage = VK_NULL_HANDLE;
+		VkDeviceMemory atlasImageMemory = VK_NULL_HANDLE;
+		VkImageView atlasImageView = VK_NULL_HANDLE;
+		VkSampler atlasSampler = VK_NULL_HANDLE;
+
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSet atlasSet = VK_NULL_HANDLE;
 };
\ No newline at end of file
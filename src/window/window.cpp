@@ -4,35 +4,92 @@
 void Window::init(Application& application) {
 	log_info("Initializing window...");
 
+	if (application.options.headless) {
+		log_info("Headless mode, skipping window creation!");
+
+		return;
+	}
+
 	glfwInit();
 
 	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
 	application.window.glfwWindow = glfwCreateWindow(application.window.getWindowWidth(application), application.window.getWindowHeight(application), application.window.getWindowName(application), nullptr, nullptr);
-	glfwSetWindowUserPointer(application.window.glfwWindow, this);
+	glfwSetWindowUserPointer(application.window.glfwWindow, &application);
 	glfwSetFramebufferSizeCallback(application.window.glfwWindow, application.window.framebufferResizeCallback);
+	glfwSetWindowIconifyCallback(application.window.glfwWindow, application.window.iconifyCallback);
+	glfwSetWindowRefreshCallback(application.window.glfwWindow, application.window.refreshCallback);
 
 	log_info("Window initialized!");
 }
 
 void Window::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
-	auto renderer = reinterpret_cast<Renderer*>(glfwGetWindowUserPointer(window));
-	renderer->framebufferResized = true;
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+	application->renderer.framebufferResized = true;
+
+	Input::event resizeEvent{};
+	resizeEvent.type = Input::eventType::resize;
+	resizeEvent.x = width;
+	resizeEvent.y = height;
+
+	application->input.pushEvent(resizeEvent);
+}
+
+void Window::iconifyCallback(GLFWwindow* window, int iconified) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+	application->window.minimized = iconified == GLFW_TRUE;
+
+	if (!application->window.minimized) {
+		application->renderer.markDamaged();
+	}
+}
+
+void Window::refreshCallback(GLFWwindow* window) {
+	Application* application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+	application->renderer.markDamaged();
+}
+
+bool Window::isMinimized() {
+	return minimized;
 }
 
 bool Window::shouldClose(Application& application) {
+	if (application.options.headless) {
+		return application.options.frameCount != 0 && application.renderer.getFrameNumber() >= application.options.frameCount;
+	}
+
 	return glfwWindowShouldClose(application.window.glfwWindow);
 }
 
 void Window::poll(Application& application) {
-	glfwPollEvents();
-
-	application.input.loop(application, application.window.glfwWindow);
+	trace_zone("Window::poll");
+
+	if (application.options.headless) {
+		return;
+	}
+
+	if (application.window.isMinimized()) {
+		trace_zone("wait minimized");
+		glfwWaitEvents();
+	}
+	else if (application.renderer.canIdle()) {
+		trace_zone("wait idle");
+		glfwWaitEventsTimeout(application.renderer.getIdleTimeout());
+	}
+	else {
+		glfwPollEvents();
+	}
+
+	application.input.processEvents(application);
 }
 
 void Window::cleanup(Application& application) const {
 	log_info("Cleaning up window...");
 
+	if (application.options.headless) {
+		return;
+	}
+
 	glfwDestroyWindow(application.window.glfwWindow);
 	glfwTerminate();
 
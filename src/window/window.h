@@ -2,7 +2,10 @@
 #define window_h
 
 #define GLFW_INCLUDE_VULKAN
+
+#ifdef _WIN32
 #define GLFW_EXPOSE_NATIVE_WIN32
+#endif
 
 #include "GLFW/glfw3.h"
 #include "GLFW/glfw3native.h"
@@ -15,6 +18,7 @@ class Window {
 		void poll(Application& application);
 		void cleanup(Application& application) const;
 		bool shouldClose(Application& application);
+		bool isMinimized();
 
 		const char* getWindowName(Application& application);
 		const uint32_t getWindowWidth(Application& application);
@@ -31,5 +35,9 @@ class Window {
 		uint32_t windowWidth = 800;
 		uint32_t windowHeight = 600;
 
+		bool minimized = false;
+
 		static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
+		static void iconifyCallback(GLFWwindow* window, int iconified);
+		static void refreshCallback(GLFWwindow* window);
 };
\ No newline at end of file